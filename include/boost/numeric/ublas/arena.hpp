@@ -0,0 +1,356 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_ARENA_
+#define _BOOST_UBLAS_ARENA_
+
+#include <new>
+#include <algorithm>
+#include <limits>
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/numeric/ublas/exception.hpp>
+
+/** \file arena.hpp
+ *  \brief Scoped bump allocation for dense temporaries.
+ *
+ * An \c arena hands out memory from a few large blocks by advancing a pointer.
+ * Memory is never returned piecewise: an \c arena_scope records the position
+ * of the arena on construction and rewinds to it on destruction. While a scope
+ * is active on a thread, \c arena_allocator (and hence the scratch vectors and
+ * matrices uBLAS uses internally, see \c detail/temporary.hpp) draws from it
+ * instead of the global heap.
+ *
+ * \code
+ * arena a;                      // one per thread
+ * for (...) {
+ *     arena_scope scope (a);    // temporaries below are bump allocated
+ *     lu_factorize (m, pm);
+ *     axpy_prod (m, x, y);
+ * }                             // everything released at once
+ * \endcode
+ *
+ * Containers using \c arena_allocator must not be used after the scope in which
+ * they were allocated has ended, but may still be destroyed: releasing memory
+ * drawn from an arena does not touch the arena, whichever thread it happens
+ * on, and the memory is reused only after the next rewind.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+    class arena_scope;
+
+    /** \brief Stack-like bump allocator made of a list of blocks.
+     *
+     * Blocks are kept after a rewind and reused by later allocations; they are
+     * returned to the heap only by \c release or on destruction.
+     */
+    class arena:
+        private boost::noncopyable {
+        struct block {
+            block *next_;
+            std::size_t size_;
+            std::size_t used_;
+
+            char *data () {
+                return reinterpret_cast<char *> (this + 1);
+            }
+        };
+    public:
+        typedef std::size_t size_type;
+
+        /// Position in the arena, see \c mark and \c rewind
+        class marker {
+        public:
+            marker ():
+                block_ (0), used_ (0) {}
+        private:
+            marker (block *b, size_type used):
+                block_ (b), used_ (used) {}
+            block *block_;
+            size_type used_;
+            friend class arena;
+        };
+
+        // Construction and destruction
+        explicit BOOST_UBLAS_INLINE
+        arena (size_type block_size = BOOST_UBLAS_ARENA_BLOCK_SIZE):
+            block_size_ (block_size), first_ (0), current_ (0) {}
+        BOOST_UBLAS_INLINE
+        ~arena () {
+            free_blocks (first_);
+        }
+
+        // Allocation
+        void *allocate (size_type n, size_type alignment) {
+            if (alignment < BOOST_UBLAS_ARENA_ALIGNMENT)
+                alignment = BOOST_UBLAS_ARENA_ALIGNMENT;
+            if (current_) {
+                void *p = bump (current_, n, alignment);
+                if (p)
+                    return p;
+                // Reuse the following blocks left over from a rewind
+                while (current_->next_) {
+                    current_ = current_->next_;
+                    current_->used_ = 0;
+                    p = bump (current_, n, alignment);
+                    if (p)
+                        return p;
+                }
+            }
+            block *b = new_block ((std::max) (block_size_, n + alignment));
+            if (current_)
+                current_->next_ = b;
+            else
+                first_ = b;
+            current_ = b;
+            return bump (current_, n, alignment);
+        }
+        BOOST_UBLAS_INLINE
+        bool owns (const void *p) const {
+            const char *cp = static_cast<const char *> (p);
+            for (block *b = first_; b; b = b->next_) {
+                if (cp >= b->data () && cp < b->data () + b->size_)
+                    return true;
+                if (b == current_)
+                    break;
+            }
+            return false;
+        }
+
+        // Stack discipline
+        BOOST_UBLAS_INLINE
+        marker mark () const {
+            return current_ ? marker (current_, current_->used_) : marker ();
+        }
+        BOOST_UBLAS_INLINE
+        void rewind (const marker &m) {
+            if (m.block_) {
+                current_ = m.block_;
+                current_->used_ = m.used_;
+            } else if (first_) {
+                current_ = first_;
+                current_->used_ = 0;
+            }
+        }
+
+        /// Return the blocks not in use to the heap
+        BOOST_UBLAS_INLINE
+        void release () {
+            if (current_) {
+                free_blocks (current_->next_);
+                current_->next_ = 0;
+            }
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type block_size () const {
+            return block_size_;
+        }
+        /// Bytes currently handed out, including alignment padding
+        BOOST_UBLAS_INLINE
+        size_type used () const {
+            size_type s = 0;
+            for (block *b = first_; b; b = b->next_) {
+                s += b->used_;
+                if (b == current_)
+                    break;
+            }
+            return s;
+        }
+        /// Bytes reserved from the heap
+        BOOST_UBLAS_INLINE
+        size_type capacity () const {
+            size_type s = 0;
+            for (block *b = first_; b; b = b->next_)
+                s += b->size_;
+            return s;
+        }
+
+        /// The arena of the innermost active scope on this thread, or 0
+        static arena *active ();
+
+    private:
+        static void *bump (block *b, size_type n, size_type alignment) {
+            std::size_t base = reinterpret_cast<std::size_t> (b->data ());
+            std::size_t p = (base + b->used_ + alignment - 1) / alignment * alignment;
+            if (p + n > base + b->size_)
+                return 0;
+            b->used_ = p + n - base;
+            return reinterpret_cast<void *> (p);
+        }
+        static block *new_block (size_type size) {
+            block *b = static_cast<block *> (::operator new (sizeof (block) + size));
+            b->next_ = 0;
+            b->size_ = size;
+            b->used_ = 0;
+            return b;
+        }
+        static void free_blocks (block *b) {
+            while (b) {
+                block *next = b->next_;
+                ::operator delete (b);
+                b = next;
+            }
+        }
+
+        size_type block_size_;
+        block *first_;
+        block *current_;
+    };
+
+    /** \brief Makes an arena active on the current thread for the lifetime of the scope.
+     *
+     * On destruction the arena is rewound to the position it had on construction
+     * and the previously active arena, if any, becomes active again. The default
+     * constructor opens a nested scope on the currently active arena.
+     */
+    class arena_scope:
+        private boost::noncopyable {
+    public:
+        explicit BOOST_UBLAS_INLINE
+        arena_scope (arena &a):
+            previous_ (innermost ()), arena_ (&a), marker_ (a.mark ()) {
+            innermost () = this;
+        }
+        BOOST_UBLAS_INLINE
+        arena_scope ():
+            previous_ (innermost ()), arena_ (previous_ ? previous_->arena_ : 0),
+            marker_ (arena_ ? arena_->mark () : arena::marker ()) {
+            innermost () = this;
+        }
+        BOOST_UBLAS_INLINE
+        ~arena_scope () {
+            BOOST_UBLAS_CHECK (innermost () == this, internal_logic ());
+            if (arena_)
+                arena_->rewind (marker_);
+            innermost () = previous_;
+        }
+
+        BOOST_UBLAS_INLINE
+        arena *get () const {
+            return arena_;
+        }
+
+    private:
+        static arena_scope *&innermost () {
+            static BOOST_UBLAS_THREAD_LOCAL arena_scope *scope = 0;
+            return scope;
+        }
+
+        arena_scope *previous_;
+        arena *arena_;
+        arena::marker marker_;
+
+        friend class arena;
+    };
+
+    inline
+    arena *arena::active () {
+        arena_scope *s = arena_scope::innermost ();
+        return s ? s->arena_ : 0;
+    }
+
+
+    /** \brief Stateless allocator drawing from the active arena, or the heap if there is none.
+     *
+     * Usable as the allocator of \c unbounded_array so that user containers can
+     * opt in, e.g. <tt>matrix<double, row_major, unbounded_array<double, arena_allocator<double> > ></tt>.
+     */
+    template<class T>
+    class arena_allocator {
+    public:
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+
+        template<class U>
+        struct rebind {
+            typedef arena_allocator<U> other;
+        };
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        arena_allocator () {}
+        template<class U>
+        BOOST_UBLAS_INLINE
+        arena_allocator (const arena_allocator<U> &) {}
+
+        BOOST_UBLAS_INLINE
+        pointer address (reference x) const {
+            return &x;
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer address (const_reference x) const {
+            return &x;
+        }
+
+        // Allocation
+        // The arena an element array was drawn from, or 0 for the heap, is stored just in front of
+        // it, in a header keeping the alignment of the arena or of T. Arena memory is left to the
+        // rewind of the arena: once its scope has ended a newer allocation may sit at the same
+        // address, so even the most recent allocation cannot be handed back safely.
+        BOOST_UBLAS_INLINE
+        pointer allocate (size_type n, const void * = 0) {
+            arena *a = arena::active ();
+            const size_type h = header_size (a);
+            char *p = a ? static_cast<char *> (a->allocate (n * sizeof (T) + h, boost::alignment_of<T>::value)) :
+                          static_cast<char *> (::operator new (n * sizeof (T) + h));
+            *reinterpret_cast<arena **> (p + h - sizeof (arena *)) = a;
+            return reinterpret_cast<pointer> (p + h);
+        }
+        BOOST_UBLAS_INLINE
+        void deallocate (pointer p, size_type) {
+            char *cp = reinterpret_cast<char *> (p);
+            if (! *reinterpret_cast<arena **> (cp - sizeof (arena *)))
+                ::operator delete (cp - header_size (0));
+        }
+        BOOST_UBLAS_INLINE
+        size_type max_size () const {
+            return ((std::numeric_limits<size_type>::max) () - header_size (0) - BOOST_UBLAS_ARENA_ALIGNMENT) / sizeof (T);
+        }
+
+        BOOST_UBLAS_INLINE
+        void construct (pointer p, const_reference t) {
+            new (p) T (t);
+        }
+        BOOST_UBLAS_INLINE
+        void destroy (pointer p) {
+            p->~T ();
+        }
+
+    private:
+        static BOOST_UBLAS_INLINE
+        size_type header_size (const arena *a) {
+            const size_type alignment = a && BOOST_UBLAS_ARENA_ALIGNMENT > boost::alignment_of<T>::value ?
+                                        BOOST_UBLAS_ARENA_ALIGNMENT : boost::alignment_of<T>::value;
+            return (sizeof (arena *) + alignment - 1) / alignment * alignment;
+        }
+    };
+
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool operator == (const arena_allocator<T> &, const arena_allocator<U> &) {
+        return true;
+    }
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool operator != (const arena_allocator<T> &, const arena_allocator<U> &) {
+        return false;
+    }
+
+}}}
+
+#endif
@@ -16,6 +16,10 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
 
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 // Iterators based on ideas of Jeremy Siek
 
 namespace boost { namespace numeric { namespace ublas {
@@ -2066,6 +2070,332 @@ namespace boost { namespace numeric { namespace ublas {
         }
     };
 
+
+    namespace detail {
+        // Direction of unit stride in the storage of banded matrices, the kernels below walk along it.
+        // unknown_orientation_tag stands for diagonals.
+        template<class M>
+        struct banded_storage_traits {};
+        template<class T, class L, class A>
+        struct banded_storage_traits<banded_matrix<T, L, A> > {
+            static const bool value = boost::is_pointer<typename A::iterator>::value;
+            typedef T value_type;
+#ifdef BOOST_UBLAS_OWN_BANDED
+            typedef unknown_orientation_tag orientation_category;
+#else
+            // Columns of the band are stored together in row major, diagonals in column major
+            typedef typename boost::mpl::if_<boost::is_same<typename L::orientation_category, row_major_tag>,
+                                              column_major_tag,
+                                              unknown_orientation_tag>::type orientation_category;
+#endif
+        };
+        template<class M>
+        struct banded_storage_traits<banded_adaptor<M> > {
+            typedef typename boost::remove_const<M>::type matrix_type;
+            static const bool value = dense_block_traits<matrix_type>::value;
+            typedef typename dense_block_traits<matrix_type>::value_type value_type;
+            typedef typename dense_block_traits<matrix_type>::orientation_category orientation_category;
+        };
+
+        template<class T, class L, class A>
+        struct matrix_vector_kernel_traits<banded_matrix<T, L, A> >:
+            banded_storage_traits<banded_matrix<T, L, A> > {};
+        template<class M>
+        struct matrix_vector_kernel_traits<banded_adaptor<M> >:
+            banded_storage_traits<banded_adaptor<M> > {};
+
+        // y += alpha * m * x, in the spirit of BLAS gbmv. The elements of the band are addressed
+        // through a pointer and a stride, which is 1 along the orientation of the storage.
+        template<class M, class T>
+        void banded_axpy (const M &m, const T *x, T *y, const T &alpha, unknown_orientation_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename M::difference_type difference_type;
+            size_type size1 = m.size1 (), size2 = m.size2 ();
+            size_type lower = m.lower (), upper = m.upper ();
+            // Diagonal l holds the elements with i - j == l - upper
+            for (size_type l = 0; l < lower + 1 + upper; ++ l) {
+                size_type i = l > upper ? l - upper : 0;
+                size_type j = l < upper ? upper - l : 0;
+                if (i >= size1 || j >= size2)
+                    continue;
+                size_type n = (std::min) (size1 - i, size2 - j);
+                const T *a = &m (i, j);
+                difference_type s = n > 1 ? &m (i + 1, j + 1) - a : 1;
+                const T *xj = x + j;
+                T *yi = y + i;
+                if (s == 1) {
+                    for (size_type k = 0; k < n; ++ k)
+                        yi [k] += alpha * a [k] * xj [k];
+                } else {
+                    for (size_type k = 0; k < n; ++ k)
+                        yi [k] += alpha * a [k * s] * xj [k];
+                }
+            }
+        }
+        template<class M, class T>
+        void banded_axpy (const M &m, const T *x, T *y, const T &alpha, column_major_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename M::difference_type difference_type;
+            size_type size1 = m.size1 (), size2 = m.size2 ();
+            size_type lower = m.lower (), upper = m.upper ();
+            for (size_type j = 0; j < size2; ++ j) {
+                size_type first = j > upper ? j - upper : 0;
+                size_type last = (std::min) (size1, j + lower + 1);
+                if (first >= last || x [j] == T/*zero*/())
+                    continue;
+                size_type n = last - first;
+                const T *a = &m (first, j);
+                difference_type s = n > 1 ? &m (first + 1, j) - a : 1;
+                T t (alpha * x [j]);
+                T *yi = y + first;
+                if (s == 1) {
+                    for (size_type k = 0; k < n; ++ k)
+                        yi [k] += a [k] * t;
+                } else {
+                    for (size_type k = 0; k < n; ++ k)
+                        yi [k] += a [k * s] * t;
+                }
+            }
+        }
+        template<class M, class T>
+        void banded_axpy (const M &m, const T *x, T *y, const T &alpha, row_major_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename M::difference_type difference_type;
+            size_type size1 = m.size1 (), size2 = m.size2 ();
+            size_type lower = m.lower (), upper = m.upper ();
+            for (size_type i = 0; i < size1; ++ i) {
+                size_type first = i > lower ? i - lower : 0;
+                size_type last = (std::min) (size2, i + upper + 1);
+                if (first >= last)
+                    continue;
+                size_type n = last - first;
+                const T *a = &m (i, first);
+                difference_type s = n > 1 ? &m (i, first + 1) - a : 1;
+                const T *xj = x + first;
+                T t = T/*zero*/();
+                if (s == 1) {
+                    for (size_type k = 0; k < n; ++ k)
+                        t += a [k] * xj [k];
+                } else {
+                    for (size_type k = 0; k < n; ++ k)
+                        t += a [k * s] * xj [k];
+                }
+                y [i] += alpha * t;
+            }
+        }
+
+        // Product of two banded matrices, accumulated as outer products of the columns of e1
+        // and the rows of e2 into a banded result with l1 + l2 lower and u1 + u2 upper diagonals
+        template<class R, class E1, class E2>
+        R banded_prod (const E1 &e1, const E2 &e2) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+            size_type size1 = e1.size1 (), size2 = e2.size2 ();
+            size_type size = BOOST_UBLAS_SAME (e1.size2 (), e2.size1 ());
+            size_type lower = (std::min) (e1.lower () + e2.lower (), size1 > 0 ? size1 - 1 : 0);
+            size_type upper = (std::min) (e1.upper () + e2.upper (), size2 > 0 ? size2 - 1 : 0);
+            R r (size1, size2, lower, upper);
+            r.clear ();
+            for (size_type k = 0; k < size; ++ k) {
+                size_type first1 = k > e1.upper () ? k - e1.upper () : 0;
+                size_type last1 = (std::min) (size1, k + e1.lower () + 1);
+                size_type first2 = k > e2.lower () ? k - e2.lower () : 0;
+                size_type last2 = (std::min) (size2, k + e2.upper () + 1);
+                for (size_type j = first2; j < last2; ++ j) {
+                    value_type t (e2 (k, j));
+                    if (t == value_type/*zero*/())
+                        continue;
+                    for (size_type i = first1; i < last1; ++ i)
+                        r.at_element (i, j) += e1 (i, k) * t;
+                }
+            }
+            return r;
+        }
+    }
+
+    // Matrix vector product kernels
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const banded_matrix<T, L, A> &m, const T *x, T *y, const T &alpha) {
+        detail::banded_axpy (m, x, y, alpha, typename detail::banded_storage_traits<banded_matrix<T, L, A> >::orientation_category ());
+    }
+    template<class M, class T>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const banded_adaptor<M> &m, const T *x, T *y, const T &alpha) {
+        detail::banded_axpy (m, x, y, alpha, typename detail::banded_storage_traits<banded_adaptor<M> >::orientation_category ());
+    }
+
+    /** \brief Product of banded matrices, evaluated into a banded matrix.
+     *
+     * The result is a \c banded_matrix with the sum of the lower and the sum of the upper
+     * bandwidths of the operands, and is computed in \f$O(n\,(l_1+u_1+1)(l_2+u_2+1))\f$
+     * operations instead of a dense product. \c prod of banded matrices remains the lazy
+     * matrix product expression.
+     */
+    template<class T1, class L1, class A1, class T2, class L2, class A2>
+    BOOST_UBLAS_INLINE
+    banded_matrix<typename promote_traits<T1, T2>::promote_type, L1>
+    banded_prod (const banded_matrix<T1, L1, A1> &e1,
+                 const banded_matrix<T2, L2, A2> &e2) {
+        typedef banded_matrix<typename promote_traits<T1, T2>::promote_type, L1> result_type;
+        return detail::banded_prod<result_type> (e1, e2);
+    }
+    template<class T1, class L1, class A1, class M2>
+    BOOST_UBLAS_INLINE
+    banded_matrix<typename promote_traits<T1, typename M2::value_type>::promote_type, L1>
+    banded_prod (const banded_matrix<T1, L1, A1> &e1,
+                 const banded_adaptor<M2> &e2) {
+        typedef banded_matrix<typename promote_traits<T1, typename M2::value_type>::promote_type, L1> result_type;
+        return detail::banded_prod<result_type> (e1, e2);
+    }
+    template<class M1, class T2, class L2, class A2>
+    BOOST_UBLAS_INLINE
+    banded_matrix<typename promote_traits<typename M1::value_type, T2>::promote_type, L2>
+    banded_prod (const banded_adaptor<M1> &e1,
+                 const banded_matrix<T2, L2, A2> &e2) {
+        typedef banded_matrix<typename promote_traits<typename M1::value_type, T2>::promote_type, L2> result_type;
+        return detail::banded_prod<result_type> (e1, e2);
+    }
+    template<class M1, class M2>
+    BOOST_UBLAS_INLINE
+    banded_matrix<typename promote_traits<typename M1::value_type, typename M2::value_type>::promote_type>
+    banded_prod (const banded_adaptor<M1> &e1,
+                 const banded_adaptor<M2> &e2) {
+        typedef banded_matrix<typename promote_traits<typename M1::value_type, typename M2::value_type>::promote_type> result_type;
+        return detail::banded_prod<result_type> (e1, e2);
+    }
+
+    namespace detail {
+        template<class T, class L, class A>
+        struct diagonal_operand_traits<banded_matrix<T, L, A> > {
+            static const bool value = true;
+        };
+        template<class M>
+        struct diagonal_operand_traits<banded_adaptor<M> > {
+            static const bool value = true;
+        };
+
+        // y := (assign ? 0 : y) + s * d * x along a line of n elements, d (k) being 1 without d
+        template<class T>
+        void diagonal_scale_line (T *y, std::ptrdiff_t sy, const T *x, std::ptrdiff_t sx, const T *d, const T &s,
+                                  std::size_t n, bool assign) {
+            typedef std::size_t size_type;
+            if (sy == 1 && sx == 1) {
+                if (d && assign)
+                    for (size_type k = 0; k < n; ++ k)
+                        y [k] = s * d [k] * x [k];
+                else if (d)
+                    for (size_type k = 0; k < n; ++ k)
+                        y [k] += s * d [k] * x [k];
+                else if (assign)
+                    for (size_type k = 0; k < n; ++ k)
+                        y [k] = s * x [k];
+                else
+                    for (size_type k = 0; k < n; ++ k)
+                        y [k] += s * x [k];
+            } else {
+                for (size_type k = 0; k < n; ++ k) {
+                    T t (d ? s * d [k] * x [k * sx] : s * x [k * sx]);
+                    if (assign)
+                        y [k * sy] = t;
+                    else
+                        y [k * sy] += t;
+                }
+            }
+        }
+
+        // The lines [first, last) of m along its orientation, dv holding the diagonal along the
+        // scaled dimension. Lines and elements beyond the extent of a are zero.
+        template<class E, class M, class V>
+        void diagonal_prod_lines (const E &a, M &m, const V &dv, const typename M::value_type &alpha, bool assign, bool left,
+                                  typename M::size_type first, typename M::size_type last) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            const bool rows = boost::is_same<typename dense_block_traits<M>::orientation_category, row_major_tag>::value;
+            const size_type length = rows ? m.size2 () : m.size1 ();
+            const size_type a_lines = rows ? a.size1 () : a.size2 ();
+            const size_type a_length = (std::min) (length, rows ? a.size2 () : a.size1 ());
+            // Whole lines are scaled by one element of the diagonal when they run across it
+            const bool per_line = left == rows;
+            for (size_type l = first; l < last; ++ l) {
+                value_type *y = rows ? &m (l, 0) : &m (0, l);
+                const std::ptrdiff_t sy = length > 1 ? (rows ? &m (l, 1) : &m (1, l)) - y : 1;
+                size_type done = 0;
+                if (l < a_lines && a_length > 0) {
+                    const value_type *x = rows ? &a (l, 0) : &a (0, l);
+                    const std::ptrdiff_t sx = a_length > 1 ? (rows ? &a (l, 1) : &a (1, l)) - x : 1;
+                    if (per_line)
+                        diagonal_scale_line<value_type> (y, sy, x, sx, 0, alpha * dv [l], a_length, assign);
+                    else
+                        diagonal_scale_line<value_type> (y, sy, x, sx, &dv [0], alpha, a_length, assign);
+                    done = a_length;
+                }
+                if (assign)
+                    for (size_type k = done; k < length; ++ k)
+                        y [k * sy] = value_type/*zero*/();
+            }
+        }
+
+        // m := (assign ? 0 : m) + alpha * d * a (left) or alpha * a * d (right), line by line
+        // along the orientation of m, the lines being shared between OpenMP threads for large
+        // matrices
+        template<class D, class E, class M>
+        void diagonal_prod (const D &d, const E &a, M &m, const typename M::value_type &alpha, bool assign, bool left) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+            typedef typename vector_scratch_traits<value_type>::type scratch_type;
+
+            if (left) {
+                BOOST_UBLAS_CHECK (m.size1 () == d.size1 () && d.size2 () == a.size1 () && m.size2 () == a.size2 (), bad_size ());
+            } else {
+                BOOST_UBLAS_CHECK (m.size1 () == a.size1 () && a.size2 () == d.size1 () && m.size2 () == d.size2 (), bad_size ());
+            }
+            // The diagonal along the scaled dimension of m, zero beyond the diagonal of d
+            scratch_type dv (left ? m.size1 () : m.size2 (), value_type/*zero*/());
+            const size_type diagonal = (std::min) ((std::min) (d.size1 (), d.size2 ()), dv.size ());
+            for (size_type k = 0; k < diagonal; ++ k)
+                dv [k] = d (k, k);
+
+            const bool rows = boost::is_same<typename dense_block_traits<M>::orientation_category, row_major_tag>::value;
+            const size_type lines = rows ? m.size1 () : m.size2 ();
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (lines > chunk && m.size1 () * m.size2 () >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((lines + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long c = 0; c < chunks; ++ c)
+                    diagonal_prod_lines (a, m, dv, alpha, assign, left, size_type (c) * chunk, (std::min) (size_type (c + 1) * chunk, lines));
+                return;
+            }
+#endif
+            diagonal_prod_lines (a, m, dv, alpha, assign, left, 0, lines);
+        }
+
+        template<class E1, class E2, class M>
+        bool diagonal_prod_axpy (const E1 &e1, const E2 &e2, M &m, const typename M::value_type &alpha, bool assign, boost::mpl::true_) {
+            if (e1.lower () != 0 || e1.upper () != 0)
+                return false;
+            diagonal_prod (e1, e2, m, alpha, assign, true);
+            return true;
+        }
+        template<class E1, class E2, class M>
+        bool diagonal_prod_axpy (const E1 &e1, const E2 &e2, M &m, const typename M::value_type &alpha, bool assign, boost::mpl::false_) {
+            if (e2.lower () != 0 || e2.upper () != 0)
+                return false;
+            diagonal_prod (e2, e1, m, alpha, assign, false);
+            return true;
+        }
+    }
+
+    // Products with a diagonal_matrix, a diagonal_adaptor or any other band of the diagonal alone,
+    // see diagonal_prod_tag. Wider bands are left to the caller, false being returned.
+    template<class E1, class E2, class M, class T>
+    bool diagonal_prod_axpy (const E1 &e1, const E2 &e2, M &m, const T &alpha, bool assign) {
+        return detail::diagonal_prod_axpy (e1, e2, m, alpha, assign, boost::mpl::bool_<detail::diagonal_operand_traits<E1>::value> ());
+    }
+
 }}}
 
 #endif
@@ -11,6 +11,7 @@
 #define _BOOST_UBLAS_BLAS_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/contiguous.hpp>
 
 namespace boost { namespace numeric { namespace ublas {
     
@@ -338,6 +339,93 @@ namespace boost { namespace numeric { namespace ublas {
 
     }
 
+    namespace detail {
+        // The container of which an expression reads the elements, through references,
+        // transposes, ranges and adaptors, or the expression itself
+        template<class E>
+        const void *referred_storage (const E &e);
+        template<class E>
+        const void *referred_storage (const matrix_reference<E> &e);
+        template<class E, class F>
+        const void *referred_storage (const matrix_unary1<E, F> &e);
+        template<class E, class F>
+        const void *referred_storage (const matrix_unary2<E, F> &e);
+        template<class M>
+        const void *referred_storage (const matrix_range<M> &e);
+        template<class M, class TRI>
+        const void *referred_storage (const symmetric_adaptor<M, TRI> &e);
+        template<class M, class TRI>
+        const void *referred_storage (const hermitian_adaptor<M, TRI> &e);
+
+        template<class E>
+        const void *referred_storage (const E &e) {
+            return &e;
+        }
+        template<class E>
+        const void *referred_storage (const matrix_reference<E> &e) {
+            return referred_storage (e.expression ());
+        }
+        template<class E, class F>
+        const void *referred_storage (const matrix_unary1<E, F> &e) {
+            return referred_storage (e.expression ());
+        }
+        template<class E, class F>
+        const void *referred_storage (const matrix_unary2<E, F> &e) {
+            return referred_storage (e.expression ());
+        }
+        template<class M>
+        const void *referred_storage (const matrix_range<M> &e) {
+            return referred_storage (e.data ());
+        }
+        template<class M, class TRI>
+        const void *referred_storage (const symmetric_adaptor<M, TRI> &e) {
+            return referred_storage (e.data ());
+        }
+        template<class M, class TRI>
+        const void *referred_storage (const hermitian_adaptor<M, TRI> &e) {
+            return referred_storage (e.data ());
+        }
+
+        // Rank k and rank 2k updates, of the stored triangle only when m1 is a symmetric or
+        // hermitian matrix, see symmetric_prod_update. The kernel writes m1 while it reads the
+        // operands, so that an operand referring to m1 is read from a copy of it.
+        template<class M1, class T1, class T2, class M2, class M3>
+        M1 &rank_update (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3, boost::mpl::true_) {
+            typedef typename M1::value_type value_type;
+            const void *storage = referred_storage (m1);
+            if (referred_storage (m2) == storage || referred_storage (m3) == storage) {
+                typename symmetric_target_traits<M1>::temporary_type temporary (m1);
+                symmetric_prod_update (temporary, m2, m3, value_type (t2), value_type (t1));
+                return m1 = temporary;
+            }
+            symmetric_prod_update (m1, m2, m3, value_type (t2), value_type (t1));
+            return m1;
+        }
+        template<class M1, class T1, class T2, class M2, class M3>
+        M1 &rank_update (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3, boost::mpl::false_) {
+            return m1 = t1 * m1 + t2 * prod (m2, m3);
+        }
+        template<class M1, class T1, class T2, class M2, class M3, class M4, class M5, class T3>
+        M1 &rank_update (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3,
+                         const T3 &t3, const M4 &m4, const M5 &m5, boost::mpl::true_) {
+            typedef typename M1::value_type value_type;
+            const void *storage = referred_storage (m1);
+            if (referred_storage (m2) == storage || referred_storage (m3) == storage ||
+                referred_storage (m4) == storage || referred_storage (m5) == storage) {
+                typename symmetric_target_traits<M1>::temporary_type temporary (m1);
+                symmetric_prod_update (temporary, m2, m3, value_type (t2), m4, m5, value_type (t3), value_type (t1));
+                return m1 = temporary;
+            }
+            symmetric_prod_update (m1, m2, m3, value_type (t2), m4, m5, value_type (t3), value_type (t1));
+            return m1;
+        }
+        template<class M1, class T1, class T2, class M2, class M3, class M4, class M5, class T3>
+        M1 &rank_update (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3,
+                         const T3 &t3, const M4 &m4, const M5 &m5, boost::mpl::false_) {
+            return m1 = t1 * m1 + t2 * prod (m2, m3) + t3 * prod (m4, m5);
+        }
+    }
+
     /** \brief Interface and implementation of BLAS level 3
      * This includes functions which perform \b matrix-matrix operations.
      * More information about BLAS can be found at 
@@ -362,7 +450,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class M1, class T, class M2, class M3>
         M1 & tmm (M1 &m1, const T &t, const M2 &m2, const M3 &m3) 
     {
-            return m1 = t * prod (m2, m3);
+            // The product alone is seen by the triangular kernel when m2 or m3 is triangular
+            m1 = prod (m2, m3);
+            return m1 *= t;
         }
 
         /** \brief triangular solve \f$ m_2.x = t.m_1\f$ in place, \f$m_2\f$ is a triangular matrix
@@ -417,12 +507,12 @@ namespace boost { namespace numeric { namespace ublas {
      * \tparam T1 type of the first scalar (not needed by default)
      * \tparam T2 type of the second scalar (not needed by default)
      * \tparam M2 type of the second matrix (not needed by default)
-     * \todo use opb_prod()
+     * Symmetric and hermitian \c m1 only have their stored triangle computed, by blocks.
          */                 
         template<class M1, class T1, class T2, class M2>
         M1 & srk (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2) 
     {
-            return m1 = t1 * m1 + t2 * prod (m2, trans (m2));
+            return detail::rank_update (m1, t1, t2, m2, trans (m2), boost::mpl::bool_<detail::symmetric_target_traits<M1>::value> ());
         }
 
         /** \brief hermitian rank \a k update: \f$m_1=t.m_1+t_2.(m_2.m2^H)\f$
@@ -437,12 +527,12 @@ namespace boost { namespace numeric { namespace ublas {
      * \tparam T1 type of the first scalar (not needed by default)
      * \tparam T2 type of the second scalar (not needed by default)
      * \tparam M2 type of the second matrix (not needed by default)
-     * \todo use opb_prod()
+     * Symmetric and hermitian \c m1 only have their stored triangle computed, by blocks.
          */                 
         template<class M1, class T1, class T2, class M2>
         M1 & hrk (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2) 
     {
-            return m1 = t1 * m1 + t2 * prod (m2, herm (m2));
+            return detail::rank_update (m1, t1, t2, m2, herm (m2), boost::mpl::bool_<detail::symmetric_target_traits<M1>::value> ());
         }
 
         /** \brief generalized symmetric rank \a k update: \f$m_1=t_1.m_1+t_2.(m_2.m3^T)+t_2.(m_3.m2^T)\f$
@@ -459,12 +549,13 @@ namespace boost { namespace numeric { namespace ublas {
      * \tparam T2 type of the second scalar (not needed by default)
      * \tparam M2 type of the second matrix (not needed by default)
      * \tparam M3 type of the third matrix (not needed by default)
-     * \todo use opb_prod()
+     * Symmetric and hermitian \c m1 only have their stored triangle computed, by blocks.
          */                 
         template<class M1, class T1, class T2, class M2, class M3>
         M1 & sr2k (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3) 
     {
-            return m1 = t1 * m1 + t2 * (prod (m2, trans (m3)) + prod (m3, trans (m2)));
+            return detail::rank_update (m1, t1, t2, m2, trans (m3), t2, m3, trans (m2),
+                                        boost::mpl::bool_<detail::symmetric_target_traits<M1>::value> ());
         }
 
         /** \brief generalized hermitian rank \a k update: * \f$m_1=t_1.m_1+t_2.(m_2.m_3^H)+(m_3.(t_2.m_2)^H)\f$
@@ -481,15 +572,13 @@ namespace boost { namespace numeric { namespace ublas {
      * \tparam T2 type of the second scalar (not needed by default)
      * \tparam M2 type of the second matrix (not needed by default)
      * \tparam M3 type of the third matrix (not needed by default)
-     * \todo use opb_prod()
+     * Symmetric and hermitian \c m1 only have their stored triangle computed, by blocks.
          */                 
         template<class M1, class T1, class T2, class M2, class M3>
         M1 & hr2k (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3) 
     {
-            return m1 = 
-              t1 * m1 
-            + t2 * prod (m2, herm (m3)) 
-            + type_traits<T2>::conj (t2) * prod (m3, herm (m2));
+            return detail::rank_update (m1, t1, t2, m2, herm (m3), type_traits<T2>::conj (t2), m3, herm (m2),
+                                        boost::mpl::bool_<detail::symmetric_target_traits<M1>::value> ());
         }
 
     }
@@ -262,6 +262,33 @@ bool disable_type_check<Dummy>::value = false;
 #endif
 // #define BOOST_UBLAS_ITERATOR_THRESHOLD 0
 
+// Side (in elements) of the blocks transposed directly by the cache oblivious transposition
+#ifndef BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE
+#define BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE 32
+#endif
+
+// Size in bytes from which dense storage is filled and copied with non temporal stores
+#ifndef BOOST_UBLAS_STREAMING_THRESHOLD
+#define BOOST_UBLAS_STREAMING_THRESHOLD (1 << 24)
+#endif
+#if !defined (BOOST_UBLAS_NO_STREAMING_STORES) && \
+    (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BOOST_UBLAS_HAVE_STREAMING_STORES
+#endif
+
+// Amount of work, in stored elements or multiplications, from which the loops of the dense
+// and sparse kernels are shared between OpenMP threads, when compiled with OpenMP
+#ifndef BOOST_UBLAS_PARALLEL_THRESHOLD
+#define BOOST_UBLAS_PARALLEL_THRESHOLD (1 << 18)
+#endif
+// Number of rows, columns or elements handled at once by the blocked dense and sparse kernels
+#ifndef BOOST_UBLAS_SOLVE_BLOCK_SIZE
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 64
+#endif
+#if defined (_OPENMP) && !defined (BOOST_UBLAS_NO_OPENMP)
+#define BOOST_UBLAS_HAVE_OPENMP
+#endif
+
 // Use indexed iterators - unsupported implementation experiment
 // #define BOOST_UBLAS_USE_INDEXED_ITERATOR
 
@@ -270,6 +297,28 @@ bool disable_type_check<Dummy>::value = false;
 #define BOOST_UBLAS_BOUNDED_ARRAY_ALIGN
 #endif
 
+// Default block size and minimum alignment (in bytes) of arena allocations
+#ifndef BOOST_UBLAS_ARENA_BLOCK_SIZE
+#define BOOST_UBLAS_ARENA_BLOCK_SIZE (1 << 20)
+#endif
+#ifndef BOOST_UBLAS_ARENA_ALIGNMENT
+#define BOOST_UBLAS_ARENA_ALIGNMENT 64
+#endif
+
+// Storage class specifier for per thread state such as the active arena
+#ifndef BOOST_UBLAS_THREAD_LOCAL
+#if !defined (BOOST_NO_CXX11_THREAD_LOCAL)
+#define BOOST_UBLAS_THREAD_LOCAL thread_local
+#elif defined (BOOST_MSVC)
+#define BOOST_UBLAS_THREAD_LOCAL __declspec(thread)
+#elif defined (__GNUC__)
+#define BOOST_UBLAS_THREAD_LOCAL __thread
+#else
+// Not thread safe
+#define BOOST_UBLAS_THREAD_LOCAL
+#endif
+#endif
+
 // Enable different sparse element proxies
 #ifndef BOOST_UBLAS_NO_ELEMENT_PROXIES
 // Sparse proxies prevent reference invalidation problems in expressions such as:
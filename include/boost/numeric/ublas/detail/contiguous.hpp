@@ -0,0 +1,520 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_CONTIGUOUS_
+#define _BOOST_UBLAS_CONTIGUOUS_
+
+#include <boost/numeric/ublas/functional.hpp> // scalar_assign
+
+// Recognition of dense vectors and matrices whose elements are addressable in contiguous lines:
+// containers with pointer iterated storage, ranges of them and rows (columns) of row (column)
+// major matrices. Assignments between two of those with the same value type copy whole lines.
+
+namespace boost { namespace numeric { namespace ublas {
+
+    template<class E1, class E2, class F>
+    class matrix_vector_binary1;
+    template<class E1, class E2, class F>
+    class matrix_vector_binary2;
+    template<class E1, class E2, class F>
+    class matrix_matrix_binary;
+    template<class E, class F>
+    class matrix_unary2;
+    template<class E1, class E2, class F>
+    class vector_binary;
+    template<class E1, class E2, class F>
+    class matrix_binary;
+
+namespace detail {
+
+    // Vectors stored with unit stride
+    template<class V>
+    struct dense_span_traits {
+        static const bool value = false;
+        typedef void value_type;
+    };
+
+    template<class T, class A>
+    struct dense_span_traits<vector<T, A> > {
+        static const bool value = boost::is_pointer<typename A::iterator>::value;
+        typedef T value_type;
+    };
+    template<class V>
+    struct dense_span_traits<vector_range<V> >:
+        dense_span_traits<typename boost::remove_const<V>::type> {};
+
+    // Matrices stored in lines of unit stride along orientation_category
+    template<class M>
+    struct dense_block_traits {
+        static const bool value = false;
+        typedef void value_type;
+        typedef unknown_orientation_tag orientation_category;
+    };
+
+    template<class T, class L, class A>
+    struct dense_block_traits<matrix<T, L, A> > {
+        static const bool value = boost::is_pointer<typename A::iterator>::value;
+        typedef T value_type;
+        typedef typename L::orientation_category orientation_category;
+    };
+    template<class M>
+    struct dense_block_traits<matrix_range<M> >:
+        dense_block_traits<typename boost::remove_const<M>::type> {};
+
+    template<class M, class C>
+    struct dense_line_traits {
+        static const bool value = dense_block_traits<M>::value &&
+                                  boost::is_same<typename dense_block_traits<M>::orientation_category, C>::value;
+        typedef typename dense_block_traits<M>::value_type value_type;
+    };
+    template<class M>
+    struct dense_span_traits<matrix_row<M> >:
+        dense_line_traits<typename boost::remove_const<M>::type, row_major_tag> {};
+    template<class M>
+    struct dense_span_traits<matrix_column<M> >:
+        dense_line_traits<typename boost::remove_const<M>::type, column_major_tag> {};
+
+    // Plain assignment between two such expressions of the same trivially copyable type
+    struct dense_copy_tag {};
+
+    template<class V, class E, class F, class SC>
+    struct vector_copy_traits {
+        typedef typename dense_span_traits<V>::value_type value_type;
+        typedef typename boost::mpl::if_c<dense_span_traits<V>::value &&
+                                          dense_span_traits<E>::value &&
+                                          boost::is_same<value_type, typename dense_span_traits<E>::value_type>::value &&
+                                          boost::is_same<F, scalar_assign<typename V::reference, typename E::value_type> >::value &&
+                                          has_trivial_assign<value_type>::value,
+                                          dense_copy_tag,
+                                          SC>::type storage_category;
+    };
+
+    template<class M, class E, class F, class SC>
+    struct matrix_copy_traits {
+        typedef typename dense_block_traits<M>::value_type value_type;
+        typedef typename boost::mpl::if_c<dense_block_traits<M>::value &&
+                                          dense_block_traits<E>::value &&
+                                          boost::is_same<value_type, typename dense_block_traits<E>::value_type>::value &&
+                                          boost::is_same<typename dense_block_traits<M>::orientation_category,
+                                                         typename dense_block_traits<E>::orientation_category>::value &&
+                                          boost::is_same<F, scalar_assign<typename M::reference, typename E::value_type> >::value &&
+                                          has_trivial_assign<value_type>::value,
+                                          dense_copy_tag,
+                                          SC>::type storage_category;
+    };
+
+    // Sparse matrix containers read and written line by line by the conversions of
+    // detail/sparse_conversion.hpp, specialized next to those types
+    template<class M>
+    struct sparse_format_traits {
+        static const bool value = false;
+    };
+
+    // Pairs of sparse matrix types of which plain assignment converts the storage directly, in
+    // O(nnz), by sparse_convert (e, m), any two formats and otherwise specialized next to the
+    // source types
+    template<class M, class E>
+    struct sparse_conversion_traits {
+        static const bool value = sparse_format_traits<M>::value && sparse_format_traits<E>::value;
+    };
+
+    struct sparse_conversion_tag {};
+
+    template<class M, class E, class F, class SC>
+    struct matrix_conversion_traits {
+        typedef typename boost::mpl::if_c<sparse_conversion_traits<M, E>::value &&
+                                          boost::is_same<F, scalar_assign<typename M::reference, typename E::value_type> >::value,
+                                          sparse_conversion_tag,
+                                          SC>::type storage_category;
+    };
+
+    // Sparse container types of which element wise sums, differences and products of two
+    // containers of the type are merged line by line into a third by sparse_merge (e1, e2, m, f),
+    // specialized next to those types
+    template<class C>
+    struct sparse_merge_traits {
+        static const bool value = false;
+    };
+
+    // Element wise functors which are merged, over the union of the elements of both operands
+    // or over their intersection when a zero operand gives a zero result
+    template<class F>
+    struct merge_functor_traits {
+        static const bool value = false;
+        static const bool intersection = false;
+    };
+    template<class T1, class T2>
+    struct merge_functor_traits<scalar_plus<T1, T2> > {
+        static const bool value = true;
+        static const bool intersection = false;
+    };
+    template<class T1, class T2>
+    struct merge_functor_traits<scalar_minus<T1, T2> > {
+        static const bool value = true;
+        static const bool intersection = false;
+    };
+    template<class T1, class T2>
+    struct merge_functor_traits<scalar_multiplies<T1, T2> > {
+        static const bool value = true;
+        static const bool intersection = true;
+    };
+
+    struct sparse_merge_tag {};
+
+    template<class V, class E, class F, class SC>
+    struct vector_merge_traits {
+        typedef SC storage_category;
+    };
+    template<class V, class E1, class E2, class F2, class F, class SC>
+    struct vector_merge_traits<V, vector_binary<E1, E2, F2>, F, SC> {
+        typedef typename boost::mpl::if_c<sparse_merge_traits<V>::value &&
+                                          boost::is_same<E1, V>::value && boost::is_same<E2, V>::value &&
+                                          merge_functor_traits<F2>::value &&
+                                          boost::is_same<typename F2::result_type, typename V::value_type>::value &&
+                                          boost::is_same<F, scalar_assign<typename V::reference, typename F2::result_type> >::value,
+                                          sparse_merge_tag,
+                                          SC>::type storage_category;
+    };
+
+    template<class M, class E, class F, class SC>
+    struct matrix_merge_traits {
+        typedef SC storage_category;
+    };
+    template<class M, class E1, class E2, class F2, class F, class SC>
+    struct matrix_merge_traits<M, matrix_binary<E1, E2, F2>, F, SC> {
+        typedef typename boost::mpl::if_c<sparse_merge_traits<M>::value &&
+                                          boost::is_same<E1, M>::value && boost::is_same<E2, M>::value &&
+                                          merge_functor_traits<F2>::value &&
+                                          boost::is_same<typename F2::result_type, typename M::value_type>::value &&
+                                          boost::is_same<F, scalar_assign<typename M::reference, typename F2::result_type> >::value,
+                                          sparse_merge_tag,
+                                          SC>::type storage_category;
+    };
+
+    // Matrix types with a dedicated kernel matrix_vector_axpy (m, x, y, alpha) computing
+    // y += alpha * m * x on pointers to contiguous vectors, specialized next to those types
+    template<class M>
+    struct matrix_vector_kernel_traits {
+        static const bool value = false;
+    };
+
+    // The matrix referenced by the closure of a container or the closure of a proxy itself
+    template<class M>
+    BOOST_UBLAS_INLINE
+    const M &closure_matrix (const M &m) {
+        return m;
+    }
+    template<class M>
+    BOOST_UBLAS_INLINE
+    const M &closure_matrix (const matrix_reference<M> &m) {
+        return m.expression ();
+    }
+
+    // The vector referenced by the closure of a container or the closure of a proxy itself
+    template<class V>
+    BOOST_UBLAS_INLINE
+    const V &closure_vector (const V &v) {
+        return v;
+    }
+    template<class V>
+    BOOST_UBLAS_INLINE
+    const V &closure_vector (const vector_reference<V> &v) {
+        return v.expression ();
+    }
+
+    // Plain, added or subtracted product of such a matrix and a contiguous vector into a contiguous vector
+    struct matrix_vector_kernel_tag {};
+
+    template<class V, class E, class F, class SC>
+    struct vector_prod_traits {
+        typedef SC storage_category;
+    };
+    template<class V, class E1, class E2, class M1, class V1, class TV, class F, class SC>
+    struct vector_prod_traits<V, matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, V1, TV> >, F, SC> {
+        typedef typename V::reference reference;
+        typedef typename boost::mpl::if_c<matrix_vector_kernel_traits<E1>::value &&
+                                          dense_span_traits<V>::value &&
+                                          dense_span_traits<E2>::value &&
+                                          boost::is_same<typename E1::value_type, TV>::value &&
+                                          boost::is_same<typename dense_span_traits<V>::value_type, TV>::value &&
+                                          boost::is_same<typename dense_span_traits<E2>::value_type, TV>::value &&
+                                          (boost::is_same<F, scalar_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_plus_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_minus_assign<reference, TV> >::value),
+                                          matrix_vector_kernel_tag,
+                                          SC>::type storage_category;
+    };
+
+
+    // Matrix types of triangular structure, specialized next to those types with the
+    // parameterisation of the triangle as triangular_type
+    template<class M>
+    struct triangular_operand_traits {
+        static const bool value = false;
+    };
+
+    // Plain, added or subtracted product of such a matrix and a dense matrix, in either order,
+    // into a dense matrix, computed by triangular_prod_axpy (e1, e2, m, minus)
+    struct triangular_prod_tag {};
+
+    // Banded matrix types, specialized next to those types. diagonal_matrix and diagonal_adaptor
+    // take part in expressions as their banded bases, so that the band is checked at run time.
+    template<class M>
+    struct diagonal_operand_traits {
+        static const bool value = false;
+    };
+
+    // Plain, added or subtracted product of such a matrix and a dense matrix, in either order,
+    // into a dense matrix, computed by diagonal_prod_axpy (e1, e2, m, alpha, assign) as a
+    // scaling of the rows or of the columns of the dense operand when the band is the diagonal
+    // alone. diagonal_prod_axpy returns false for wider bands, which take the general path.
+    struct diagonal_prod_tag {};
+
+    // Sparse matrix types of which such products keep the structure, only the values being
+    // scaled, specialized next to those types. The product is assigned to a matrix of the same
+    // type as the sparse operand, again by diagonal_prod_axpy.
+    template<class M>
+    struct diagonal_scaling_traits {
+        static const bool value = false;
+    };
+
+    // Symmetric and hermitian matrix types of which only one triangle is stored, specialized
+    // next to those types with the parameterisation of the triangle as triangular_type and a
+    // container holding a copy of the stored triangle as temporary_type
+    template<class M>
+    struct symmetric_target_traits {
+        static const bool value = false;
+        static const bool hermitian = false;
+    };
+
+    // Dense matrices and their transposes
+    template<class E>
+    struct dense_operand_traits:
+        dense_block_traits<E> {};
+    template<class E, class F>
+    struct dense_operand_traits<matrix_unary2<E, F> >:
+        dense_block_traits<typename boost::remove_const<E>::type> {};
+
+    // Plain, added or subtracted product of two such dense operands into a symmetric or
+    // hermitian matrix, of which only the stored triangle is computed by
+    // symmetric_prod_update (m, e1, e2, alpha, beta)
+    struct symmetric_prod_tag {};
+
+    // Sparse matrix types with a dedicated kernel matrix_matrix_axpy (e1, e2, m, alpha) computing
+    // m += alpha * e1 * e2 for dense e2 and m, specialized next to those types
+    template<class M>
+    struct matrix_matrix_kernel_traits {
+        static const bool value = false;
+    };
+
+    // Plain, added or subtracted product of such a sparse matrix and a dense matrix into a
+    // dense matrix
+    struct matrix_matrix_kernel_tag {};
+
+    // Strides between the rows and between the columns of a dense block, 1 along its orientation
+    template<class M>
+    void dense_block_strides (const M &m, std::ptrdiff_t &stride1, std::ptrdiff_t &stride2) {
+        const bool rows = boost::is_same<typename dense_block_traits<typename boost::remove_const<M>::type>::orientation_category,
+                                         row_major_tag>::value;
+        stride1 = rows ? (m.size1 () > 1 ? &m (1, 0) - &m (0, 0) : std::ptrdiff_t (m.size2 ())) : 1;
+        stride2 = rows ? 1 : (m.size2 () > 1 ? &m (0, 1) - &m (0, 0) : std::ptrdiff_t (m.size1 ()));
+    }
+
+    template<class M, class E, class F, class SC>
+    struct matrix_prod_traits {
+        typedef SC storage_category;
+    };
+    template<class M, class E1, class E2, class M1, class M2, class TV, class F, class SC>
+    struct matrix_prod_traits<M, matrix_matrix_binary<E1, E2, matrix_matrix_prod<M1, M2, TV> >, F, SC> {
+        typedef typename M::reference reference;
+        typedef typename boost::mpl::if_c<dense_block_traits<M>::value &&
+                                          ((triangular_operand_traits<E1>::value && dense_block_traits<E2>::value) ||
+                                           (dense_block_traits<E1>::value && triangular_operand_traits<E2>::value)) &&
+                                          boost::is_same<typename M::value_type, TV>::value &&
+                                          (boost::is_same<F, scalar_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_plus_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_minus_assign<reference, TV> >::value),
+                                          triangular_prod_tag,
+                typename boost::mpl::if_c<dense_block_traits<M>::value &&
+                                          ((diagonal_operand_traits<E1>::value && dense_block_traits<E2>::value) ||
+                                           (dense_block_traits<E1>::value && diagonal_operand_traits<E2>::value)) &&
+                                          boost::is_same<typename M::value_type, TV>::value &&
+                                          (boost::is_same<F, scalar_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_plus_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_minus_assign<reference, TV> >::value),
+                                          diagonal_prod_tag,
+                typename boost::mpl::if_c<diagonal_scaling_traits<M>::value &&
+                                          ((diagonal_operand_traits<E1>::value && boost::is_same<E2, M>::value) ||
+                                           (boost::is_same<E1, M>::value && diagonal_operand_traits<E2>::value)) &&
+                                          boost::is_same<typename M::value_type, TV>::value &&
+                                          boost::is_same<F, scalar_assign<reference, TV> >::value,
+                                          diagonal_prod_tag,
+                typename boost::mpl::if_c<symmetric_target_traits<M>::value &&
+                                          dense_operand_traits<E1>::value && dense_operand_traits<E2>::value &&
+                                          boost::is_same<typename M::value_type, TV>::value &&
+                                          (boost::is_same<F, scalar_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_plus_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_minus_assign<reference, TV> >::value),
+                                          symmetric_prod_tag,
+                typename boost::mpl::if_c<dense_block_traits<M>::value &&
+                                          matrix_matrix_kernel_traits<E1>::value && dense_block_traits<E2>::value &&
+                                          boost::is_same<typename M::value_type, TV>::value &&
+                                          boost::is_same<typename E1::value_type, TV>::value &&
+                                          boost::is_same<typename dense_block_traits<E2>::value_type, TV>::value &&
+                                          (boost::is_same<F, scalar_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_plus_assign<reference, TV> >::value ||
+                                           boost::is_same<F, scalar_minus_assign<reference, TV> >::value),
+                                          matrix_matrix_kernel_tag,
+                                          SC>::type>::type>::type>::type>::type storage_category;
+    };
+
+
+    // The constant vectors and matrices, see vector_expression.hpp and matrix_expression.hpp
+    template<class E>
+    struct constant_expression_traits;
+
+    // Plain, added or subtracted sums and products with such a constant operand, folded when they
+    // are evaluated: a zero result, one of the operands, a row or column picked by a unit
+    // vector, a constant, or the outer product of a constant and a vector of sums
+    struct expression_fold_tag {};
+    struct zero_fold_tag {};
+    struct first_fold_tag {};
+    struct second_fold_tag {};
+    struct first_line_fold_tag {};
+    struct second_line_fold_tag {};
+    struct scalar_fold_tag {};
+    struct rank_one_fold_tag {};
+
+    // Assignments which a zero operand leaves unchanged, unless plain
+    template<class F>
+    struct additive_assign_traits {
+        static const bool value = false;
+    };
+    template<class T1, class T2>
+    struct additive_assign_traits<scalar_assign<T1, T2> > {
+        static const bool value = true;
+    };
+    template<class T1, class T2>
+    struct additive_assign_traits<scalar_plus_assign<T1, T2> > {
+        static const bool value = true;
+    };
+    template<class T1, class T2>
+    struct additive_assign_traits<scalar_minus_assign<T1, T2> > {
+        static const bool value = true;
+    };
+
+    // Sums and differences, of which a zero operand is dropped
+    template<class F>
+    struct sum_functor_traits {
+        static const bool value = false;
+        static const bool minus = false;
+    };
+    template<class T1, class T2>
+    struct sum_functor_traits<scalar_plus<T1, T2> > {
+        static const bool value = true;
+        static const bool minus = false;
+    };
+    template<class T1, class T2>
+    struct sum_functor_traits<scalar_minus<T1, T2> > {
+        static const bool value = true;
+        static const bool minus = true;
+    };
+
+    template<class V, class E, class F, class SC>
+    struct vector_fold_traits {
+        typedef SC storage_category;
+    };
+    template<class V, class E1, class E2, class F2, class F, class SC>
+    struct vector_fold_traits<V, vector_binary<E1, E2, F2>, F, SC> {
+        typedef typename F2::result_type value_type;
+        typedef typename boost::mpl::if_c<! additive_assign_traits<F>::value || ! sum_functor_traits<F2>::value,
+                                          SC,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::zero &&
+                                          boost::is_same<typename E1::value_type, value_type>::value,
+                                          first_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::zero && ! sum_functor_traits<F2>::minus &&
+                                          boost::is_same<typename E2::value_type, value_type>::value,
+                                          second_fold_tag,
+                                          SC>::type>::type>::type storage_category;
+    };
+    template<class V, class E1, class E2, class M1, class V1, class TV, class F, class SC>
+    struct vector_fold_traits<V, matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, V1, TV> >, F, SC> {
+        static const bool dense = boost::is_same<typename V::storage_category, dense_tag>::value ||
+                                  boost::is_same<typename V::storage_category, dense_proxy_tag>::value;
+        typedef typename boost::mpl::if_c<! additive_assign_traits<F>::value,
+                                          SC,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::zero || constant_expression_traits<E2>::zero,
+                                          zero_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::identity &&
+                                          boost::is_same<typename E2::value_type, TV>::value,
+                                          second_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::unit && dense,
+                                          first_line_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::scalar,
+                                          scalar_fold_tag,
+                                          SC>::type>::type>::type>::type>::type storage_category;
+    };
+    template<class V, class E1, class E2, class V1, class M2, class TV, class F, class SC>
+    struct vector_fold_traits<V, matrix_vector_binary2<E1, E2, matrix_vector_prod2<V1, M2, TV> >, F, SC> {
+        static const bool dense = boost::is_same<typename V::storage_category, dense_tag>::value ||
+                                  boost::is_same<typename V::storage_category, dense_proxy_tag>::value;
+        typedef typename boost::mpl::if_c<! additive_assign_traits<F>::value,
+                                          SC,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::zero || constant_expression_traits<E2>::zero,
+                                          zero_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::identity &&
+                                          boost::is_same<typename E1::value_type, TV>::value,
+                                          first_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::unit && dense,
+                                          second_line_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::scalar,
+                                          scalar_fold_tag,
+                                          SC>::type>::type>::type>::type>::type storage_category;
+    };
+
+    template<class M, class E, class F, class SC>
+    struct matrix_fold_traits {
+        typedef SC storage_category;
+    };
+    template<class M, class E1, class E2, class F2, class F, class SC>
+    struct matrix_fold_traits<M, matrix_binary<E1, E2, F2>, F, SC> {
+        typedef typename F2::result_type value_type;
+        typedef typename boost::mpl::if_c<! additive_assign_traits<F>::value || ! sum_functor_traits<F2>::value,
+                                          SC,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::zero &&
+                                          boost::is_same<typename E1::value_type, value_type>::value,
+                                          first_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::zero && ! sum_functor_traits<F2>::minus &&
+                                          boost::is_same<typename E2::value_type, value_type>::value,
+                                          second_fold_tag,
+                                          SC>::type>::type>::type storage_category;
+    };
+    template<class M, class E1, class E2, class M1, class M2, class TV, class F, class SC>
+    struct matrix_fold_traits<M, matrix_matrix_binary<E1, E2, matrix_matrix_prod<M1, M2, TV> >, F, SC> {
+        typedef typename boost::mpl::if_c<! additive_assign_traits<F>::value,
+                                          SC,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::zero || constant_expression_traits<E2>::zero,
+                                          zero_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::identity &&
+                                          boost::is_same<typename E2::value_type, TV>::value,
+                                          second_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::identity &&
+                                          boost::is_same<typename E1::value_type, TV>::value,
+                                          first_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::scalar && constant_expression_traits<E2>::scalar,
+                                          scalar_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::scalar || constant_expression_traits<E2>::scalar,
+                                          rank_one_fold_tag,
+                                          SC>::type>::type>::type>::type>::type>::type storage_category;
+    };
+
+}
+}}}
+
+#endif
@@ -14,6 +14,9 @@
 #define _BOOST_UBLAS_MATRIX_ASSIGN_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/contiguous.hpp>
+#include <boost/numeric/ublas/detail/streaming.hpp>
+#include <boost/numeric/ublas/detail/transpose.hpp>
 // Required for make_conformant storage
 #include <vector>
 
@@ -448,11 +451,28 @@ namespace detail {
         }
     }
 
+    // Dense container fill case, the padding of the storage is filled as well
+    template<class M, class F, class SC>
+    struct matrix_fill_traits {
+        typedef SC storage_category;
+    };
+    template<class T, class L, class A, class U, class SC>
+    struct matrix_fill_traits<matrix<T, L, A>, scalar_assign<T &, U>, SC> {
+        typedef detail::dense_fill_tag storage_category;
+    };
+
+    template<template <class T1, class T2> class F, class M, class T, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign_scalar (M &m, const T &t, detail::dense_fill_tag, C) {
+        detail::fill_storage (m.data ().begin (), m.data ().end (), typename M::value_type (t));
+    }
+
     // Dispatcher
     template<template <class T1, class T2> class F, class M, class T>
     BOOST_UBLAS_INLINE
     void matrix_assign_scalar (M &m, const T &t) {
-        typedef typename M::storage_category storage_category;
+        typedef typename matrix_fill_traits<M, F<typename M::reference, T>,
+                                            typename M::storage_category>::storage_category storage_category;
         typedef typename M::orientation_category orientation_category;
         matrix_assign_scalar<F> (m, t, storage_category (), orientation_category ());
     }
@@ -1200,6 +1220,260 @@ namespace detail {
 #endif
     }
 
+    // Dense transposition case
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::dense_transpose_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef detail::matrix_transpose_traits<M, E, detail::dense_transpose_tag> transpose_traits;
+        typedef typename transpose_traits::expression_type expression_type;
+        typedef typename transpose_traits::functor_type unary_functor_type;
+        typedef typename transpose_traits::layout_type layout_type;
+        typedef typename transpose_traits::expression_layout_type expression_layout_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        if (size1 == 0 || size2 == 0)
+            return;
+        const expression_type &s (e ().expression ());
+        typename M::value_type *pm = &m.data () [0];
+        const typename expression_type::value_type *ps = &s.data () [0];
+        difference_type ld_m (layout_type::leading_dimension (size1, size2));
+        difference_type ld_s (expression_layout_type::leading_dimension (size2, size1));
+        // noalias (m) = trans (m) of a square matrix is carried out in place
+        if (boost::is_same<functor_type, scalar_assign<typename M::reference, typename E::value_type> >::value &&
+            static_cast<const void *> (pm) == static_cast<const void *> (ps))
+            detail::transpose_square_inplace<unary_functor_type> (pm, ld_m, size1);
+        else
+            detail::transpose_copy<functor_type, unary_functor_type> (pm, ld_m, ps, ld_s,
+                                                                      layout_type::size_M (size1, size2),
+                                                                      layout_type::size_m (size1, size2));
+    }
+
+    // Dense copy case
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::dense_copy_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef typename detail::dense_block_traits<M>::orientation_category orientation_category;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        if (size1 == 0 || size2 == 0)
+            return;
+        // Both blocks without gaps are copied at once
+        difference_type size (size1 * size2);
+        if (&e () (size1 - 1, size2 - 1) - &e () (0, 0) == size - 1 &&
+            &m (size1 - 1, size2 - 1) - &m (0, 0) == size - 1) {
+            detail::copy_storage (&e () (0, 0), &e () (0, 0) + size, &m (0, 0));
+        } else if (boost::is_same<orientation_category, row_major_tag>::value) {
+            for (size_type i = 0; i < size1; ++ i)
+                detail::copy_storage (&e () (i, 0), &e () (i, 0) + size2, &m (i, 0));
+        } else {
+            for (size_type j = 0; j < size2; ++ j)
+                detail::copy_storage (&e () (0, j), &e () (0, j) + size1, &m (0, j));
+        }
+    }
+
+    // Sparse conversion case, see sparse_conversion_traits
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::sparse_conversion_tag, C) {
+        // R unnecessary, make_conformant not required
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        sparse_convert (e (), m);
+    }
+
+    // Element wise operation between sparse containers case, see sparse_merge_traits
+    template<template <class T1, class T2> class F, class R, class M, class E1, class E2, class F2, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_binary<E1, E2, F2> > &e, detail::sparse_merge_tag, C) {
+        // R unnecessary, make_conformant not required
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        sparse_merge (detail::closure_matrix (e ().expression1 ()), detail::closure_matrix (e ().expression2 ()), m, F2 ());
+    }
+
+    // Product with a triangular matrix case, computed by the blocked kernel of triangular.hpp
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::triangular_prod_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::value_type value_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        if (boost::is_same<functor_type, scalar_assign<typename M::reference, typename E::value_type> >::value)
+            matrix_assign_scalar<scalar_assign> (m, value_type/*zero*/());
+        if (m.size1 () == 0 || m.size2 () == 0)
+            return;
+        triangular_prod_axpy (detail::closure_matrix (e ().expression1 ()), detail::closure_matrix (e ().expression2 ()), m,
+                              boost::is_same<functor_type, scalar_minus_assign<typename M::reference, typename E::value_type> >::value);
+    }
+
+    // Product with a banded matrix case, computed by the scaling kernel of banded.hpp when the band
+    // is the diagonal alone. The elements are read before they are written, so that the dense
+    // operand may be m itself.
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::diagonal_prod_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::value_type value_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        if (m.size1 () == 0 || m.size2 () == 0)
+            return;
+        const bool minus = boost::is_same<functor_type, scalar_minus_assign<typename M::reference, typename E::value_type> >::value;
+        const bool assign = boost::is_same<functor_type, scalar_assign<typename M::reference, typename E::value_type> >::value;
+        if (diagonal_prod_axpy (detail::closure_matrix (e ().expression1 ()), detail::closure_matrix (e ().expression2 ()), m,
+                                minus ? value_type (-1) : value_type (1), assign))
+            return;
+        // A band wider than the diagonal
+        typedef typename matrix_assign_traits<typename M::storage_category,
+                                              functor_type::computed,
+                                              typename E::const_iterator1::iterator_category,
+                                              typename E::const_iterator2::iterator_category>::storage_category assign_category;
+        matrix_assign<F, R> (m, e, assign_category (), C ());
+    }
+
+    // Product into a symmetric or hermitian matrix case, computed by the rank update kernel of
+    // detail/symmetric_kernel.hpp
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::symmetric_prod_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::value_type value_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        const bool minus = boost::is_same<functor_type, scalar_minus_assign<typename M::reference, typename E::value_type> >::value;
+        const bool assign = boost::is_same<functor_type, scalar_assign<typename M::reference, typename E::value_type> >::value;
+        symmetric_prod_update (m, detail::closure_matrix (e ().expression1 ()), detail::closure_matrix (e ().expression2 ()),
+                               minus ? value_type (-1) : value_type (1), assign ? value_type/*zero*/() : value_type (1));
+    }
+
+    // Product of a sparse matrix and a dense matrix into a dense matrix case, computed by the
+    // kernel of the sparse matrix type
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::matrix_matrix_kernel_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::value_type value_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        if (boost::is_same<functor_type, scalar_assign<typename M::reference, typename E::value_type> >::value)
+            matrix_assign_scalar<scalar_assign> (m, value_type/*zero*/());
+        if (m.size1 () == 0 || m.size2 () == 0)
+            return;
+        const bool minus = boost::is_same<functor_type, scalar_minus_assign<typename M::reference, typename E::value_type> >::value;
+        matrix_matrix_axpy (detail::closure_matrix (e ().expression1 ()), detail::closure_matrix (e ().expression2 ()), m,
+                            minus ? value_type (-1) : value_type (1));
+    }
+
+    // Sums and products with a constant operand case, see matrix_fold_traits
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::zero_fold_tag, C) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        if (boost::is_same<functor_type, scalar_assign<typename M::reference, typename E::value_type> >::value)
+            matrix_assign<scalar_assign, R> (m, zero_matrix<typename M::value_type> (m.size1 (), m.size2 ()));
+    }
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::first_fold_tag, C) {
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        matrix_assign<F, R> (m, detail::closure_matrix (e ().expression1 ()));
+    }
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::second_fold_tag, C) {
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        matrix_assign<F, R> (m, detail::closure_matrix (e ().expression2 ()));
+    }
+    // A product with an identity matrix which is not square takes the general path
+    template<template <class T1, class T2> class F, class R, class M, class E1, class E2, class F2, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_matrix_binary<E1, E2, F2> > &e, detail::first_fold_tag, C) {
+        typedef matrix_matrix_binary<E1, E2, F2> expression_type;
+        typedef F<typename M::reference, typename expression_type::value_type> functor_type;
+        if (e ().expression2 ().size1 () == e ().expression2 ().size2 ()) {
+            BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+            BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+            matrix_assign<F, R> (m, detail::closure_matrix (e ().expression1 ()));
+            return;
+        }
+        typedef typename matrix_assign_traits<typename M::storage_category,
+                                              functor_type::computed,
+                                              typename expression_type::const_iterator1::iterator_category,
+                                              typename expression_type::const_iterator2::iterator_category>::storage_category assign_category;
+        matrix_assign<F, R> (m, e, assign_category (), C ());
+    }
+    template<template <class T1, class T2> class F, class R, class M, class E1, class E2, class F2, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_matrix_binary<E1, E2, F2> > &e, detail::second_fold_tag, C) {
+        typedef matrix_matrix_binary<E1, E2, F2> expression_type;
+        typedef F<typename M::reference, typename expression_type::value_type> functor_type;
+        if (e ().expression1 ().size1 () == e ().expression1 ().size2 ()) {
+            BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+            BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+            matrix_assign<F, R> (m, detail::closure_matrix (e ().expression2 ()));
+            return;
+        }
+        typedef typename matrix_assign_traits<typename M::storage_category,
+                                              functor_type::computed,
+                                              typename expression_type::const_iterator1::iterator_category,
+                                              typename expression_type::const_iterator2::iterator_category>::storage_category assign_category;
+        matrix_assign<F, R> (m, e, assign_category (), C ());
+    }
+    // Every element is the inner product of two constant lines
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::scalar_fold_tag, C) {
+        typedef typename E::value_type value_type;
+        typedef typename E::size_type size_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (e ().expression1 ().size2 () == e ().expression2 ().size1 (), bad_size ());
+        const size_type size (e ().expression1 ().size2 ());
+        const value_type t (e ().size1 () == 0 || e ().size2 () == 0 || size == 0 ? value_type/*zero*/() :
+                            value_type (inner_prod (scalar_vector<value_type> (size, value_type (e ().expression1 () (0, 0))),
+                                                    scalar_vector<value_type> (size, value_type (e ().expression2 () (0, 0))))));
+        matrix_assign<F, R> (m, scalar_matrix<value_type> (m.size1 (), m.size2 (), t));
+    }
+    // The sums of the lines of the other operand, scaled by the constant, are computed once and
+    // repeated along the constant side by a lazy outer product
+    template<template <class T1, class T2> class F, class R, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<E> &e, detail::rank_one_fold_tag, C) {
+        typedef typename E::value_type value_type;
+        typedef typename E::size_type size_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (e ().expression1 ().size2 () == e ().expression2 ().size1 (), bad_size ());
+        const size_type size (e ().expression1 ().size2 ());
+        if (detail::constant_expression_traits<typename E::expression1_type>::scalar) {
+            vector<value_type> sums (e ().size2 (), value_type/*zero*/());
+            if (e ().size1 () != 0 && size != 0)
+                sums.assign (prod (scalar_vector<value_type> (size, value_type (e ().expression1 () (0, 0))), e ().expression2 ()));
+            matrix_assign<F, R> (m, outer_prod (scalar_vector<value_type> (m.size1 (), value_type (1)), sums));
+        } else {
+            vector<value_type> sums (e ().size1 (), value_type/*zero*/());
+            if (e ().size2 () != 0 && size != 0)
+                sums.assign (prod (e ().expression1 (), scalar_vector<value_type> (size, value_type (e ().expression2 () (0, 0)))));
+            matrix_assign<F, R> (m, outer_prod (sums, scalar_vector<value_type> (m.size2 (), value_type (1))));
+        }
+    }
+
     // Dispatcher
     template<template <class T1, class T2> class F, class M, class E>
     BOOST_UBLAS_INLINE
@@ -1207,7 +1481,14 @@ namespace detail {
         typedef typename matrix_assign_traits<typename M::storage_category,
                                               F<typename M::reference, typename E::value_type>::computed,
                                               typename E::const_iterator1::iterator_category,
-                                              typename E::const_iterator2::iterator_category>::storage_category storage_category;
+                                              typename E::const_iterator2::iterator_category>::storage_category assign_category;
+        typedef typename detail::matrix_transpose_traits<M, E, assign_category>::storage_category transpose_category;
+        typedef typename detail::matrix_fold_traits<M, E, F<typename M::reference, typename E::value_type>,
+                    typename detail::matrix_prod_traits<M, E, F<typename M::reference, typename E::value_type>,
+                        typename detail::matrix_copy_traits<M, E, F<typename M::reference, typename E::value_type>,
+                            typename detail::matrix_conversion_traits<M, E, F<typename M::reference, typename E::value_type>,
+                                typename detail::matrix_merge_traits<M, E, F<typename M::reference, typename E::value_type>,
+                                                                     transpose_category>::storage_category>::storage_category>::storage_category>::storage_category>::storage_category storage_category;
         // give preference to matrix M's orientation if known
         typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, unknown_orientation_tag>,
                                           typename E::orientation_category ,
@@ -1222,7 +1503,14 @@ namespace detail {
         typedef typename matrix_assign_traits<typename M::storage_category,
                                               F<typename M::reference, typename E::value_type>::computed,
                                               typename E::const_iterator1::iterator_category,
-                                              typename E::const_iterator2::iterator_category>::storage_category storage_category;
+                                              typename E::const_iterator2::iterator_category>::storage_category assign_category;
+        typedef typename detail::matrix_transpose_traits<M, E, assign_category>::storage_category transpose_category;
+        typedef typename detail::matrix_fold_traits<M, E, F<typename M::reference, typename E::value_type>,
+                    typename detail::matrix_prod_traits<M, E, F<typename M::reference, typename E::value_type>,
+                        typename detail::matrix_copy_traits<M, E, F<typename M::reference, typename E::value_type>,
+                            typename detail::matrix_conversion_traits<M, E, F<typename M::reference, typename E::value_type>,
+                                typename detail::matrix_merge_traits<M, E, F<typename M::reference, typename E::value_type>,
+                                                                     transpose_category>::storage_category>::storage_category>::storage_category>::storage_category>::storage_category storage_category;
         // give preference to matrix M's orientation if known
         typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, unknown_orientation_tag>,
                                           typename E::orientation_category ,
@@ -51,6 +51,9 @@ namespace boost { namespace numeric { namespace ublas { namespace raw {
     template < typename M >
     BOOST_UBLAS_INLINE
     int leading_dimension( const matrix_reference<M> &m ) ;
+    template < typename T, typename L, typename A >
+    BOOST_UBLAS_INLINE
+    int leading_dimension( const matrix<T, L, A> &m ) ;
 
     template < typename V >
     BOOST_UBLAS_INLINE
@@ -84,6 +87,13 @@ namespace boost { namespace numeric { namespace ublas { namespace raw {
     BOOST_UBLAS_INLINE
     int stride2( const matrix_reference<M> &m ) ;
 
+    template < typename T, typename L, typename A >
+    BOOST_UBLAS_INLINE
+    int stride1( const matrix<T, L, A> &m ) ;
+    template < typename T, typename L, typename A >
+    BOOST_UBLAS_INLINE
+    int stride2( const matrix<T, L, A> &m ) ;
+
     template < typename T, std::size_t M, std::size_t N >
     BOOST_UBLAS_INLINE
     int stride1( const c_matrix<T, M, N> &m ) ;
@@ -402,6 +412,13 @@ namespace boost { namespace numeric { namespace ublas { namespace raw {
         return leading_dimension( m.expression() ) ;
     }
 
+    // The layout knows about padding between rows or columns
+    template < typename T, typename L, typename A >
+    BOOST_UBLAS_INLINE
+    int leading_dimension( const matrix<T, L, A> &m ) {
+        return L::leading_dimension( m.size1(), m.size2() ) ;
+    }
+
     template < typename V >
     BOOST_UBLAS_INLINE
     int stride( const V &v ) {
@@ -454,6 +471,17 @@ namespace boost { namespace numeric { namespace ublas { namespace raw {
         return stride2( m.expression() ) ;
     }
 
+    template < typename T, typename L, typename A >
+    BOOST_UBLAS_INLINE
+    int stride1( const matrix<T, L, A> &m ) {
+        return boost::is_same< typename L::orientation_category, row_major_tag >::value ? leading_dimension( m ) : 1 ;
+    }
+    template < typename T, typename L, typename A >
+    BOOST_UBLAS_INLINE
+    int stride2( const matrix<T, L, A> &m ) {
+        return boost::is_same< typename L::orientation_category, row_major_tag >::value ? 1 : leading_dimension( m ) ;
+    }
+
     template < typename T, std::size_t M, std::size_t N >
     BOOST_UBLAS_INLINE
     int stride1( const c_matrix<T, M, N> &m ) {
@@ -0,0 +1,416 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SPARSE_CONVERSION_
+#define _BOOST_UBLAS_SPARSE_CONVERSION_
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/numeric/ublas/functional.hpp>
+
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+// Conversions between sparse matrix containers in O(nnz). The elements of the source are read
+// line by line, in the orientation of the source, through a view:
+//
+//   value_type                  the type of the elements
+//   row_major ()                whether the lines are rows
+//   lines (), line_size ()      the number and the length of the lines
+//   nnz ()                      the number of stored elements
+//   begin (l), end (l)          the zero based addresses of the elements of line l
+//   index (k), value (k)        the zero based index in its line and the value of element k
+//
+// and written through a sink into the lines of the target:
+//
+//   start (l, p)                line l of the target begins at address p, for every l up to
+//                               and including the number of lines, which receives the total
+//   s (p, l, i, t)              the element at address p is t, in line l at index i
+//
+// The lines are copied when both orientations agree. Otherwise the elements of every line of
+// the target are counted, the lines are placed by prefix sums and the elements scattered. In
+// both cases explicitly stored zeros are dropped, as by plain assignment. With OpenMP the lines
+// of the source are shared between threads of as many elements each, every thread counting
+// into a row of its own: the prefix sums run over the lines of the target first and the threads
+// second, so that each line of the target receives the elements in the order of the source.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // The number of nonzero elements of line l
+    template<class V>
+    std::size_t sparse_line_count (const V &v, std::size_t l) {
+        typedef typename V::value_type value_type;
+        std::size_t n = 0;
+        for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+            if (v.value (k) != value_type/*zero*/())
+                ++ n;
+        return n;
+    }
+
+    // Line l of the source into line l of the target, from address p
+    template<class V, class S>
+    void sparse_line_copy (const V &v, std::size_t l, std::size_t p, S &s) {
+        typedef typename V::value_type value_type;
+        for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+            if (v.value (k) != value_type/*zero*/())
+                s (p ++, l, v.index (k), v.value (k));
+    }
+
+    // The lines of the target placed by prefix sums of their sizes, found in starts [l + 1]
+    template<class S>
+    void sparse_lines_start (std::vector<std::size_t> &starts, S &s) {
+        const std::size_t lines = starts.size () - 1;
+        for (std::size_t l = 0; l < lines; ++ l) {
+            s.start (l, starts [l]);
+            starts [l + 1] += starts [l];
+        }
+        s.start (lines, starts [lines]);
+    }
+
+    // Conversion to the orientation of the source
+    template<class V, class S>
+    void sparse_lines_copy (const V &v, S &s) {
+        const std::size_t lines = v.lines ();
+        std::vector<std::size_t> starts (lines + 1, 0);
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        const long chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        if (long (lines) > chunk && v.nnz () >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+            omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+#pragma omp parallel for schedule (dynamic, chunk)
+            for (long l = 0; l < long (lines); ++ l)
+                starts [l + 1] = sparse_line_count (v, l);
+            sparse_lines_start (starts, s);
+#pragma omp parallel for schedule (dynamic, chunk)
+            for (long l = 0; l < long (lines); ++ l)
+                sparse_line_copy (v, l, starts [l], s);
+            return;
+        }
+#endif
+        for (std::size_t l = 0; l < lines; ++ l)
+            starts [l + 1] = sparse_line_count (v, l);
+        sparse_lines_start (starts, s);
+        for (std::size_t l = 0; l < lines; ++ l)
+            sparse_line_copy (v, l, starts [l], s);
+    }
+
+    // The first line of part p of parts of the lines of as many elements each
+    template<class V>
+    std::size_t sparse_lines_part (const V &v, std::size_t p, std::size_t parts) {
+        if (p == 0)
+            return 0;
+        if (p >= parts)
+            return v.lines ();
+        const std::size_t nnz = v.nnz ();
+        const std::size_t first = nnz / parts * p + nnz % parts * p / parts;
+        std::size_t lower = 0, upper = v.lines ();
+        while (lower < upper) {
+            const std::size_t middle = lower + (upper - lower) / 2;
+            if (v.begin (middle) < first)
+                lower = middle + 1;
+            else
+                upper = middle;
+        }
+        return lower;
+    }
+
+    // The nonzero elements of the lines [first, last) counted by line of the target
+    template<class V>
+    void sparse_lines_count (const V &v, std::size_t first, std::size_t last, std::size_t *count) {
+        typedef typename V::value_type value_type;
+        for (std::size_t l = first; l < last; ++ l)
+            for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+                if (v.value (k) != value_type/*zero*/())
+                    ++ count [v.index (k)];
+    }
+
+    // The lines of the target placed by prefix sums over the counts of the parts, which become
+    // the next address of each part in each line
+    template<class S>
+    void sparse_lines_offsets (std::size_t lines, std::size_t parts, std::vector<std::size_t> &next, S &s) {
+        std::size_t p = 0;
+        for (std::size_t l = 0; l < lines; ++ l) {
+            s.start (l, p);
+            for (std::size_t u = 0; u < parts; ++ u) {
+                const std::size_t n = next [u * lines + l];
+                next [u * lines + l] = p;
+                p += n;
+            }
+        }
+        s.start (lines, p);
+    }
+
+    // The nonzero elements of the lines [first, last) scattered into the lines of the target
+    template<class V, class S>
+    void sparse_lines_scatter (const V &v, std::size_t first, std::size_t last, std::size_t *next, S &s) {
+        typedef typename V::value_type value_type;
+        for (std::size_t l = first; l < last; ++ l)
+            for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+                if (v.value (k) != value_type/*zero*/()) {
+                    const std::size_t m = v.index (k);
+                    s (next [m] ++, m, l, v.value (k));
+                }
+    }
+
+    // Conversion to the other orientation
+    template<class V, class S>
+    void sparse_lines_transpose (const V &v, S &s) {
+        const std::size_t lines = v.line_size ();
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        if (v.nnz () >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+            omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+            const int threads = omp_get_max_threads ();
+            std::vector<std::size_t> next (std::size_t (threads) * lines + 1, 0);
+#pragma omp parallel num_threads (threads)
+            {
+                const std::size_t t = omp_get_thread_num (), parts = omp_get_num_threads ();
+                const std::size_t first = sparse_lines_part (v, t, parts);
+                const std::size_t last = sparse_lines_part (v, t + 1, parts);
+                std::size_t *count = &next [t * lines];
+                sparse_lines_count (v, first, last, count);
+#pragma omp barrier
+#pragma omp single
+                sparse_lines_offsets (lines, parts, next, s);
+                sparse_lines_scatter (v, first, last, count, s);
+            }
+            return;
+        }
+#endif
+        std::vector<std::size_t> next (lines + 1, 0);
+        sparse_lines_count (v, 0, v.lines (), &next [0]);
+        sparse_lines_offsets (lines, 1, next, s);
+        sparse_lines_scatter (v, 0, v.lines (), &next [0], s);
+    }
+
+    // Conversion into the orientation of the target
+    template<class V, class S>
+    void sparse_lines_convert (const V &v, bool row_major, S &s) {
+        if (v.row_major () == row_major)
+            sparse_lines_copy (v, s);
+        else
+            sparse_lines_transpose (v, s);
+    }
+
+    // The elements of a sparse matrix expression gathered line by line through its iterators,
+    // or the elements of a conversion, itself a view of them
+    template<class T>
+    class sparse_lines_buffer {
+    public:
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        sparse_lines_buffer ():
+            row_major_ (true), lines_ (0), line_size_ (0), starts_ (1, 0), indices_ (), values_ () {}
+
+        // Gathering in the orientation of e
+        template<class E>
+        void gather (const E &e, row_major_tag) {
+            prepare (true, e.size1 (), e.size2 (), 0);
+            for (typename E::const_iterator1 it1 (e.begin1 ()); it1 != e.end1 (); ++ it1)
+                for (typename E::const_iterator2 it2 (it1.begin ()); it2 != it1.end (); ++ it2) {
+                    ++ starts_ [it2.index1 () + 1];
+                    indices_.push_back (it2.index2 ());
+                    values_.push_back (*it2);
+                }
+            for (std::size_t l = 0; l < lines_; ++ l)
+                starts_ [l + 1] += starts_ [l];
+        }
+        template<class E>
+        void gather (const E &e, column_major_tag) {
+            prepare (false, e.size2 (), e.size1 (), 0);
+            for (typename E::const_iterator2 it2 (e.begin2 ()); it2 != e.end2 (); ++ it2)
+                for (typename E::const_iterator1 it1 (it2.begin ()); it1 != it2.end (); ++ it1) {
+                    ++ starts_ [it1.index2 () + 1];
+                    indices_.push_back (it1.index1 ());
+                    values_.push_back (*it1);
+                }
+            for (std::size_t l = 0; l < lines_; ++ l)
+                starts_ [l + 1] += starts_ [l];
+        }
+
+        // Sink of at most nnz elements
+        BOOST_UBLAS_INLINE
+        void prepare (bool row_major, std::size_t lines, std::size_t line_size, std::size_t nnz) {
+            row_major_ = row_major;
+            lines_ = lines;
+            line_size_ = line_size;
+            starts_.assign (lines + 1, 0);
+            indices_.resize (nnz);
+            values_.resize (nnz);
+        }
+        BOOST_UBLAS_INLINE
+        void start (std::size_t l, std::size_t p) {
+            starts_ [l] = p;
+        }
+        BOOST_UBLAS_INLINE
+        void operator () (std::size_t p, std::size_t /* l */, std::size_t i, const value_type &t) {
+            indices_ [p] = i;
+            values_ [p] = t;
+        }
+
+        // View
+        BOOST_UBLAS_INLINE
+        bool row_major () const {
+            return row_major_;
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t lines () const {
+            return lines_;
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t line_size () const {
+            return line_size_;
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t nnz () const {
+            return starts_ [lines_];
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t begin (std::size_t l) const {
+            return starts_ [l];
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t end (std::size_t l) const {
+            return starts_ [l + 1];
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t index (std::size_t k) const {
+            return indices_ [k];
+        }
+        BOOST_UBLAS_INLINE
+        const value_type &value (std::size_t k) const {
+            return values_ [k];
+        }
+
+    private:
+        bool row_major_;
+        std::size_t lines_;
+        std::size_t line_size_;
+        std::vector<std::size_t> starts_;
+        std::vector<std::size_t> indices_;
+        std::vector<value_type> values_;
+    };
+
+    // Element wise operations f between two sources of the same orientation and shape, merged
+    // line by line into the sink: over the union of the elements of both lines, an element
+    // missing from one of them being zero, or over their intersection alone when f of zero and
+    // anything is zero. The lines are merged twice, once to count the nonzero results and once
+    // to write them, so that the target is sized before it is filled.
+
+    // Counts the nonzero results of a merge
+    struct sparse_merge_count {
+        BOOST_UBLAS_INLINE
+        sparse_merge_count ():
+            n (0) {}
+        template<class T>
+        BOOST_UBLAS_INLINE
+        void operator () (std::size_t /* i */, const T &t) {
+            if (t != T/*zero*/())
+                ++ n;
+        }
+        std::size_t n;
+    };
+
+    // Writes the nonzero results of a merge into line l of the target, from address p
+    template<class S>
+    struct sparse_merge_write {
+        BOOST_UBLAS_INLINE
+        sparse_merge_write (S &s, std::size_t l, std::size_t p):
+            s (s), l (l), p (p) {}
+        template<class T>
+        BOOST_UBLAS_INLINE
+        void operator () (std::size_t i, const T &t) {
+            if (t != T/*zero*/())
+                s (p ++, l, i, t);
+        }
+        S &s;
+        std::size_t l;
+        std::size_t p;
+    };
+
+    // The results of line l passed to g in the order of their indices
+    template<class F, class V1, class V2, class G>
+    void sparse_line_merge (const V1 &v1, const V2 &v2, std::size_t l, bool intersection, G &g) {
+        typedef typename V1::value_type value_type1;
+        typedef typename V2::value_type value_type2;
+        std::size_t k1 = v1.begin (l), k2 = v2.begin (l);
+        const std::size_t e1 = v1.end (l), e2 = v2.end (l);
+        if (intersection) {
+            while (k1 < e1 && k2 < e2) {
+                const std::size_t i1 = v1.index (k1), i2 = v2.index (k2);
+                if (i1 < i2)
+                    ++ k1;
+                else if (i2 < i1)
+                    ++ k2;
+                else
+                    g (i1, F::apply (v1.value (k1 ++), v2.value (k2 ++)));
+            }
+            return;
+        }
+        while (k1 < e1 || k2 < e2) {
+            if (k2 == e2 || (k1 < e1 && v1.index (k1) < v2.index (k2))) {
+                g (v1.index (k1), F::apply (v1.value (k1), value_type2/*zero*/()));
+                ++ k1;
+            } else if (k1 == e1 || v2.index (k2) < v1.index (k1)) {
+                g (v2.index (k2), F::apply (value_type1/*zero*/(), v2.value (k2)));
+                ++ k2;
+            } else {
+                g (v1.index (k1), F::apply (v1.value (k1), v2.value (k2)));
+                ++ k1;
+                ++ k2;
+            }
+        }
+    }
+
+    template<class F, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    std::size_t sparse_line_merge_count (const V1 &v1, const V2 &v2, std::size_t l, bool intersection) {
+        sparse_merge_count c;
+        sparse_line_merge<F> (v1, v2, l, intersection, c);
+        return c.n;
+    }
+    template<class F, class V1, class V2, class S>
+    BOOST_UBLAS_INLINE
+    void sparse_line_merge_copy (const V1 &v1, const V2 &v2, std::size_t l, bool intersection, std::size_t p, S &s) {
+        sparse_merge_write<S> w (s, l, p);
+        sparse_line_merge<F> (v1, v2, l, intersection, w);
+    }
+
+    // Merge of the lines of v1 and v2, shared between OpenMP threads as copies are
+    template<class F, class V1, class V2, class S>
+    void sparse_lines_merge (const V1 &v1, const V2 &v2, bool intersection, S &s) {
+        const std::size_t lines = v1.lines ();
+        std::vector<std::size_t> starts (lines + 1, 0);
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        const long chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        if (long (lines) > chunk && v1.nnz () + v2.nnz () >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+            omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+#pragma omp parallel for schedule (dynamic, chunk)
+            for (long l = 0; l < long (lines); ++ l)
+                starts [l + 1] = sparse_line_merge_count<F> (v1, v2, l, intersection);
+            sparse_lines_start (starts, s);
+#pragma omp parallel for schedule (dynamic, chunk)
+            for (long l = 0; l < long (lines); ++ l)
+                sparse_line_merge_copy<F> (v1, v2, l, intersection, starts [l], s);
+            return;
+        }
+#endif
+        for (std::size_t l = 0; l < lines; ++ l)
+            starts [l + 1] = sparse_line_merge_count<F> (v1, v2, l, intersection);
+        sparse_lines_start (starts, s);
+        for (std::size_t l = 0; l < lines; ++ l)
+            sparse_line_merge_copy<F> (v1, v2, l, intersection, starts [l], s);
+    }
+
+}
+}}}
+
+#endif
@@ -0,0 +1,134 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_STREAMING_
+#define _BOOST_UBLAS_STREAMING_
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/numeric/ublas/traits.hpp>
+
+#ifdef BOOST_UBLAS_HAVE_STREAMING_STORES
+#include <emmintrin.h>
+#endif
+
+// Bulk fills and copies of dense storage.
+// Ranges of at least BOOST_UBLAS_STREAMING_THRESHOLD bytes of a trivially copyable type
+// are written with non temporal stores: the destination is neither read for ownership nor
+// kept in the caches, which would otherwise be flushed entirely by a very large clear ().
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+#ifdef BOOST_UBLAS_HAVE_STREAMING_STORES
+    // Store 16 byte lines from p (aligned) up to n bytes, the pattern is repeated or the source is copied
+    inline
+    void stream_fill_lines (char *p, std::size_t n, __m128i pattern) {
+        for (char *end = p + n; p != end; p += 16)
+            _mm_stream_si128 (reinterpret_cast<__m128i *> (p), pattern);
+        _mm_sfence ();
+    }
+    inline
+    void stream_copy_lines (char *p, std::size_t n, const char *s) {
+        for (char *end = p + n; p != end; p += 16, s += 16)
+            _mm_stream_si128 (reinterpret_cast<__m128i *> (p),
+                              _mm_loadu_si128 (reinterpret_cast<const __m128i *> (s)));
+        _mm_sfence ();
+    }
+
+    // Number of leading elements to write before p + i is aligned to a 16 byte line, or size if never
+    template<class T>
+    BOOST_UBLAS_INLINE
+    std::size_t stream_head (const T *p, std::size_t size) {
+        std::size_t misalignment (reinterpret_cast<std::size_t> (p) % 16);
+        if (misalignment == 0)
+            return 0;
+        if (misalignment % sizeof (T) != 0 || 16 % sizeof (T) != 0)
+            return size;
+        return (std::min) ((16 - misalignment) / sizeof (T), size);
+    }
+
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool use_streaming (std::size_t size) {
+        return has_trivial_assign<T>::value &&
+               16 % sizeof (T) == 0 &&
+               size * sizeof (T) >= BOOST_UBLAS_STREAMING_THRESHOLD;
+    }
+#endif
+
+    // Assignment of a scalar to a whole dense container
+    struct dense_fill_tag {};
+
+    // Fill storage with t
+    template<class I, class T>
+    BOOST_UBLAS_INLINE
+    void fill_storage (I first, I last, const T &t) {
+        std::fill (first, last, t);
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void fill_storage (T *first, T *last, const T &t) {
+#ifdef BOOST_UBLAS_HAVE_STREAMING_STORES
+        std::size_t size (last - first);
+        if (use_streaming<T> (size)) {
+            std::size_t head (stream_head (first, size));
+            std::fill (first, first + head, t);
+            first += head, size -= head;
+            std::size_t body (size * sizeof (T) / 16 * 16);
+            if (body) {
+                union {
+                    __m128i line;
+                    char bytes [16];
+                } pattern;
+                for (std::size_t k = 0; k < 16; k += sizeof (T))
+                    std::memcpy (pattern.bytes + k, &t, sizeof (T));
+                stream_fill_lines (reinterpret_cast<char *> (first), body, pattern.line);
+                first += body / sizeof (T);
+            }
+        }
+#endif
+        std::fill (first, last, t);
+    }
+
+    // Copy storage [first, last) to d, the ranges do not overlap
+    template<class I, class O>
+    BOOST_UBLAS_INLINE
+    void copy_storage (I first, I last, O d) {
+        std::copy (first, last, d);
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void copy_storage (const T *first, const T *last, T *d) {
+#ifdef BOOST_UBLAS_HAVE_STREAMING_STORES
+        std::size_t size (last - first);
+        if (use_streaming<T> (size)) {
+            std::size_t head (stream_head (d, size));
+            std::copy (first, first + head, d);
+            first += head, d += head, size -= head;
+            std::size_t body (size * sizeof (T) / 16 * 16);
+            if (body) {
+                stream_copy_lines (reinterpret_cast<char *> (d), body, reinterpret_cast<const char *> (first));
+                first += body / sizeof (T), d += body / sizeof (T);
+            }
+        }
+#endif
+        std::copy (first, last, d);
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void copy_storage (T *first, T *last, T *d) {
+        copy_storage (const_cast<const T *> (first), const_cast<const T *> (last), d);
+    }
+
+}
+}}}
+
+#endif
@@ -0,0 +1,313 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SYMMETRIC_KERNEL_
+#define _BOOST_UBLAS_SYMMETRIC_KERNEL_
+
+#include <vector>
+
+#include <boost/numeric/ublas/functional.hpp>
+#include <boost/numeric/ublas/detail/temporary.hpp>
+#include <boost/numeric/ublas/detail/contiguous.hpp>
+
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+// Products of symmetric and hermitian matrices with dense vectors in the spirit of BLAS spmv,
+// symv, hpmv and hemv. Only the stored triangle is read, each element once: an off diagonal
+// element contributes to both y (i) and y (j).
+//
+// Products into symmetric and hermitian matrices in the spirit of BLAS syrk, herk, syr2k and
+// her2k. Only the stored triangle is computed, by tiles of packed operands.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Whether the lines of a packed triangle are contiguous, which is not the case for the
+    // rectangular full packed storage
+    template<class TRI>
+    struct packed_lines_traits {
+        static const bool value = false;
+    };
+    template<class Z>
+    struct packed_lines_traits<basic_lower<Z> > {
+        static const bool value = true;
+    };
+    template<class Z>
+    struct packed_lines_traits<basic_upper<Z> > {
+        static const bool value = true;
+    };
+
+    // Addresses of the stored elements of a packed triangle
+    template<class T, class TRI, class L>
+    class packed_triangle_lines {
+    public:
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_INLINE
+        packed_triangle_lines (const T *data, size_type size):
+            data_ (data), size_ (size) {}
+
+        BOOST_UBLAS_INLINE
+        const T *operator () (size_type i, size_type j) const {
+            return data_ + TRI::element (L (), i, size_, j, size_);
+        }
+
+    private:
+        const T *data_;
+        size_type size_;
+    };
+
+    // Addresses of the elements of a dense matrix
+    template<class M>
+    class dense_triangle_lines {
+    public:
+        typedef std::size_t size_type;
+        typedef typename M::value_type value_type;
+
+        BOOST_UBLAS_INLINE
+        dense_triangle_lines (const M &m):
+            m_ (m) {}
+
+        BOOST_UBLAS_INLINE
+        const value_type *operator () (size_type i, size_type j) const {
+            return &m_ (i, j);
+        }
+
+    private:
+        const M &m_;
+    };
+
+    // One line of n elements with the diagonal at d: t += F1 (a) * xc, yc += F2 (a) * xr
+    template<class F1, class F2, class T>
+    BOOST_UBLAS_INLINE
+    void symmetric_line (const T *p, std::size_t d, std::size_t n, const T *xc, T *yc, const T &xr, T &t) {
+        for (std::size_t k = 0; k < d; ++ k) {
+            t += F1::apply (p [k]) * xc [k];
+            yc [k] += F2::apply (p [k]) * xr;
+        }
+        for (std::size_t k = d + 1; k < n; ++ k) {
+            t += F1::apply (p [k]) * xc [k];
+            yc [k] += F2::apply (p [k]) * xr;
+        }
+    }
+
+    // y += alpha * A * x over the lines [first, last) of the stored triangle of A, where F is
+    // scalar_identity for symmetric and scalar_conj for hermitian A. Line r is row r (rows) or
+    // column r of the triangle and holds the indices 0 to r (before) or r to size - 1,
+    // contiguously from line (r, c) or line (c, r).
+    template<class F, class P, class T>
+    void symmetric_axpy_lines (const P &line, std::size_t size, bool rows, bool before,
+                               const T *x, T *y, const T &alpha, std::size_t first, std::size_t last) {
+        typedef std::size_t size_type;
+        for (size_type r = first; r < last; ++ r) {
+            size_type c = before ? 0 : r;
+            size_type n = before ? r + 1 : size - r;
+            size_type d = before ? r : 0;
+            const T *p = rows ? line (r, c) : line (c, r);
+            T xr (alpha * x [r]);
+            T t = T/*zero*/();
+            if (rows)
+                symmetric_line<scalar_identity<T>, F> (p, d, n, x + c, y + c, xr, t);
+            else
+                symmetric_line<F, scalar_identity<T> > (p, d, n, x + c, y + c, xr, t);
+            y [r] += alpha * t + p [d] * xr;
+        }
+    }
+
+    // Shares the lines between OpenMP threads for large matrices, each thread accumulating
+    // into its own copy of y
+    template<class F, class P, class T>
+    void symmetric_axpy (const P &line, std::size_t size, bool rows, bool before,
+                         const T *x, T *y, const T &alpha) {
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        if (size * (size + 1) / 2 >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+            omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+            const long lines = long (size);
+#pragma omp parallel
+            {
+                std::vector<T> yt (size, T/*zero*/());
+#pragma omp for schedule (dynamic, 16)
+                for (long r = 0; r < lines; ++ r)
+                    symmetric_axpy_lines<F> (line, size, rows, before, x, &yt [0], alpha, std::size_t (r), std::size_t (r) + 1);
+#pragma omp critical
+                for (std::size_t i = 0; i < size; ++ i)
+                    y [i] += yt [i];
+            }
+            return;
+        }
+#endif
+        symmetric_axpy_lines<F> (line, size, rows, before, x, y, alpha, 0, size);
+    }
+
+    // One term alpha * x * y of a rank update. The tiles of x and y are packed into contiguous
+    // rows of x and columns of y.
+    template<class E1, class E2, class T>
+    class rank_update_term {
+    public:
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_INLINE
+        rank_update_term (const E1 &x, const E2 &y, const T &alpha):
+            x_ (x), y_ (y), alpha_ (alpha) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            return BOOST_UBLAS_SAME (x_.size2 (), y_.size1 ());
+        }
+
+        // acc (i, j) += alpha * x (i0 + i, k0:k1) * y (k0:k1, j0 + j) for (i, j) in the triangle
+        // of the tile selected by TRI
+        template<class TRI>
+        void apply (T *acc, T *xp, T *yp, size_type i0, size_type i1, size_type j0, size_type j1,
+                    size_type k0, size_type k1) const {
+            const size_type n = k1 - k0;
+            const size_type nj = j1 - j0;
+            for (size_type i = i0; i < i1; ++ i)
+                for (size_type k = k0; k < k1; ++ k)
+                    xp [(i - i0) * n + k - k0] = x_ (i, k);
+            for (size_type j = j0; j < j1; ++ j)
+                for (size_type k = k0; k < k1; ++ k)
+                    yp [(j - j0) * n + k - k0] = y_ (k, j);
+            for (size_type i = i0; i < i1; ++ i) {
+                const T *xr = xp + (i - i0) * n;
+                for (size_type j = j0; j < j1; ++ j) {
+                    if (! TRI::other (i, j))
+                        continue;
+                    const T *yc = yp + (j - j0) * n;
+                    T s = T/*zero*/();
+                    for (size_type k = 0; k < n; ++ k)
+                        s += xr [k] * yc [k];
+                    acc [(i - i0) * nj + j - j0] += alpha_ * s;
+                }
+            }
+        }
+
+    private:
+        const E1 &x_;
+        const E2 &y_;
+        T alpha_;
+    };
+
+    // No second term
+    template<class T>
+    class rank_update_none {
+    public:
+        typedef std::size_t size_type;
+
+        template<class TRI>
+        BOOST_UBLAS_INLINE
+        void apply (T *, T *, T *, size_type, size_type, size_type, size_type, size_type, size_type) const {}
+    };
+
+    // m := beta * m + t1 + t2 over the rows [i0, i1) of the stored triangle TRI of m, where the
+    // diagonal is kept real for hermitian m
+    template<class TRI, class M, class T1, class T2>
+    void rank_update_rows (M &m, const T1 &t1, const T2 &t2, const typename M::value_type &beta,
+                           bool hermitian, std::size_t i0, std::size_t i1) {
+        typedef std::size_t size_type;
+        typedef typename M::value_type value_type;
+        typedef typename vector_scratch_traits<value_type>::type scratch_type;
+
+        const size_type size = m.size1 ();
+        const size_type depth = t1.size ();
+        const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        const size_type panel = 4 * block;
+        const bool lower = TRI::other (1, 0);
+        scratch_type acc (block * block);
+        scratch_type xp (block * (std::min) (panel, depth + 1));
+        scratch_type yp (block * (std::min) (panel, depth + 1));
+        const M &cm (m);
+        const size_type j_first = lower ? 0 : i0;
+        const size_type j_last = lower ? i1 : size;
+        for (size_type j0 = j_first; j0 < j_last; j0 += block) {
+            const size_type j1 = (std::min) (j0 + block, j_last);
+            std::fill (acc.begin (), acc.end (), value_type/*zero*/());
+            for (size_type k0 = 0; k0 < depth; k0 += panel) {
+                const size_type k1 = (std::min) (k0 + panel, depth);
+                t1.template apply<TRI> (&acc [0], &xp [0], &yp [0], i0, i1, j0, j1, k0, k1);
+                t2.template apply<TRI> (&acc [0], &xp [0], &yp [0], i0, i1, j0, j1, k0, k1);
+            }
+            for (size_type i = i0; i < i1; ++ i)
+                for (size_type j = j0; j < j1; ++ j) {
+                    if (! TRI::other (i, j))
+                        continue;
+                    value_type t (acc [(i - i0) * (j1 - j0) + j - j0]);
+                    if (beta != value_type/*zero*/())
+                        t += beta * cm (i, j);
+                    if (hermitian && i == j)
+                        t = type_traits<value_type>::real (t);
+                    m (i, j) = t;
+                }
+        }
+    }
+
+    // Shares the blocks of rows between OpenMP threads for large updates
+    template<class TRI, class M, class T1, class T2>
+    void rank_update (M &m, const T1 &t1, const T2 &t2, const typename M::value_type &beta, bool hermitian) {
+        typedef std::size_t size_type;
+
+        const size_type size = m.size1 ();
+        const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        if (size > block && size * size / 2 * t1.size () >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+            omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+            const long blocks = long ((size + block - 1) / block);
+#pragma omp parallel for schedule (dynamic, 1)
+            for (long b = 0; b < blocks; ++ b)
+                rank_update_rows<TRI> (m, t1, t2, beta, hermitian, size_type (b) * block, (std::min) (size_type (b + 1) * block, size));
+            return;
+        }
+#endif
+        for (size_type i = 0; i < size; i += block)
+            rank_update_rows<TRI> (m, t1, t2, beta, hermitian, i, (std::min) (i + block, size));
+    }
+
+}
+
+    /** \brief Rank \a k update of the stored triangle of a symmetric or hermitian matrix,
+     * \f$M := \beta M + \alpha XY\f$ as in BLAS syrk and herk
+     *
+     * \c m is a symmetric_matrix, a hermitian_matrix or an adaptor of a dense matrix. Only the
+     * elements of its stored triangle are computed, the product is assumed to be symmetric
+     * (hermitian), e.g. \f$Y = X^T\f$ (\f$X^H\f$).
+     */
+    template<class M, class E1, class E2>
+    void symmetric_prod_update (M &m, const E1 &x, const E2 &y,
+                                const typename M::value_type &alpha, const typename M::value_type &beta) {
+        typedef typename M::value_type value_type;
+        typedef typename detail::symmetric_target_traits<M> traits_type;
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == x.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == y.size2 (), bad_size ());
+        detail::rank_update<typename traits_type::triangular_type> (m, detail::rank_update_term<E1, E2, value_type> (x, y, alpha),
+                                                                   detail::rank_update_none<value_type> (), beta, traits_type::hermitian);
+    }
+    /** \brief Rank \a 2k update of the stored triangle of a symmetric or hermitian matrix,
+     * \f$M := \beta M + \alpha_1 X_1Y_1 + \alpha_2 X_2Y_2\f$ as in BLAS syr2k and her2k
+     */
+    template<class M, class E1, class E2, class E3, class E4>
+    void symmetric_prod_update (M &m, const E1 &x1, const E2 &y1, const typename M::value_type &alpha1,
+                                const E3 &x2, const E4 &y2, const typename M::value_type &alpha2,
+                                const typename M::value_type &beta) {
+        typedef typename M::value_type value_type;
+        typedef typename detail::symmetric_target_traits<M> traits_type;
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == x1.size1 () && m.size1 () == x2.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == y1.size2 () && m.size2 () == y2.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (x1.size2 () == x2.size2 (), bad_size ());
+        detail::rank_update<typename traits_type::triangular_type> (m, detail::rank_update_term<E1, E2, value_type> (x1, y1, alpha1),
+                                                                   detail::rank_update_term<E3, E4, value_type> (x2, y2, alpha2),
+                                                                   beta, traits_type::hermitian);
+    }
+
+}}}
+
+#endif
@@ -28,6 +28,20 @@ struct matrix_temporary_traits {
    typedef typename M::matrix_temporary_type type ;
 };
 
+/// For the creation of dense scratch vectors local to an algorithm.
+/// The storage is drawn from the active arena if there is one.
+template <class T>
+struct vector_scratch_traits {
+   typedef vector<T, unbounded_array<T, arena_allocator<T> > > type ;
+};
+
+/// For the creation of dense scratch matrices local to an algorithm.
+/// The storage is drawn from the active arena if there is one.
+template <class T, class L = row_major>
+struct matrix_scratch_traits {
+   typedef matrix<T, L, unbounded_array<T, arena_allocator<T> > > type ;
+};
+
 } } }
 
 #endif
@@ -0,0 +1,160 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_TRANSPOSE_
+#define _BOOST_UBLAS_TRANSPOSE_
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/numeric/ublas/traits.hpp>
+
+// Cache oblivious transposition kernels working on the storage of dense matrices.
+// The blocks are halved along their longer side until both sides fit into
+// BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE, so that the rows read and the rows written
+// by a leaf stay in the first level cache whatever its size.
+
+namespace boost { namespace numeric { namespace ublas {
+
+    template<class E, class F>
+    class matrix_unary2;
+
+namespace detail {
+
+    // Out of place: d [i * ld_d + j] = f (s [j * ld_s + i]) for i < size_M, j < size_m
+    template<class F, class G, class T1, class T2, class S, class D>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void transpose_copy (T1 *d, D ld_d, const T2 *s, D ld_s, S size_M, S size_m) {
+        typedef F functor_type;
+        typedef G unary_functor_type;
+        while (size_M > BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE || size_m > BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE) {
+            if (size_M >= size_m) {
+                S half (size_M / 2);
+                transpose_copy<F, G> (d, ld_d, s, ld_s, half, size_m);
+                d += half * ld_d, s += half;
+                size_M -= half;
+            } else {
+                S half (size_m / 2);
+                transpose_copy<F, G> (d, ld_d, s, ld_s, size_M, half);
+                d += half, s += half * ld_s;
+                size_m -= half;
+            }
+        }
+        for (S i = 0; i < size_M; ++ i) {
+            T1 *di = d + i * ld_d;
+            const T2 *si = s + i;
+            for (S j = 0; j < size_m; ++ j)
+                functor_type::apply (di [j], unary_functor_type::apply (si [j * ld_s]));
+        }
+    }
+
+    // In place exchange of two disjoint blocks: a [i * ld + j] <-> g (b [j * ld + i])
+    template<class G, class T, class S, class D>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void transpose_swap (T *a, T *b, D ld, S size_M, S size_m) {
+        typedef G unary_functor_type;
+        while (size_M > BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE || size_m > BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE) {
+            if (size_M >= size_m) {
+                S half (size_M / 2);
+                transpose_swap<G> (a, b, ld, half, size_m);
+                a += half * ld, b += half;
+                size_M -= half;
+            } else {
+                S half (size_m / 2);
+                transpose_swap<G> (a, b, ld, size_M, half);
+                a += half, b += half * ld;
+                size_m -= half;
+            }
+        }
+        for (S i = 0; i < size_M; ++ i) {
+            T *ai = a + i * ld;
+            T *bi = b + i;
+            for (S j = 0; j < size_m; ++ j) {
+                T t (ai [j]);
+                ai [j] = unary_functor_type::apply (bi [j * ld]);
+                bi [j * ld] = unary_functor_type::apply (t);
+            }
+        }
+    }
+
+    // In place transposition of a square block with leading dimension ld
+    template<class G, class T, class S, class D>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void transpose_square_inplace (T *p, D ld, S size) {
+        typedef G unary_functor_type;
+        if (size > BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE) {
+            S half (size / 2);
+            transpose_square_inplace<G> (p, ld, half);
+            transpose_square_inplace<G> (p + half * ld + half, ld, size - half);
+            transpose_swap<G> (p + half * ld, p + half, ld, size - half, half);
+            return;
+        }
+        for (S i = 0; i < size; ++ i) {
+            T *pi = p + i * ld;
+            for (S j = 0; j < i; ++ j) {
+                T t (pi [j]);
+                pi [j] = unary_functor_type::apply (p [j * ld + i]);
+                p [j * ld + i] = unary_functor_type::apply (t);
+            }
+            pi [i] = unary_functor_type::apply (pi [i]);
+        }
+    }
+
+    // In place transposition of a contiguous size_M x size_m array into a size_m x size_M one.
+    // Element k = i * size_m + j moves to j * size_M + i = k * size_M mod (size - 1),
+    // each cycle of this permutation is followed once.
+    template<class T, class S>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void transpose_rectangular_inplace (T *p, S size_M, S size_m) {
+        S size (size_M * size_m);
+        if (size_M <= 1 || size_m <= 1)
+            return;
+        S last (size - 1);
+        std::vector<bool> moved (size);
+        for (S k = 1; k < last; ++ k) {
+            if (moved [k])
+                continue;
+            T t (p [k]);
+            S i (k);
+            do {
+                i = (i * size_M) % last;
+                std::swap (t, p [i]);
+                moved [i] = true;
+            } while (i != k);
+        }
+    }
+
+    // Assignment of trans (e) or herm (e) to a matrix with the same storage orientation as e
+    struct dense_transpose_tag {};
+
+    template<class M, class E, class SC>
+    struct matrix_transpose_traits {
+        typedef SC storage_category;
+    };
+
+    template<class T1, class L1, class A1, class T2, class L2, class A2, class F1, class SC>
+    struct matrix_transpose_traits<matrix<T1, L1, A1>, matrix_unary2<const matrix<T2, L2, A2>, F1>, SC> {
+        typedef L1 layout_type;
+        typedef matrix<T2, L2, A2> expression_type;
+        typedef L2 expression_layout_type;
+        typedef F1 functor_type;
+        typedef typename boost::mpl::if_<boost::is_same<typename L1::orientation_category,
+                                                        typename L2::orientation_category>,
+                                         dense_transpose_tag,
+                                         SC>::type storage_category;
+    };
+    template<class T1, class L1, class A1, class T2, class L2, class A2, class F1, class SC>
+    struct matrix_transpose_traits<matrix<T1, L1, A1>, matrix_unary2<matrix<T2, L2, A2>, F1>, SC>:
+        matrix_transpose_traits<matrix<T1, L1, A1>, matrix_unary2<const matrix<T2, L2, A2>, F1>, SC> {};
+
+}
+
+}}}
+
+#endif
@@ -14,6 +14,8 @@
 #define _BOOST_UBLAS_VECTOR_ASSIGN_
 
 #include <boost/numeric/ublas/functional.hpp> // scalar_assign
+#include <boost/numeric/ublas/detail/contiguous.hpp>
+#include <boost/numeric/ublas/detail/streaming.hpp>
 // Required for make_conformant storage
 #include <vector>
 
@@ -169,11 +171,28 @@ namespace detail {
             functor_type::apply (*it, t), ++ it;
     }
 
+    // Dense container fill case
+    template<class V, class F, class SC>
+    struct vector_fill_traits {
+        typedef SC storage_category;
+    };
+    template<class T, class A, class U, class SC>
+    struct vector_fill_traits<vector<T, A>, scalar_assign<T &, U>, SC> {
+        typedef detail::dense_fill_tag storage_category;
+    };
+
+    template<template <class T1, class T2> class F, class V, class T>
+    BOOST_UBLAS_INLINE
+    void vector_assign_scalar (V &v, const T &t, detail::dense_fill_tag) {
+        detail::fill_storage (v.data ().begin (), v.data ().end (), typename V::value_type (t));
+    }
+
     // Dispatcher
     template<template <class T1, class T2> class F, class V, class T>
     BOOST_UBLAS_INLINE
     void vector_assign_scalar (V &v, const T &t) {
-        typedef typename V::storage_category storage_category;
+        typedef typename vector_fill_traits<V, F<typename V::reference, T>,
+                                            typename V::storage_category>::storage_category storage_category;
         vector_assign_scalar<F> (v, t, storage_category ());
     }
 
@@ -438,13 +457,151 @@ namespace detail {
 #endif
     }
 
+    // Dense copy case
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, detail::dense_copy_tag) {
+        typedef typename V::size_type size_type;
+        size_type size (BOOST_UBLAS_SAME (v.size (), e ().size ()));
+        if (size == 0)
+            return;
+        detail::copy_storage (&e () (0), &e () (0) + size, &v (0));
+    }
+
+    // Matrix vector product case, computed by the kernel of the matrix type
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, detail::matrix_vector_kernel_tag) {
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type value_type;
+        size_type size (BOOST_UBLAS_SAME (v.size (), e ().size ()));
+        if (boost::is_same<functor_type, scalar_assign<typename V::reference, typename E::value_type> >::value)
+            vector_assign_scalar<scalar_assign> (v, value_type/*zero*/());
+        if (size == 0 || e ().expression2 ().size () == 0)
+            return;
+        value_type alpha (boost::is_same<functor_type, scalar_minus_assign<typename V::reference, typename E::value_type> >::value ? -1 : 1);
+        matrix_vector_axpy (detail::closure_matrix (e ().expression1 ()), &e ().expression2 () (0), &v (0), alpha);
+    }
+
+    // Element wise operation between sparse containers case, see sparse_merge_traits
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class F2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<vector_binary<E1, E2, F2> > &e, detail::sparse_merge_tag) {
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        sparse_merge (detail::closure_vector (e ().expression1 ()), detail::closure_vector (e ().expression2 ()), v, F2 ());
+    }
+
+    // Sums and products with a constant operand case, see vector_fold_traits
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, detail::zero_fold_tag) {
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        if (boost::is_same<functor_type, scalar_assign<typename V::reference, typename E::value_type> >::value)
+            vector_assign<scalar_assign> (v, zero_vector<typename V::value_type> (v.size ()));
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, detail::first_fold_tag) {
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        vector_assign<F> (v, detail::closure_vector (e ().expression1 ()));
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class F2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<vector_binary<E1, E2, F2> > &e, detail::second_fold_tag) {
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        vector_assign<F> (v, detail::closure_vector (e ().expression2 ()));
+    }
+    // A product with an identity matrix which is not square takes the general path
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class F2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary1<E1, E2, F2> > &e, detail::second_fold_tag) {
+        typedef matrix_vector_binary1<E1, E2, F2> expression_type;
+        typedef F<typename V::reference, typename expression_type::value_type> functor_type;
+        if (e ().expression1 ().size1 () == e ().expression1 ().size2 ()) {
+            BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+            vector_assign<F> (v, detail::closure_vector (e ().expression2 ()));
+            return;
+        }
+        typedef typename vector_assign_traits<typename V::storage_category,
+                                              functor_type::computed,
+                                              typename expression_type::const_iterator::iterator_category>::storage_category assign_category;
+        vector_assign<F> (v, e, assign_category ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class F2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary2<E1, E2, F2> > &e, detail::first_fold_tag) {
+        typedef matrix_vector_binary2<E1, E2, F2> expression_type;
+        typedef F<typename V::reference, typename expression_type::value_type> functor_type;
+        if (e ().expression2 ().size1 () == e ().expression2 ().size2 ()) {
+            BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+            vector_assign<F> (v, detail::closure_vector (e ().expression1 ()));
+            return;
+        }
+        typedef typename vector_assign_traits<typename V::storage_category,
+                                              functor_type::computed,
+                                              typename expression_type::const_iterator::iterator_category>::storage_category assign_category;
+        vector_assign<F> (v, e, assign_category ());
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, detail::first_line_fold_tag) {
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+        typedef typename V::size_type size_type;
+        size_type size (BOOST_UBLAS_SAME (v.size (), e ().size ()));
+        BOOST_UBLAS_CHECK (e ().expression1 ().size2 () == e ().expression2 ().size (), bad_size ());
+        const size_type k (detail::closure_vector (e ().expression2 ()).index ());
+        for (size_type i = 0; i < size; ++ i)
+            functor_type::apply (v (i), typename E::value_type (e ().expression1 () (i, k)));
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, detail::second_line_fold_tag) {
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+        typedef typename V::size_type size_type;
+        size_type size (BOOST_UBLAS_SAME (v.size (), e ().size ()));
+        BOOST_UBLAS_CHECK (e ().expression1 ().size () == e ().expression2 ().size1 (), bad_size ());
+        const size_type k (detail::closure_vector (e ().expression1 ()).index ());
+        for (size_type j = 0; j < size; ++ j)
+            functor_type::apply (v (j), typename E::value_type (e ().expression2 () (k, j)));
+    }
+    // Every element is the inner product of the constant line and the other operand
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class F2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary1<E1, E2, F2> > &e, detail::scalar_fold_tag) {
+        typedef typename F2::result_type value_type;
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        BOOST_UBLAS_CHECK (e ().expression1 ().size2 () == e ().expression2 ().size (), bad_size ());
+        const value_type t (e ().size () == 0 || e ().expression2 ().size () == 0 ? value_type/*zero*/() :
+                            value_type (inner_prod (scalar_vector<value_type> (e ().expression2 ().size (), value_type (e ().expression1 () (0, 0))),
+                                                    e ().expression2 ())));
+        vector_assign<F> (v, scalar_vector<value_type> (v.size (), t));
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class F2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary2<E1, E2, F2> > &e, detail::scalar_fold_tag) {
+        typedef typename F2::result_type value_type;
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        BOOST_UBLAS_CHECK (e ().expression1 ().size () == e ().expression2 ().size1 (), bad_size ());
+        const value_type t (e ().size () == 0 || e ().expression1 ().size () == 0 ? value_type/*zero*/() :
+                            value_type (inner_prod (e ().expression1 (),
+                                                    scalar_vector<value_type> (e ().expression1 ().size (), value_type (e ().expression2 () (0, 0))))));
+        vector_assign<F> (v, scalar_vector<value_type> (v.size (), t));
+    }
+
     // Dispatcher
     template<template <class T1, class T2> class F, class V, class E>
     BOOST_UBLAS_INLINE
     void vector_assign (V &v, const vector_expression<E> &e) {
-        typedef typename vector_assign_traits<typename V::storage_category,
-                                              F<typename V::reference, typename E::value_type>::computed,
-                                              typename E::const_iterator::iterator_category>::storage_category storage_category;
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+        typedef typename detail::vector_fold_traits<V, E, functor_type,
+                    typename detail::vector_prod_traits<V, E, functor_type,
+                        typename detail::vector_copy_traits<V, E, functor_type,
+                            typename detail::vector_merge_traits<V, E, functor_type,
+                                typename vector_assign_traits<typename V::storage_category,
+                                                              functor_type::computed,
+                                                              typename E::const_iterator::iterator_category>::storage_category>::storage_category>::storage_category>::storage_category>::storage_category storage_category;
         vector_assign<F> (v, e, storage_category ());
     }
 
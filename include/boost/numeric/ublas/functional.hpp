@@ -14,6 +14,7 @@
 #define _BOOST_UBLAS_FUNCTIONAL_
 
 #include <functional>
+#include <limits>
 
 #include <boost/numeric/ublas/traits.hpp>
 #ifdef BOOST_UBLAS_USE_DUFF_DEVICE
@@ -324,6 +325,97 @@ namespace boost { namespace numeric { namespace ublas {
         };
     };
 
+    // Semirings
+    // The addition and multiplication of sparse products, see sparse_prod. The zero is the
+    // identity of the addition, which unstored elements of the operands and the result stand for
+    template<class T>
+    struct semiring_functor {
+        typedef T value_type;
+        typedef typename type_traits<T>::const_reference argument_type;
+        typedef T result_type;
+    };
+
+    template<class T>
+    struct plus_times_semiring:
+        public semiring_functor<T> {
+        typedef typename semiring_functor<T>::argument_type argument_type;
+        typedef typename semiring_functor<T>::result_type result_type;
+
+        static BOOST_UBLAS_INLINE
+        result_type zero () {
+            return result_type/*zero*/();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type plus (argument_type t1, argument_type t2) {
+            return t1 + t2;
+        }
+        static BOOST_UBLAS_INLINE
+        result_type times (argument_type t1, argument_type t2) {
+            return t1 * t2;
+        }
+    };
+    // Shortest paths
+    template<class T>
+    struct min_plus_semiring:
+        public semiring_functor<T> {
+        typedef typename semiring_functor<T>::argument_type argument_type;
+        typedef typename semiring_functor<T>::result_type result_type;
+
+        static BOOST_UBLAS_INLINE
+        result_type zero () {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity () : (std::numeric_limits<T>::max) ();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type plus (argument_type t1, argument_type t2) {
+            return (std::min) (t1, t2);
+        }
+        static BOOST_UBLAS_INLINE
+        result_type times (argument_type t1, argument_type t2) {
+            return t1 + t2;
+        }
+    };
+    // Most reliable paths, on non negative elements such as probabilities, of which 0 is the
+    // identity of the maximum and annihilates the product
+    template<class T>
+    struct max_times_semiring:
+        public semiring_functor<T> {
+        typedef typename semiring_functor<T>::argument_type argument_type;
+        typedef typename semiring_functor<T>::result_type result_type;
+
+        static BOOST_UBLAS_INLINE
+        result_type zero () {
+            return result_type/*zero*/();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type plus (argument_type t1, argument_type t2) {
+            return (std::max) (t1, t2);
+        }
+        static BOOST_UBLAS_INLINE
+        result_type times (argument_type t1, argument_type t2) {
+            return t1 * t2;
+        }
+    };
+    // Reachability, nonzero elements being true
+    template<class T>
+    struct or_and_semiring:
+        public semiring_functor<T> {
+        typedef typename semiring_functor<T>::argument_type argument_type;
+        typedef typename semiring_functor<T>::result_type result_type;
+
+        static BOOST_UBLAS_INLINE
+        result_type zero () {
+            return result_type/*zero*/();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type plus (argument_type t1, argument_type t2) {
+            return t1 != result_type/*zero*/() || t2 != result_type/*zero*/() ? result_type (1) : result_type/*zero*/();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type times (argument_type t1, argument_type t2) {
+            return t1 != result_type/*zero*/() && t2 != result_type/*zero*/() ? result_type (1) : result_type/*zero*/();
+        }
+    };
+
     // Vector functors
 
     // Unary returning scalar
@@ -1362,6 +1454,11 @@ namespace boost { namespace numeric { namespace ublas {
             BOOST_UBLAS_CHECK (size_j == 0 || size_i <= (std::numeric_limits<size_type>::max) () / size_j, bad_size ());
             return size_i * size_j;
         }
+        static
+        BOOST_UBLAS_INLINE
+        size_type leading_dimension (size_type /* size_i */, size_type size_j) {
+            return size_j;
+        }
 
         // Indexing conversion to storage element
         static
@@ -1540,6 +1637,11 @@ namespace boost { namespace numeric { namespace ublas {
             BOOST_UBLAS_CHECK (size_i == 0 || size_j <= (std::numeric_limits<size_type>::max) () / size_i, bad_size ());
             return size_i * size_j;
         }
+        static
+        BOOST_UBLAS_INLINE
+        size_type leading_dimension (size_type size_i, size_type /* size_j */) {
+            return size_i;
+        }
 
         // Indexing conversion to storage element
         static
@@ -1700,6 +1802,183 @@ namespace boost { namespace numeric { namespace ublas {
         }
     };
 
+    namespace detail {
+        // Leading dimension for rows or columns of n elements, rounded up to a
+        // multiple of N elements (one cache line). Long lines use an odd number of
+        // cache lines, so that consecutive rows or columns neither share cache sets
+        // nor alias at power of two distances.
+        template<std::size_t N, class Z>
+        BOOST_UBLAS_INLINE
+        Z padded_leading_dimension (Z n) {
+            BOOST_STATIC_ASSERT (N > 0);
+            Z lines = (n + N - 1) / N;
+            if (lines >= 8 && lines % 2 == 0)
+                ++ lines;
+            return lines * N;
+        }
+    }
+
+    // forward declaration
+    template <std::size_t N, class Z, class D> struct basic_padded_column_major;
+
+    // This functor defines a row major storage layout with padded rows
+    // matrix (i,j) -> storage [i * ld + j], ld = padded_leading_dimension (size_j)
+    // Each row starts on a multiple of N elements. The padding is never accessed
+    // through the matrix interface.
+    template <std::size_t N, class Z, class D>
+    struct basic_padded_row_major:
+        public basic_row_major<Z, D> {
+        typedef Z size_type;
+        typedef D difference_type;
+        typedef basic_padded_column_major<N, Z, D> transposed_layout;
+
+        static
+        BOOST_UBLAS_INLINE
+        size_type leading_dimension (size_type /* size_i */, size_type size_j) {
+            return detail::padded_leading_dimension<N> (size_j);
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type storage_size (size_type size_i, size_type size_j) {
+            return basic_row_major<Z, D>::storage_size (size_i, leading_dimension (size_i, size_j));
+        }
+
+        // Indexing conversion to storage element
+        static
+        BOOST_UBLAS_INLINE
+        size_type element (size_type i, size_type size_i, size_type j, size_type size_j) {
+            BOOST_UBLAS_CHECK (j < size_j, bad_index ());
+            return basic_row_major<Z, D>::element (i, size_i, j, leading_dimension (size_i, size_j));
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type address (size_type i, size_type size_i, size_type j, size_type size_j) {
+            BOOST_UBLAS_CHECK (j <= size_j, bad_index ());
+            return basic_row_major<Z, D>::address (i, size_i, j, leading_dimension (size_i, size_j));
+        }
+
+        // Storage element to index conversion
+        static
+        BOOST_UBLAS_INLINE
+        difference_type distance_i (difference_type k, size_type size_i, size_type size_j) {
+            return basic_row_major<Z, D>::distance_i (k, size_i, leading_dimension (size_i, size_j));
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type index_i (difference_type k, size_type size_i, size_type size_j) {
+            return basic_row_major<Z, D>::index_i (k, size_i, leading_dimension (size_i, size_j));
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type index_j (difference_type k, size_type size_i, size_type size_j) {
+            return basic_row_major<Z, D>::index_j (k, size_i, leading_dimension (size_i, size_j));
+        }
+
+        // Iterating storage elements
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void increment_i (I &it, size_type size_i, size_type size_j) {
+            it += leading_dimension (size_i, size_j);
+        }
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void increment_i (I &it, difference_type n, size_type size_i, size_type size_j) {
+            it += n * leading_dimension (size_i, size_j);
+        }
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void decrement_i (I &it, size_type size_i, size_type size_j) {
+            it -= leading_dimension (size_i, size_j);
+        }
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void decrement_i (I &it, difference_type n, size_type size_i, size_type size_j) {
+            it -= n * leading_dimension (size_i, size_j);
+        }
+    };
+
+    // This functor defines a column major storage layout with padded columns
+    // matrix (i,j) -> storage [i + j * ld], ld = padded_leading_dimension (size_i)
+    template <std::size_t N, class Z, class D>
+    struct basic_padded_column_major:
+        public basic_column_major<Z, D> {
+        typedef Z size_type;
+        typedef D difference_type;
+        typedef basic_padded_row_major<N, Z, D> transposed_layout;
+
+        static
+        BOOST_UBLAS_INLINE
+        size_type leading_dimension (size_type size_i, size_type /* size_j */) {
+            return detail::padded_leading_dimension<N> (size_i);
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type storage_size (size_type size_i, size_type size_j) {
+            return basic_column_major<Z, D>::storage_size (leading_dimension (size_i, size_j), size_j);
+        }
+
+        // Indexing conversion to storage element
+        static
+        BOOST_UBLAS_INLINE
+        size_type element (size_type i, size_type size_i, size_type j, size_type size_j) {
+            BOOST_UBLAS_CHECK (i < size_i, bad_index ());
+            return basic_column_major<Z, D>::element (i, leading_dimension (size_i, size_j), j, size_j);
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type address (size_type i, size_type size_i, size_type j, size_type size_j) {
+            BOOST_UBLAS_CHECK (i <= size_i, bad_index ());
+            return basic_column_major<Z, D>::address (i, leading_dimension (size_i, size_j), j, size_j);
+        }
+
+        // Storage element to index conversion
+        static
+        BOOST_UBLAS_INLINE
+        difference_type distance_j (difference_type k, size_type size_i, size_type size_j) {
+            return basic_column_major<Z, D>::distance_j (k, leading_dimension (size_i, size_j), size_j);
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type index_i (difference_type k, size_type size_i, size_type size_j) {
+            return basic_column_major<Z, D>::index_i (k, leading_dimension (size_i, size_j), size_j);
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type index_j (difference_type k, size_type size_i, size_type size_j) {
+            return basic_column_major<Z, D>::index_j (k, leading_dimension (size_i, size_j), size_j);
+        }
+
+        // Iterating storage elements
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void increment_j (I &it, size_type size_i, size_type size_j) {
+            it += leading_dimension (size_i, size_j);
+        }
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void increment_j (I &it, difference_type n, size_type size_i, size_type size_j) {
+            it += n * leading_dimension (size_i, size_j);
+        }
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void decrement_j (I &it, size_type size_i, size_type size_j) {
+            it -= leading_dimension (size_i, size_j);
+        }
+        template<class I>
+        static
+        BOOST_UBLAS_INLINE
+        void decrement_j (I &it, difference_type n, size_type size_i, size_type size_j) {
+            it -= n * leading_dimension (size_i, size_j);
+        }
+    };
+
 
     template <class Z>
     struct basic_full {
@@ -2057,6 +2336,104 @@ namespace boost { namespace numeric { namespace ublas {
         typedef strict_upper_tag triangular_type;
     };
 
+    namespace detail {
+        // The rectangle of rectangular full packed storage: a triangle of size n is held in
+        // n + 1 rows by n / 2 columns for even n and n rows by (n + 1) / 2 columns for odd n
+        template <class Z>
+        struct rfp_rectangle {
+            typedef Z size_type;
+
+            static
+            BOOST_UBLAS_INLINE
+            size_type size1 (size_type n) {
+                return n % 2 ? n : n + 1;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type size2 (size_type n) {
+                return (n + 1) / 2;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type element (row_major_tag, size_type r, size_type c, size_type n) {
+                return r * size2 (n) + c;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type element (column_major_tag, size_type r, size_type c, size_type n) {
+                return r + c * size1 (n);
+            }
+        };
+    }
+
+    // Rectangular full packed storage (RFP, LAPACK's TRANSR = 'N'). The triangle is split
+    // into two triangles and a rectangle which are stored as dense blocks of a rectangle of
+    // n (n + 1) / 2 elements, the second triangle transposed beside the first one.
+    // The layout orients the rectangle; the footprint is the same as the packed storage.
+    template <class Z>
+    struct basic_rfp_lower : public basic_lower<Z> {
+        typedef Z size_type;
+        typedef lower_tag triangular_type;
+
+        // Only square triangles are stored
+        template<class L>
+        static
+        BOOST_UBLAS_INLINE
+        size_type packed_size (L, size_type size_i, size_type size_j) {
+            BOOST_UBLAS_CHECK (size_i == size_j, bad_size ());
+            return size_i * (size_i + 1) / 2;
+        }
+
+        // The first triangle holds the columns j < (n + 1) / 2
+        template<class L>
+        static
+        BOOST_UBLAS_INLINE
+        size_type element (L, size_type i, size_type size_i, size_type j, size_type size_j) {
+            typedef detail::rfp_rectangle<Z> rectangle;
+            BOOST_UBLAS_CHECK (i < size_i, bad_index ());
+            BOOST_UBLAS_CHECK (j < size_j, bad_index ());
+            BOOST_UBLAS_CHECK (i >= j, bad_index ());
+            const size_type n = (std::max) (size_i, size_j);
+            const size_type k = rectangle::size2 (n);
+            const size_type e = n % 2 ? 0 : 1;
+            if (j < k)
+                return rectangle::element (typename L::orientation_category (), i + e, j, n);
+            return rectangle::element (typename L::orientation_category (), j - k, i - k + 1 - e, n);
+        }
+    };
+
+    template <class Z>
+    struct basic_rfp_upper : public basic_upper<Z> {
+        typedef Z size_type;
+        typedef upper_tag triangular_type;
+
+        // Only square triangles are stored
+        template<class L>
+        static
+        BOOST_UBLAS_INLINE
+        size_type packed_size (L, size_type size_i, size_type size_j) {
+            BOOST_UBLAS_CHECK (size_i == size_j, bad_size ());
+            return size_i * (size_i + 1) / 2;
+        }
+
+        // The second triangle holds the columns j >= n / 2
+        template<class L>
+        static
+        BOOST_UBLAS_INLINE
+        size_type element (L, size_type i, size_type size_i, size_type j, size_type size_j) {
+            typedef detail::rfp_rectangle<Z> rectangle;
+            BOOST_UBLAS_CHECK (i < size_i, bad_index ());
+            BOOST_UBLAS_CHECK (j < size_j, bad_index ());
+            BOOST_UBLAS_CHECK (i <= j, bad_index ());
+            const size_type n = (std::max) (size_i, size_j);
+            const size_type n1 = n / 2;
+            const size_type e = n % 2 ? 0 : 1;
+            if (j >= n1)
+                return rectangle::element (typename L::orientation_category (), i, j - n1, n);
+            return rectangle::element (typename L::orientation_category (), j + n - n1 + e, i, n);
+        }
+    };
+
 
 }}}
 
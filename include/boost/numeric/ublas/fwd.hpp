@@ -26,6 +26,11 @@ namespace boost { namespace numeric { namespace ublas {
     template<class T, std::size_t N, class ALLOC = std::allocator<T> >
     class bounded_array;
 
+    class arena;
+    class arena_scope;
+    template<class T>
+    class arena_allocator;
+
     template <class Z = std::size_t, class D = std::ptrdiff_t>
     class basic_range;
     template <class Z = std::size_t, class D = std::ptrdiff_t>
@@ -123,6 +128,14 @@ namespace boost { namespace numeric { namespace ublas {
     struct basic_column_major;
     typedef basic_column_major<> column_major;
 
+    template <std::size_t N = 8, class Z = std::size_t, class D = std::ptrdiff_t>
+    struct basic_padded_row_major;
+    typedef basic_padded_row_major<> padded_row_major;
+
+    template <std::size_t N = 8, class Z = std::size_t, class D = std::ptrdiff_t>
+    struct basic_padded_column_major;
+    typedef basic_padded_column_major<> padded_column_major;
+
     template<class T, class L = row_major, class A = unbounded_array<T> >
     class matrix;
     template<class T, std::size_t M, std::size_t N, class L = row_major>
@@ -181,11 +194,21 @@ namespace boost { namespace numeric { namespace ublas {
     struct basic_strict_upper;
     typedef basic_strict_upper<> strict_upper;
 
+    template <class Z = std::size_t>
+    struct basic_rfp_lower;
+    typedef basic_rfp_lower<> rfp_lower;
+
+    template <class Z = std::size_t>
+    struct basic_rfp_upper;
+    typedef basic_rfp_upper<> rfp_upper;
+
     // Special matrices
     template<class T, class L = row_major, class A = unbounded_array<T> >
     class banded_matrix;
     template<class T, class L = row_major, class A = unbounded_array<T> >
     class diagonal_matrix;
+    template<class M>
+    class banded_adaptor;
 
     template<class T, class TRI = lower, class L = row_major, class A = unbounded_array<T> >
     class triangular_matrix;
@@ -211,6 +234,14 @@ namespace boost { namespace numeric { namespace ublas {
     class compressed_matrix;
     template<class T, class L = row_major, std::size_t IB = 0, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
     class coordinate_matrix;
+    template<class T, std::size_t BR = 0, std::size_t BC = BR, class L = row_major, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
+    class block_compressed_matrix;
+    template<class T, std::size_t C = 8, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
+    class sliced_ellpack_matrix;
+    template<class T, class TRI = lower, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
+    class symmetric_compressed_matrix;
+    template<class T, class L = row_major, std::size_t IB = 0, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
+    class dual_compressed_matrix;
 
 }}}
 
@@ -18,6 +18,9 @@
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/detail/temporary.hpp>
 
 // LU factorizations in the spirit of LAPACK and Golub & van Loan
 
@@ -98,7 +101,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix_type cm (m);
+        typename matrix_scratch_traits<value_type>::type cm (m);
 #endif
         size_type singular = 0;
         size_type size1 = m.size1 ();
@@ -134,7 +137,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix_type cm (m);
+        typename matrix_scratch_traits<value_type>::type cm (m);
 #endif
         size_type singular = 0;
         size_type size1 = m.size1 ();
@@ -175,10 +178,10 @@ namespace boost { namespace numeric { namespace ublas {
         typedef M matrix_type;
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
-        typedef vector<value_type> vector_type;
+        typedef typename vector_scratch_traits<value_type>::type vector_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix_type cm (m);
+        typename matrix_scratch_traits<value_type>::type cm (m);
 #endif
         size_type singular = 0;
         size_type size1 = m.size1 ();
@@ -266,7 +269,7 @@ namespace boost { namespace numeric { namespace ublas {
     template<class M, class E>
     void lu_substitute (const M &m, vector_expression<E> &e) {
         typedef const M const_matrix_type;
-        typedef vector<typename E::value_type> vector_type;
+        typedef typename vector_scratch_traits<typename E::value_type>::type vector_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
         vector_type cv1 (e);
@@ -284,7 +287,7 @@ namespace boost { namespace numeric { namespace ublas {
     template<class M, class E>
     void lu_substitute (const M &m, matrix_expression<E> &e) {
         typedef const M const_matrix_type;
-        typedef matrix<typename E::value_type> matrix_type;
+        typedef typename matrix_scratch_traits<typename E::value_type>::type matrix_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
         matrix_type cm1 (e);
@@ -307,7 +310,7 @@ namespace boost { namespace numeric { namespace ublas {
     template<class E, class M>
     void lu_substitute (vector_expression<E> &e, const M &m) {
         typedef const M const_matrix_type;
-        typedef vector<typename E::value_type> vector_type;
+        typedef typename vector_scratch_traits<typename E::value_type>::type vector_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
         vector_type cv1 (e);
@@ -325,7 +328,7 @@ namespace boost { namespace numeric { namespace ublas {
     template<class E, class M>
     void lu_substitute (matrix_expression<E> &e, const M &m) {
         typedef const M const_matrix_type;
-        typedef matrix<typename E::value_type> matrix_type;
+        typedef typename matrix_scratch_traits<typename E::value_type>::type matrix_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
         matrix_type cm1 (e);
@@ -346,6 +349,499 @@ namespace boost { namespace numeric { namespace ublas {
         lu_substitute (mv, m);
     }
 
+    // Banded LU factorization with partial pivoting in the spirit of LAPACK gbtrf.
+    // Row interchanges fill in up to lower () further super-diagonals, so the upper bandwidth
+    // of m is widened by m.lower () first. On return the upper band holds U and the lower band
+    // the multipliers of each elimination step, which are not permuted by later interchanges:
+    // use banded_lu_substitute rather than lu_substitute to solve with the factors.
+    template<class T, class L, class A, class PM>
+    typename banded_matrix<T, L, A>::size_type banded_lu_factorize (banded_matrix<T, L, A> &m, PM &pm) {
+        typedef banded_matrix<T, L, A> matrix_type;
+        typedef typename matrix_type::size_type size_type;
+        typedef typename matrix_type::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        size_type size = BOOST_UBLAS_SAME (m.size1 (), m.size2 ());
+        size_type lower = m.lower ();
+        size_type upper = m.upper () + lower;
+        if (lower > 0) {
+            matrix_type fm (size, size, lower, upper);
+            fm.clear ();
+            for (size_type j = 0; j < size; ++ j) {
+                size_type first = j > m.upper () ? j - m.upper () : 0;
+                size_type last = (std::min) (size, j + lower + 1);
+                for (size_type i = first; i < last; ++ i)
+                    fm.at_element (i, j) = m.at_element (i, j);
+            }
+            m.assign_temporary (fm);
+        }
+        size_type singular = 0;
+        for (size_type j = 0; j < size; ++ j) {
+            size_type last = (std::min) (size, j + lower + 1);
+            size_type i_norm_inf = j;
+            real_type norm_inf = type_traits<value_type>::norm_inf (m.at_element (j, j));
+            for (size_type i = j + 1; i < last; ++ i) {
+                real_type t = type_traits<value_type>::norm_inf (m.at_element (i, j));
+                if (t > norm_inf) {
+                    norm_inf = t;
+                    i_norm_inf = i;
+                }
+            }
+            pm (j) = i_norm_inf;
+            if (m.at_element (i_norm_inf, j) != value_type/*zero*/()) {
+                size_type last_column = (std::min) (size, j + upper + 1);
+                if (i_norm_inf != j) {
+                    for (size_type k = j; k < last_column; ++ k)
+                        std::swap (m.at_element (j, k), m.at_element (i_norm_inf, k));
+                }
+                value_type m_inv = value_type (1) / m.at_element (j, j);
+                for (size_type i = j + 1; i < last; ++ i)
+                    m.at_element (i, j) *= m_inv;
+                for (size_type k = j + 1; k < last_column; ++ k) {
+                    value_type t (m.at_element (j, k));
+                    if (t != value_type/*zero*/()) {
+                        for (size_type i = j + 1; i < last; ++ i)
+                            m.at_element (i, k) -= m.at_element (i, j) * t;
+                    }
+                }
+            } else if (singular == 0) {
+                singular = j + 1;
+            }
+        }
+        return singular;
+    }
+
+    // Banded LU substitution
+    template<class M, class PM, class MV>
+    void banded_lu_substitute (const M &m, const PM &pm, MV &mv, vector_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        size_type size = BOOST_UBLAS_SAME (m.size1 (), mv.size ());
+        size_type lower = m.lower ();
+        size_type upper = m.upper ();
+        // Interchanges and multipliers in the order of the elimination
+        for (size_type j = 0; j < size; ++ j) {
+            if (pm (j) != j)
+                std::swap (mv (j), mv (pm (j)));
+            value_type t (mv (j));
+            if (t != value_type/*zero*/()) {
+                size_type last = (std::min) (size, j + lower + 1);
+                for (size_type i = j + 1; i < last; ++ i)
+                    mv (i) -= m (i, j) * t;
+            }
+        }
+        // Column oriented back substitution with U
+        for (size_type j = size; j-- > 0; ) {
+            value_type t (mv (j) /= m (j, j));
+            if (t != value_type/*zero*/()) {
+                size_type first = j > upper ? j - upper : 0;
+                for (size_type i = first; i < j; ++ i)
+                    mv (i) -= m (i, j) * t;
+            }
+        }
+    }
+    template<class M, class PM, class MV>
+    void banded_lu_substitute (const M &m, const PM &pm, MV &mv, matrix_tag) {
+        typedef typename MV::size_type size_type;
+
+        size_type size2 = mv.size2 ();
+        for (size_type k = 0; k < size2; ++ k) {
+            matrix_column<MV> mck (column (mv, k));
+            banded_lu_substitute (m, pm, mck, vector_tag ());
+        }
+    }
+    // Dispatcher
+    template<class M, class PMT, class PMA, class MV>
+    void banded_lu_substitute (const M &m, const permutation_matrix<PMT, PMA> &pm, MV &mv) {
+        banded_lu_substitute (m, pm, mv, typename MV::type_category ());
+    }
+
+    namespace detail {
+        // Elimination of row i + 1 by row i of a tridiagonal system with partial pivoting as in
+        // LAPACK gtsv. After an interchange dl holds the second super-diagonal of row i, du1 is
+        // the super-diagonal of row i + 1 or 0 in the last step. Returns false on a zero pivot.
+        template<class T>
+        BOOST_UBLAS_INLINE
+        bool tridiagonal_eliminate (T &dl, T &d0, T &d1, T &du0, T *du1, T &b0, T &b1) {
+            if (type_traits<T>::norm_inf (d0) >= type_traits<T>::norm_inf (dl)) {
+                if (d0 == T/*zero*/())
+                    return false;
+                T fact (dl / d0);
+                d1 -= fact * du0;
+                b1 -= fact * b0;
+                dl = T/*zero*/();
+            } else {
+                T fact (d0 / dl);
+                d0 = dl;
+                T t (d1);
+                d1 = du0 - fact * t;
+                if (du1) {
+                    dl = *du1;
+                    *du1 = - fact * dl;
+                }
+                du0 = t;
+                t = b0;
+                b0 = b1;
+                b1 = t - fact * b1;
+            }
+            return true;
+        }
+    }
+
+    /** \brief Solve a tridiagonal system in place with partial pivoting.
+     *
+     * \c dl, \c d and \c du hold the sub-, main and super-diagonal, of sizes \f$n-1\f$, \f$n\f$ and
+     * \f$n-1\f$; they are overwritten by the factorization. \c b is overwritten by the solution.
+     * Returns 0, or \f$i+1\f$ if the \f$i\f$-th pivot is zero.
+     */
+    template<class VL, class VD, class VU, class V>
+    typename V::size_type tridiagonal_solve (VL &dl, VD &d, VU &du, V &b) {
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type value_type;
+
+        size_type size = BOOST_UBLAS_SAME (d.size (), b.size ());
+        if (size == 0)
+            return 0;
+        BOOST_UBLAS_CHECK (dl.size () + 1 >= size && du.size () + 1 >= size, bad_size ());
+        for (size_type i = 0; i + 1 < size; ++ i) {
+            if (! detail::tridiagonal_eliminate (dl (i), d (i), d (i + 1), du (i),
+                                                 i + 2 < size ? &du (i + 1) : 0, b (i), b (i + 1)))
+                return i + 1;
+        }
+        if (d (size - 1) == value_type/*zero*/())
+            return size;
+        b (size - 1) /= d (size - 1);
+        if (size > 1) {
+            b (size - 2) = (b (size - 2) - du (size - 2) * b (size - 1)) / d (size - 2);
+            for (size_type i = size - 2; i-- > 0; )
+                b (i) = (b (i) - du (i) * b (i + 1) - dl (i) * b (i + 2)) / d (i);
+        }
+        return 0;
+    }
+
+    /** \brief Solve many independent tridiagonal systems of the same size in place.
+     *
+     * Column \f$k\f$ of \c dl, \c d, \c du and \c b holds the diagonals and the right hand side of
+     * system \f$k\f$, as for tridiagonal_solve. The systems are eliminated side by side, so with
+     * row major arguments the innermost loop runs over contiguous elements.
+     * Returns 0, or \f$k+1\f$ for the first system \f$k\f$ with a zero pivot.
+     */
+    template<class ML, class MD, class MU, class MB>
+    typename MB::size_type tridiagonal_solve_batched (ML &dl, MD &d, MU &du, MB &b) {
+        typedef typename MB::size_type size_type;
+        typedef typename MB::value_type value_type;
+
+        size_type size = BOOST_UBLAS_SAME (d.size1 (), b.size1 ());
+        size_type count = BOOST_UBLAS_SAME (d.size2 (), b.size2 ());
+        if (size == 0)
+            return 0;
+        BOOST_UBLAS_CHECK (dl.size1 () + 1 >= size && du.size1 () + 1 >= size, bad_size ());
+        BOOST_UBLAS_CHECK (dl.size2 () == count && du.size2 () == count, bad_size ());
+        size_type singular = 0;
+        for (size_type i = 0; i + 1 < size; ++ i) {
+            for (size_type k = 0; k < count; ++ k) {
+                if (! detail::tridiagonal_eliminate (dl (i, k), d (i, k), d (i + 1, k), du (i, k),
+                                                     i + 2 < size ? &du (i + 1, k) : 0, b (i, k), b (i + 1, k)) &&
+                    (singular == 0 || k + 1 < singular))
+                    singular = k + 1;
+            }
+        }
+        for (size_type k = 0; k < count; ++ k) {
+            if (d (size - 1, k) == value_type/*zero*/() && (singular == 0 || k + 1 < singular))
+                singular = k + 1;
+            b (size - 1, k) /= d (size - 1, k);
+        }
+        if (size > 1) {
+            for (size_type k = 0; k < count; ++ k)
+                b (size - 2, k) = (b (size - 2, k) - du (size - 2, k) * b (size - 1, k)) / d (size - 2, k);
+            for (size_type i = size - 2; i-- > 0; ) {
+                for (size_type k = 0; k < count; ++ k)
+                    b (i, k) = (b (i, k) - du (i, k) * b (i + 1, k) - dl (i, k) * b (i + 2, k)) / d (i, k);
+            }
+        }
+        return singular;
+    }
+
+    namespace detail {
+        // The trailing block [offset, size) x [offset, size) of a symmetric matrix, as the target
+        // of rank_update
+        template<class M>
+        class symmetric_trailing_block {
+        public:
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+            typedef typename M::const_reference const_reference;
+            typedef typename M::reference reference;
+
+            BOOST_UBLAS_INLINE
+            symmetric_trailing_block (M &m, size_type offset):
+                m_ (m), offset_ (offset) {}
+
+            BOOST_UBLAS_INLINE
+            size_type size1 () const {
+                return m_.size1 () - offset_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type size2 () const {
+                return m_.size2 () - offset_;
+            }
+            BOOST_UBLAS_INLINE
+            const_reference operator () (size_type i, size_type j) const {
+                return static_cast<const M &> (m_) (offset_ + i, offset_ + j);
+            }
+            BOOST_UBLAS_INLINE
+            reference operator () (size_type i, size_type j) {
+                return m_ (offset_ + i, offset_ + j);
+            }
+
+        private:
+            M &m_;
+            size_type offset_;
+        };
+
+        // w (k:size, c) := A (k:size, j) - L (k:size, k0:k) * W (j, 0:k-k0)^T, column j of the
+        // trailing matrix updated by the columns of the current panel
+        template<class M, class W>
+        void ldlt_update_column (const M &m, W &w, std::size_t k0, std::size_t k, std::size_t j, std::size_t c) {
+            typedef typename M::value_type value_type;
+            const std::size_t size = m.size1 ();
+            for (std::size_t i = k; i < size; ++ i) {
+                value_type t (m (i, j));
+                for (std::size_t l = k0; l < k; ++ l)
+                    t -= m (i, l) * w (j, l - k0);
+                w (i, c) = t;
+            }
+        }
+
+        // Interchanges rows and columns p and q of the trailing matrix [first, size) of a
+        // symmetric matrix
+        template<class M>
+        void ldlt_swap (M &m, std::size_t first, std::size_t p, std::size_t q) {
+            const std::size_t size = m.size1 ();
+            for (std::size_t i = first; i < size; ++ i)
+                if (i != p && i != q)
+                    std::swap (m (i, p), m (i, q));
+            std::swap (m (p, p), m (q, q));
+        }
+
+        // Whether the pivot at k is the first of a 2 by 2 block
+        template<class PM>
+        BOOST_UBLAS_INLINE
+        bool ldlt_block (const PM &pm, std::size_t k) {
+            return k + 1 < pm.size () && pm (k + 1) == k;
+        }
+    }
+
+    /** \brief Symmetric indefinite factorization \f$PAP^T = LDL^T\f$ with the diagonal pivoting of
+     * Bunch and Kaufman, in the spirit of LAPACK sytrf.
+     *
+     * \c m is a symmetric_matrix of either triangle or a symmetric_adaptor of a dense matrix. It
+     * is overwritten by the unit lower triangle of \f$L\f$ and by the diagonal blocks of \f$D\f$,
+     * which are 1 by 1 or 2 by 2. Only half of the matrix is stored and read. Columns are
+     * factored in panels of \c BOOST_UBLAS_SOLVE_BLOCK_SIZE, of which the update of the trailing
+     * matrix is a blocked rank update.
+     *
+     * \c pm records the interchanges in the order of the elimination, applied to whole rows as by
+     * lu_factorize. For a 1 by 1 pivot \f$k\f$, \c pm(k) is the row interchanged with \f$k\f$. For
+     * a 2 by 2 pivot in rows \f$k\f$ and \f$k+1\f$, \c pm(k) is the row interchanged with
+     * \f$k+1\f$ and \c pm(k+1) is \f$k\f$, which no 1 by 1 pivot produces. Use ldlt_substitute to
+     * solve with the factors.
+     *
+     * Returns 0, or \f$k+1\f$ for the first pivot \f$k\f$ of a zero column, for which \f$D\f$
+     * is singular.
+     */
+    template<class M, class PM>
+    typename M::size_type ldlt_factorize (M &m, PM &pm) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size = BOOST_UBLAS_SAME (m.size1 (), m.size2 ());
+        BOOST_UBLAS_CHECK (pm.size () == size, bad_size ());
+        const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        const real_type alpha = (real_type (1) + type_traits<real_type>::type_sqrt (real_type (17))) / real_type (8);
+        // W = L D for the columns of the panel, one more for a 2 by 2 pivot at its end
+        matrix<value_type, column_major> w (size, (std::min) (block, size) + 1);
+        size_type singular = 0;
+        size_type k = 0;
+        while (k < size) {
+            const size_type k0 = k;
+            while (k < size && k - k0 < block) {
+                const size_type c = k - k0;
+                detail::ldlt_update_column (m, w, k0, k, k, c);
+                const real_type absakk = type_traits<value_type>::norm_inf (w (k, c));
+                size_type imax = k;
+                real_type colmax = real_type/*zero*/();
+                for (size_type i = k + 1; i < size; ++ i) {
+                    real_type t = type_traits<value_type>::norm_inf (w (i, c));
+                    if (t > colmax) {
+                        colmax = t;
+                        imax = i;
+                    }
+                }
+                size_type kstep = 1;
+                size_type kp = k;
+                if (absakk == real_type/*zero*/() && colmax == real_type/*zero*/()) {
+                    if (singular == 0)
+                        singular = k + 1;
+                } else if (absakk < alpha * colmax) {
+                    // Column imax, updated, and its largest element off the diagonal
+                    detail::ldlt_update_column (m, w, k0, k, imax, c + 1);
+                    real_type rowmax = real_type/*zero*/();
+                    for (size_type i = k; i < size; ++ i) {
+                        if (i != imax)
+                            rowmax = (std::max) (rowmax, type_traits<value_type>::norm_inf (w (i, c + 1)));
+                    }
+                    if (absakk * rowmax >= alpha * colmax * colmax) {
+                        // No interchange, 1 by 1 pivot
+                    } else if (type_traits<value_type>::norm_inf (w (imax, c + 1)) >= alpha * rowmax) {
+                        // Interchange k and imax, 1 by 1 pivot
+                        kp = imax;
+                        for (size_type i = k; i < size; ++ i)
+                            w (i, c) = w (i, c + 1);
+                    } else {
+                        // Interchange k + 1 and imax, 2 by 2 pivot
+                        kp = imax;
+                        kstep = 2;
+                    }
+                }
+                const size_type kk = k + kstep - 1;
+                if (kp != kk) {
+                    detail::ldlt_swap (m, k, kk, kp);
+                    for (size_type j = 0; j < k; ++ j)
+                        std::swap (m (kk, j), m (kp, j));
+                    for (size_type j = 0; j < c + kstep; ++ j)
+                        std::swap (w (kk, j), w (kp, j));
+                }
+                if (kstep == 1) {
+                    const value_type d (w (k, c));
+                    m (k, k) = d;
+                    if (d != value_type/*zero*/()) {
+                        const value_type d_inv = value_type (1) / d;
+                        for (size_type i = k + 1; i < size; ++ i)
+                            m (i, k) = w (i, c) * d_inv;
+                    } else {
+                        for (size_type i = k + 1; i < size; ++ i)
+                            m (i, k) = value_type/*zero*/();
+                    }
+                    pm (k) = kp;
+                } else {
+                    // Columns of L from the inverse of the 2 by 2 block, scaled as in LAPACK
+                    value_type d21 (w (k + 1, c));
+                    const value_type d11 (w (k + 1, c + 1) / d21);
+                    const value_type d22 (w (k, c) / d21);
+                    const value_type t (value_type (1) / (d11 * d22 - value_type (1)));
+                    d21 = t / d21;
+                    for (size_type i = k + 2; i < size; ++ i) {
+                        m (i, k) = d21 * (d11 * w (i, c) - w (i, c + 1));
+                        m (i, k + 1) = d21 * (d22 * w (i, c + 1) - w (i, c));
+                    }
+                    m (k, k) = w (k, c);
+                    m (k + 1, k) = w (k + 1, c);
+                    m (k + 1, k + 1) = w (k + 1, c + 1);
+                    pm (k) = kp;
+                    pm (k + 1) = k;
+                }
+                k += kstep;
+            }
+            // A22 := A22 - L21 W21^T
+            const size_type kb = k - k0;
+            if (k < size) {
+                const size_type size2 = size - k;
+                matrix<value_type> l21 (size2, kb), wt (kb, size2);
+                for (size_type i = 0; i < size2; ++ i)
+                    for (size_type j = 0; j < kb; ++ j) {
+                        l21 (i, j) = m (k + i, k0 + j);
+                        wt (j, i) = w (k + i, j);
+                    }
+                detail::symmetric_trailing_block<M> a22 (m, k);
+                detail::rank_update<lower> (a22, detail::rank_update_term<matrix<value_type>, matrix<value_type>, value_type> (l21, wt, value_type (-1)),
+                                            detail::rank_update_none<value_type> (), value_type (1), false);
+            }
+        }
+        return singular;
+    }
+
+    // Symmetric indefinite substitution
+    template<class M, class PM, class MV>
+    void ldlt_substitute (const M &m, const PM &pm, MV &mv, vector_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size = BOOST_UBLAS_SAME (m.size1 (), mv.size ());
+        BOOST_UBLAS_CHECK (pm.size () == size, bad_size ());
+        // Interchanges
+        for (size_type k = 0; k < size; ) {
+            const size_type s = detail::ldlt_block (pm, k) ? 2 : 1;
+            if (pm (k) != k + s - 1)
+                std::swap (mv (k + s - 1), mv (pm (k)));
+            k += s;
+        }
+        // Column oriented forward substitution with L, which is the identity in the 2 by 2 blocks
+        for (size_type k = 0; k < size; ) {
+            const size_type s = detail::ldlt_block (pm, k) ? 2 : 1;
+            for (size_type j = k; j < k + s; ++ j) {
+                value_type t (mv (j));
+                if (t != value_type/*zero*/()) {
+                    for (size_type i = k + s; i < size; ++ i)
+                        mv (i) -= m (i, j) * t;
+                }
+            }
+            k += s;
+        }
+        // D
+        for (size_type k = 0; k < size; ) {
+            if (detail::ldlt_block (pm, k)) {
+                const value_type akm1k (m (k + 1, k));
+                const value_type akm1 (m (k, k) / akm1k);
+                const value_type ak (m (k + 1, k + 1) / akm1k);
+                const value_type denom (akm1 * ak - value_type (1));
+                const value_type bkm1 (mv (k) / akm1k);
+                const value_type bk (mv (k + 1) / akm1k);
+                mv (k) = (ak * bkm1 - bk) / denom;
+                mv (k + 1) = (akm1 * bk - bkm1) / denom;
+                k += 2;
+            } else {
+                mv (k) /= m (k, k);
+                k += 1;
+            }
+        }
+        // Row oriented back substitution with L^T
+        for (size_type k = size; k > 0; ) {
+            const size_type s = k >= 2 && pm (k - 1) == k - 2 ? 2 : 1;
+            k -= s;
+            for (size_type j = k; j < k + s; ++ j) {
+                value_type t (mv (j));
+                for (size_type i = k + s; i < size; ++ i)
+                    t -= m (i, j) * mv (i);
+                mv (j) = t;
+            }
+        }
+        // Interchanges in reverse order
+        for (size_type k = size; k > 0; ) {
+            const size_type s = k >= 2 && pm (k - 1) == k - 2 ? 2 : 1;
+            k -= s;
+            if (pm (k) != k + s - 1)
+                std::swap (mv (k + s - 1), mv (pm (k)));
+        }
+    }
+    template<class M, class PM, class MV>
+    void ldlt_substitute (const M &m, const PM &pm, MV &mv, matrix_tag) {
+        typedef typename MV::size_type size_type;
+
+        size_type size2 = mv.size2 ();
+        for (size_type k = 0; k < size2; ++ k) {
+            matrix_column<MV> mck (column (mv, k));
+            ldlt_substitute (m, pm, mck, vector_tag ());
+        }
+    }
+    // Dispatcher
+    template<class M, class PMT, class PMA, class MV>
+    void ldlt_substitute (const M &m, const permutation_matrix<PMT, PMA> &pm, MV &mv) {
+        ldlt_substitute (m, pm, mv, typename MV::type_category ());
+    }
+
 }}}
 
 #endif
@@ -288,7 +288,7 @@ namespace boost { namespace numeric {
      */
         BOOST_UBLAS_INLINE
         void clear () {
-            std::fill (data ().begin (), data ().end (), value_type/*zero*/());
+            detail::fill_storage (data ().begin (), data ().end (), value_type/*zero*/());
         }
 
         // Assignment
@@ -1093,6 +1093,42 @@ namespace boost { namespace numeric {
         array_type data_;
     };
 
+    /** \brief Transpose a dense matrix in place: \f$M \leftarrow M^T\f$.
+     *
+     * Square matrices are transposed by recursively swapping blocks across the diagonal.
+     * A rectangular \f$(m \times n)\f$ matrix without padding is rearranged inside its
+     * storage by following the cycles of the permutation and then reshaped to
+     * \f$(n \times m)\f$; with a padded layout a transposed copy is made instead.
+     */
+    template<class T, class L, class A>
+    void inplace_transpose (matrix<T, L, A> &m) {
+        typedef matrix<T, L, A> matrix_type;
+        typedef L layout_type;
+        typedef typename matrix_type::size_type size_type;
+        typedef typename matrix_type::difference_type difference_type;
+        size_type size1 (m.size1 ());
+        size_type size2 (m.size2 ());
+        if (size1 == 0 || size2 == 0) {
+            m.resize (size2, size1, false);
+            return;
+        }
+        if (size1 == size2)
+            detail::transpose_square_inplace<scalar_identity<T> > (&m.data () [0],
+                                                                   difference_type (layout_type::leading_dimension (size1, size2)),
+                                                                   size1);
+        else if (layout_type::storage_size (size1, size2) == size1 * size2 &&
+                 layout_type::storage_size (size2, size1) == size1 * size2) {
+            detail::transpose_rectangular_inplace (&m.data () [0],
+                                                   layout_type::size_M (size1, size2),
+                                                   layout_type::size_m (size1, size2));
+            // Same storage size, the elements are kept
+            m.resize (size2, size1, false);
+        } else {
+            matrix_type temporary (trans (m));
+            m.assign_temporary (temporary);
+        }
+    }
+
     /** \brief A dense matrix of values of type \c T with a variable size bounded to a maximum of \f$M\f$ by \f$N\f$. 
      *
      * For a \f$(m \times n)\f$-dimensional matrix and \f$ 0 \leq i < m, 0 \leq j < n\f$, every element \f$m_{i,j}\f$ is mapped
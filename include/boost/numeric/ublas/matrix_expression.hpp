@@ -2470,6 +2470,31 @@ namespace boost { namespace numeric { namespace ublas {
 #endif
     };
 
+    namespace detail {
+        // The constant matrices, see constant_expression_traits in vector_expression.hpp
+        template<class T, class ALLOC>
+        struct constant_expression_traits<zero_matrix<T, ALLOC> > {
+            static const bool zero = true;
+            static const bool identity = false;
+            static const bool scalar = false;
+            static const bool unit = false;
+        };
+        template<class T, class ALLOC>
+        struct constant_expression_traits<identity_matrix<T, ALLOC> > {
+            static const bool zero = false;
+            static const bool identity = true;
+            static const bool scalar = false;
+            static const bool unit = false;
+        };
+        template<class T, class ALLOC>
+        struct constant_expression_traits<scalar_matrix<T, ALLOC> > {
+            static const bool zero = false;
+            static const bool identity = false;
+            static const bool scalar = true;
+            static const bool unit = false;
+        };
+    }
+
     // (m1 + m2) [i] [j] = m1 [i] [j] + m2 [i] [j]
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
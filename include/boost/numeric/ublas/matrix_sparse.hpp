@@ -16,10 +16,16 @@
 #include <boost/numeric/ublas/vector_sparse.hpp>
 #include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/numeric/ublas/detail/matrix_assign.hpp>
+#include <boost/numeric/ublas/detail/temporary.hpp>
+#include <boost/numeric/ublas/detail/sparse_conversion.hpp>
 #if BOOST_UBLAS_TYPE_CHECK
 #include <boost/numeric/ublas/matrix.hpp>
 #endif
 
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 // Iterators based on ideas of Jeremy Siek
 
 namespace boost { namespace numeric { namespace ublas {
@@ -2686,25 +2692,13 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         compressed_matrix (const coordinate_matrix<T, L, IB, IA, TA> &m):
             matrix_container<self_type> (),
-            size1_ (m.size1()), size2_ (m.size2()),
-            index1_data_ (layout_type::size_M (size1_, size2_) + 1)
-        {
-            m.sort();
-            reserve(m.nnz(), false);
-            filled2_ = m.nnz();
-            const_subiterator_type  i_start = m.index1_data().begin();
-            const_subiterator_type  i_end   = (i_start + filled2_);
-            const_subiterator_type  i = i_start;
-            size_type r = 1;
-            for (; (r < layout_type::size_M (size1_, size2_)) && (i != i_end); ++r) {
-                i = std::lower_bound(i, i_end, r);
-                index1_data_[r] = k_based( i - i_start );
-            }
-            filled1_ = r + 1;
-            std::copy( m.index2_data().begin(), m.index2_data().begin() + filled2_, index2_data_.begin());
-            std::copy( m.value_data().begin(), m.value_data().begin() + filled2_, value_data_.begin());
-            index1_data_ [filled1_ - 1] = k_based(filled2_);
+            size1_ (m.size1 ()), size2_ (m.size2 ()), capacity_ (restrict_capacity (0)),
+            filled1_ (1), filled2_ (0),
+            index1_data_ (layout_type::size_M (size1_, size2_) + 1),
+            index2_data_ (capacity_), value_data_ (capacity_) {
+            index1_data_ [filled1_ - 1] = k_based (filled2_);
             storage_invariants ();
+            sparse_convert (m, *this);
         }
 
        template<class AE>
@@ -4120,6 +4114,14 @@ namespace boost { namespace numeric { namespace ublas {
             filled_ = filled;
             storage_invariants ();
         }
+        // The elements being sorted without duplicates, as after sort ()
+        BOOST_UBLAS_INLINE
+        void set_sorted_filled (const array_size_type &filled) {
+            filled_ = filled;
+            sorted_filled_ = filled;
+            sorted_ = true;
+            storage_invariants ();
+        }
         BOOST_UBLAS_INLINE
         index_array_type &index1_data () {
             return index1_data_;
@@ -5416,6 +5418,4657 @@ namespace boost { namespace numeric { namespace ublas {
     template<class T, class L, std::size_t IB, class IA, class TA>
     const typename coordinate_matrix<T, L, IB, IA, TA>::value_type coordinate_matrix<T, L, IB, IA, TA>::zero_ = value_type/*zero*/();
 
+    namespace detail {
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct diagonal_scaling_traits<compressed_matrix<T, L, IB, IA, TA> > {
+            static const bool value = true;
+        };
+
+        // m := alpha * d * a (left) or alpha * a * d (right). The values of a copy of a are scaled
+        // in place for square d, otherwise the elements beyond the diagonal of d are dropped while
+        // the product is built. a may be m itself.
+        template<class D, class M>
+        void compressed_diagonal_prod (const D &d, const M &a, M &m, const typename M::value_type &alpha, bool left) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            typedef typename M::value_type value_type;
+            typedef typename vector_scratch_traits<value_type>::type scratch_type;
+
+            if (left) {
+                BOOST_UBLAS_CHECK (m.size1 () == d.size1 () && d.size2 () == a.size1 () && m.size2 () == a.size2 (), bad_size ());
+            } else {
+                BOOST_UBLAS_CHECK (m.size1 () == a.size1 () && a.size2 () == d.size1 () && m.size2 () == d.size2 (), bad_size ());
+            }
+            const bool rows = boost::is_same<typename M::orientation_category, row_major_tag>::value;
+            // Elements of the major lines scale by the same element of d, when these run across it
+            const bool per_line = left == rows;
+            const size_type diagonal = (std::min) (d.size1 (), d.size2 ());
+            scratch_type dv (diagonal);
+            for (size_type k = 0; k < diagonal; ++ k)
+                dv [k] = alpha * d (k, k);
+
+            if (d.size1 () == d.size2 ()) {
+                if (&m != &a)
+                    m = a;
+                const array_size_type lines = m.filled1 () > 0 ? m.filled1 () - 1 : 0;
+                for (array_size_type l = 0; l < lines; ++ l) {
+                    const array_size_type first = m.index1_data () [l] - M::index_base ();
+                    const array_size_type last = m.index1_data () [l + 1] - M::index_base ();
+                    for (array_size_type k = first; k < last; ++ k)
+                        m.value_data () [k] *= dv [per_line ? size_type (l) : size_type (m.index2_data () [k] - M::index_base ())];
+                }
+                return;
+            }
+
+            M t (m.size1 (), m.size2 (), a.nnz ());
+            const array_size_type lines = a.filled1 () > 0 ? a.filled1 () - 1 : 0;
+            for (array_size_type l = 0; l < lines; ++ l) {
+                const array_size_type first = a.index1_data () [l] - M::index_base ();
+                const array_size_type last = a.index1_data () [l + 1] - M::index_base ();
+                for (array_size_type k = first; k < last; ++ k) {
+                    const size_type minor = a.index2_data () [k] - M::index_base ();
+                    const size_type i = rows ? size_type (l) : minor;
+                    const size_type j = rows ? minor : size_type (l);
+                    const size_type e = left ? i : j;
+                    if (e < diagonal)
+                        t.push_back (i, j, dv [e] * a.value_data () [k]);
+                }
+            }
+            m.assign_temporary (t);
+        }
+    }
+
+    // Products of a diagonal matrix and a compressed matrix into a compressed matrix of the same
+    // type, see diagonal_scaling_traits
+    template<class E, class T, class L, std::size_t IB, class IA, class TA>
+    bool diagonal_prod_axpy (const E &e1, const compressed_matrix<T, L, IB, IA, TA> &e2, compressed_matrix<T, L, IB, IA, TA> &m,
+                             const T &alpha, bool) {
+        if (e1.lower () != 0 || e1.upper () != 0)
+            return false;
+        detail::compressed_diagonal_prod (e1, e2, m, alpha, true);
+        return true;
+    }
+    template<class T, class L, std::size_t IB, class IA, class TA, class E>
+    bool diagonal_prod_axpy (const compressed_matrix<T, L, IB, IA, TA> &e1, const E &e2, compressed_matrix<T, L, IB, IA, TA> &m,
+                             const T &alpha, bool) {
+        if (e2.lower () != 0 || e2.upper () != 0)
+            return false;
+        detail::compressed_diagonal_prod (e2, e1, m, alpha, false);
+        return true;
+    }
+
+    namespace detail {
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct matrix_matrix_kernel_traits<compressed_matrix<T, L, IB, IA, TA> > {
+            static const bool value = true;
+        };
+
+        // C += alpha * a * B for the rows [first, last) of a row major a, and the columns [first2,
+        // last2) of B and C. Each row of a is read once, the rows of B it selects being added to
+        // the row of C, which is vectorized along when B and C are row major.
+        template<class M, class T>
+        void compressed_prod_rows (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                   T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, const T &alpha,
+                                   std::size_t first, std::size_t last, std::size_t first2, std::size_t last2) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type n = last2 - first2;
+            for (size_type l = first; l < last; ++ l) {
+                T *ci = c + std::ptrdiff_t (l) * c1 + std::ptrdiff_t (first2) * c2;
+                const array_size_type k_first = a.index1_data () [l] - M::index_base ();
+                const array_size_type k_last = a.index1_data () [l + 1] - M::index_base ();
+                for (array_size_type k = k_first; k < k_last; ++ k) {
+                    const T &v = a.value_data () [k];
+                    if (v == T/*zero*/())
+                        continue;
+                    const T t (alpha * v);
+                    const T *bj = b + std::ptrdiff_t (a.index2_data () [k] - M::index_base ()) * b1 + std::ptrdiff_t (first2) * b2;
+                    if (b2 == 1 && c2 == 1) {
+                        for (size_type p = 0; p < n; ++ p)
+                            ci [p] += t * bj [p];
+                    } else {
+                        for (size_type p = 0; p < n; ++ p)
+                            ci [p * c2] += t * bj [p * b2];
+                    }
+                }
+            }
+        }
+        // The same for a column major a, each element scattering a row of B into a row of C
+        template<class M, class T>
+        void compressed_prod_columns (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                      T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, const T &alpha,
+                                      std::size_t first, std::size_t last, std::size_t first2, std::size_t last2) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type n = last2 - first2;
+            for (size_type l = first; l < last; ++ l) {
+                const T *bj = b + std::ptrdiff_t (l) * b1 + std::ptrdiff_t (first2) * b2;
+                const array_size_type k_first = a.index1_data () [l] - M::index_base ();
+                const array_size_type k_last = a.index1_data () [l + 1] - M::index_base ();
+                for (array_size_type k = k_first; k < k_last; ++ k) {
+                    const T &v = a.value_data () [k];
+                    if (v == T/*zero*/())
+                        continue;
+                    const T t (alpha * v);
+                    T *ci = c + std::ptrdiff_t (a.index2_data () [k] - M::index_base ()) * c1 + std::ptrdiff_t (first2) * c2;
+                    if (b2 == 1 && c2 == 1) {
+                        for (size_type p = 0; p < n; ++ p)
+                            ci [p] += t * bj [p];
+                    } else {
+                        for (size_type p = 0; p < n; ++ p)
+                            ci [p * c2] += t * bj [p * b2];
+                    }
+                }
+            }
+        }
+
+        // Row major matrices share chunks of rows between OpenMP threads, column major matrices,
+        // which scatter into the whole of C, chunks of columns of B and C
+        template<class M, class T>
+        void compressed_prod (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                              T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha, row_major_tag) {
+            typedef typename M::size_type size_type;
+            const size_type lines = a.filled1 () > 0 ? a.filled1 () - 1 : 0;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (lines > chunk && a.nnz () * n >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((lines + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long k = 0; k < chunks; ++ k)
+                    compressed_prod_rows (a, b, b1, b2, c, c1, c2, alpha,
+                                          size_type (k) * chunk, (std::min) (size_type (k + 1) * chunk, lines), 0, n);
+                return;
+            }
+#endif
+            compressed_prod_rows (a, b, b1, b2, c, c1, c2, alpha, 0, lines, 0, n);
+        }
+        template<class M, class T>
+        void compressed_prod (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                              T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha, column_major_tag) {
+            typedef typename M::size_type size_type;
+            const size_type lines = a.filled1 () > 0 ? a.filled1 () - 1 : 0;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (n > chunk && a.nnz () * n >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((n + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long k = 0; k < chunks; ++ k)
+                    compressed_prod_columns (a, b, b1, b2, c, c1, c2, alpha,
+                                             0, lines, size_type (k) * chunk, (std::min) (size_type (k + 1) * chunk, size_type (n)));
+                return;
+            }
+#endif
+            compressed_prod_columns (a, b, b1, b2, c, c1, c2, alpha, 0, lines, 0, n);
+        }
+    }
+
+    // Matrix matrix product kernel, e2 and m being dense blocks, see matrix_matrix_kernel_traits
+    template<class T, class L, std::size_t IB, class IA, class TA, class E2, class M>
+    BOOST_UBLAS_INLINE
+    void matrix_matrix_axpy (const compressed_matrix<T, L, IB, IA, TA> &e1, const E2 &e2, M &m, const T &alpha) {
+        BOOST_UBLAS_CHECK (m.size1 () == e1.size1 () && e1.size2 () == e2.size1 () && m.size2 () == e2.size2 (), bad_size ());
+        if (e1.nnz () == 0 || m.size2 () == 0)
+            return;
+        std::ptrdiff_t b1, b2, c1, c2;
+        detail::dense_block_strides (e2, b1, b2);
+        detail::dense_block_strides (m, c1, c2);
+        detail::compressed_prod (e1, &e2 (0, 0), b1, b2, &m (0, 0), c1, c2, m.size2 (), alpha, typename L::orientation_category ());
+    }
+
+
+    // Block compressed sparse row matrix class
+    // The non zero elements are held in dense blocks of block1 () rows and block2 () columns,
+    // of which a compressed matrix along the orientation of L stores one index per block. The
+    // elements of a block are stored along the same orientation. The block size is fixed at
+    // compile time by BR and BC, or at run time when BR is 0, and divides the sizes of the
+    // matrix. All elements of the stored blocks are stored, erased elements being zeroed.
+    template<class T, std::size_t BR, std::size_t BC, class L, class IA, class TA>
+    class block_compressed_matrix:
+        public matrix_container<block_compressed_matrix<T, BR, BC, L, IA, TA> > {
+
+        typedef T &true_reference;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef L layout_type;
+        typedef block_compressed_matrix<T, BR, BC, L, IA, TA> self_type;
+        BOOST_STATIC_ASSERT ((BR == 0) == (BC == 0));
+    public:
+#ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
+        using matrix_container<self_type>::operator ();
+#endif
+        typedef typename IA::value_type size_type;
+        typedef typename IA::size_type array_size_type;
+        typedef typename IA::difference_type difference_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+#ifndef BOOST_UBLAS_STRICT_MATRIX_SPARSE
+        typedef T &reference;
+#else
+        typedef sparse_matrix_element<self_type> reference;
+#endif
+        typedef IA index_array_type;
+        typedef TA value_array_type;
+        typedef const matrix_reference<const self_type> const_closure_type;
+        typedef matrix_reference<self_type> closure_type;
+        typedef compressed_vector<T, 0, IA, TA> vector_temporary_type;
+        // Temporaries may have any size
+        typedef compressed_matrix<T, L, 0, IA, TA> matrix_temporary_type;
+        typedef sparse_tag storage_category;
+        typedef typename L::orientation_category orientation_category;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix ():
+            matrix_container<self_type> (),
+            size1_ (0), size2_ (0), block1_ (BR != 0 ? BR : 1), block2_ (BC != 0 ? BC : 1),
+            capacity_ (0), filled_ (0),
+            index1_data_ (1, 0), index2_data_ (0), value_data_ (0) {
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (size_type size1, size_type size2, size_type non_zero_blocks = 0):
+            matrix_container<self_type> (),
+            size1_ (size1), size2_ (size2), block1_ (BR != 0 ? BR : 1), block2_ (BC != 0 ? BC : 1),
+            capacity_ (non_zero_blocks), filled_ (0),
+            index1_data_ (lines () + 1, 0), index2_data_ (capacity_), value_data_ (capacity_ * block_size ()) {
+            BOOST_UBLAS_CHECK (size1_ % block1 () == 0 && size2_ % block2 () == 0, bad_size ());
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (size_type size1, size_type size2, size_type block_size1, size_type block_size2, size_type non_zero_blocks = 0):
+            matrix_container<self_type> (),
+            size1_ (size1), size2_ (size2), block1_ (block_size1), block2_ (block_size2),
+            capacity_ (non_zero_blocks), filled_ (0),
+            index1_data_ (lines () + 1, 0), index2_data_ (capacity_), value_data_ (capacity_ * block_size ()) {
+            BOOST_UBLAS_CHECK (BR == 0 || (block_size1 == BR && block_size2 == BC), bad_size ());
+            BOOST_UBLAS_CHECK (size1_ % block1 () == 0 && size2_ % block2 () == 0, bad_size ());
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (const block_compressed_matrix &m):
+            matrix_container<self_type> (),
+            size1_ (m.size1_), size2_ (m.size2_), block1_ (m.block1_), block2_ (m.block2_),
+            capacity_ (m.capacity_), filled_ (m.filled_),
+            index1_data_ (m.index1_data_), index2_data_ (m.index2_data_), value_data_ (m.value_data_) {
+            storage_invariants ();
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (const matrix_expression<AE> &ae):
+            matrix_container<self_type> (),
+            size1_ (ae ().size1 ()), size2_ (ae ().size2 ()), block1_ (BR != 0 ? BR : 1), block2_ (BC != 0 ? BC : 1),
+            capacity_ (0), filled_ (0),
+            index1_data_ (lines () + 1, 0), index2_data_ (0), value_data_ (0) {
+            storage_invariants ();
+            assign (ae);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (const matrix_expression<AE> &ae, size_type block_size1, size_type block_size2):
+            matrix_container<self_type> (),
+            size1_ (ae ().size1 ()), size2_ (ae ().size2 ()), block1_ (block_size1), block2_ (block_size2),
+            capacity_ (0), filled_ (0),
+            index1_data_ (lines () + 1, 0), index2_data_ (0), value_data_ (0) {
+            BOOST_UBLAS_CHECK (BR == 0 || (block_size1 == BR && block_size2 == BC), bad_size ());
+            storage_invariants ();
+            assign (ae);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type block1 () const {
+            return BR != 0 ? size_type (BR) : block1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type block2 () const {
+            return BC != 0 ? size_type (BC) : block2_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type block_size () const {
+            return block1 () * block2 ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type nnz_capacity () const {
+            return capacity_ * block_size ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type nnz () const {
+            return filled_ * block_size ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type nnz_blocks () const {
+            return filled_;
+        }
+
+        // Storage accessors
+        // index1_data () holds the first block of each line of blocks and the number of blocks,
+        // index2_data () the index of each block along the lines and value_data () the elements
+        // of each block
+        BOOST_UBLAS_INLINE
+        array_size_type filled () const {
+            return filled_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index1_data () const {
+            return index1_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index2_data () const {
+            return index2_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &value_data () const {
+            return value_data_;
+        }
+        BOOST_UBLAS_INLINE
+        index_array_type &index1_data () {
+            return index1_data_;
+        }
+        BOOST_UBLAS_INLINE
+        index_array_type &index2_data () {
+            return index2_data_;
+        }
+        BOOST_UBLAS_INLINE
+        value_array_type &value_data () {
+            return value_data_;
+        }
+
+        // Resizing
+        BOOST_UBLAS_INLINE
+        void resize (size_type size1, size_type size2, bool preserve = true) {
+            // FIXME preserve unimplemented
+            BOOST_UBLAS_CHECK (!preserve, internal_logic ());
+            size1_ = size1;
+            size2_ = size2;
+            BOOST_UBLAS_CHECK (size1_ % block1 () == 0 && size2_ % block2 () == 0, bad_size ());
+            filled_ = 0;
+            index1_data_.resize (lines () + 1);
+            std::fill (index1_data_.begin (), index1_data_.end (), size_type/*zero*/());
+            storage_invariants ();
+        }
+
+        // Reserving
+        BOOST_UBLAS_INLINE
+        void reserve (size_type non_zero_blocks, bool preserve = true) {
+            if (preserve) {
+                capacity_ = (std::max) (array_size_type (non_zero_blocks), filled_);
+                index2_data_.resize (capacity_, size_type ());
+                value_data_.resize (capacity_ * block_size (), value_type ());
+            } else {
+                capacity_ = non_zero_blocks;
+                index2_data_.resize (capacity_);
+                value_data_.resize (capacity_ * block_size ());
+                filled_ = 0;
+                std::fill (index1_data_.begin (), index1_data_.end (), size_type/*zero*/());
+            }
+            storage_invariants ();
+        }
+
+        // Block support
+        BOOST_UBLAS_INLINE
+        pointer find_block (size_type block_index1, size_type block_index2) {
+            return const_cast<pointer> (const_cast<const self_type&>(*this).find_block (block_index1, block_index2));
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer find_block (size_type block_index1, size_type block_index2) const {
+            array_size_type k (block_address (layout_type::index_M (block_index1, block_index2),
+                                              layout_type::index_m (block_index1, block_index2)));
+            if (k == filled_)
+                return 0;
+            return &value_data_ [k * block_size ()];
+        }
+        // Inserts a zero block unless present
+        BOOST_UBLAS_INLINE
+        pointer insert_block (size_type block_index1, size_type block_index2) {
+            array_size_type k (insert_block_address (layout_type::index_M (block_index1, block_index2),
+                                                     layout_type::index_m (block_index1, block_index2)));
+            return &value_data_ [k * block_size ()];
+        }
+
+        // Element support
+        BOOST_UBLAS_INLINE
+        pointer find_element (size_type i, size_type j) {
+            return const_cast<pointer> (const_cast<const self_type&>(*this).find_element (i, j));
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer find_element (size_type i, size_type j) const {
+            size_type element1 (layout_type::index_M (i, j));
+            size_type element2 (layout_type::index_m (i, j));
+            array_size_type k (block_address (element1 / major_block (), element2 / minor_block ()));
+            if (k == filled_)
+                return 0;
+            return &value_data_ [element_address (k, element1, element2)];
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type i, size_type j) const {
+            const_pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return zero_;
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type i, size_type j) {
+#ifndef BOOST_UBLAS_STRICT_MATRIX_SPARSE
+            pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return insert_element (i, j, value_type/*zero*/());
+#else
+            return reference (*this, i, j);
+#endif
+        }
+
+        // Element assignment
+        // The element of a stored block is overwritten, otherwise a zero block is inserted first
+        BOOST_UBLAS_INLINE
+        true_reference insert_element (size_type i, size_type j, const_reference t) {
+            BOOST_UBLAS_CHECK (i < size1_ && j < size2_, bad_index ());
+            size_type element1 (layout_type::index_M (i, j));
+            size_type element2 (layout_type::index_m (i, j));
+            array_size_type k (insert_block_address (element1 / major_block (), element2 / minor_block ()));
+            true_reference r (value_data_ [element_address (k, element1, element2)]);
+            r = t;
+            return r;
+        }
+        BOOST_UBLAS_INLINE
+        void erase_element (size_type i, size_type j) {
+            pointer p = find_element (i, j);
+            if (p)
+                *p = value_type/*zero*/();
+        }
+
+        // Zeroing
+        BOOST_UBLAS_INLINE
+        void clear () {
+            filled_ = 0;
+            std::fill (index1_data_.begin (), index1_data_.end (), size_type/*zero*/());
+            storage_invariants ();
+        }
+
+        // Assignment
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &operator = (const block_compressed_matrix &m) {
+            if (this != &m) {
+                size1_ = m.size1_;
+                size2_ = m.size2_;
+                block1_ = m.block1_;
+                block2_ = m.block2_;
+                capacity_ = m.capacity_;
+                filled_ = m.filled_;
+                index1_data_ = m.index1_data_;
+                index2_data_ = m.index2_data_;
+                value_data_ = m.value_data_;
+            }
+            storage_invariants ();
+            return *this;
+        }
+        template<class C>          // Container assignment without temporary
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &operator = (const matrix_container<C> &m) {
+            resize (m ().size1 (), m ().size2 (), false);
+            assign (m);
+            return *this;
+        }
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &assign_temporary (block_compressed_matrix &m) {
+            swap (m);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &operator = (const matrix_expression<AE> &ae) {
+            self_type temporary (ae, block1 (), block2 ());
+            return assign_temporary (temporary);
+        }
+        // The elements of ae are gathered before the storage is rebuilt, so that ae may refer to *this
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &assign (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_CHECK (size1_ == ae ().size1 () && size2_ == ae ().size2 (), bad_size ());
+            std::vector<entry> entries;
+            gather (ae (), entries);
+            build (entries);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix& operator += (const matrix_expression<AE> &ae) {
+            self_type temporary (*this + ae, block1 (), block2 ());
+            return assign_temporary (temporary);
+        }
+        template<class C>          // Container assignment without temporary
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &operator += (const matrix_container<C> &m) {
+            plus_assign (m);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &plus_assign (const matrix_expression<AE> &ae) {
+            matrix_assign<scalar_plus_assign> (*this, ae);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix& operator -= (const matrix_expression<AE> &ae) {
+            self_type temporary (*this - ae, block1 (), block2 ());
+            return assign_temporary (temporary);
+        }
+        template<class C>          // Container assignment without temporary
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &operator -= (const matrix_container<C> &m) {
+            minus_assign (m);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix &minus_assign (const matrix_expression<AE> &ae) {
+            matrix_assign<scalar_minus_assign> (*this, ae);
+            return *this;
+        }
+        template<class AT>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix& operator *= (const AT &at) {
+            for (array_size_type k = 0; k < filled_ * block_size (); ++ k)
+                value_data_ [k] *= at;
+            return *this;
+        }
+        template<class AT>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix& operator /= (const AT &at) {
+            for (array_size_type k = 0; k < filled_ * block_size (); ++ k)
+                value_data_ [k] /= at;
+            return *this;
+        }
+
+        // Swapping
+        BOOST_UBLAS_INLINE
+        void swap (block_compressed_matrix &m) {
+            if (this != &m) {
+                std::swap (size1_, m.size1_);
+                std::swap (size2_, m.size2_);
+                std::swap (block1_, m.block1_);
+                std::swap (block2_, m.block2_);
+                std::swap (capacity_, m.capacity_);
+                std::swap (filled_, m.filled_);
+                index1_data_.swap (m.index1_data_);
+                index2_data_.swap (m.index2_data_);
+                value_data_.swap (m.value_data_);
+            }
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        friend void swap (block_compressed_matrix &m1, block_compressed_matrix &m2) {
+            m1.swap (m2);
+        }
+
+        // Iterator types
+    private:
+        // Use index array iterator
+        typedef typename IA::const_iterator const_subiterator_type;
+        typedef typename IA::iterator subiterator_type;
+
+        BOOST_UBLAS_INLINE
+        true_reference at_element (size_type i, size_type j) {
+            pointer p = find_element (i, j);
+            BOOST_UBLAS_CHECK (p, bad_index ());
+            return *p;
+        }
+
+    public:
+        class const_iterator1;
+        class iterator1;
+        class const_iterator2;
+        class iterator2;
+        typedef reverse_iterator_base1<const_iterator1> const_reverse_iterator1;
+        typedef reverse_iterator_base1<iterator1> reverse_iterator1;
+        typedef reverse_iterator_base2<const_iterator2> const_reverse_iterator2;
+        typedef reverse_iterator_base2<iterator2> reverse_iterator2;
+
+        // Element lookup
+        BOOST_UBLAS_INLINE
+        const_iterator1 find1 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (filled_);
+            if (rank == 1)
+                k = locate (i, j, true, direction);
+            return const_iterator1 (*this, rank, i, j, k);
+        }
+        BOOST_UBLAS_INLINE
+        iterator1 find1 (int rank, size_type i, size_type j, int direction = 1) {
+            array_size_type k (filled_);
+            if (rank == 1)
+                k = locate (i, j, true, direction);
+            return iterator1 (*this, rank, i, j, k);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 find2 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (filled_);
+            if (rank == 1)
+                k = locate (i, j, false, direction);
+            return const_iterator2 (*this, rank, i, j, k);
+        }
+        BOOST_UBLAS_INLINE
+        iterator2 find2 (int rank, size_type i, size_type j, int direction = 1) {
+            array_size_type k (filled_);
+            if (rank == 1)
+                k = locate (i, j, false, direction);
+            return iterator2 (*this, rank, i, j, k);
+        }
+
+
+        class const_iterator1:
+            public container_const_reference<block_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator1, value_type> {
+        public:
+            typedef typename block_compressed_matrix::value_type value_type;
+            typedef typename block_compressed_matrix::difference_type difference_type;
+            typedef typename block_compressed_matrix::const_reference reference;
+            typedef const typename block_compressed_matrix::pointer pointer;
+
+            typedef const_iterator2 dual_iterator_type;
+            typedef const_reverse_iterator2 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator1 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator1 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+            BOOST_UBLAS_INLINE
+            const_iterator1 (const iterator1 &it):
+                container_const_reference<self_type> (it ()), rank_ (it.rank_), i_ (it.i_), j_ (it.j_), k_ (it.k_) {}
+
+            // Arithmetic
+            // Within a block along the minor dimension the block is kept
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator ++ () {
+                ++ i_;
+                if (rank_ == 1 && ! (layout_type::fast_i () && i_ % (*this) ().minor_block () != 0))
+                    *this = (*this) ().find1 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator -- () {
+                const bool within = layout_type::fast_i () && i_ % (*this) ().minor_block () != 0;
+                -- i_;
+                if (rank_ == 1 && ! within)
+                    *this = (*this) ().find1 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().value_data_ [(*this) ().element_address (k_, layout_type::index_M (i_, j_), layout_type::index_m (i_, j_))];
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 begin () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), 0);
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 end () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), m.size2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rbegin () const {
+                return const_reverse_iterator2 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rend () const {
+                return const_reverse_iterator2 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator = (const const_iterator1 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator1 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator1 begin1 () const {
+            return find1 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator1 end1 () const {
+            return find1 (0, size1_, 0);
+        }
+
+        class iterator1:
+            public container_reference<block_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               iterator1, value_type> {
+        public:
+            typedef typename block_compressed_matrix::value_type value_type;
+            typedef typename block_compressed_matrix::difference_type difference_type;
+            typedef typename block_compressed_matrix::true_reference reference;
+            typedef typename block_compressed_matrix::pointer pointer;
+
+            typedef iterator2 dual_iterator_type;
+            typedef reverse_iterator2 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            iterator1 ():
+                container_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            iterator1 (self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            iterator1 &operator ++ () {
+                ++ i_;
+                if (rank_ == 1 && ! (layout_type::fast_i () && i_ % (*this) ().minor_block () != 0))
+                    *this = (*this) ().find1 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            iterator1 &operator -- () {
+                const bool within = layout_type::fast_i () && i_ % (*this) ().minor_block () != 0;
+                -- i_;
+                if (rank_ == 1 && ! within)
+                    *this = (*this) ().find1 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().value_data_ [(*this) ().element_address (k_, layout_type::index_M (i_, j_), layout_type::index_m (i_, j_))];
+                } else {
+                    return (*this) ().at_element (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            iterator2 begin () const {
+                self_type &m = (*this) ();
+                return m.find2 (1, index1 (), 0);
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            iterator2 end () const {
+                self_type &m = (*this) ();
+                return m.find2 (1, index1 (), m.size2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            reverse_iterator2 rbegin () const {
+                return reverse_iterator2 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            reverse_iterator2 rend () const {
+                return reverse_iterator2 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            iterator1 &operator = (const iterator1 &it) {
+                container_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const iterator1 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+
+            friend class const_iterator1;
+        };
+
+        BOOST_UBLAS_INLINE
+        iterator1 begin1 () {
+            return find1 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        iterator1 end1 () {
+            return find1 (0, size1_, 0);
+        }
+
+        class const_iterator2:
+            public container_const_reference<block_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator2, value_type> {
+        public:
+            typedef typename block_compressed_matrix::value_type value_type;
+            typedef typename block_compressed_matrix::difference_type difference_type;
+            typedef typename block_compressed_matrix::const_reference reference;
+            typedef const typename block_compressed_matrix::pointer pointer;
+
+            typedef const_iterator1 dual_iterator_type;
+            typedef const_reverse_iterator1 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator2 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator2 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+            BOOST_UBLAS_INLINE
+            const_iterator2 (const iterator2 &it):
+                container_const_reference<self_type> (it ()), rank_ (it.rank_), i_ (it.i_), j_ (it.j_), k_ (it.k_) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator ++ () {
+                ++ j_;
+                if (rank_ == 1 && ! (layout_type::fast_j () && j_ % (*this) ().minor_block () != 0))
+                    *this = (*this) ().find2 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator -- () {
+                const bool within = layout_type::fast_j () && j_ % (*this) ().minor_block () != 0;
+                -- j_;
+                if (rank_ == 1 && ! within)
+                    *this = (*this) ().find2 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().value_data_ [(*this) ().element_address (k_, layout_type::index_M (i_, j_), layout_type::index_m (i_, j_))];
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 begin () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, 0, index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 end () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, m.size1 (), index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rbegin () const {
+                return const_reverse_iterator1 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rend () const {
+                return const_reverse_iterator1 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator = (const const_iterator2 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator2 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator2 begin2 () const {
+            return find2 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 end2 () const {
+            return find2 (0, 0, size2_);
+        }
+
+        class iterator2:
+            public container_reference<block_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               iterator2, value_type> {
+        public:
+            typedef typename block_compressed_matrix::value_type value_type;
+            typedef typename block_compressed_matrix::difference_type difference_type;
+            typedef typename block_compressed_matrix::true_reference reference;
+            typedef typename block_compressed_matrix::pointer pointer;
+
+            typedef iterator1 dual_iterator_type;
+            typedef reverse_iterator1 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            iterator2 ():
+                container_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            iterator2 (self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            iterator2 &operator ++ () {
+                ++ j_;
+                if (rank_ == 1 && ! (layout_type::fast_j () && j_ % (*this) ().minor_block () != 0))
+                    *this = (*this) ().find2 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            iterator2 &operator -- () {
+                const bool within = layout_type::fast_j () && j_ % (*this) ().minor_block () != 0;
+                -- j_;
+                if (rank_ == 1 && ! within)
+                    *this = (*this) ().find2 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().value_data_ [(*this) ().element_address (k_, layout_type::index_M (i_, j_), layout_type::index_m (i_, j_))];
+                } else {
+                    return (*this) ().at_element (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            iterator1 begin () const {
+                self_type &m = (*this) ();
+                return m.find1 (1, 0, index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            iterator1 end () const {
+                self_type &m = (*this) ();
+                return m.find1 (1, m.size1 (), index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            reverse_iterator1 rbegin () const {
+                return reverse_iterator1 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            reverse_iterator1 rend () const {
+                return reverse_iterator1 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            iterator2 &operator = (const iterator2 &it) {
+                container_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const iterator2 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+
+            friend class const_iterator2;
+        };
+
+        BOOST_UBLAS_INLINE
+        iterator2 begin2 () {
+            return find2 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        iterator2 end2 () {
+            return find2 (0, 0, size2_);
+        }
+
+        // Reverse iterators
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rbegin1 () const {
+            return const_reverse_iterator1 (end1 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rend1 () const {
+            return const_reverse_iterator1 (begin1 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        reverse_iterator1 rbegin1 () {
+            return reverse_iterator1 (end1 ());
+        }
+        BOOST_UBLAS_INLINE
+        reverse_iterator1 rend1 () {
+            return reverse_iterator1 (begin1 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rbegin2 () const {
+            return const_reverse_iterator2 (end2 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rend2 () const {
+            return const_reverse_iterator2 (begin2 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        reverse_iterator2 rbegin2 () {
+            return reverse_iterator2 (end2 ());
+        }
+        BOOST_UBLAS_INLINE
+        reverse_iterator2 rend2 () {
+            return reverse_iterator2 (begin2 ());
+        }
+
+    private:
+        // An element by major and minor index
+        struct entry {
+            size_type major;
+            size_type minor;
+            value_type value;
+        };
+
+        BOOST_UBLAS_INLINE
+        size_type major_block () const {
+            return layout_type::size_M (block1 (), block2 ());
+        }
+        BOOST_UBLAS_INLINE
+        size_type minor_block () const {
+            return layout_type::size_m (block1 (), block2 ());
+        }
+        BOOST_UBLAS_INLINE
+        size_type lines () const {
+            return layout_type::size_M (size1_, size2_) / major_block ();
+        }
+        BOOST_UBLAS_INLINE
+        array_size_type element_address (array_size_type k, size_type element1, size_type element2) const {
+            return k * block_size () + (element1 % major_block ()) * minor_block () + element2 % minor_block ();
+        }
+
+        // The address of block b of line l or filled_ if it is not stored
+        BOOST_UBLAS_INLINE
+        array_size_type block_address (size_type l, size_type b) const {
+            if (l >= lines ())
+                return filled_;
+            const_subiterator_type it_begin (index2_data_.begin () + index1_data_ [l]);
+            const_subiterator_type it_end (index2_data_.begin () + index1_data_ [l + 1]);
+            const_subiterator_type it (detail::lower_bound (it_begin, it_end, b, std::less<size_type> ()));
+            if (it == it_end || *it != b)
+                return filled_;
+            return it - index2_data_.begin ();
+        }
+        array_size_type insert_block_address (size_type l, size_type b) {
+            BOOST_UBLAS_CHECK (l < lines () && b < layout_type::size_m (size1_, size2_) / minor_block (), bad_index ());
+            subiterator_type it_begin (index2_data_.begin () + index1_data_ [l]);
+            subiterator_type it_end (index2_data_.begin () + index1_data_ [l + 1]);
+            subiterator_type it (detail::lower_bound (it_begin, it_end, b, std::less<size_type> ()));
+            const array_size_type k = it - index2_data_.begin ();
+            if (it != it_end && *it == b)
+                return k;
+            if (filled_ >= capacity_)
+                reserve ((std::max) (2 * filled_, array_size_type (1)), true);
+            const size_type bs = block_size ();
+            std::copy_backward (index2_data_.begin () + k, index2_data_.begin () + filled_, index2_data_.begin () + filled_ + 1);
+            index2_data_ [k] = b;
+            std::copy_backward (value_data_.begin () + k * bs, value_data_.begin () + filled_ * bs, value_data_.begin () + (filled_ + 1) * bs);
+            std::fill (value_data_.begin () + k * bs, value_data_.begin () + (k + 1) * bs, value_type/*zero*/());
+            ++ filled_;
+            for (size_type m = l + 1; m <= lines (); ++ m)
+                ++ index1_data_ [m];
+            storage_invariants ();
+            return k;
+        }
+
+        // Moves (i, j) along i or along j in the given direction to the nearest stored element and
+        // returns the address of its block. The index moved is set to its size if there is none
+        // forward, and left as it is if there is none backward.
+        array_size_type locate (size_type &i, size_type &j, bool along_i, int direction) const {
+            size_type element1 (layout_type::index_M (i, j));
+            size_type element2 (layout_type::index_m (i, j));
+            const size_type size_M (layout_type::size_M (size1_, size2_)), size_m (layout_type::size_m (size1_, size2_));
+            const size_type bM = major_block (), bm = minor_block ();
+            array_size_type k (filled_);
+            if (along_i == layout_type::fast_i ()) {
+                // Along a line
+                if (element1 >= size_M) {
+                    element2 = size_m;
+                } else {
+                    const size_type l = element1 / bM;
+                    const_subiterator_type it_begin (index2_data_.begin () + index1_data_ [l]);
+                    const_subiterator_type it_end (index2_data_.begin () + index1_data_ [l + 1]);
+                    if (direction > 0) {
+                        const_subiterator_type it (element2 < size_m ?
+                                                   detail::lower_bound (it_begin, it_end, element2 / bm, std::less<size_type> ()) :
+                                                   it_end);
+                        if (it == it_end) {
+                            element2 = size_m;
+                        } else {
+                            element2 = (std::max) (element2, *it * bm);
+                            k = it - index2_data_.begin ();
+                        }
+                    } else {
+                        const_subiterator_type it (std::upper_bound (it_begin, it_end, element2 / bm));
+                        if (it != it_begin) {
+                            -- it;
+                            element2 = (std::min) (element2, *it * bm + bm - 1);
+                            k = it - index2_data_.begin ();
+                        }
+                    }
+                }
+            } else {
+                // Across the lines
+                if (element2 >= size_m)
+                    element1 = size_M;
+                while (element1 < size_M) {
+                    k = block_address (element1 / bM, element2 / bm);
+                    if (k != filled_)
+                        break;
+                    if (direction > 0)
+                        element1 = (element1 / bM + 1) * bM;
+                    else if (element1 < bM)
+                        break;
+                    else
+                        element1 = element1 / bM * bM - 1;
+                }
+            }
+            i = layout_type::index_M (element1, element2);
+            j = layout_type::index_m (element1, element2);
+            return k;
+        }
+
+        // The non zero elements of an expression, of a compressed matrix or of a coordinate matrix
+        template<class E>
+        void gather (const matrix_expression<E> &e, std::vector<entry> &entries) const {
+            typename E::const_iterator1 it1 (e ().begin1 ());
+            typename E::const_iterator1 it1_end (e ().end1 ());
+            while (it1 != it1_end) {
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+                typename E::const_iterator2 it2 (it1.begin ());
+                typename E::const_iterator2 it2_end (it1.end ());
+#else
+                typename E::const_iterator2 it2 (boost::numeric::ublas::begin (it1, iterator1_tag ()));
+                typename E::const_iterator2 it2_end (boost::numeric::ublas::end (it1, iterator1_tag ()));
+#endif
+                while (it2 != it2_end) {
+                    gather (it2.index1 (), it2.index2 (), *it2, entries);
+                    ++ it2;
+                }
+                ++ it1;
+            }
+        }
+        template<class T2, class L2, std::size_t IB2, class IA2, class TA2>
+        void gather (const compressed_matrix<T2, L2, IB2, IA2, TA2> &e, std::vector<entry> &entries) const {
+            typedef typename compressed_matrix<T2, L2, IB2, IA2, TA2>::array_size_type source_size_type;
+            entries.reserve (e.nnz ());
+            const source_size_type lines = e.filled1 () > 0 ? e.filled1 () - 1 : 0;
+            for (source_size_type l = 0; l < lines; ++ l) {
+                for (source_size_type k = e.index1_data () [l] - IB2; k < e.index1_data () [l + 1] - IB2; ++ k) {
+                    const size_type minor = e.index2_data () [k] - IB2;
+                    gather (L2::index_M (l, minor), L2::index_m (l, minor), e.value_data () [k], entries);
+                }
+            }
+        }
+        template<class T2, class L2, std::size_t IB2, class IA2, class TA2>
+        void gather (const coordinate_matrix<T2, L2, IB2, IA2, TA2> &e, std::vector<entry> &entries) const {
+            typedef typename coordinate_matrix<T2, L2, IB2, IA2, TA2>::array_size_type source_size_type;
+            entries.reserve (e.nnz ());
+            for (source_size_type k = 0; k < e.nnz (); ++ k) {
+                const size_type major = e.index1_data () [k] - IB2, minor = e.index2_data () [k] - IB2;
+                gather (L2::index_M (major, minor), L2::index_m (major, minor), e.value_data () [k], entries);
+            }
+        }
+        BOOST_UBLAS_INLINE
+        void gather (size_type i, size_type j, const value_type &t, std::vector<entry> &entries) const {
+            if (t == value_type/*zero*/())
+                return;
+            entry e;
+            e.major = layout_type::index_M (i, j);
+            e.minor = layout_type::index_m (i, j);
+            e.value = t;
+            entries.push_back (e);
+        }
+
+        // Rebuilds the storage from the elements, the values of repeated elements being summed.
+        // The elements are sorted into their lines by counting, the blocks of a line are marked
+        // by the last line met.
+        void build (const std::vector<entry> &entries) {
+            BOOST_UBLAS_CHECK (size1_ % block1 () == 0 && size2_ % block2 () == 0, bad_size ());
+            const size_type bM = major_block (), bm = minor_block (), bs = block_size ();
+            const size_type n_lines = lines (), n_blocks = layout_type::size_m (size1_, size2_) / bm;
+            std::vector<array_size_type> first (n_lines + 1, 0);
+            for (array_size_type p = 0; p < entries.size (); ++ p)
+                ++ first [entries [p].major / bM + 1];
+            for (size_type l = 0; l < n_lines; ++ l)
+                first [l + 1] += first [l];
+            std::vector<array_size_type> order (entries.size ());
+            std::vector<array_size_type> next (first.begin (), first.end () - 1);
+            for (array_size_type p = 0; p < entries.size (); ++ p)
+                order [next [entries [p].major / bM] ++] = p;
+
+            std::vector<size_type> mark (n_blocks, n_lines);
+            array_size_type blocks = 0;
+            for (size_type l = 0; l < n_lines; ++ l)
+                for (array_size_type p = first [l]; p < first [l + 1]; ++ p) {
+                    const size_type b = entries [order [p]].minor / bm;
+                    if (mark [b] != l)
+                        mark [b] = l, ++ blocks;
+                }
+            reserve (blocks, false);
+            std::fill (value_data_.begin (), value_data_.begin () + blocks * bs, value_type/*zero*/());
+            std::fill (mark.begin (), mark.end (), n_lines);
+            std::vector<array_size_type> address (n_blocks);
+            for (size_type l = 0; l < n_lines; ++ l) {
+                const array_size_type line_first = filled_;
+                index1_data_ [l] = line_first;
+                for (array_size_type p = first [l]; p < first [l + 1]; ++ p) {
+                    const size_type b = entries [order [p]].minor / bm;
+                    if (mark [b] != l)
+                        mark [b] = l, index2_data_ [filled_ ++] = b;
+                }
+                std::sort (index2_data_.begin () + line_first, index2_data_.begin () + filled_);
+                for (array_size_type k = line_first; k < filled_; ++ k)
+                    address [index2_data_ [k]] = k;
+                for (array_size_type p = first [l]; p < first [l + 1]; ++ p) {
+                    const entry &e = entries [order [p]];
+                    value_data_ [element_address (address [e.minor / bm], e.major, e.minor)] += e.value;
+                }
+            }
+            index1_data_ [n_lines] = filled_;
+            storage_invariants ();
+        }
+
+        void storage_invariants () const {
+            BOOST_UBLAS_CHECK (block1 () > 0 && block2 () > 0, internal_logic ());
+            BOOST_UBLAS_CHECK (lines () + 1 == index1_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (capacity_ == index2_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (capacity_ * block_size () == value_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (filled_ <= capacity_, internal_logic ());
+            BOOST_UBLAS_CHECK (index1_data_ [lines ()] == filled_, internal_logic ());
+        }
+
+        size_type size1_;
+        size_type size2_;
+        size_type block1_;
+        size_type block2_;
+        array_size_type capacity_;
+        array_size_type filled_;
+        index_array_type index1_data_;
+        index_array_type index2_data_;
+        value_array_type value_data_;
+        static const value_type zero_;
+
+        friend class iterator1;
+        friend class iterator2;
+        friend class const_iterator1;
+        friend class const_iterator2;
+    };
+
+    template<class T, std::size_t BR, std::size_t BC, class L, class IA, class TA>
+    const typename block_compressed_matrix<T, BR, BC, L, IA, TA>::value_type block_compressed_matrix<T, BR, BC, L, IA, TA>::zero_ = value_type/*zero*/();
+
+    namespace detail {
+        template<class T, std::size_t BR, std::size_t BC, class L, class IA, class TA>
+        struct matrix_vector_kernel_traits<block_compressed_matrix<T, BR, BC, L, IA, TA> > {
+            static const bool value = true;
+        };
+        template<class T, std::size_t BR, std::size_t BC, class L, class IA, class TA>
+        struct matrix_matrix_kernel_traits<block_compressed_matrix<T, BR, BC, L, IA, TA> > {
+            static const bool value = true;
+        };
+
+        // The kernels below read the block size through block1 () and block2 (), which are
+        // constants when the block size is fixed at compile time, so that the loops over a block
+        // are unrolled and vectorized.
+
+        // y += alpha * a * x for the lines of blocks [first, last) of a row major a, a block row
+        // at a time, each row of it accumulated in a register
+        template<class M, class T>
+        void block_compressed_axpy_rows (const M &a, const T *x, T *y, const T &alpha,
+                                         std::size_t first, std::size_t last) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type br = a.block1 (), bc = a.block2 (), bs = br * bc;
+            const T *values = &a.value_data () [0];
+            for (size_type l = first; l < last; ++ l) {
+                const array_size_type k_first = a.index1_data () [l], k_last = a.index1_data () [l + 1];
+                for (size_type r = 0; r < br; ++ r) {
+                    T t = T/*zero*/();
+                    for (array_size_type k = k_first; k < k_last; ++ k) {
+                        const T *v = values + k * bs + r * bc;
+                        const T *xj = x + a.index2_data () [k] * bc;
+                        for (size_type c = 0; c < bc; ++ c)
+                            t += v [c] * xj [c];
+                    }
+                    y [l * br + r] += alpha * t;
+                }
+            }
+        }
+        // The same for a column major a, a block column at a time
+        template<class M, class T>
+        void block_compressed_axpy_columns (const M &a, const T *x, T *y, const T &alpha) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type br = a.block1 (), bc = a.block2 (), bs = br * bc;
+            const size_type lines = a.index1_data ().size () - 1;
+            const T *values = &a.value_data () [0];
+            for (size_type l = 0; l < lines; ++ l) {
+                for (array_size_type k = a.index1_data () [l]; k < a.index1_data () [l + 1]; ++ k) {
+                    T *yi = y + a.index2_data () [k] * br;
+                    for (size_type c = 0; c < bc; ++ c) {
+                        const T t (alpha * x [l * bc + c]);
+                        const T *v = values + k * bs + c * br;
+                        for (size_type r = 0; r < br; ++ r)
+                            yi [r] += v [r] * t;
+                    }
+                }
+            }
+        }
+
+        // C += alpha * a * B for the lines of blocks [first, last) of a row major a. Rows of B are
+        // added to the rows of C, which are vectorized along when B and C are row major.
+        template<class M, class T>
+        void block_compressed_prod_rows (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                         T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha,
+                                         std::size_t first, std::size_t last) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type br = a.block1 (), bc = a.block2 (), bs = br * bc;
+            const T *values = &a.value_data () [0];
+            for (size_type l = first; l < last; ++ l) {
+                for (size_type r = 0; r < br; ++ r) {
+                    T *ci = c + std::ptrdiff_t (l * br + r) * c1;
+                    for (array_size_type k = a.index1_data () [l]; k < a.index1_data () [l + 1]; ++ k) {
+                        const T *v = values + k * bs + r * bc;
+                        const T *bj = b + std::ptrdiff_t (a.index2_data () [k] * bc) * b1;
+                        for (size_type q = 0; q < bc; ++ q, bj += b1) {
+                            if (v [q] == T/*zero*/())
+                                continue;
+                            const T t (alpha * v [q]);
+                            if (b2 == 1 && c2 == 1) {
+                                for (size_type p = 0; p < n; ++ p)
+                                    ci [p] += t * bj [p];
+                            } else {
+                                for (size_type p = 0; p < n; ++ p)
+                                    ci [p * c2] += t * bj [p * b2];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        // The same for a column major a
+        template<class M, class T>
+        void block_compressed_prod_columns (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                            T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type br = a.block1 (), bc = a.block2 (), bs = br * bc;
+            const size_type lines = a.index1_data ().size () - 1;
+            const T *values = &a.value_data () [0];
+            for (size_type l = 0; l < lines; ++ l) {
+                for (array_size_type k = a.index1_data () [l]; k < a.index1_data () [l + 1]; ++ k) {
+                    const size_type i0 = a.index2_data () [k] * br;
+                    for (size_type q = 0; q < bc; ++ q) {
+                        const T *bj = b + std::ptrdiff_t (l * bc + q) * b1;
+                        const T *v = values + k * bs + q * br;
+                        for (size_type r = 0; r < br; ++ r) {
+                            if (v [r] == T/*zero*/())
+                                continue;
+                            const T t (alpha * v [r]);
+                            T *ci = c + std::ptrdiff_t (i0 + r) * c1;
+                            if (b2 == 1 && c2 == 1) {
+                                for (size_type p = 0; p < n; ++ p)
+                                    ci [p] += t * bj [p];
+                            } else {
+                                for (size_type p = 0; p < n; ++ p)
+                                    ci [p * c2] += t * bj [p * b2];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Row major matrices share chunks of block rows between OpenMP threads, column major
+        // matrices scatter into the whole of the result and are not shared
+        template<class M, class T>
+        void block_compressed_axpy (const M &a, const T *x, T *y, const T &alpha, row_major_tag) {
+            typedef typename M::size_type size_type;
+            const size_type lines = a.index1_data ().size () - 1;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (lines > chunk && a.nnz () >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((lines + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long c = 0; c < chunks; ++ c)
+                    block_compressed_axpy_rows (a, x, y, alpha, size_type (c) * chunk, (std::min) (size_type (c + 1) * chunk, lines));
+                return;
+            }
+#endif
+            block_compressed_axpy_rows (a, x, y, alpha, 0, lines);
+        }
+        template<class M, class T>
+        void block_compressed_axpy (const M &a, const T *x, T *y, const T &alpha, column_major_tag) {
+            block_compressed_axpy_columns (a, x, y, alpha);
+        }
+        template<class M, class T>
+        void block_compressed_prod (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                    T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha, row_major_tag) {
+            typedef typename M::size_type size_type;
+            const size_type lines = a.index1_data ().size () - 1;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (lines > chunk && a.nnz () * n >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((lines + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long k = 0; k < chunks; ++ k)
+                    block_compressed_prod_rows (a, b, b1, b2, c, c1, c2, n, alpha,
+                                                size_type (k) * chunk, (std::min) (size_type (k + 1) * chunk, lines));
+                return;
+            }
+#endif
+            block_compressed_prod_rows (a, b, b1, b2, c, c1, c2, n, alpha, 0, lines);
+        }
+        template<class M, class T>
+        void block_compressed_prod (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                    T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha, column_major_tag) {
+            block_compressed_prod_columns (a, b, b1, b2, c, c1, c2, n, alpha);
+        }
+    }
+
+    // Matrix vector product kernel
+    template<class T, std::size_t BR, std::size_t BC, class L, class IA, class TA>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const block_compressed_matrix<T, BR, BC, L, IA, TA> &m, const T *x, T *y, const T &alpha) {
+        if (m.nnz_blocks () == 0)
+            return;
+        detail::block_compressed_axpy (m, x, y, alpha, typename L::orientation_category ());
+    }
+
+    // Matrix matrix product kernel, e2 and m being dense blocks, see matrix_matrix_kernel_traits
+    template<class T, std::size_t BR, std::size_t BC, class L, class IA, class TA, class E2, class M>
+    BOOST_UBLAS_INLINE
+    void matrix_matrix_axpy (const block_compressed_matrix<T, BR, BC, L, IA, TA> &e1, const E2 &e2, M &m, const T &alpha) {
+        BOOST_UBLAS_CHECK (m.size1 () == e1.size1 () && e1.size2 () == e2.size1 () && m.size2 () == e2.size2 (), bad_size ());
+        if (e1.nnz_blocks () == 0 || m.size2 () == 0)
+            return;
+        std::ptrdiff_t b1, b2, c1, c2;
+        detail::dense_block_strides (e2, b1, b2);
+        detail::dense_block_strides (m, c1, c2);
+        detail::block_compressed_prod (e1, &e2 (0, 0), b1, b2, &m (0, 0), c1, c2, m.size2 (), alpha, typename L::orientation_category ());
+    }
+
+
+    // Sliced ELLPACK sparse matrix class (SELL-C-sigma)
+    // The rows are grouped into slices of C rows, each slice being stored as a dense column
+    // major C by w block of values and column indices, w being the length of its longest row.
+    // Shorter rows are padded with zeros, so that products run over all the C rows of a slice
+    // at once. Before slicing, the rows of each window of sigma rows are sorted by decreasing
+    // length to reduce the padding. The matrix is row major and read only, built from another
+    // matrix, usually a compressed_matrix.
+    template<class T, std::size_t C, class IA, class TA>
+    class sliced_ellpack_matrix:
+        public matrix_container<sliced_ellpack_matrix<T, C, IA, TA> > {
+
+        typedef const T *const_pointer;
+        typedef sliced_ellpack_matrix<T, C, IA, TA> self_type;
+        BOOST_STATIC_ASSERT (C > 0);
+    public:
+#ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
+        using matrix_container<self_type>::operator ();
+#endif
+        typedef typename IA::value_type size_type;
+        typedef typename IA::size_type array_size_type;
+        typedef typename IA::difference_type difference_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef const T &reference;
+        typedef IA index_array_type;
+        typedef TA value_array_type;
+        typedef const matrix_reference<const self_type> const_closure_type;
+        typedef matrix_reference<self_type> closure_type;
+        typedef compressed_vector<T, 0, IA, TA> vector_temporary_type;
+        typedef compressed_matrix<T, row_major, 0, IA, TA> matrix_temporary_type;
+        typedef sparse_tag storage_category;
+        typedef row_major_tag orientation_category;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix ():
+            matrix_container<self_type> (),
+            size1_ (0), size2_ (0), sigma_ (1), nnz_ (0),
+            slice_data_ (1, 0), row_data_ (0), length_data_ (0), position_data_ (0),
+            index2_data_ (0), value_data_ (0) {
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix (const sliced_ellpack_matrix &m):
+            matrix_container<self_type> (),
+            size1_ (m.size1_), size2_ (m.size2_), sigma_ (m.sigma_), nnz_ (m.nnz_),
+            slice_data_ (m.slice_data_), row_data_ (m.row_data_), length_data_ (m.length_data_),
+            position_data_ (m.position_data_), index2_data_ (m.index2_data_), value_data_ (m.value_data_) {
+            storage_invariants ();
+        }
+        template<class T2, std::size_t IB2, class IA2, class TA2>
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix (const compressed_matrix<T2, row_major, IB2, IA2, TA2> &m, size_type sigma = 1):
+            matrix_container<self_type> (),
+            size1_ (0), size2_ (0), sigma_ (sigma), nnz_ (0),
+            slice_data_ (1, 0), row_data_ (0), length_data_ (0), position_data_ (0),
+            index2_data_ (0), value_data_ (0) {
+            build (m);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix (const matrix_expression<AE> &ae, size_type sigma = 1):
+            matrix_container<self_type> (),
+            size1_ (0), size2_ (0), sigma_ (sigma), nnz_ (0),
+            slice_data_ (1, 0), row_data_ (0), length_data_ (0), position_data_ (0),
+            index2_data_ (0), value_data_ (0) {
+            build (matrix_temporary_type (ae));
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        BOOST_UBLAS_INLINE
+        static size_type chunk_size () {
+            return C;
+        }
+        BOOST_UBLAS_INLINE
+        size_type sigma () const {
+            return sigma_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type slices () const {
+            return size_type (slice_data_.size () - 1);
+        }
+        // The number of elements of the matrix, not counting the padding
+        BOOST_UBLAS_INLINE
+        size_type nnz () const {
+            return nnz_;
+        }
+        // The number of stored elements, padding included
+        BOOST_UBLAS_INLINE
+        size_type nnz_capacity () const {
+            return size_type (slice_data_ [slices ()]);
+        }
+        // The number of zeros stored to pad the rows of the slices
+        BOOST_UBLAS_INLINE
+        size_type padding () const {
+            return nnz_capacity () - nnz_;
+        }
+
+        // Storage accessors
+        BOOST_UBLAS_INLINE
+        const index_array_type &slice_data () const {
+            return slice_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &row_data () const {
+            return row_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &length_data () const {
+            return length_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index2_data () const {
+            return index2_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &value_data () const {
+            return value_data_;
+        }
+
+        // Element support
+        BOOST_UBLAS_INLINE
+        const_pointer find_element (size_type i, size_type j) const {
+            BOOST_UBLAS_CHECK (i < size1_, bad_index ());
+            BOOST_UBLAS_CHECK (j < size2_, bad_index ());
+            const array_size_type k = find_address (i, j);
+            if (k == nnz_capacity ())
+                return 0;
+            return &value_data_ [k];
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type i, size_type j) const {
+            const_pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return zero_;
+        }
+
+        // Assignment
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix &operator = (const sliced_ellpack_matrix &m) {
+            if (this != &m) {
+                size1_ = m.size1_;
+                size2_ = m.size2_;
+                sigma_ = m.sigma_;
+                nnz_ = m.nnz_;
+                slice_data_ = m.slice_data_;
+                row_data_ = m.row_data_;
+                length_data_ = m.length_data_;
+                position_data_ = m.position_data_;
+                index2_data_ = m.index2_data_;
+                value_data_ = m.value_data_;
+            }
+            storage_invariants ();
+            return *this;
+        }
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix &assign_temporary (sliced_ellpack_matrix &m) {
+            swap (m);
+            return *this;
+        }
+        // The window of sorted rows is kept
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        sliced_ellpack_matrix &operator = (const matrix_expression<AE> &ae) {
+            self_type temporary (ae, sigma_);
+            return assign_temporary (temporary);
+        }
+
+        // Swapping
+        BOOST_UBLAS_INLINE
+        void swap (sliced_ellpack_matrix &m) {
+            if (this != &m) {
+                std::swap (size1_, m.size1_);
+                std::swap (size2_, m.size2_);
+                std::swap (sigma_, m.sigma_);
+                std::swap (nnz_, m.nnz_);
+                slice_data_.swap (m.slice_data_);
+                row_data_.swap (m.row_data_);
+                length_data_.swap (m.length_data_);
+                position_data_.swap (m.position_data_);
+                index2_data_.swap (m.index2_data_);
+                value_data_.swap (m.value_data_);
+            }
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        friend void swap (sliced_ellpack_matrix &m1, sliced_ellpack_matrix &m2) {
+            m1.swap (m2);
+        }
+
+        // Iterator types
+    public:
+        class const_iterator1;
+        class const_iterator2;
+        typedef const_iterator1 iterator1;
+        typedef const_iterator2 iterator2;
+        typedef reverse_iterator_base1<const_iterator1> const_reverse_iterator1;
+        typedef reverse_iterator_base2<const_iterator2> const_reverse_iterator2;
+        typedef const_reverse_iterator1 reverse_iterator1;
+        typedef const_reverse_iterator2 reverse_iterator2;
+
+        // Element lookup
+        BOOST_UBLAS_INLINE
+        const_iterator1 find1 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (nnz_capacity ());
+            if (rank == 1)
+                k = locate (i, j, true, direction);
+            return const_iterator1 (*this, rank, i, j, k);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 find2 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (nnz_capacity ());
+            if (rank == 1)
+                k = locate (i, j, false, direction);
+            return const_iterator2 (*this, rank, i, j, k);
+        }
+
+
+        class const_iterator1:
+            public container_const_reference<sliced_ellpack_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator1, value_type> {
+        public:
+            typedef typename sliced_ellpack_matrix::value_type value_type;
+            typedef typename sliced_ellpack_matrix::difference_type difference_type;
+            typedef typename sliced_ellpack_matrix::const_reference reference;
+            typedef typename sliced_ellpack_matrix::const_pointer pointer;
+
+            typedef const_iterator2 dual_iterator_type;
+            typedef const_reverse_iterator2 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator1 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator1 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator ++ () {
+                ++ i_;
+                if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator -- () {
+                -- i_;
+                if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().value_data_ [k_];
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 begin () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), 0);
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 end () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), m.size2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rbegin () const {
+                return const_reverse_iterator2 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rend () const {
+                return const_reverse_iterator2 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator = (const const_iterator1 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator1 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator1 begin1 () const {
+            return find1 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator1 end1 () const {
+            return find1 (0, size1_, 0);
+        }
+
+        class const_iterator2:
+            public container_const_reference<sliced_ellpack_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator2, value_type> {
+        public:
+            typedef typename sliced_ellpack_matrix::value_type value_type;
+            typedef typename sliced_ellpack_matrix::difference_type difference_type;
+            typedef typename sliced_ellpack_matrix::const_reference reference;
+            typedef typename sliced_ellpack_matrix::const_pointer pointer;
+
+            typedef const_iterator1 dual_iterator_type;
+            typedef const_reverse_iterator1 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator2 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator2 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator ++ () {
+                ++ j_;
+                if (rank_ == 1)
+                    *this = (*this) ().find2 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator -- () {
+                -- j_;
+                if (rank_ == 1)
+                    *this = (*this) ().find2 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().value_data_ [k_];
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 begin () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, 0, index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 end () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, m.size1 (), index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rbegin () const {
+                return const_reverse_iterator1 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rend () const {
+                return const_reverse_iterator1 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator = (const const_iterator2 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator2 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator2 begin2 () const {
+            return find2 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 end2 () const {
+            return find2 (0, 0, size2_);
+        }
+
+        // Reverse iterators
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rbegin1 () const {
+            return const_reverse_iterator1 (end1 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rend1 () const {
+            return const_reverse_iterator1 (begin1 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rbegin2 () const {
+            return const_reverse_iterator2 (end2 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rend2 () const {
+            return const_reverse_iterator2 (begin2 ());
+        }
+
+    private:
+        // The address of the q-th element of the row in slot p
+        BOOST_UBLAS_INLINE
+        array_size_type element_address (size_type p, size_type q) const {
+            return slice_data_ [p / C] + array_size_type (q) * C + p % C;
+        }
+
+        // The position among the elements of row i of the first one of column not less than j,
+        // or the length of the row if there is none
+        size_type lower_position (size_type i, size_type j) const {
+            const size_type p = position_data_ [i];
+            size_type first = 0, last = length_data_ [p];
+            while (first < last) {
+                const size_type middle = first + (last - first) / 2;
+                if (index2_data_ [element_address (p, middle)] < j)
+                    first = middle + 1;
+                else
+                    last = middle;
+            }
+            return first;
+        }
+
+        // The address of the element (i, j), or nnz_capacity () if it is not stored
+        array_size_type find_address (size_type i, size_type j) const {
+            const size_type p = position_data_ [i];
+            const size_type q = lower_position (i, j);
+            if (q < length_data_ [p] && index2_data_ [element_address (p, q)] == j)
+                return element_address (p, q);
+            return nnz_capacity ();
+        }
+
+        // Moves (i, j) along i or along j in the given direction to the nearest stored element and
+        // returns its address. The index moved is set to its size if there is none forward, and
+        // left as it is if there is none backward.
+        array_size_type locate (size_type &i, size_type &j, bool along_i, int direction) const {
+            array_size_type k (nnz_capacity ());
+            if (! along_i) {
+                // Along a row
+                if (i >= size1_) {
+                    j = size2_;
+                } else if (direction > 0) {
+                    const size_type q = j < size2_ ? lower_position (i, j) : length_data_ [position_data_ [i]];
+                    if (q == length_data_ [position_data_ [i]]) {
+                        j = size2_;
+                    } else {
+                        k = element_address (position_data_ [i], q);
+                        j = index2_data_ [k];
+                    }
+                } else {
+                    const size_type q = j < size2_ ? lower_position (i, j + 1) : length_data_ [position_data_ [i]];
+                    if (q > 0) {
+                        k = element_address (position_data_ [i], q - 1);
+                        j = index2_data_ [k];
+                    }
+                }
+            } else {
+                // Across the rows
+                if (j >= size2_)
+                    i = size1_;
+                while (i < size1_) {
+                    k = find_address (i, j);
+                    if (k != nnz_capacity ())
+                        break;
+                    if (direction > 0)
+                        ++ i;
+                    else if (i == 0)
+                        break;
+                    else
+                        -- i;
+                }
+            }
+            return k;
+        }
+
+        // Slices the rows of a row major compressed matrix, sorted by decreasing length within
+        // windows of sigma rows. Padding repeats the last column index of a row with a zero
+        // value, so that products read the vector where the row already did.
+        template<class T2, std::size_t IB2, class IA2, class TA2>
+        void build (const compressed_matrix<T2, row_major, IB2, IA2, TA2> &m) {
+            typedef typename compressed_matrix<T2, row_major, IB2, IA2, TA2>::array_size_type source_size_type;
+            BOOST_UBLAS_CHECK (sigma_ > 0, bad_argument ());
+            size1_ = m.size1 ();
+            size2_ = m.size2 ();
+            const size_type n_slices = (size1_ + C - 1) / C, n_slots = n_slices * C;
+            const source_size_type lines = m.filled1 () > 0 ? m.filled1 () - 1 : 0;
+            std::vector<source_size_type> first (size1_, 0);
+            index_array_type length (n_slots, 0);
+            nnz_ = 0;
+            for (source_size_type l = 0; l < lines && l < size1_; ++ l) {
+                first [l] = m.index1_data () [l] - IB2;
+                length [l] = size_type (m.index1_data () [l + 1] - m.index1_data () [l]);
+                nnz_ += length [l];
+            }
+
+            // Rows by decreasing length within each window, stably
+            index_array_type row (n_slots);
+            for (size_type p = 0; p < n_slots; ++ p)
+                row [p] = p;
+            if (sigma_ > 1) {
+                for (size_type w = 0; w < size1_; w += sigma_)
+                    std::stable_sort (row.begin () + w, row.begin () + (std::min) (w + sigma_, size1_),
+                                      longer_row (length));
+            }
+            index_array_type position (size1_);
+            row_data_.resize (n_slots);
+            length_data_.resize (n_slots);
+            for (size_type p = 0; p < n_slots; ++ p) {
+                row_data_ [p] = p < size1_ ? row [p] : size1_;
+                length_data_ [p] = p < size1_ ? length [row [p]] : 0;
+                if (p < size1_)
+                    position [row [p]] = p;
+            }
+            position_data_.swap (position);
+
+            index_array_type slices (n_slices + 1);
+            slices [0] = 0;
+            for (size_type s = 0; s < n_slices; ++ s) {
+                size_type width = 0;
+                for (size_type r = 0; r < C; ++ r)
+                    width = (std::max) (width, size_type (length_data_ [s * C + r]));
+                slices [s + 1] = slices [s] + width * C;
+            }
+            slice_data_.swap (slices);
+
+            const array_size_type capacity = slice_data_ [n_slices];
+            index2_data_.resize (capacity);
+            value_data_.resize (capacity);
+            for (size_type p = 0; p < n_slots; ++ p) {
+                const size_type s = p / C, width = size_type (slice_data_ [s + 1] - slice_data_ [s]) / C;
+                size_type column = 0;
+                for (size_type q = 0; q < width; ++ q) {
+                    const array_size_type k = element_address (p, q);
+                    if (q < length_data_ [p]) {
+                        const source_size_type source = first [row_data_ [p]] + q;
+                        column = size_type (m.index2_data () [source] - IB2);
+                        index2_data_ [k] = column;
+                        value_data_ [k] = m.value_data () [source];
+                    } else {
+                        index2_data_ [k] = column;
+                        value_data_ [k] = value_type/*zero*/();
+                    }
+                }
+            }
+            storage_invariants ();
+        }
+
+        struct longer_row {
+            longer_row (const index_array_type &length): length_ (length) {}
+            bool operator () (size_type r1, size_type r2) const {
+                return length_ [r1] > length_ [r2];
+            }
+            const index_array_type &length_;
+        };
+
+        void storage_invariants () const {
+            BOOST_UBLAS_CHECK (sigma_ > 0, internal_logic ());
+            BOOST_UBLAS_CHECK (slice_data_.size () == (size1_ + C - 1) / C + 1, internal_logic ());
+            BOOST_UBLAS_CHECK (row_data_.size () == slices () * C, internal_logic ());
+            BOOST_UBLAS_CHECK (length_data_.size () == slices () * C, internal_logic ());
+            BOOST_UBLAS_CHECK (position_data_.size () == size1_, internal_logic ());
+            BOOST_UBLAS_CHECK (index2_data_.size () == nnz_capacity (), internal_logic ());
+            BOOST_UBLAS_CHECK (value_data_.size () == nnz_capacity (), internal_logic ());
+            BOOST_UBLAS_CHECK (nnz_ <= nnz_capacity (), internal_logic ());
+        }
+
+        size_type size1_;
+        size_type size2_;
+        size_type sigma_;
+        size_type nnz_;
+        index_array_type slice_data_;
+        index_array_type row_data_;
+        index_array_type length_data_;
+        index_array_type position_data_;
+        index_array_type index2_data_;
+        value_array_type value_data_;
+        static const value_type zero_;
+
+        friend class const_iterator1;
+        friend class const_iterator2;
+    };
+
+    template<class T, std::size_t C, class IA, class TA>
+    const typename sliced_ellpack_matrix<T, C, IA, TA>::value_type sliced_ellpack_matrix<T, C, IA, TA>::zero_ = value_type/*zero*/();
+
+    namespace detail {
+        template<class T, std::size_t C, class IA, class TA>
+        struct matrix_vector_kernel_traits<sliced_ellpack_matrix<T, C, IA, TA> > {
+            static const bool value = true;
+        };
+        template<class T, std::size_t C, class IA, class TA>
+        struct matrix_matrix_kernel_traits<sliced_ellpack_matrix<T, C, IA, TA> > {
+            static const bool value = true;
+        };
+
+        // y += alpha * a * x for the slices [first, last), the C rows of a slice being accumulated
+        // together, column of the slice after column, in a loop of constant length C
+        template<class T, std::size_t C, class IA, class TA>
+        void sliced_ellpack_axpy_slices (const sliced_ellpack_matrix<T, C, IA, TA> &a, const T *x, T *y, const T &alpha,
+                                         std::size_t first, std::size_t last) {
+            typedef typename IA::value_type size_type;
+            typedef typename IA::size_type array_size_type;
+            const T *values = &a.value_data () [0];
+            const size_type *columns = &a.index2_data () [0];
+            const size_type size1 = a.size1 ();
+            T t [C];
+            for (size_type s = first; s < last; ++ s) {
+                for (size_type r = 0; r < C; ++ r)
+                    t [r] = T/*zero*/();
+                for (array_size_type k = a.slice_data () [s]; k < a.slice_data () [s + 1]; k += C) {
+                    const T *v = values + k;
+                    const size_type *j = columns + k;
+                    for (size_type r = 0; r < C; ++ r)
+                        t [r] += v [r] * x [j [r]];
+                }
+                for (size_type r = 0; r < C; ++ r) {
+                    const size_type i = a.row_data () [s * C + r];
+                    if (i < size1)
+                        y [i] += alpha * t [r];
+                }
+            }
+        }
+
+        // C += alpha * a * B for the slices [first, last). Rows of B are added to the rows of C,
+        // which are vectorized along when B and C are row major. Padding is skipped.
+        template<class M, class T>
+        void sliced_ellpack_prod_slices (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                         T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha,
+                                         std::size_t first, std::size_t last) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const size_type C = M::chunk_size ();
+            for (size_type p = first * C; p < last * C; ++ p) {
+                const size_type i = a.row_data () [p];
+                if (i >= a.size1 ())
+                    continue;
+                T *ci = c + std::ptrdiff_t (i) * c1;
+                const array_size_type k_first = a.slice_data () [p / C] + p % C;
+                for (size_type q = 0; q < a.length_data () [p]; ++ q) {
+                    const array_size_type k = k_first + array_size_type (q) * C;
+                    const T &v = a.value_data () [k];
+                    if (v == T/*zero*/())
+                        continue;
+                    const T t (alpha * v);
+                    const T *bj = b + std::ptrdiff_t (a.index2_data () [k]) * b1;
+                    if (b2 == 1 && c2 == 1) {
+                        for (size_type l = 0; l < n; ++ l)
+                            ci [l] += t * bj [l];
+                    } else {
+                        for (size_type l = 0; l < n; ++ l)
+                            ci [l * c2] += t * bj [l * b2];
+                    }
+                }
+            }
+        }
+
+        // Chunks of slices are shared between OpenMP threads, each row being in one slice only
+        template<class M, class T>
+        void sliced_ellpack_axpy (const M &a, const T *x, T *y, const T &alpha) {
+            typedef typename M::size_type size_type;
+            const size_type slices = a.slices ();
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (slices > chunk && a.nnz_capacity () >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((slices + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long c = 0; c < chunks; ++ c)
+                    sliced_ellpack_axpy_slices (a, x, y, alpha, size_type (c) * chunk, (std::min) (size_type (c + 1) * chunk, slices));
+                return;
+            }
+#endif
+            sliced_ellpack_axpy_slices (a, x, y, alpha, 0, slices);
+        }
+        template<class M, class T>
+        void sliced_ellpack_prod (const M &a, const T *b, std::ptrdiff_t b1, std::ptrdiff_t b2,
+                                  T *c, std::ptrdiff_t c1, std::ptrdiff_t c2, std::size_t n, const T &alpha) {
+            typedef typename M::size_type size_type;
+            const size_type slices = a.slices ();
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const size_type chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (slices > chunk && a.nnz () * n >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long chunks = long ((slices + chunk - 1) / chunk);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long k = 0; k < chunks; ++ k)
+                    sliced_ellpack_prod_slices (a, b, b1, b2, c, c1, c2, n, alpha,
+                                                size_type (k) * chunk, (std::min) (size_type (k + 1) * chunk, slices));
+                return;
+            }
+#endif
+            sliced_ellpack_prod_slices (a, b, b1, b2, c, c1, c2, n, alpha, 0, slices);
+        }
+    }
+
+    // Matrix vector product kernel
+    template<class T, std::size_t C, class IA, class TA>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const sliced_ellpack_matrix<T, C, IA, TA> &m, const T *x, T *y, const T &alpha) {
+        if (m.nnz_capacity () == 0)
+            return;
+        detail::sliced_ellpack_axpy (m, x, y, alpha);
+    }
+
+    // Matrix matrix product kernel, e2 and m being dense blocks, see matrix_matrix_kernel_traits
+    template<class T, std::size_t C, class IA, class TA, class E2, class M>
+    BOOST_UBLAS_INLINE
+    void matrix_matrix_axpy (const sliced_ellpack_matrix<T, C, IA, TA> &e1, const E2 &e2, M &m, const T &alpha) {
+        BOOST_UBLAS_CHECK (m.size1 () == e1.size1 () && e1.size2 () == e2.size1 () && m.size2 () == e2.size2 (), bad_size ());
+        if (e1.nnz () == 0 || m.size2 () == 0)
+            return;
+        std::ptrdiff_t b1, b2, c1, c2;
+        detail::dense_block_strides (e2, b1, b2);
+        detail::dense_block_strides (m, c1, c2);
+        detail::sliced_ellpack_prod (e1, &e2 (0, 0), b1, b2, &m (0, 0), c1, c2, m.size2 (), alpha);
+    }
+
+    // Symmetric compressed matrix class
+    // One triangle of a symmetric sparse matrix, selected by TRI, is stored without its diagonal as
+    // a row major compressed matrix, the diagonal being held apart in a dense array. Each stored
+    // element stands for itself and for its transposed element. Zero diagonal elements are not
+    // met by the iterators.
+    template<class T, class TRI, class IA, class TA>
+    class symmetric_compressed_matrix:
+        public matrix_container<symmetric_compressed_matrix<T, TRI, IA, TA> > {
+
+        typedef T &true_reference;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef symmetric_compressed_matrix<T, TRI, IA, TA> self_type;
+    public:
+#ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
+        using matrix_container<self_type>::operator ();
+#endif
+        typedef typename IA::value_type size_type;
+        typedef typename IA::size_type array_size_type;
+        typedef typename IA::difference_type difference_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+#ifndef BOOST_UBLAS_STRICT_MATRIX_SPARSE
+        typedef T &reference;
+#else
+        typedef sparse_matrix_element<self_type> reference;
+#endif
+        typedef IA index_array_type;
+        typedef TA value_array_type;
+        typedef TRI triangular_type;
+        typedef const matrix_reference<const self_type> const_closure_type;
+        typedef matrix_reference<self_type> closure_type;
+        typedef compressed_vector<T, 0, IA, TA> vector_temporary_type;
+        typedef compressed_matrix<T, row_major, 0, IA, TA> matrix_temporary_type;
+        typedef sparse_tag storage_category;
+        typedef row_major_tag orientation_category;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix ():
+            matrix_container<self_type> (),
+            size_ (0), capacity_ (0), filled_ (0),
+            index1_data_ (1, 0), index2_data_ (0), value_data_ (0), diagonal_data_ (0) {
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix (size_type size, size_type non_zeros = 0):
+            matrix_container<self_type> (),
+            size_ (size), capacity_ (non_zeros), filled_ (0),
+            index1_data_ (size + 1, 0), index2_data_ (capacity_), value_data_ (capacity_),
+            diagonal_data_ (size, value_type/*zero*/()) {
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix (size_type size1, size_type size2, size_type non_zeros = 0):
+            matrix_container<self_type> (),
+            size_ (BOOST_UBLAS_SAME (size1, size2)), capacity_ (non_zeros), filled_ (0),
+            index1_data_ (size_ + 1, 0), index2_data_ (capacity_), value_data_ (capacity_),
+            diagonal_data_ (size_, value_type/*zero*/()) {
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix (const symmetric_compressed_matrix &m):
+            matrix_container<self_type> (),
+            size_ (m.size_), capacity_ (m.capacity_), filled_ (m.filled_),
+            index1_data_ (m.index1_data_), index2_data_ (m.index2_data_), value_data_ (m.value_data_),
+            diagonal_data_ (m.diagonal_data_) {
+            storage_invariants ();
+        }
+        // Only the triangle of ae selected by TRI is read
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix (const matrix_expression<AE> &ae):
+            matrix_container<self_type> (),
+            size_ (BOOST_UBLAS_SAME (ae ().size1 (), ae ().size2 ())), capacity_ (0), filled_ (0),
+            index1_data_ (size_ + 1, 0), index2_data_ (0), value_data_ (0),
+            diagonal_data_ (size_, value_type/*zero*/()) {
+            storage_invariants ();
+            assign (ae);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size_;
+        }
+        // The number of stored elements, the whole diagonal included
+        BOOST_UBLAS_INLINE
+        size_type nnz_capacity () const {
+            return capacity_ + size_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type nnz () const {
+            return filled_ + size_;
+        }
+
+        // Storage accessors
+        BOOST_UBLAS_INLINE
+        array_size_type filled () const {
+            return filled_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index1_data () const {
+            return index1_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index2_data () const {
+            return index2_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &value_data () const {
+            return value_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &diagonal_data () const {
+            return diagonal_data_;
+        }
+        BOOST_UBLAS_INLINE
+        value_array_type &value_data () {
+            return value_data_;
+        }
+        BOOST_UBLAS_INLINE
+        value_array_type &diagonal_data () {
+            return diagonal_data_;
+        }
+
+        // Resizing
+        BOOST_UBLAS_INLINE
+        void resize (size_type size, bool preserve = true) {
+            // FIXME preserve unimplemented
+            BOOST_UBLAS_CHECK (!preserve, internal_logic ());
+            size_ = size;
+            filled_ = 0;
+            index1_data_.resize (size_ + 1);
+            std::fill (index1_data_.begin (), index1_data_.end (), size_type/*zero*/());
+            diagonal_data_.resize (size_);
+            std::fill (diagonal_data_.begin (), diagonal_data_.end (), value_type/*zero*/());
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        void resize (size_type size1, size_type size2, bool preserve = true) {
+            resize (BOOST_UBLAS_SAME (size1, size2), preserve);
+        }
+
+        // Reserving
+        BOOST_UBLAS_INLINE
+        void reserve (size_type non_zeros, bool preserve = true) {
+            if (preserve) {
+                capacity_ = (std::max) (array_size_type (non_zeros), filled_);
+                index2_data_.resize (capacity_, size_type ());
+                value_data_.resize (capacity_, value_type ());
+            } else {
+                capacity_ = non_zeros;
+                index2_data_.resize (capacity_);
+                value_data_.resize (capacity_);
+                filled_ = 0;
+                std::fill (index1_data_.begin (), index1_data_.end (), size_type/*zero*/());
+            }
+            storage_invariants ();
+        }
+
+        // Element support
+        BOOST_UBLAS_INLINE
+        pointer find_element (size_type i, size_type j) {
+            return const_cast<pointer> (const_cast<const self_type&>(*this).find_element (i, j));
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer find_element (size_type i, size_type j) const {
+            BOOST_UBLAS_CHECK (i < size_, bad_index ());
+            BOOST_UBLAS_CHECK (j < size_, bad_index ());
+            if (i == j)
+                return &diagonal_data_ [i];
+            if (! TRI::other (i, j))
+                std::swap (i, j);
+            array_size_type k (element_address (i, j));
+            if (k == filled_)
+                return 0;
+            return &value_data_ [k];
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type i, size_type j) const {
+            const_pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return zero_;
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type i, size_type j) {
+#ifndef BOOST_UBLAS_STRICT_MATRIX_SPARSE
+            pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return insert_element (i, j, value_type/*zero*/());
+#else
+            return reference (*this, i, j);
+#endif
+        }
+
+        // Element assignment
+        // The element and its transposed element are set together
+        BOOST_UBLAS_INLINE
+        true_reference insert_element (size_type i, size_type j, const_reference t) {
+            BOOST_UBLAS_CHECK (i < size_ && j < size_, bad_index ());
+            if (i == j)
+                return diagonal_data_ [i] = t;
+            if (! TRI::other (i, j))
+                std::swap (i, j);
+            array_size_type k (lower_address (i, j));
+            if (k == index1_data_ [i + 1] || index2_data_ [k] != j) {
+                if (filled_ >= capacity_)
+                    reserve (2 * filled_ + 1, true);
+                std::copy_backward (index2_data_.begin () + k, index2_data_.begin () + filled_, index2_data_.begin () + filled_ + 1);
+                std::copy_backward (value_data_.begin () + k, value_data_.begin () + filled_, value_data_.begin () + filled_ + 1);
+                index2_data_ [k] = j;
+                ++ filled_;
+                for (size_type r = i + 1; r <= size_; ++ r)
+                    ++ index1_data_ [r];
+            }
+            true_reference r (value_data_ [k]);
+            r = t;
+            storage_invariants ();
+            return r;
+        }
+        BOOST_UBLAS_INLINE
+        void erase_element (size_type i, size_type j) {
+            BOOST_UBLAS_CHECK (i < size_ && j < size_, bad_index ());
+            if (i == j) {
+                diagonal_data_ [i] = value_type/*zero*/();
+                return;
+            }
+            if (! TRI::other (i, j))
+                std::swap (i, j);
+            array_size_type k (element_address (i, j));
+            if (k == filled_)
+                return;
+            std::copy (index2_data_.begin () + k + 1, index2_data_.begin () + filled_, index2_data_.begin () + k);
+            std::copy (value_data_.begin () + k + 1, value_data_.begin () + filled_, value_data_.begin () + k);
+            -- filled_;
+            for (size_type r = i + 1; r <= size_; ++ r)
+                -- index1_data_ [r];
+            storage_invariants ();
+        }
+
+        // Zeroing
+        BOOST_UBLAS_INLINE
+        void clear () {
+            filled_ = 0;
+            std::fill (index1_data_.begin (), index1_data_.end (), size_type/*zero*/());
+            std::fill (diagonal_data_.begin (), diagonal_data_.end (), value_type/*zero*/());
+            storage_invariants ();
+        }
+
+        // Assignment
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &operator = (const symmetric_compressed_matrix &m) {
+            if (this != &m) {
+                size_ = m.size_;
+                capacity_ = m.capacity_;
+                filled_ = m.filled_;
+                index1_data_ = m.index1_data_;
+                index2_data_ = m.index2_data_;
+                value_data_ = m.value_data_;
+                diagonal_data_ = m.diagonal_data_;
+            }
+            storage_invariants ();
+            return *this;
+        }
+        template<class C>          // Container assignment without temporary
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &operator = (const matrix_container<C> &m) {
+            resize (m ().size1 (), m ().size2 (), false);
+            assign (m);
+            return *this;
+        }
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &assign_temporary (symmetric_compressed_matrix &m) {
+            swap (m);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &operator = (const matrix_expression<AE> &ae) {
+            self_type temporary (ae);
+            return assign_temporary (temporary);
+        }
+        // The elements of ae are gathered before the storage is rebuilt, so that ae may refer to *this
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &assign (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_CHECK (size_ == ae ().size1 () && size_ == ae ().size2 (), bad_size ());
+            std::vector<entry> entries;
+            gather (ae (), entries);
+            build (entries);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix& operator += (const matrix_expression<AE> &ae) {
+            self_type temporary (*this + ae);
+            return assign_temporary (temporary);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &plus_assign (const matrix_expression<AE> &ae) {
+            return assign (*this + ae);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix& operator -= (const matrix_expression<AE> &ae) {
+            self_type temporary (*this - ae);
+            return assign_temporary (temporary);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix &minus_assign (const matrix_expression<AE> &ae) {
+            return assign (*this - ae);
+        }
+        template<class AT>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix& operator *= (const AT &at) {
+            for (array_size_type k = 0; k < filled_; ++ k)
+                value_data_ [k] *= at;
+            for (size_type i = 0; i < size_; ++ i)
+                diagonal_data_ [i] *= at;
+            return *this;
+        }
+        template<class AT>
+        BOOST_UBLAS_INLINE
+        symmetric_compressed_matrix& operator /= (const AT &at) {
+            for (array_size_type k = 0; k < filled_; ++ k)
+                value_data_ [k] /= at;
+            for (size_type i = 0; i < size_; ++ i)
+                diagonal_data_ [i] /= at;
+            return *this;
+        }
+
+        // Swapping
+        BOOST_UBLAS_INLINE
+        void swap (symmetric_compressed_matrix &m) {
+            if (this != &m) {
+                std::swap (size_, m.size_);
+                std::swap (capacity_, m.capacity_);
+                std::swap (filled_, m.filled_);
+                index1_data_.swap (m.index1_data_);
+                index2_data_.swap (m.index2_data_);
+                value_data_.swap (m.value_data_);
+                diagonal_data_.swap (m.diagonal_data_);
+            }
+            storage_invariants ();
+        }
+        BOOST_UBLAS_INLINE
+        friend void swap (symmetric_compressed_matrix &m1, symmetric_compressed_matrix &m2) {
+            m1.swap (m2);
+        }
+
+        // Iterator types
+        // The elements are read only through the iterators, as each one stands for two
+    private:
+        // Use index array iterator
+        typedef typename IA::const_iterator const_subiterator_type;
+
+    public:
+        class const_iterator1;
+        class const_iterator2;
+        typedef const_iterator1 iterator1;
+        typedef const_iterator2 iterator2;
+        typedef reverse_iterator_base1<const_iterator1> const_reverse_iterator1;
+        typedef reverse_iterator_base2<const_iterator2> const_reverse_iterator2;
+        typedef const_reverse_iterator1 reverse_iterator1;
+        typedef const_reverse_iterator2 reverse_iterator2;
+
+        // Element lookup
+        // Along a column by symmetry along the row of the same index
+        BOOST_UBLAS_INLINE
+        const_iterator1 find1 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (filled_);
+            if (rank == 1)
+                k = locate (j, i, direction);
+            return const_iterator1 (*this, rank, i, j, k);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 find2 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (filled_);
+            if (rank == 1)
+                k = locate (i, j, direction);
+            return const_iterator2 (*this, rank, i, j, k);
+        }
+
+
+        class const_iterator1:
+            public container_const_reference<symmetric_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator1, value_type> {
+        public:
+            typedef typename symmetric_compressed_matrix::value_type value_type;
+            typedef typename symmetric_compressed_matrix::difference_type difference_type;
+            typedef typename symmetric_compressed_matrix::const_reference reference;
+            typedef typename symmetric_compressed_matrix::const_pointer pointer;
+
+            typedef const_iterator2 dual_iterator_type;
+            typedef const_reverse_iterator2 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator1 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator1 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator ++ () {
+                ++ i_;
+                if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator -- () {
+                -- i_;
+                if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().element (i_, j_, k_);
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 begin () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), 0);
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 end () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), m.size2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rbegin () const {
+                return const_reverse_iterator2 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rend () const {
+                return const_reverse_iterator2 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator = (const const_iterator1 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator1 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator1 begin1 () const {
+            return find1 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator1 end1 () const {
+            return find1 (0, size_, 0);
+        }
+
+        class const_iterator2:
+            public container_const_reference<symmetric_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator2, value_type> {
+        public:
+            typedef typename symmetric_compressed_matrix::value_type value_type;
+            typedef typename symmetric_compressed_matrix::difference_type difference_type;
+            typedef typename symmetric_compressed_matrix::const_reference reference;
+            typedef typename symmetric_compressed_matrix::const_pointer pointer;
+
+            typedef const_iterator1 dual_iterator_type;
+            typedef const_reverse_iterator1 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator2 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator2 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator ++ () {
+                ++ j_;
+                if (rank_ == 1)
+                    *this = (*this) ().find2 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator -- () {
+                -- j_;
+                if (rank_ == 1)
+                    *this = (*this) ().find2 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().element (i_, j_, k_);
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 begin () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, 0, index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 end () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, m.size1 (), index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rbegin () const {
+                return const_reverse_iterator1 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rend () const {
+                return const_reverse_iterator1 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator = (const const_iterator2 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator2 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator2 begin2 () const {
+            return find2 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 end2 () const {
+            return find2 (0, 0, size_);
+        }
+
+        // Reverse iterators
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rbegin1 () const {
+            return const_reverse_iterator1 (end1 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rend1 () const {
+            return const_reverse_iterator1 (begin1 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rbegin2 () const {
+            return const_reverse_iterator2 (end2 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rend2 () const {
+            return const_reverse_iterator2 (begin2 ());
+        }
+
+    private:
+        struct entry {
+            size_type i;
+            size_type j;
+            value_type value;
+        };
+        struct entry_column_less {
+            bool operator () (const entry &e1, const entry &e2) const {
+                return e1.j < e2.j;
+            }
+        };
+
+        // Whether the rows store the elements left of the diagonal
+        BOOST_UBLAS_INLINE
+        static bool left_stored () {
+            return TRI::other (1, 0);
+        }
+
+        // The address of the first element of row i of the stored triangle of column not less than j
+        BOOST_UBLAS_INLINE
+        array_size_type lower_address (size_type i, size_type j) const {
+            const_subiterator_type it_begin (index2_data_.begin () + index1_data_ [i]);
+            const_subiterator_type it_end (index2_data_.begin () + index1_data_ [i + 1]);
+            return detail::lower_bound (it_begin, it_end, j, std::less<size_type> ()) - index2_data_.begin ();
+        }
+        // The address of the element (i, j) of the stored triangle, or filled_ if it is not stored
+        BOOST_UBLAS_INLINE
+        array_size_type element_address (size_type i, size_type j) const {
+            array_size_type k (lower_address (i, j));
+            if (k == index1_data_ [i + 1] || index2_data_ [k] != j)
+                return filled_;
+            return k;
+        }
+        BOOST_UBLAS_INLINE
+        const_reference element (size_type i, size_type j, array_size_type k) const {
+            if (i == j)
+                return diagonal_data_ [i];
+            return value_data_ [k];
+        }
+
+        // Moves j along row i in the given direction to the nearest element of either triangle, or
+        // of the diagonal when it is not zero, and returns the address of the stored element. The
+        // row holds stored elements of row i on one side of the diagonal and of column i on the
+        // other. j is set to the size if there is none forward, and left as it is if there is
+        // none backward.
+        array_size_type locate (size_type i, size_type &j, int direction) const {
+            if (i >= size_) {
+                if (direction > 0)
+                    j = size_;
+                return filled_;
+            }
+            const array_size_type row_begin = index1_data_ [i], row_end = index1_data_ [i + 1];
+            if (direction > 0) {
+                size_type c = j;
+                if (c < i) {
+                    if (left_stored ()) {
+                        const array_size_type k (lower_address (i, c));
+                        if (k != row_end) {
+                            j = index2_data_ [k];
+                            return k;
+                        }
+                    } else {
+                        for (size_type r = c; r < i; ++ r) {
+                            const array_size_type k (element_address (r, i));
+                            if (k != filled_) {
+                                j = r;
+                                return k;
+                            }
+                        }
+                    }
+                    c = i;
+                }
+                if (c == i) {
+                    if (diagonal_data_ [i] != value_type/*zero*/()) {
+                        j = i;
+                        return filled_;
+                    }
+                    c = i + 1;
+                }
+                if (c < size_) {
+                    if (left_stored ()) {
+                        for (size_type r = c; r < size_; ++ r) {
+                            const array_size_type k (element_address (r, i));
+                            if (k != filled_) {
+                                j = r;
+                                return k;
+                            }
+                        }
+                    } else {
+                        const array_size_type k (lower_address (i, c));
+                        if (k != row_end) {
+                            j = index2_data_ [k];
+                            return k;
+                        }
+                    }
+                }
+                j = size_;
+                return filled_;
+            } else {
+                size_type c = (std::min) (j, size_ - 1);
+                if (c > i) {
+                    if (left_stored ()) {
+                        for (size_type r = c; r > i; -- r) {
+                            const array_size_type k (element_address (r, i));
+                            if (k != filled_) {
+                                j = r;
+                                return k;
+                            }
+                        }
+                    } else {
+                        const array_size_type k (lower_address (i, c + 1));
+                        if (k != row_begin) {
+                            j = index2_data_ [k - 1];
+                            return k - 1;
+                        }
+                    }
+                    c = i;
+                }
+                if (c == i) {
+                    if (diagonal_data_ [i] != value_type/*zero*/()) {
+                        j = i;
+                        return filled_;
+                    }
+                    if (i == 0)
+                        return filled_;
+                    c = i - 1;
+                }
+                if (left_stored ()) {
+                    const array_size_type k (lower_address (i, c + 1));
+                    if (k != row_begin) {
+                        j = index2_data_ [k - 1];
+                        return k - 1;
+                    }
+                } else {
+                    for (size_type r = c + 1; r -- > 0; ) {
+                        const array_size_type k (element_address (r, i));
+                        if (k != filled_) {
+                            j = r;
+                            return k;
+                        }
+                    }
+                }
+                return filled_;
+            }
+        }
+
+        // The non zero elements of the stored triangle of an expression, of a compressed matrix or
+        // of a symmetric compressed matrix
+        template<class E>
+        void gather (const matrix_expression<E> &e, std::vector<entry> &entries) const {
+            typename E::const_iterator1 it1 (e ().begin1 ());
+            typename E::const_iterator1 it1_end (e ().end1 ());
+            while (it1 != it1_end) {
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+                typename E::const_iterator2 it2 (it1.begin ());
+                typename E::const_iterator2 it2_end (it1.end ());
+#else
+                typename E::const_iterator2 it2 (boost::numeric::ublas::begin (it1, iterator1_tag ()));
+                typename E::const_iterator2 it2_end (boost::numeric::ublas::end (it1, iterator1_tag ()));
+#endif
+                while (it2 != it2_end) {
+                    gather (it2.index1 (), it2.index2 (), *it2, entries);
+                    ++ it2;
+                }
+                ++ it1;
+            }
+        }
+        template<class T2, class L2, std::size_t IB2, class IA2, class TA2>
+        void gather (const compressed_matrix<T2, L2, IB2, IA2, TA2> &e, std::vector<entry> &entries) const {
+            typedef typename compressed_matrix<T2, L2, IB2, IA2, TA2>::array_size_type source_size_type;
+            entries.reserve (e.nnz () / 2 + size_);
+            const source_size_type lines = e.filled1 () > 0 ? e.filled1 () - 1 : 0;
+            for (source_size_type l = 0; l < lines; ++ l) {
+                for (source_size_type k = e.index1_data () [l] - IB2; k < e.index1_data () [l + 1] - IB2; ++ k) {
+                    const size_type minor = e.index2_data () [k] - IB2;
+                    gather (L2::index_M (l, minor), L2::index_m (l, minor), e.value_data () [k], entries);
+                }
+            }
+        }
+        template<class T2, class TRI2, class IA2, class TA2>
+        void gather (const symmetric_compressed_matrix<T2, TRI2, IA2, TA2> &e, std::vector<entry> &entries) const {
+            typedef typename symmetric_compressed_matrix<T2, TRI2, IA2, TA2>::array_size_type source_size_type;
+            entries.reserve (e.nnz ());
+            for (size_type i = 0; i < e.size1 (); ++ i) {
+                gather (i, i, e.diagonal_data () [i], entries);
+                for (source_size_type k = e.index1_data () [i]; k < e.index1_data () [i + 1]; ++ k) {
+                    const size_type j = e.index2_data () [k];
+                    if (TRI::other (i, j))
+                        gather (i, j, e.value_data () [k], entries);
+                    else
+                        gather (j, i, e.value_data () [k], entries);
+                }
+            }
+        }
+        BOOST_UBLAS_INLINE
+        void gather (size_type i, size_type j, const value_type &t, std::vector<entry> &entries) const {
+            if (t == value_type/*zero*/() || ! TRI::other (i, j))
+                return;
+            entry e;
+            e.i = i;
+            e.j = j;
+            e.value = t;
+            entries.push_back (e);
+        }
+
+        // Rebuilds the storage from the elements, the values of repeated elements being summed.
+        // The elements are sorted into their rows by counting, then by column within a row.
+        void build (std::vector<entry> &entries) {
+            std::vector<array_size_type> first (size_ + 2, 0);
+            std::fill (diagonal_data_.begin (), diagonal_data_.end (), value_type/*zero*/());
+            for (array_size_type p = 0; p < entries.size (); ++ p)
+                if (entries [p].i != entries [p].j)
+                    ++ first [entries [p].i + 2];
+            for (size_type i = 0; i < size_; ++ i)
+                first [i + 2] += first [i + 1];
+            std::vector<entry> sorted (first [size_ + 1]);
+            for (array_size_type p = 0; p < entries.size (); ++ p) {
+                const entry &e = entries [p];
+                if (e.i == e.j)
+                    diagonal_data_ [e.i] += e.value;
+                else
+                    sorted [first [e.i + 1] ++] = e;
+            }
+            std::vector<entry> ().swap (entries);
+
+            reserve (sorted.size (), false);
+            for (size_type i = 0; i < size_; ++ i) {
+                index1_data_ [i] = filled_;
+                std::stable_sort (sorted.begin () + first [i], sorted.begin () + first [i + 1], entry_column_less ());
+                for (array_size_type p = first [i]; p < first [i + 1]; ++ p) {
+                    if (filled_ > index1_data_ [i] && index2_data_ [filled_ - 1] == sorted [p].j) {
+                        value_data_ [filled_ - 1] += sorted [p].value;
+                    } else {
+                        index2_data_ [filled_] = sorted [p].j;
+                        value_data_ [filled_] = sorted [p].value;
+                        ++ filled_;
+                    }
+                }
+            }
+            index1_data_ [size_] = filled_;
+            storage_invariants ();
+        }
+
+        void storage_invariants () const {
+            BOOST_UBLAS_CHECK (size_ + 1 == index1_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (size_ == diagonal_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (capacity_ == index2_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (capacity_ == value_data_.size (), internal_logic ());
+            BOOST_UBLAS_CHECK (filled_ <= capacity_, internal_logic ());
+            BOOST_UBLAS_CHECK (index1_data_ [size_] == filled_, internal_logic ());
+        }
+
+        size_type size_;
+        array_size_type capacity_;
+        array_size_type filled_;
+        index_array_type index1_data_;
+        index_array_type index2_data_;
+        value_array_type value_data_;
+        value_array_type diagonal_data_;
+        static const value_type zero_;
+
+        friend class const_iterator1;
+        friend class const_iterator2;
+    };
+
+    template<class T, class TRI, class IA, class TA>
+    const typename symmetric_compressed_matrix<T, TRI, IA, TA>::value_type symmetric_compressed_matrix<T, TRI, IA, TA>::zero_ = value_type/*zero*/();
+
+    namespace detail {
+        template<class T, class TRI, class IA, class TA>
+        struct matrix_vector_kernel_traits<symmetric_compressed_matrix<T, TRI, IA, TA> > {
+            static const bool value = true;
+        };
+        template<class T, class L, std::size_t IB, class IA, class TA, class T2, class TRI2, class IA2, class TA2>
+        struct sparse_conversion_traits<compressed_matrix<T, L, IB, IA, TA>, symmetric_compressed_matrix<T2, TRI2, IA2, TA2> > {
+            static const bool value = true;
+        };
+
+        // y += alpha * a * x for the rows [first, last) of a. Each stored element is applied twice,
+        // along its row into y and along its column into w, which is y itself unless the rows are
+        // shared between threads. The triangle stored does not matter.
+        template<class M, class T>
+        void symmetric_compressed_axpy_rows (const M &a, const T *x, T *y, T *w, const T &alpha,
+                                             std::size_t first, std::size_t last) {
+            typedef typename M::size_type size_type;
+            typedef typename M::array_size_type array_size_type;
+            const T *values = a.filled () > 0 ? &a.value_data () [0] : 0;
+            const size_type *columns = a.filled () > 0 ? &a.index2_data () [0] : 0;
+            for (size_type i = first; i < last; ++ i) {
+                const T ax (alpha * x [i]);
+                T t (a.diagonal_data () [i] * x [i]);
+                for (array_size_type k = a.index1_data () [i]; k < a.index1_data () [i + 1]; ++ k) {
+                    t += values [k] * x [columns [k]];
+                    w [columns [k]] += values [k] * ax;
+                }
+                y [i] += alpha * t;
+            }
+        }
+
+        // The rows are split between OpenMP threads in parts of as many stored elements, each
+        // thread adding the column contributions of its rows to a vector of its own. The vectors
+        // are summed into y afterwards, so that no element of y is written by two threads at once.
+        template<class M, class T>
+        void symmetric_compressed_axpy (const M &a, const T *x, T *y, const T &alpha) {
+            typedef typename M::size_type size_type;
+            const size_type size = a.size1 ();
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            typedef typename M::array_size_type array_size_type;
+            if (a.filled () >= array_size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const int threads = omp_get_max_threads ();
+                std::vector<T> buffer (std::size_t (threads) * size);
+#pragma omp parallel num_threads (threads)
+                {
+                    const int t = omp_get_thread_num (), nt = omp_get_num_threads ();
+                    const array_size_type filled = a.filled ();
+                    const size_type first = t == 0 ? 0 :
+                        size_type (std::lower_bound (a.index1_data ().begin (), a.index1_data ().begin () + size,
+                                                     filled / nt * t + filled % nt * t / nt) - a.index1_data ().begin ());
+                    const size_type last = t == nt - 1 ? size :
+                        size_type (std::lower_bound (a.index1_data ().begin (), a.index1_data ().begin () + size,
+                                                     filled / nt * (t + 1) + filled % nt * (t + 1) / nt) - a.index1_data ().begin ());
+                    symmetric_compressed_axpy_rows (a, x, y, &buffer [std::size_t (t) * size], alpha, first, last);
+#pragma omp barrier
+#pragma omp for schedule (static)
+                    for (long j = 0; j < long (size); ++ j) {
+                        T s (buffer [j]);
+                        for (int u = 1; u < nt; ++ u)
+                            s += buffer [std::size_t (u) * size + j];
+                        y [j] += s;
+                    }
+                }
+                return;
+            }
+#endif
+            symmetric_compressed_axpy_rows (a, x, y, y, alpha, 0, size);
+        }
+    }
+
+    // Matrix vector product kernel
+    template<class T, class TRI, class IA, class TA>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const symmetric_compressed_matrix<T, TRI, IA, TA> &m, const T *x, T *y, const T &alpha) {
+        if (m.size1 () == 0)
+            return;
+        detail::symmetric_compressed_axpy (m, x, y, alpha);
+    }
+
+    // Conversion into a compressed matrix, in O(nnz), see sparse_conversion_traits. Each row of the
+    // whole matrix is filled in the order of the columns: the transposed elements of the rows
+    // above it are appended while those rows are swept.
+    template<class T2, class TRI2, class IA2, class TA2, class T, class L, std::size_t IB, class IA, class TA>
+    void sparse_convert (const symmetric_compressed_matrix<T2, TRI2, IA2, TA2> &e, compressed_matrix<T, L, IB, IA, TA> &m) {
+        typedef typename compressed_matrix<T, L, IB, IA, TA>::size_type size_type;
+        typedef typename compressed_matrix<T, L, IB, IA, TA>::array_size_type array_size_type;
+        typedef typename symmetric_compressed_matrix<T2, TRI2, IA2, TA2>::array_size_type source_size_type;
+        const size_type size = BOOST_UBLAS_SAME (m.size1 (), e.size1 ());
+        const bool left = TRI2::other (1, 0);
+        // The whole matrix being symmetric, its rows are its columns for either orientation of m
+        std::vector<array_size_type> next (size + 1, 0);
+        for (size_type i = 0; i < size; ++ i) {
+            next [i + 1] += e.index1_data () [i + 1] - e.index1_data () [i];
+            if (e.diagonal_data () [i] != T2/*zero*/())
+                ++ next [i + 1];
+            for (source_size_type k = e.index1_data () [i]; k < e.index1_data () [i + 1]; ++ k)
+                ++ next [e.index2_data () [k] + 1];
+        }
+        for (size_type i = 0; i < size; ++ i)
+            next [i + 1] += next [i];
+        const array_size_type filled = next [size];
+        m.reserve (filled, false);
+        for (size_type i = 0; i <= size; ++ i)
+            m.index1_data () [i] = size_type (next [i] + IB);
+        for (size_type i = 0; i < size; ++ i) {
+            if (left) {
+                for (source_size_type k = e.index1_data () [i]; k < e.index1_data () [i + 1]; ++ k, ++ next [i]) {
+                    m.index2_data () [next [i]] = size_type (e.index2_data () [k] + IB);
+                    m.value_data () [next [i]] = e.value_data () [k];
+                }
+            }
+            if (e.diagonal_data () [i] != T2/*zero*/()) {
+                m.index2_data () [next [i]] = size_type (i + IB);
+                m.value_data () [next [i]] = e.diagonal_data () [i];
+                ++ next [i];
+            }
+            if (! left) {
+                for (source_size_type k = e.index1_data () [i]; k < e.index1_data () [i + 1]; ++ k, ++ next [i]) {
+                    m.index2_data () [next [i]] = size_type (e.index2_data () [k] + IB);
+                    m.value_data () [next [i]] = e.value_data () [k];
+                }
+            }
+            for (source_size_type k = e.index1_data () [i]; k < e.index1_data () [i + 1]; ++ k) {
+                const size_type j = e.index2_data () [k];
+                m.index2_data () [next [j]] = size_type (i + IB);
+                m.value_data () [next [j]] = e.value_data () [k];
+                ++ next [j];
+            }
+        }
+        m.set_filled (size + 1, filled);
+    }
+
+    // Dual compressed matrix class
+    // A compressed matrix which also keeps the index of its transpose: the elements of each line
+    // of the other orientation, as the positions of their lines in the compressed storage and the
+    // addresses of their values. The values are stored once. The transposed index is built on
+    // first use along the other orientation and discarded by any change of the structure, while
+    // changes of the values keep it.
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    class dual_compressed_matrix:
+        public matrix_container<dual_compressed_matrix<T, L, IB, IA, TA> > {
+
+        typedef T &true_reference;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef L layout_type;
+        typedef dual_compressed_matrix<T, L, IB, IA, TA> self_type;
+    public:
+#ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
+        using matrix_container<self_type>::operator ();
+#endif
+        typedef compressed_matrix<T, L, IB, IA, TA> compressed_type;
+        typedef typename IA::value_type size_type;
+        typedef typename IA::size_type array_size_type;
+        typedef typename IA::difference_type difference_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+#ifndef BOOST_UBLAS_STRICT_MATRIX_SPARSE
+        typedef T &reference;
+#else
+        typedef sparse_matrix_element<self_type> reference;
+#endif
+        typedef IA index_array_type;
+        typedef TA value_array_type;
+        typedef const matrix_reference<const self_type> const_closure_type;
+        typedef matrix_reference<self_type> closure_type;
+        typedef compressed_vector<T, IB, IA, TA> vector_temporary_type;
+        typedef compressed_type matrix_temporary_type;
+        typedef sparse_tag storage_category;
+        typedef typename L::orientation_category orientation_category;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix ():
+            matrix_container<self_type> (),
+            data_ (), transposed_valid_ (false),
+            transposed_index1_data_ (), transposed_index2_data_ (), permutation_data_ () {}
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix (size_type size1, size_type size2, size_type non_zeros = 0):
+            matrix_container<self_type> (),
+            data_ (size1, size2, non_zeros), transposed_valid_ (false),
+            transposed_index1_data_ (), transposed_index2_data_ (), permutation_data_ () {}
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix (const dual_compressed_matrix &m):
+            matrix_container<self_type> (),
+            data_ (m.data_), transposed_valid_ (m.transposed_valid_),
+            transposed_index1_data_ (m.transposed_index1_data_), transposed_index2_data_ (m.transposed_index2_data_),
+            permutation_data_ (m.permutation_data_) {}
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix (const matrix_expression<AE> &ae, size_type non_zeros = 0):
+            matrix_container<self_type> (),
+            data_ (ae, non_zeros), transposed_valid_ (false),
+            transposed_index1_data_ (), transposed_index2_data_ (), permutation_data_ () {}
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return data_.size1 ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return data_.size2 ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type nnz_capacity () const {
+            return data_.nnz_capacity ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type nnz () const {
+            return data_.nnz ();
+        }
+        BOOST_UBLAS_INLINE
+        const compressed_type &data () const {
+            return data_;
+        }
+
+        // Storage accessors
+        BOOST_UBLAS_INLINE
+        static size_type index_base () {
+            return IB;
+        }
+        BOOST_UBLAS_INLINE
+        array_size_type filled1 () const {
+            return data_.filled1 ();
+        }
+        BOOST_UBLAS_INLINE
+        array_size_type filled2 () const {
+            return data_.filled2 ();
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index1_data () const {
+            return data_.index1_data ();
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index2_data () const {
+            return data_.index2_data ();
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &value_data () const {
+            return data_.value_data ();
+        }
+        // The values may be changed in place, the structure may not
+        BOOST_UBLAS_INLINE
+        value_array_type &value_data () {
+            return data_.value_data ();
+        }
+        // The transposed index, of one more element than lines of the other orientation, and of
+        // nnz () elements for the indices and the addresses of the values, built if needed
+        BOOST_UBLAS_INLINE
+        const index_array_type &transposed_index1_data () const {
+            complete_transposed ();
+            return transposed_index1_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &transposed_index2_data () const {
+            complete_transposed ();
+            return transposed_index2_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &permutation_data () const {
+            complete_transposed ();
+            return permutation_data_;
+        }
+        BOOST_UBLAS_INLINE
+        bool transposed_valid () const {
+            return transposed_valid_;
+        }
+        // Builds the transposed index by counting the elements of each line of the other
+        // orientation, then scattering them in the order of the lines of the compressed storage,
+        // in O(nnz). Called before sharing the matrix between threads, as the iterators of the
+        // other orientation and the products with the transpose build it on first use.
+        void complete_transposed () const {
+            if (transposed_valid_)
+                return;
+            const size_type size_M = layout_type::size_M (size1 (), size2 ());
+            const size_type size_m = layout_type::size_m (size1 (), size2 ());
+            const array_size_type filled = data_.filled2 ();
+            const array_size_type lines = data_.filled1 () - 1;
+            transposed_index1_data_.resize (size_m + 1);
+            transposed_index2_data_.resize (filled);
+            permutation_data_.resize (filled);
+            std::vector<array_size_type> next (size_m + 1, 0);
+            for (array_size_type k = 0; k < filled; ++ k)
+                ++ next [zero_based (data_.index2_data () [k]) + 1];
+            for (size_type m = 0; m < size_m; ++ m)
+                next [m + 1] += next [m];
+            for (size_type m = 0; m <= size_m; ++ m)
+                transposed_index1_data_ [m] = k_based (next [m]);
+            for (array_size_type l = 0; l < lines && l < size_M; ++ l) {
+                for (array_size_type k = zero_based (data_.index1_data () [l]); k < zero_based (data_.index1_data () [l + 1]); ++ k) {
+                    const array_size_type p = next [zero_based (data_.index2_data () [k])] ++;
+                    transposed_index2_data_ [p] = k_based (l);
+                    permutation_data_ [p] = k;
+                }
+            }
+            transposed_valid_ = true;
+        }
+
+        // Resizing
+        BOOST_UBLAS_INLINE
+        void resize (size_type size1, size_type size2, bool preserve = true) {
+            data_.resize (size1, size2, preserve);
+            transposed_valid_ = false;
+        }
+
+        // Reserving
+        BOOST_UBLAS_INLINE
+        void reserve (size_type non_zeros, bool preserve = true) {
+            data_.reserve (non_zeros, preserve);
+            if (! preserve)
+                transposed_valid_ = false;
+        }
+
+        // Element support
+        BOOST_UBLAS_INLINE
+        pointer find_element (size_type i, size_type j) {
+            return data_.find_element (i, j);
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer find_element (size_type i, size_type j) const {
+            return data_.find_element (i, j);
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type i, size_type j) const {
+            return data_ (i, j);
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type i, size_type j) {
+#ifndef BOOST_UBLAS_STRICT_MATRIX_SPARSE
+            pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return insert_element (i, j, value_type/*zero*/());
+#else
+            return reference (*this, i, j);
+#endif
+        }
+
+        // Element assignment
+        BOOST_UBLAS_INLINE
+        true_reference insert_element (size_type i, size_type j, const_reference t) {
+            transposed_valid_ = false;
+            return data_.insert_element (i, j, t);
+        }
+        BOOST_UBLAS_INLINE
+        void erase_element (size_type i, size_type j) {
+            transposed_valid_ = false;
+            data_.erase_element (i, j);
+        }
+
+        // Zeroing
+        BOOST_UBLAS_INLINE
+        void clear () {
+            transposed_valid_ = false;
+            data_.clear ();
+        }
+
+        // Assignment
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &operator = (const dual_compressed_matrix &m) {
+            if (this != &m) {
+                data_ = m.data_;
+                transposed_valid_ = m.transposed_valid_;
+                transposed_index1_data_ = m.transposed_index1_data_;
+                transposed_index2_data_ = m.transposed_index2_data_;
+                permutation_data_ = m.permutation_data_;
+            }
+            return *this;
+        }
+        template<class C>          // Container assignment without temporary
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &operator = (const matrix_container<C> &m) {
+            transposed_valid_ = false;
+            data_ = m;
+            return *this;
+        }
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &assign_temporary (dual_compressed_matrix &m) {
+            swap (m);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &operator = (const matrix_expression<AE> &ae) {
+            self_type temporary (ae, nnz_capacity ());
+            return assign_temporary (temporary);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &assign (const matrix_expression<AE> &ae) {
+            transposed_valid_ = false;
+            data_.assign (ae);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix& operator += (const matrix_expression<AE> &ae) {
+            self_type temporary (*this + ae, nnz_capacity ());
+            return assign_temporary (temporary);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &plus_assign (const matrix_expression<AE> &ae) {
+            transposed_valid_ = false;
+            data_.plus_assign (ae);
+            return *this;
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix& operator -= (const matrix_expression<AE> &ae) {
+            self_type temporary (*this - ae, nnz_capacity ());
+            return assign_temporary (temporary);
+        }
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix &minus_assign (const matrix_expression<AE> &ae) {
+            transposed_valid_ = false;
+            data_.minus_assign (ae);
+            return *this;
+        }
+        template<class AT>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix& operator *= (const AT &at) {
+            data_ *= at;
+            return *this;
+        }
+        template<class AT>
+        BOOST_UBLAS_INLINE
+        dual_compressed_matrix& operator /= (const AT &at) {
+            data_ /= at;
+            return *this;
+        }
+
+        // Swapping
+        BOOST_UBLAS_INLINE
+        void swap (dual_compressed_matrix &m) {
+            if (this != &m) {
+                data_.swap (m.data_);
+                std::swap (transposed_valid_, m.transposed_valid_);
+                transposed_index1_data_.swap (m.transposed_index1_data_);
+                transposed_index2_data_.swap (m.transposed_index2_data_);
+                permutation_data_.swap (m.permutation_data_);
+            }
+        }
+        BOOST_UBLAS_INLINE
+        friend void swap (dual_compressed_matrix &m1, dual_compressed_matrix &m2) {
+            m1.swap (m2);
+        }
+
+        // Back-/Front-insertion
+        BOOST_UBLAS_INLINE
+        void push_back (size_type i, size_type j, const_reference t) {
+            transposed_valid_ = false;
+            data_.push_back (i, j, t);
+        }
+        BOOST_UBLAS_INLINE
+        void pop_back () {
+            transposed_valid_ = false;
+            data_.pop_back ();
+        }
+
+        // Iterator types
+        // The elements are read only through the iterators, each orientation walking its own index
+    private:
+        // Use index array iterator
+        typedef typename IA::const_iterator const_subiterator_type;
+
+    public:
+        class const_iterator1;
+        class const_iterator2;
+        typedef const_iterator1 iterator1;
+        typedef const_iterator2 iterator2;
+        typedef reverse_iterator_base1<const_iterator1> const_reverse_iterator1;
+        typedef reverse_iterator_base2<const_iterator2> const_reverse_iterator2;
+        typedef const_reverse_iterator1 reverse_iterator1;
+        typedef const_reverse_iterator2 reverse_iterator2;
+
+        // Element lookup
+        BOOST_UBLAS_INLINE
+        const_iterator1 find1 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (nnz ());
+            if (rank == 1)
+                k = locate (! row_major (), j, i, size1 (), direction);
+            return const_iterator1 (*this, rank, i, j, k);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 find2 (int rank, size_type i, size_type j, int direction = 1) const {
+            array_size_type k (nnz ());
+            if (rank == 1)
+                k = locate (row_major (), i, j, size2 (), direction);
+            return const_iterator2 (*this, rank, i, j, k);
+        }
+
+
+        class const_iterator1:
+            public container_const_reference<dual_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator1, value_type> {
+        public:
+            typedef typename dual_compressed_matrix::value_type value_type;
+            typedef typename dual_compressed_matrix::difference_type difference_type;
+            typedef typename dual_compressed_matrix::const_reference reference;
+            typedef typename dual_compressed_matrix::const_pointer pointer;
+
+            typedef const_iterator2 dual_iterator_type;
+            typedef const_reverse_iterator2 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator1 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator1 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator ++ () {
+                ++ i_;
+                if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator -- () {
+                -- i_;
+                if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().element (! row_major (), k_);
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 begin () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), 0);
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 end () const {
+                const self_type &m = (*this) ();
+                return m.find2 (1, index1 (), m.size2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rbegin () const {
+                return const_reverse_iterator2 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rend () const {
+                return const_reverse_iterator2 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator = (const const_iterator1 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator1 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator1 begin1 () const {
+            return find1 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator1 end1 () const {
+            return find1 (0, size1 (), 0);
+        }
+
+        class const_iterator2:
+            public container_const_reference<dual_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator2, value_type> {
+        public:
+            typedef typename dual_compressed_matrix::value_type value_type;
+            typedef typename dual_compressed_matrix::difference_type difference_type;
+            typedef typename dual_compressed_matrix::const_reference reference;
+            typedef typename dual_compressed_matrix::const_pointer pointer;
+
+            typedef const_iterator1 dual_iterator_type;
+            typedef const_reverse_iterator1 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator2 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator2 (const self_type &m, int rank, size_type i, size_type j, array_size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator ++ () {
+                ++ j_;
+                if (rank_ == 1)
+                    *this = (*this) ().find2 (rank_, i_, j_, 1);
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator -- () {
+                -- j_;
+                if (rank_ == 1)
+                    *this = (*this) ().find2 (rank_, i_, j_, -1);
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1) {
+                    return (*this) ().element (row_major (), k_);
+                } else {
+                    return (*this) () (i_, j_);
+                }
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 begin () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, 0, index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 end () const {
+                const self_type &m = (*this) ();
+                return m.find1 (1, m.size1 (), index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rbegin () const {
+                return const_reverse_iterator1 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rend () const {
+                return const_reverse_iterator1 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator = (const const_iterator2 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator2 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            array_size_type k_;
+        };
+
+        BOOST_UBLAS_INLINE
+        const_iterator2 begin2 () const {
+            return find2 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 end2 () const {
+            return find2 (0, 0, size2 ());
+        }
+
+        // Reverse iterators
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rbegin1 () const {
+            return const_reverse_iterator1 (end1 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rend1 () const {
+            return const_reverse_iterator1 (begin1 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rbegin2 () const {
+            return const_reverse_iterator2 (end2 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rend2 () const {
+            return const_reverse_iterator2 (begin2 ());
+        }
+
+    private:
+        BOOST_UBLAS_INLINE
+        static bool row_major () {
+            return boost::is_same<orientation_category, row_major_tag>::value;
+        }
+        BOOST_UBLAS_INLINE
+        static size_type zero_based (size_type k_based_index) {
+            return k_based_index - IB;
+        }
+        BOOST_UBLAS_INLINE
+        static size_type k_based (size_type zero_based_index) {
+            return zero_based_index + IB;
+        }
+
+        // The value at the address k of the compressed storage, or of the transposed index
+        BOOST_UBLAS_INLINE
+        const_reference element (bool compressed, array_size_type k) const {
+            if (compressed)
+                return data_.value_data () [k];
+            return data_.value_data () [permutation_data_ [k]];
+        }
+
+        // Moves m along line l of the compressed storage, or of the transposed index, in the given
+        // direction to the nearest element and returns its address. m is set to size if there is
+        // none forward, and left as it is if there is none backward.
+        array_size_type locate (bool compressed, size_type l, size_type &m, size_type size, int direction) const {
+            if (! compressed)
+                complete_transposed ();
+            const index_array_type &index1 = compressed ? data_.index1_data () : transposed_index1_data_;
+            const index_array_type &index2 = compressed ? data_.index2_data () : transposed_index2_data_;
+            const array_size_type lines = compressed ? data_.filled1 () - 1 : transposed_index1_data_.size () - 1;
+            if (l >= lines) {
+                if (direction > 0)
+                    m = size;
+                return nnz ();
+            }
+            const_subiterator_type it_begin (index2.begin () + zero_based (index1 [l]));
+            const_subiterator_type it_end (index2.begin () + zero_based (index1 [l + 1]));
+            if (direction > 0) {
+                const_subiterator_type it (detail::lower_bound (it_begin, it_end, k_based (m), std::less<size_type> ()));
+                if (it == it_end) {
+                    m = size;
+                    return nnz ();
+                }
+                m = zero_based (*it);
+                return it - index2.begin ();
+            } else {
+                const_subiterator_type it (std::upper_bound (it_begin, it_end, k_based (m)));
+                if (it == it_begin)
+                    return nnz ();
+                -- it;
+                m = zero_based (*it);
+                return it - index2.begin ();
+            }
+        }
+
+        compressed_type data_;
+        mutable bool transposed_valid_;
+        mutable index_array_type transposed_index1_data_;
+        mutable index_array_type transposed_index2_data_;
+        mutable index_array_type permutation_data_;
+
+        friend class const_iterator1;
+        friend class const_iterator2;
+    };
+
+    namespace detail {
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct matrix_vector_kernel_traits<dual_compressed_matrix<T, L, IB, IA, TA> > {
+            static const bool value = true;
+        };
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct matrix_vector_kernel_traits<matrix_unary2<const dual_compressed_matrix<T, L, IB, IA, TA>, scalar_identity<T> > > {
+            static const bool value = true;
+        };
+        template<class T, class L, std::size_t IB, class IA, class TA, class T2, class L2, std::size_t IB2, class IA2, class TA2>
+        struct sparse_conversion_traits<compressed_matrix<T, L, IB, IA, TA>, dual_compressed_matrix<T2, L2, IB2, IA2, TA2> > {
+            static const bool value = true;
+        };
+
+        // y += alpha * a * x, the lines of the index arrays being the rows of a, k based on IB, of
+        // which the values are read through the permutation when there is one. Each row is
+        // computed by a single OpenMP thread, so that no element of y is written by two.
+        template<std::size_t IB, class IA, class T>
+        void compressed_rows_axpy (std::size_t rows, const IA &index1, const IA &index2, const IA *permutation,
+                                   const T *values, const T *x, T *y, const T &alpha) {
+            typedef typename IA::size_type array_size_type;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const long chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (long (rows) > chunk && index2.size () >= array_size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+#pragma omp parallel for schedule (dynamic, chunk)
+                for (long i = 0; i < long (rows); ++ i) {
+                    T t = T/*zero*/();
+                    if (permutation) {
+                        for (array_size_type k = index1 [i] - IB; k < index1 [i + 1] - IB; ++ k)
+                            t += values [(*permutation) [k]] * x [index2 [k] - IB];
+                    } else {
+                        for (array_size_type k = index1 [i] - IB; k < index1 [i + 1] - IB; ++ k)
+                            t += values [k] * x [index2 [k] - IB];
+                    }
+                    y [i] += alpha * t;
+                }
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < rows; ++ i) {
+                T t = T/*zero*/();
+                if (permutation) {
+                    for (array_size_type k = index1 [i] - IB; k < index1 [i + 1] - IB; ++ k)
+                        t += values [(*permutation) [k]] * x [index2 [k] - IB];
+                } else {
+                    for (array_size_type k = index1 [i] - IB; k < index1 [i + 1] - IB; ++ k)
+                        t += values [k] * x [index2 [k] - IB];
+                }
+                y [i] += alpha * t;
+            }
+        }
+
+        // y += alpha * a * x, or alpha * trans (a) * x, through the rows of the compressed storage
+        // or of the transposed index
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        void dual_compressed_axpy (const dual_compressed_matrix<T, L, IB, IA, TA> &a, bool transposed,
+                                   const T *x, T *y, const T &alpha) {
+            if (a.nnz () == 0)
+                return;
+            const T *values = &a.value_data () [0];
+            if (boost::is_same<typename L::orientation_category, row_major_tag>::value != transposed) {
+                const std::size_t rows = (std::min) (std::size_t (a.filled1 () - 1),
+                                                     std::size_t (transposed ? a.size2 () : a.size1 ()));
+                compressed_rows_axpy<IB> (rows, a.index1_data (), a.index2_data (), static_cast<const IA *> (0),
+                                          values, x, y, alpha);
+            } else {
+                a.complete_transposed ();
+                compressed_rows_axpy<IB> (a.transposed_index1_data ().size () - 1,
+                                          a.transposed_index1_data (), a.transposed_index2_data (), &a.permutation_data (),
+                                          values, x, y, alpha);
+            }
+        }
+    }
+
+    // Matrix vector product kernels, of the matrix and of its transpose
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const dual_compressed_matrix<T, L, IB, IA, TA> &m, const T *x, T *y, const T &alpha) {
+        detail::dual_compressed_axpy (m, false, x, y, alpha);
+    }
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const matrix_unary2<const dual_compressed_matrix<T, L, IB, IA, TA>, scalar_identity<T> > &m,
+                             const T *x, T *y, const T &alpha) {
+        detail::dual_compressed_axpy (detail::closure_matrix (m.expression ()), true, x, y, alpha);
+    }
+
+    // Conversion into a compressed matrix, in O(nnz), see sparse_conversion_traits. The lines of
+    // either the compressed storage or the transposed index are copied, whichever has the
+    // orientation of m.
+    template<class T2, class L2, std::size_t IB2, class IA2, class TA2, class T, class L, std::size_t IB, class IA, class TA>
+    void sparse_convert (const dual_compressed_matrix<T2, L2, IB2, IA2, TA2> &e, compressed_matrix<T, L, IB, IA, TA> &m) {
+        typedef typename compressed_matrix<T, L, IB, IA, TA>::size_type size_type;
+        typedef typename compressed_matrix<T, L, IB, IA, TA>::array_size_type array_size_type;
+        const bool same = boost::is_same<typename L::orientation_category, typename L2::orientation_category>::value;
+        const size_type size_M = L::size_M (m.size1 (), m.size2 ());
+        const array_size_type filled = e.nnz ();
+        if (! same)
+            e.complete_transposed ();
+        const IA2 &index1 = same ? e.index1_data () : e.transposed_index1_data ();
+        const IA2 &index2 = same ? e.index2_data () : e.transposed_index2_data ();
+        const array_size_type lines = same ? e.filled1 () - 1 : size_M;
+        m.reserve (filled, false);
+        for (size_type l = 0; l <= size_M; ++ l)
+            m.index1_data () [l] = size_type ((l <= lines ? index1 [l] - IB2 : filled) + IB);
+        for (array_size_type k = 0; k < filled; ++ k) {
+            m.index2_data () [k] = size_type (index2 [k] - IB2 + IB);
+            m.value_data () [k] = e.value_data () [same ? k : e.permutation_data () [k]];
+        }
+        m.set_filled (size_M + 1, filled);
+    }
+
+    // Conversions between compressed, coordinate and mapped matrices, see
+    // detail/sparse_conversion.hpp
+    namespace detail {
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct sparse_format_traits<compressed_matrix<T, L, IB, IA, TA> > {
+            static const bool value = true;
+        };
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct sparse_format_traits<coordinate_matrix<T, L, IB, IA, TA> > {
+            static const bool value = true;
+        };
+        template<class T, class L, class A>
+        struct sparse_format_traits<mapped_matrix<T, L, A> > {
+            static const bool value = true;
+        };
+
+        // The lines of a compressed matrix, of which those from filled1 () - 1 on are empty
+        template<class M>
+        class compressed_lines {
+        public:
+            typedef typename M::value_type value_type;
+
+            BOOST_UBLAS_INLINE
+            explicit compressed_lines (const M &m):
+                m_ (m), filled_ (m.filled1 () - 1) {}
+
+            BOOST_UBLAS_INLINE
+            bool row_major () const {
+                return boost::is_same<typename M::orientation_category, row_major_tag>::value;
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t lines () const {
+                return row_major () ? m_.size1 () : m_.size2 ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t line_size () const {
+                return row_major () ? m_.size2 () : m_.size1 ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t nnz () const {
+                return m_.nnz ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t begin (std::size_t l) const {
+                return l < filled_ ? m_.index1_data () [l] - M::index_base () : nnz ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t end (std::size_t l) const {
+                return l < filled_ ? m_.index1_data () [l + 1] - M::index_base () : nnz ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t index (std::size_t k) const {
+                return m_.index2_data () [k] - M::index_base ();
+            }
+            BOOST_UBLAS_INLINE
+            const value_type &value (std::size_t k) const {
+                return m_.value_data () [k];
+            }
+
+        private:
+            const M &m_;
+            std::size_t filled_;
+        };
+
+        // The lines of a coordinate matrix, sorted first
+        template<class M>
+        class coordinate_lines {
+        public:
+            typedef typename M::value_type value_type;
+
+            explicit coordinate_lines (const M &m):
+                m_ (m), starts_ () {
+                m.sort ();
+                const std::size_t lines = row_major () ? m.size1 () : m.size2 ();
+                starts_.assign (lines + 1, 0);
+                for (std::size_t k = 0; k < std::size_t (m.filled ()); ++ k)
+                    ++ starts_ [m.index1_data () [k] - M::index_base () + 1];
+                for (std::size_t l = 0; l < lines; ++ l)
+                    starts_ [l + 1] += starts_ [l];
+            }
+
+            BOOST_UBLAS_INLINE
+            bool row_major () const {
+                return boost::is_same<typename M::orientation_category, row_major_tag>::value;
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t lines () const {
+                return starts_.size () - 1;
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t line_size () const {
+                return row_major () ? m_.size2 () : m_.size1 ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t nnz () const {
+                return starts_.back ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t begin (std::size_t l) const {
+                return starts_ [l];
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t end (std::size_t l) const {
+                return starts_ [l + 1];
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t index (std::size_t k) const {
+                return m_.index2_data () [k] - M::index_base ();
+            }
+            BOOST_UBLAS_INLINE
+            const value_type &value (std::size_t k) const {
+                return m_.value_data () [k];
+            }
+
+        private:
+            const M &m_;
+            std::vector<std::size_t> starts_;
+        };
+
+        // Sink into a compressed matrix reserved for all elements
+        template<class M>
+        class compressed_sink {
+        public:
+            typedef typename M::size_type size_type;
+
+            BOOST_UBLAS_INLINE
+            explicit compressed_sink (M &m):
+                m_ (m) {}
+
+            BOOST_UBLAS_INLINE
+            void start (std::size_t l, std::size_t p) {
+                m_.index1_data () [l] = size_type (p + M::index_base ());
+            }
+            template<class T>
+            BOOST_UBLAS_INLINE
+            void operator () (std::size_t p, std::size_t /* l */, std::size_t i, const T &t) {
+                m_.index2_data () [p] = size_type (i + M::index_base ());
+                m_.value_data () [p] = t;
+            }
+
+        private:
+            M &m_;
+        };
+
+        // Sink into a coordinate matrix reserved for all elements, which keeps the total
+        template<class M>
+        class coordinate_sink {
+        public:
+            typedef typename M::size_type size_type;
+
+            BOOST_UBLAS_INLINE
+            explicit coordinate_sink (M &m):
+                m_ (m), filled_ (0) {}
+
+            BOOST_UBLAS_INLINE
+            std::size_t filled () const {
+                return filled_;
+            }
+
+            BOOST_UBLAS_INLINE
+            void start (std::size_t /* l */, std::size_t p) {
+                filled_ = p;
+            }
+            template<class T>
+            BOOST_UBLAS_INLINE
+            void operator () (std::size_t p, std::size_t l, std::size_t i, const T &t) {
+                m_.index1_data () [p] = size_type (l + M::index_base ());
+                m_.index2_data () [p] = size_type (i + M::index_base ());
+                m_.value_data () [p] = t;
+            }
+
+        private:
+            M &m_;
+            std::size_t filled_;
+        };
+
+        template<class V, class T, class L, std::size_t IB, class IA, class TA>
+        void sparse_lines_assign (const V &v, compressed_matrix<T, L, IB, IA, TA> &m) {
+            const std::size_t size_M = L::size_M (m.size1 (), m.size2 ());
+            m.reserve (v.nnz (), false);
+            compressed_sink<compressed_matrix<T, L, IB, IA, TA> > s (m);
+            sparse_lines_convert (v, boost::is_same<typename L::orientation_category, row_major_tag>::value, s);
+            m.set_filled (size_M + 1, m.index1_data () [size_M] - IB);
+        }
+
+        template<class V, class T, class L, std::size_t IB, class IA, class TA>
+        void sparse_lines_assign (const V &v, coordinate_matrix<T, L, IB, IA, TA> &m) {
+            m.reserve (v.nnz (), false);
+            coordinate_sink<coordinate_matrix<T, L, IB, IA, TA> > s (m);
+            sparse_lines_convert (v, boost::is_same<typename L::orientation_category, row_major_tag>::value, s);
+            m.set_sorted_filled (s.filled ());
+        }
+
+        // The lines of v appended to the map of m, both in the same orientation
+        template<class V, class T, class L, class A>
+        void mapped_lines_append (const V &v, mapped_matrix<T, L, A> &m) {
+            typedef typename V::value_type value_type;
+            typedef typename A::value_type pair_type;
+            for (std::size_t l = 0; l < v.lines (); ++ l)
+                for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+                    if (v.value (k) != value_type/*zero*/()) {
+                        const std::size_t i = v.row_major () ? l : v.index (k);
+                        const std::size_t j = v.row_major () ? v.index (k) : l;
+                        map_append (m.data (), pair_type (L::element (i, m.size1 (), j, m.size2 ()), v.value (k)));
+                    }
+        }
+
+        // The map is filled in the order of its keys, through the lines of the other orientation
+        // when v does not have the orientation of m
+        template<class V, class T, class L, class A>
+        void sparse_lines_assign (const V &v, mapped_matrix<T, L, A> &m) {
+            const bool row_major = boost::is_same<typename L::orientation_category, row_major_tag>::value;
+            m.clear ();
+            m.reserve (v.nnz ());
+            if (v.row_major () == row_major) {
+                mapped_lines_append (v, m);
+            } else {
+                sparse_lines_buffer<typename V::value_type> b;
+                b.prepare (row_major, v.line_size (), v.lines (), v.nnz ());
+                sparse_lines_transpose (v, b);
+                mapped_lines_append (b, m);
+            }
+        }
+    }
+
+    // Conversion into any other sparse matrix format, in O(nnz), see sparse_conversion_traits
+    template<class T2, class L2, std::size_t IB2, class IA2, class TA2, class M>
+    void sparse_convert (const compressed_matrix<T2, L2, IB2, IA2, TA2> &e, M &m) {
+        if (static_cast<const void *> (&e) != static_cast<const void *> (&m))
+            sparse_lines_assign (detail::compressed_lines<compressed_matrix<T2, L2, IB2, IA2, TA2> > (e), m);
+    }
+    template<class T2, class L2, std::size_t IB2, class IA2, class TA2, class M>
+    void sparse_convert (const coordinate_matrix<T2, L2, IB2, IA2, TA2> &e, M &m) {
+        if (static_cast<const void *> (&e) != static_cast<const void *> (&m))
+            sparse_lines_assign (detail::coordinate_lines<coordinate_matrix<T2, L2, IB2, IA2, TA2> > (e), m);
+    }
+    // The elements of the map are gathered line by line first
+    template<class T2, class L2, class A2, class M>
+    void sparse_convert (const mapped_matrix<T2, L2, A2> &e, M &m) {
+        if (static_cast<const void *> (&e) != static_cast<const void *> (&m)) {
+            detail::sparse_lines_buffer<T2> b;
+            b.gather (e, typename L2::orientation_category ());
+            sparse_lines_assign (b, m);
+        }
+    }
+
+    namespace detail {
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        struct sparse_merge_traits<compressed_matrix<T, L, IB, IA, TA> > {
+            static const bool value = true;
+        };
+
+        // Sink into a compressed matrix, reserved for all elements once their number is known
+        template<class M>
+        class compressed_merge_sink:
+            public compressed_sink<M> {
+        public:
+            BOOST_UBLAS_INLINE
+            compressed_merge_sink (M &m, std::size_t lines):
+                compressed_sink<M> (m), m_ (m), lines_ (lines) {}
+
+            BOOST_UBLAS_INLINE
+            void start (std::size_t l, std::size_t p) {
+                if (l == lines_)
+                    m_.reserve (p, false);
+                compressed_sink<M>::start (l, p);
+            }
+
+        private:
+            M &m_;
+            std::size_t lines_;
+        };
+    }
+
+    /** \brief Element wise sum, difference or product of two compressed matrices, merged line by
+     * line into \c m in two passes, the first counting the elements of each line
+     *
+     * The operation is the functor \c F, scalar_plus, scalar_minus or scalar_multiplies. A
+     * product only visits the elements stored in both operands. Zero results are dropped. The
+     * lines are shared between OpenMP threads. \c m may be either operand.
+     */
+    template<class F, class T, class L, std::size_t IB, class IA, class TA>
+    void sparse_merge (const compressed_matrix<T, L, IB, IA, TA> &e1, const compressed_matrix<T, L, IB, IA, TA> &e2,
+                       compressed_matrix<T, L, IB, IA, TA> &m, F) {
+        typedef compressed_matrix<T, L, IB, IA, TA> matrix_type;
+        BOOST_UBLAS_CHECK (e1.size1 () == e2.size1 () && e1.size2 () == e2.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == e1.size1 () && m.size2 () == e1.size2 (), bad_size ());
+        const std::size_t size_M = L::size_M (e1.size1 (), e1.size2 ());
+        matrix_type t (e1.size1 (), e1.size2 (), 0);
+        detail::compressed_merge_sink<matrix_type> s (t, size_M);
+        detail::sparse_lines_merge<F> (detail::compressed_lines<matrix_type> (e1), detail::compressed_lines<matrix_type> (e2),
+                                       detail::merge_functor_traits<F>::intersection, s);
+        t.set_filled (size_M + 1, t.index1_data () [size_M] - IB);
+        m.assign_temporary (t);
+    }
+
 }}}
 
 #endif
@@ -14,6 +14,7 @@
 #define _BOOST_UBLAS_OPERATION_
 
 #include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/detail/temporary.hpp>
 
 /** \file operation.hpp
  *  \brief This file contains some specialized products.
@@ -75,7 +76,7 @@ namespace boost { namespace numeric { namespace ublas {
         if (init)
             v.assign (zero_vector<value_type> (e1.size1 ()));
 #if BOOST_UBLAS_TYPE_CHECK
-        vector<value_type> cv (v);
+        typename vector_scratch_traits<value_type>::type cv (v);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
@@ -122,6 +123,112 @@ namespace boost { namespace numeric { namespace ublas {
         return v;
     }
 
+    namespace detail {
+        // Matrices with a kernel for the product with a vector, used through v.plus_assign
+        // when v and e2 are contiguous dense vectors, see matrix_vector_axpy
+        template<class V, class E1, class E2>
+        BOOST_UBLAS_INLINE
+        V &
+        kernel_axpy_prod (const E1 &e1,
+                          const vector_expression<E2> &e2,
+                          V &v, bool init) {
+            typedef typename V::value_type value_type;
+
+            if (init)
+                v.assign (zero_vector<value_type> (e1.size1 ()));
+            return v.plus_assign (prod (e1, e2));
+        }
+    }
+
+    template<class V, class T1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const banded_matrix<T1, L1, A1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class M1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const banded_adaptor<M1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, class TRI1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const symmetric_matrix<T1, TRI1, L1, A1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class M1, class TRI1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const symmetric_adaptor<M1, TRI1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, class TRI1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const hermitian_matrix<T1, TRI1, L1, A1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class M1, class TRI1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const hermitian_adaptor<M1, TRI1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, std::size_t BR1, std::size_t BC1, class L1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const block_compressed_matrix<T1, BR1, BC1, L1, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, std::size_t C1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const sliced_ellpack_matrix<T1, C1, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, class TRI1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const symmetric_compressed_matrix<T1, TRI1, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, class L1, std::size_t IB1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const dual_compressed_matrix<T1, L1, IB1, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+    template<class V, class T1, class L1, std::size_t IB1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const matrix_unary2<const dual_compressed_matrix<T1, L1, IB1, IA1, TA1>, scalar_identity<T1> > &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        return detail::kernel_axpy_prod (e1, e2, v, init);
+    }
+
     template<class V, class E1, class E2>
     BOOST_UBLAS_INLINE
     V &
@@ -228,6 +335,9 @@ namespace boost { namespace numeric { namespace ublas {
 
           Up to now there are some specialisation for compressed
           matrices that give a large speed up compared to prod.
+          Products over other semirings, with a structural mask of
+          the result, are the overloads of sparse_prod in
+          operation_sparse.hpp.
           
           \ingroup blas2
 
@@ -250,7 +360,7 @@ namespace boost { namespace numeric { namespace ublas {
         if (init)
             v.assign (zero_vector<value_type> (e1 ().size1 ()));
 #if BOOST_UBLAS_TYPE_CHECK
-        vector<value_type> cv (v);
+        typename vector_scratch_traits<value_type>::type cv (v);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
@@ -322,7 +432,7 @@ namespace boost { namespace numeric { namespace ublas {
         if (init)
             v.assign (zero_vector<value_type> (e2.size2 ()));
 #if BOOST_UBLAS_TYPE_CHECK
-        vector<value_type> cv (v);
+        typename vector_scratch_traits<value_type>::type cv (v);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
@@ -472,7 +582,7 @@ namespace boost { namespace numeric { namespace ublas {
         if (init)
             v.assign (zero_vector<value_type> (e2 ().size2 ()));
 #if BOOST_UBLAS_TYPE_CHECK
-        vector<value_type> cv (v);
+        typename vector_scratch_traits<value_type>::type cv (v);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
@@ -508,7 +618,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix<value_type, row_major> cm (m);
+        typename matrix_scratch_traits<value_type, row_major>::type cm (m);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_plus_assign> (cm, prod (e1, e2), row_major_tag ());
@@ -538,7 +648,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix<value_type, row_major> cm (m);
+        typename matrix_scratch_traits<value_type, row_major>::type cm (m);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_plus_assign> (cm, prod (e1, e2), row_major_tag ());
@@ -587,7 +697,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix<value_type, column_major> cm (m);
+        typename matrix_scratch_traits<value_type, column_major>::type cm (m);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_plus_assign> (cm, prod (e1, e2), column_major_tag ());
@@ -617,7 +727,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix<value_type, column_major> cm (m);
+        typename matrix_scratch_traits<value_type, column_major>::type cm (m);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_plus_assign> (cm, prod (e1, e2), column_major_tag ());
@@ -681,6 +791,50 @@ namespace boost { namespace numeric { namespace ublas {
         return axpy_prod (e1, e2, m, triangular_restriction (), true);
     }
 
+    // Products with a triangular_matrix or triangular_adaptor, see triangular.hpp
+    template<class M, class E1, class E2, class O>
+    BOOST_UBLAS_INLINE
+    M &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               M &m, full,
+               detail::triangular_prod_tag, O) {
+        if (m.size1 () != 0 && m.size2 () != 0)
+            triangular_prod_axpy (detail::closure_matrix (e1 ()), detail::closure_matrix (e2 ()), m, false);
+        return m;
+    }
+
+    // Products with a diagonal_matrix or diagonal_adaptor, see banded.hpp
+    template<class M, class E1, class E2, class O>
+    BOOST_UBLAS_INLINE
+    M &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               M &m, full,
+               detail::diagonal_prod_tag, O) {
+        typedef typename M::value_type value_type;
+        typedef typename M::storage_category storage_category;
+        if (m.size1 () == 0 || m.size2 () == 0 ||
+            diagonal_prod_axpy (detail::closure_matrix (e1 ()), detail::closure_matrix (e2 ()), m, value_type (1), false))
+            return m;
+        // A band wider than the diagonal
+        return axpy_prod (e1, e2, m, full (), storage_category (), O ());
+    }
+
+    // Products of a sparse matrix with a kernel and a dense matrix, see matrix_matrix_kernel_traits
+    template<class M, class E1, class E2, class O>
+    BOOST_UBLAS_INLINE
+    M &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               M &m, full,
+               detail::matrix_matrix_kernel_tag, O) {
+        typedef typename M::value_type value_type;
+        if (m.size1 () != 0 && m.size2 () != 0)
+            matrix_matrix_axpy (detail::closure_matrix (e1 ()), detail::closure_matrix (e2 ()), m, value_type (1));
+        return m;
+    }
+
   /** \brief computes <tt>M += A X</tt> or <tt>M = A X</tt> in an
           optimized fashion.
 
@@ -694,7 +848,16 @@ namespace boost { namespace numeric { namespace ublas {
           <tt>M.clear()</tt> before <tt>axpy_prod</tt>. Currently \a init
           defaults to \c true, but this may change in the future.
 
-          Up to now there are no specialisations.
+          Products with a triangular_matrix or a triangular_adaptor of a
+          dense matrix, in either order, into a dense matrix only read
+          the stored triangle, see triangular.hpp. Products with a
+          diagonal_matrix or a diagonal_adaptor scale the rows or the
+          columns of the dense operand, see banded.hpp. Products of a
+          compressed_matrix and a dense matrix into a dense matrix add
+          whole rows of the dense operand at once, products of a
+          block_compressed_matrix are computed block by block, and
+          products of a sliced_ellpack_matrix slice by slice, see
+          matrix_sparse.hpp.
           
           \ingroup blas3
 
@@ -715,9 +878,14 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::storage_category storage_category;
         typedef typename M::orientation_category orientation_category;
 
+        typedef typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type product_type;
+        typedef typename detail::matrix_prod_traits<M, matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, product_type> >,
+                                                    scalar_plus_assign<typename M::reference, product_type>,
+                                                    storage_category>::storage_category prod_category;
+
         if (init)
             m.assign (zero_matrix<value_type> (e1 ().size1 (), e2 ().size2 ()));
-        return axpy_prod (e1, e2, m, full (), storage_category (), orientation_category ());
+        return axpy_prod (e1, e2, m, full (), prod_category (), orientation_category ());
     }
     template<class M, class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -745,15 +913,15 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix<value_type, row_major> cm (m);
+        typename matrix_scratch_traits<value_type, row_major>::type cm (m);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_plus_assign> (cm, prod (e1, e2), row_major_tag ());
 #endif
         size_type size (BOOST_UBLAS_SAME (e1 ().size2 (), e2 ().size1 ()));
         for (size_type k = 0; k < size; ++ k) {
-            vector<value_type> ce1 (column (e1 (), k));
-            vector<value_type> re2 (row (e2 (), k));
+            typename vector_scratch_traits<value_type>::type ce1 (column (e1 (), k));
+            typename vector_scratch_traits<value_type>::type re2 (row (e2 (), k));
             m.plus_assign (outer_prod (ce1, re2));
         }
 #if BOOST_UBLAS_TYPE_CHECK
@@ -776,15 +944,15 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::value_type value_type;
 
 #if BOOST_UBLAS_TYPE_CHECK
-        matrix<value_type, column_major> cm (m);
+        typename matrix_scratch_traits<value_type, column_major>::type cm (m);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_plus_assign> (cm, prod (e1, e2), column_major_tag ());
 #endif
         size_type size (BOOST_UBLAS_SAME (e1 ().size2 (), e2 ().size1 ()));
         for (size_type k = 0; k < size; ++ k) {
-            vector<value_type> ce1 (column (e1 (), k));
-            vector<value_type> re2 (row (e2 (), k));
+            typename vector_scratch_traits<value_type>::type ce1 (column (e1 (), k));
+            typename vector_scratch_traits<value_type>::type re2 (row (e2 (), k));
             m.plus_assign (outer_prod (ce1, re2));
         }
 #if BOOST_UBLAS_TYPE_CHECK
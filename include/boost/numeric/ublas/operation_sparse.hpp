@@ -13,33 +13,148 @@
 #ifndef _BOOST_UBLAS_OPERATION_SPARSE_
 #define _BOOST_UBLAS_OPERATION_SPARSE_
 
+#include <vector>
+
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/functional.hpp>
+#include <boost/numeric/ublas/detail/temporary.hpp>
 
 // These scaled additions were borrowed from MTL unashamedly.
 // But Alexei Novakov had a lot of ideas to improve these. Thanks.
 
 namespace boost { namespace numeric { namespace ublas {
 
-    template<class M, class E1, class E2, class TRI>
+    // Structural masks
+    // The elements of the result of sparse_prod computed at all, every element or those stored
+    // in the mask expression, or not stored in it when complemented. A line of the mask is marked
+    // in marker, stamped with its index + 1, before the products of the same line are formed.
+    class no_mask {
+    public:
+        typedef std::size_t size_type;
+
+        template<class O>
+        BOOST_UBLAS_INLINE
+        bool select (size_type /* l */, std::vector<size_type> &/* marker */, O) const {
+            return true;
+        }
+        BOOST_UBLAS_INLINE
+        bool selected (size_type /* l */, size_type /* k */, const std::vector<size_type> &/* marker */) const {
+            return true;
+        }
+    };
+
+    template<class E>
+    class structural_mask {
+    public:
+        typedef std::size_t size_type;
+        typedef E expression_type;
+
+        BOOST_UBLAS_INLINE
+        structural_mask (const expression_type &e, bool complemented = false):
+            e_ (e), complemented_ (complemented) {}
+
+        BOOST_UBLAS_INLINE
+        const expression_type &expression () const {
+            return e_;
+        }
+        BOOST_UBLAS_INLINE
+        bool complemented () const {
+            return complemented_;
+        }
+
+        // Marks row or column l of a matrix mask, false if no element of the line is selected
+        BOOST_UBLAS_INLINE
+        bool select (size_type l, std::vector<size_type> &marker, row_major_tag) const {
+            if (marker.size () < e_.size2 ())
+                marker.resize (e_.size2 (), 0);
+            bool stored (false);
+            typename expression_type::const_iterator2 it (e_.find2 (1, l, 0));
+            typename expression_type::const_iterator2 it_end (e_.find2 (1, l, e_.size2 ()));
+            for (; it != it_end; ++ it, stored = true)
+                marker [it.index2 ()] = l + 1;
+            return stored || complemented_;
+        }
+        BOOST_UBLAS_INLINE
+        bool select (size_type l, std::vector<size_type> &marker, column_major_tag) const {
+            if (marker.size () < e_.size1 ())
+                marker.resize (e_.size1 (), 0);
+            bool stored (false);
+            typename expression_type::const_iterator1 it (e_.find1 (1, 0, l));
+            typename expression_type::const_iterator1 it_end (e_.find1 (1, e_.size1 (), l));
+            for (; it != it_end; ++ it, stored = true)
+                marker [it.index1 ()] = l + 1;
+            return stored || complemented_;
+        }
+        // Marks a vector mask as its line 0
+        BOOST_UBLAS_INLINE
+        bool select (size_type /* l */, std::vector<size_type> &marker, vector_tag) const {
+            marker.assign (e_.size (), 0);
+            bool stored (false);
+            typename expression_type::const_iterator it (e_.begin ());
+            typename expression_type::const_iterator it_end (e_.end ());
+            for (; it != it_end; ++ it, stored = true)
+                marker [it.index ()] = 1;
+            return stored || complemented_;
+        }
+        BOOST_UBLAS_INLINE
+        bool selected (size_type l, size_type k, const std::vector<size_type> &marker) const {
+            return (marker [k] == l + 1) != complemented_;
+        }
+
+    private:
+        const expression_type &e_;
+        bool complemented_;
+    };
+
+    template<class E>
+    BOOST_UBLAS_INLINE
+    structural_mask<E> mask (const matrix_expression<E> &e) {
+        return structural_mask<E> (e ());
+    }
+    template<class E>
+    BOOST_UBLAS_INLINE
+    structural_mask<E> mask (const vector_expression<E> &e) {
+        return structural_mask<E> (e ());
+    }
+    template<class E>
+    BOOST_UBLAS_INLINE
+    structural_mask<E> complement_mask (const matrix_expression<E> &e) {
+        return structural_mask<E> (e (), true);
+    }
+    template<class E>
+    BOOST_UBLAS_INLINE
+    structural_mask<E> complement_mask (const vector_expression<E> &e) {
+        return structural_mask<E> (e (), true);
+    }
+
+    // The sums and products of the kernels are those of the semiring S, see functional.hpp,
+    // and the elements of the result are formed only where the mask K selects them
+    template<class M, class E1, class E2, class TRI, class S, class K>
     BOOST_UBLAS_INLINE
     M &
     sparse_prod (const matrix_expression<E1> &e1,
                  const matrix_expression<E2> &e2,
-                 M &m, TRI,
+                 M &m, TRI, S, const K &mask,
                  row_major_tag) {
         typedef M matrix_type;
         typedef TRI triangular_restriction;
+        typedef S semiring_type;
         typedef const E1 expression1_type;
         typedef const E2 expression2_type;
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
 
         // ISSUE why is there a dense vector here?
-        vector<value_type> temporary (e2 ().size2 ());
-        temporary.clear ();
+        typename vector_scratch_traits<value_type>::type temporary (e2 ().size2 (), semiring_type::zero ());
+        std::vector<std::size_t> marker;
         typename expression1_type::const_iterator1 it1 (e1 ().begin1 ());
         typename expression1_type::const_iterator1 it1_end (e1 ().end1 ());
         while (it1 != it1_end) {
+            const size_type i (it1.index1 ());
+            if (! mask.select (i, marker, row_major_tag ())) {
+                ++ it1;
+                continue;
+            }
             size_type jb (temporary.size ());
             size_type je (0);
 #ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
@@ -56,22 +171,24 @@ namespace boost { namespace numeric { namespace ublas {
                 typename matrix_row<expression2_type>::const_iterator itr_end (mr.end ());
                 while (itr != itr_end) {
                     size_type j (itr.index ());
-                    temporary (j) += *it2 * *itr;
-                    jb = (std::min) (jb, j);
-                    je = (std::max) (je, j);
+                    if (mask.selected (i, j, marker)) {
+                        temporary (j) = semiring_type::plus (temporary (j), semiring_type::times (*it2, *itr));
+                        jb = (std::min) (jb, j);
+                        je = (std::max) (je, j);
+                    }
                     ++ itr;
                 }
                 ++ it2;
             }
             for (size_type j = jb; j < je + 1; ++ j) {
-                if (temporary (j) != value_type/*zero*/()) {
+                if (temporary (j) != semiring_type::zero ()) {
                     // FIXME we'll need to extend the container interface!
-                    // m.push_back (it1.index1 (), j, temporary (j));
+                    // m.push_back (i, j, temporary (j));
                     // FIXME What to do with adaptors?
-                    // m.insert (it1.index1 (), j, temporary (j));
-                    if (triangular_restriction::other (it1.index1 (), j))
-                        m (it1.index1 (), j) = temporary (j);
-                    temporary (j) = value_type/*zero*/();
+                    // m.insert (i, j, temporary (j));
+                    if (triangular_restriction::other (i, j))
+                        m (i, j) = temporary (j);
+                    temporary (j) = semiring_type::zero ();
                 }
             }
             ++ it1;
@@ -79,26 +196,32 @@ namespace boost { namespace numeric { namespace ublas {
         return m;
     }
 
-    template<class M, class E1, class E2, class TRI>
+    template<class M, class E1, class E2, class TRI, class S, class K>
     BOOST_UBLAS_INLINE
     M &
     sparse_prod (const matrix_expression<E1> &e1,
                  const matrix_expression<E2> &e2,
-                 M &m, TRI,
+                 M &m, TRI, S, const K &mask,
                  column_major_tag) {
         typedef M matrix_type;
         typedef TRI triangular_restriction;
+        typedef S semiring_type;
         typedef const E1 expression1_type;
         typedef const E2 expression2_type;
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
 
         // ISSUE why is there a dense vector here?
-        vector<value_type> temporary (e1 ().size1 ());
-        temporary.clear ();
+        typename vector_scratch_traits<value_type>::type temporary (e1 ().size1 (), semiring_type::zero ());
+        std::vector<std::size_t> marker;
         typename expression2_type::const_iterator2 it2 (e2 ().begin2 ());
         typename expression2_type::const_iterator2 it2_end (e2 ().end2 ());
         while (it2 != it2_end) {
+            const size_type j (it2.index2 ());
+            if (! mask.select (j, marker, column_major_tag ())) {
+                ++ it2;
+                continue;
+            }
             size_type ib (temporary.size ());
             size_type ie (0);
 #ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
@@ -115,22 +238,24 @@ namespace boost { namespace numeric { namespace ublas {
                 typename matrix_column<expression1_type>::const_iterator itc_end (mc.end ());
                 while (itc != itc_end) {
                     size_type i (itc.index ());
-                    temporary (i) += *it1 * *itc;
-                    ib = (std::min) (ib, i);
-                    ie = (std::max) (ie, i);
+                    if (mask.selected (j, i, marker)) {
+                        temporary (i) = semiring_type::plus (temporary (i), semiring_type::times (*itc, *it1));
+                        ib = (std::min) (ib, i);
+                        ie = (std::max) (ie, i);
+                    }
                     ++ itc;
                 }
                 ++ it1;
             }
             for (size_type i = ib; i < ie + 1; ++ i) {
-                if (temporary (i) != value_type/*zero*/()) {
+                if (temporary (i) != semiring_type::zero ()) {
                     // FIXME we'll need to extend the container interface!
-                    // m.push_back (i, it2.index2 (), temporary (i));
+                    // m.push_back (i, j, temporary (i));
                     // FIXME What to do with adaptors?
-                    // m.insert (i, it2.index2 (), temporary (i));
-                    if (triangular_restriction::other (i, it2.index2 ()))
-                        m (i, it2.index2 ()) = temporary (i);
-                    temporary (i) = value_type/*zero*/();
+                    // m.insert (i, j, temporary (i));
+                    if (triangular_restriction::other (i, j))
+                        m (i, j) = temporary (i);
+                    temporary (i) = semiring_type::zero ();
                 }
             }
             ++ it2;
@@ -138,6 +263,32 @@ namespace boost { namespace numeric { namespace ublas {
         return m;
     }
 
+    // The products of the usual sums and products, with no mask
+    template<class M, class E1, class E2, class TRI>
+    BOOST_UBLAS_INLINE
+    M &
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const matrix_expression<E2> &e2,
+                 M &m, TRI,
+                 row_major_tag) {
+        typedef typename M::value_type value_type;
+        typedef TRI triangular_restriction;
+
+        return sparse_prod (e1, e2, m, triangular_restriction (), plus_times_semiring<value_type> (), no_mask (), row_major_tag ());
+    }
+    template<class M, class E1, class E2, class TRI>
+    BOOST_UBLAS_INLINE
+    M &
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const matrix_expression<E2> &e2,
+                 M &m, TRI,
+                 column_major_tag) {
+        typedef typename M::value_type value_type;
+        typedef TRI triangular_restriction;
+
+        return sparse_prod (e1, e2, m, triangular_restriction (), plus_times_semiring<value_type> (), no_mask (), column_major_tag ());
+    }
+
     // Dispatcher
     template<class M, class E1, class E2, class TRI>
     BOOST_UBLAS_INLINE
@@ -151,7 +302,7 @@ namespace boost { namespace numeric { namespace ublas {
 
         if (init)
             m.assign (zero_matrix<value_type> (e1 ().size1 (), e2 ().size2 ()));
-        return sparse_prod (e1, e2, m, triangular_restriction (), orientation_category ());
+        return sparse_prod (e1, e2, m, triangular_restriction (), plus_times_semiring<value_type> (), no_mask (), orientation_category ());
     }
     template<class M, class E1, class E2, class TRI>
     BOOST_UBLAS_INLINE
@@ -178,7 +329,7 @@ namespace boost { namespace numeric { namespace ublas {
 
         if (init)
             m.assign (zero_matrix<value_type> (e1 ().size1 (), e2 ().size2 ()));
-        return sparse_prod (e1, e2, m, full (), orientation_category ());
+        return sparse_prod (e1, e2, m, full (), plus_times_semiring<value_type> (), no_mask (), orientation_category ());
     }
     template<class M, class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -193,6 +344,165 @@ namespace boost { namespace numeric { namespace ublas {
         return sparse_prod (e1, e2, m, full (), true);
     }
 
+
+    /** \brief Sparse product of two matrix expressions over the semiring \c S, written to \c m
+     * where the mask selects it.
+     *
+     * The sums and products of the elements are \c S::plus and \c S::times, of a semiring of
+     * functional.hpp such as plus_times_semiring, min_plus_semiring, max_times_semiring or
+     * or_and_semiring. The unstored elements of the operands and of the result stand for
+     * \c S::zero (): only the stored elements take part in the product, and the elements of
+     * the result with no term or equal to \c S::zero () are not stored. The mask, \c no_mask (),
+     * \c mask (e) or \c complement_mask (e), restricts the elements formed to those stored or
+     * not stored in \c e, which prunes the products themselves rather than their results.
+     *
+     * \param e1 the left matrix expression
+     * \param e2 the right matrix expression
+     * \param m the result, assigned a zero matrix first when \c init
+     * \param mask the structural mask of the result
+     */
+    template<class M, class E1, class E2, class S, class K>
+    BOOST_UBLAS_INLINE
+    M &
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const matrix_expression<E2> &e2,
+                 M &m, S, const K &mask, bool init = true) {
+        typedef typename M::value_type value_type;
+        typedef typename M::orientation_category orientation_category;
+
+        if (init)
+            m.assign (zero_matrix<value_type> (e1 ().size1 (), e2 ().size2 ()));
+        return sparse_prod (e1, e2, m, full (), S (), mask, orientation_category ());
+    }
+    template<class M, class E1, class E2, class S, class K>
+    BOOST_UBLAS_INLINE
+    M
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const matrix_expression<E2> &e2,
+                 S, const K &mask) {
+        typedef M matrix_type;
+
+        matrix_type m (e1 ().size1 (), e2 ().size2 ());
+        return sparse_prod (e1, e2, m, S (), mask, true);
+    }
+
+    // Matrix vector products over a semiring, pulling the rows of a row major matrix or pushing
+    // the columns of a column major one selected by the stored elements of the vector
+    template<class V, class E1, class E2, class S, class K>
+    BOOST_UBLAS_INLINE
+    V &
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const vector_expression<E2> &e2,
+                 V &v, S, const K &mask,
+                 row_major_tag) {
+        typedef S semiring_type;
+        typedef const E1 expression1_type;
+        typedef const E2 expression2_type;
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type value_type;
+
+        typename vector_scratch_traits<value_type>::type temporary (e2 ().size (), semiring_type::zero ());
+        std::vector<bool> stored (e2 ().size (), false);
+        typename expression2_type::const_iterator it (e2 ().begin ());
+        typename expression2_type::const_iterator it_end (e2 ().end ());
+        for (; it != it_end; ++ it) {
+            temporary (it.index ()) = *it;
+            stored [it.index ()] = true;
+        }
+        std::vector<std::size_t> marker;
+        if (! mask.select (0, marker, vector_tag ()))
+            return v;
+        typename expression1_type::const_iterator1 it1 (e1 ().begin1 ());
+        typename expression1_type::const_iterator1 it1_end (e1 ().end1 ());
+        for (; it1 != it1_end; ++ it1) {
+            const size_type i (it1.index1 ());
+            if (! mask.selected (0, i, marker))
+                continue;
+            value_type t (semiring_type::zero ());
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            typename expression1_type::const_iterator2 it2 (it1.begin ());
+            typename expression1_type::const_iterator2 it2_end (it1.end ());
+#else
+            typename expression1_type::const_iterator2 it2 (boost::numeric::ublas::begin (it1, iterator1_tag ()));
+            typename expression1_type::const_iterator2 it2_end (boost::numeric::ublas::end (it1, iterator1_tag ()));
+#endif
+            for (; it2 != it2_end; ++ it2)
+                if (stored [it2.index2 ()])
+                    t = semiring_type::plus (t, semiring_type::times (*it2, temporary (it2.index2 ())));
+            if (t != semiring_type::zero ())
+                v (i) = t;
+        }
+        return v;
+    }
+
+    template<class V, class E1, class E2, class S, class K>
+    BOOST_UBLAS_INLINE
+    V &
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const vector_expression<E2> &e2,
+                 V &v, S, const K &mask,
+                 column_major_tag) {
+        typedef S semiring_type;
+        typedef const E1 expression1_type;
+        typedef const E2 expression2_type;
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type value_type;
+
+        typename vector_scratch_traits<value_type>::type temporary (e1 ().size1 (), semiring_type::zero ());
+        std::vector<std::size_t> marker;
+        if (! mask.select (0, marker, vector_tag ()))
+            return v;
+        size_type ib (temporary.size ());
+        size_type ie (0);
+        typename expression2_type::const_iterator it (e2 ().begin ());
+        typename expression2_type::const_iterator it_end (e2 ().end ());
+        for (; it != it_end; ++ it) {
+            matrix_column<expression1_type> mc (e1 (), it.index ());
+            typename matrix_column<expression1_type>::const_iterator itc (mc.begin ());
+            typename matrix_column<expression1_type>::const_iterator itc_end (mc.end ());
+            for (; itc != itc_end; ++ itc) {
+                size_type i (itc.index ());
+                if (mask.selected (0, i, marker)) {
+                    temporary (i) = semiring_type::plus (temporary (i), semiring_type::times (*itc, *it));
+                    ib = (std::min) (ib, i);
+                    ie = (std::max) (ie, i);
+                }
+            }
+        }
+        for (size_type i = ib; i < ie + 1; ++ i)
+            if (temporary (i) != semiring_type::zero ())
+                v (i) = temporary (i);
+        return v;
+    }
+
+    /** \brief Sparse product of a matrix and a vector expression over the semiring \c S,
+     * written to \c v where the vector mask selects it, see the matrix product above.
+     */
+    template<class V, class E1, class E2, class S, class K>
+    BOOST_UBLAS_INLINE
+    V &
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const vector_expression<E2> &e2,
+                 V &v, S, const K &mask, bool init = true) {
+        typedef typename V::value_type value_type;
+        typedef typename E1::orientation_category orientation_category;
+
+        if (init)
+            v.assign (zero_vector<value_type> (e1 ().size1 ()));
+        return sparse_prod (e1, e2, v, S (), mask, orientation_category ());
+    }
+    template<class V, class E1, class E2, class S, class K>
+    BOOST_UBLAS_INLINE
+    V
+    sparse_prod (const matrix_expression<E1> &e1,
+                 const vector_expression<E2> &e2,
+                 S, const K &mask) {
+        typedef V vector_type;
+
+        vector_type v (e1 ().size1 ());
+        return sparse_prod (e1, e2, v, S (), mask, true);
+    }
+
 }}}
 
 #endif
@@ -0,0 +1,405 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_ORDERING_
+#define _BOOST_UBLAS_ORDERING_
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+// Orderings of the rows and columns of square compressed matrices which reduce the bandwidth,
+// reverse Cuthill-McKee, or the fill of a Cholesky factorization, approximate minimum degree,
+// both computed from the pattern of A + trans (A) without its diagonal. A permutation p lists
+// the rows and columns in their new order: element (i, j) of P A P^T is element (p (i), p (j))
+// of A, which symmetric_permute computes in O(nnz).
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // The pattern of a + trans (a) without the diagonal as adjacency lists, the neighbours of
+    // vertex i being adjacency [starts [i], starts [i + 1]) in increasing order. The lines of v
+    // are merged with those of its transpose, which are sorted by construction.
+    template<class V>
+    void symmetric_adjacency (const V &v, std::vector<std::size_t> &starts, std::vector<std::size_t> &adjacency) {
+        const std::size_t n = v.lines ();
+        std::vector<std::size_t> transposed_starts (n + 1, 0);
+        for (std::size_t l = 0; l < n; ++ l)
+            for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+                if (v.index (k) != l)
+                    ++ transposed_starts [v.index (k) + 1];
+        for (std::size_t l = 0; l < n; ++ l)
+            transposed_starts [l + 1] += transposed_starts [l];
+        std::vector<std::size_t> transposed (transposed_starts [n]);
+        std::vector<std::size_t> next (transposed_starts.begin (), transposed_starts.end () - 1);
+        for (std::size_t l = 0; l < n; ++ l)
+            for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+                if (v.index (k) != l)
+                    transposed [next [v.index (k)] ++] = l;
+
+        starts.assign (n + 1, 0);
+        adjacency.clear ();
+        adjacency.reserve (2 * transposed.size ());
+        for (std::size_t l = 0; l < n; ++ l) {
+            std::size_t k = v.begin (l), t = transposed_starts [l];
+            while (k < v.end (l) || t < transposed_starts [l + 1]) {
+                std::size_t j;
+                if (t == transposed_starts [l + 1] || (k < v.end (l) && v.index (k) <= transposed [t]))
+                    j = v.index (k ++);
+                else
+                    j = transposed [t ++];
+                if (j != l && (adjacency.size () == starts [l] || adjacency.back () != j))
+                    adjacency.push_back (j);
+            }
+            starts [l + 1] = adjacency.size ();
+        }
+    }
+
+    // The vertices reached from root by breadth first search, level by level in order, and
+    // the number of levels. The vertices met are marked with stamp.
+    BOOST_UBLAS_INLINE
+    std::size_t adjacency_levels (const std::vector<std::size_t> &starts, const std::vector<std::size_t> &adjacency,
+                                  std::size_t root, std::vector<std::size_t> &mark, std::size_t stamp,
+                                  std::vector<std::size_t> &reached, std::size_t &last_level) {
+        reached.clear ();
+        reached.push_back (root);
+        mark [root] = stamp;
+        std::size_t levels = 0, first = 0;
+        while (first < reached.size ()) {
+            const std::size_t end = reached.size ();
+            last_level = first;
+            ++ levels;
+            for (std::size_t r = first; r < end; ++ r)
+                for (std::size_t k = starts [reached [r]]; k < starts [reached [r] + 1]; ++ k)
+                    if (mark [adjacency [k]] != stamp) {
+                        mark [adjacency [k]] = stamp;
+                        reached.push_back (adjacency [k]);
+                    }
+            first = end;
+        }
+        return levels;
+    }
+
+    // Orders vertices by degree, then by index
+    struct degree_less {
+        BOOST_UBLAS_INLINE
+        explicit degree_less (const std::vector<std::size_t> &starts):
+            starts_ (starts) {}
+        BOOST_UBLAS_INLINE
+        bool operator () (std::size_t i, std::size_t j) const {
+            const std::size_t di = starts_ [i + 1] - starts_ [i], dj = starts_ [j + 1] - starts_ [j];
+            return di < dj || (di == dj && i < j);
+        }
+        const std::vector<std::size_t> &starts_;
+    };
+
+    // The vertices of the quotient graph of an elimination
+    enum quotient_state {
+        quotient_variable, quotient_element, quotient_absorbed
+    };
+
+    // Whether j is no longer adjacent to a variable of the element marked with stamp, being
+    // eliminated or a variable of that element itself
+    struct ordering_outside {
+        BOOST_UBLAS_INLINE
+        ordering_outside (const std::vector<char> &state, const std::vector<std::size_t> &mark, std::size_t stamp):
+            state_ (state), mark_ (mark), stamp_ (stamp) {}
+        BOOST_UBLAS_INLINE
+        bool operator () (std::size_t j) const {
+            return state_ [j] != quotient_variable || mark_ [j] == stamp_;
+        }
+        const std::vector<char> &state_;
+        const std::vector<std::size_t> &mark_;
+        std::size_t stamp_;
+    };
+
+    // The lines of a view with indices renumbered by q
+    template<class V>
+    class renumbered_lines {
+    public:
+        typedef typename V::value_type value_type;
+
+        BOOST_UBLAS_INLINE
+        renumbered_lines (const V &v, const std::vector<std::size_t> &q):
+            v_ (v), q_ (q) {}
+
+        BOOST_UBLAS_INLINE
+        bool row_major () const {
+            return v_.row_major ();
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t lines () const {
+            return v_.lines ();
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t line_size () const {
+            return v_.line_size ();
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t nnz () const {
+            return v_.nnz ();
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t begin (std::size_t l) const {
+            return v_.begin (l);
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t end (std::size_t l) const {
+            return v_.end (l);
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t index (std::size_t k) const {
+            return q_ [v_.index (k)];
+        }
+        BOOST_UBLAS_INLINE
+        const value_type &value (std::size_t k) const {
+            return v_.value (k);
+        }
+
+    private:
+        const V &v_;
+        const std::vector<std::size_t> &q_;
+    };
+
+}
+
+    // Reverse Cuthill-McKee ordering. Each connected component is searched breadth first from
+    // a pseudo peripheral vertex, found from one of least degree as in George and Liu, the
+    // neighbours of each vertex being taken by increasing degree. The order is then reversed.
+    template<class T, class L, std::size_t IB, class IA, class TA, class PV>
+    void reverse_cuthill_mckee_ordering (const compressed_matrix<T, L, IB, IA, TA> &a, PV &p) {
+        typedef compressed_matrix<T, L, IB, IA, TA> matrix_type;
+        BOOST_UBLAS_CHECK (a.size1 () == a.size2 (), bad_size ());
+        const std::size_t n = a.size1 ();
+        BOOST_UBLAS_CHECK (p.size () == n, bad_size ());
+        std::vector<std::size_t> starts, adjacency;
+        detail::symmetric_adjacency (detail::compressed_lines<matrix_type> (a), starts, adjacency);
+        const detail::degree_less less (starts);
+
+        std::vector<std::size_t> by_degree (n);
+        for (std::size_t i = 0; i < n; ++ i)
+            by_degree [i] = i;
+        std::sort (by_degree.begin (), by_degree.end (), less);
+
+        std::vector<std::size_t> order, reached, candidate;
+        order.reserve (n);
+        std::vector<std::size_t> mark (n, 0);
+        std::size_t stamp = 1;
+        const std::size_t ordered = stamp ++;
+        for (std::size_t s = 0; s < n; ++ s) {
+            std::size_t root = by_degree [s];
+            if (mark [root] == ordered)
+                continue;
+            // Pseudo peripheral root: the vertex of least degree of the last level, as long as
+            // the number of levels grows
+            std::size_t last = 0;
+            std::size_t levels = detail::adjacency_levels (starts, adjacency, root, mark, stamp ++, reached, last);
+            for (;;) {
+                const std::size_t x = *std::min_element (reached.begin () + last, reached.end (), less);
+                std::size_t x_last = 0;
+                const std::size_t x_levels = detail::adjacency_levels (starts, adjacency, x, mark, stamp ++, candidate, x_last);
+                if (x_levels <= levels)
+                    break;
+                root = x;
+                levels = x_levels;
+                reached.swap (candidate);
+                last = x_last;
+            }
+
+            // Cuthill-McKee search
+            std::size_t first = order.size ();
+            order.push_back (root);
+            mark [root] = ordered;
+            while (first < order.size ()) {
+                const std::size_t v = order [first ++];
+                const std::size_t begin = order.size ();
+                for (std::size_t k = starts [v]; k < starts [v + 1]; ++ k)
+                    if (mark [adjacency [k]] != ordered) {
+                        mark [adjacency [k]] = ordered;
+                        order.push_back (adjacency [k]);
+                    }
+                std::sort (order.begin () + begin, order.end (), less);
+            }
+        }
+        for (std::size_t k = 0; k < n; ++ k)
+            p [k] = order [n - 1 - k];
+    }
+
+    // Approximate minimum degree ordering, after Amestoy, Davis and Duff. The elimination is
+    // simulated on the quotient graph: the eliminated vertex becomes an element which absorbs
+    // the elements adjacent to it, its neighbours being those of the variables of the element.
+    // The degree of each such neighbour i is bounded by the variables adjacent to i and the
+    // sizes of its elements outside the new one, |Le \ Lp|, which are counted once for all
+    // neighbours; elements found inside the new one are absorbed as well. Supervariables are
+    // not detected, every variable being eliminated on its own.
+    template<class T, class L, std::size_t IB, class IA, class TA, class PV>
+    void approximate_minimum_degree_ordering (const compressed_matrix<T, L, IB, IA, TA> &a, PV &p) {
+        typedef compressed_matrix<T, L, IB, IA, TA> matrix_type;
+        BOOST_UBLAS_CHECK (a.size1 () == a.size2 (), bad_size ());
+        const std::size_t n = a.size1 ();
+        BOOST_UBLAS_CHECK (p.size () == n, bad_size ());
+        std::vector<std::size_t> starts, adjacency;
+        detail::symmetric_adjacency (detail::compressed_lines<matrix_type> (a), starts, adjacency);
+
+        std::vector<char> state (n, detail::quotient_variable);
+        // Variables adjacent to variables, elements adjacent to variables, variables of elements
+        std::vector<std::vector<std::size_t> > variables (n), elements (n), members (n);
+        std::vector<std::size_t> degree (n);
+        for (std::size_t i = 0; i < n; ++ i) {
+            variables [i].assign (adjacency.begin () + starts [i], adjacency.begin () + starts [i + 1]);
+            degree [i] = variables [i].size ();
+        }
+        std::vector<std::size_t> ().swap (adjacency);
+
+        // Variables by degree in doubly linked lists
+        const std::size_t none = n;
+        std::vector<std::size_t> head (n + 1, none), next (n, none), previous (n, none);
+        std::size_t least = 0;
+        for (std::size_t i = 0; i < n; ++ i) {
+            next [i] = head [degree [i]];
+            if (head [degree [i]] != none)
+                previous [head [degree [i]]] = i;
+            head [degree [i]] = i;
+        }
+
+        std::vector<std::size_t> mark (n, 0), weight (n, 0), weight_mark (n, 0);
+        std::size_t stamp = 0;
+        std::vector<std::size_t> lp;
+        for (std::size_t k = 0; k < n; ++ k) {
+            while (head [least] == none)
+                ++ least;
+            const std::size_t v = head [least];
+            head [least] = next [v];
+            if (next [v] != none)
+                previous [next [v]] = none;
+            p [k] = v;
+            state [v] = detail::quotient_element;
+
+            // The variables of the new element
+            ++ stamp;
+            mark [v] = stamp;
+            lp.clear ();
+            for (std::size_t r = 0; r < variables [v].size (); ++ r) {
+                const std::size_t j = variables [v] [r];
+                if (state [j] == detail::quotient_variable && mark [j] != stamp) {
+                    mark [j] = stamp;
+                    lp.push_back (j);
+                }
+            }
+            for (std::size_t r = 0; r < elements [v].size (); ++ r) {
+                const std::size_t e = elements [v] [r];
+                if (state [e] != detail::quotient_element)
+                    continue;
+                for (std::size_t s = 0; s < members [e].size (); ++ s) {
+                    const std::size_t j = members [e] [s];
+                    if (state [j] == detail::quotient_variable && mark [j] != stamp) {
+                        mark [j] = stamp;
+                        lp.push_back (j);
+                    }
+                }
+                state [e] = detail::quotient_absorbed;
+                std::vector<std::size_t> ().swap (members [e]);
+            }
+            std::vector<std::size_t> ().swap (variables [v]);
+            std::vector<std::size_t> ().swap (elements [v]);
+            members [v] = lp;
+
+            // |Le \ Lp| for the other elements of the variables of the new element, those of
+            // them inside it being absorbed
+            for (std::size_t r = 0; r < lp.size (); ++ r) {
+                const std::vector<std::size_t> &ei = elements [lp [r]];
+                for (std::size_t s = 0; s < ei.size (); ++ s) {
+                    const std::size_t e = ei [s];
+                    if (state [e] != detail::quotient_element)
+                        continue;
+                    if (weight_mark [e] != stamp) {
+                        weight_mark [e] = stamp;
+                        weight [e] = members [e].size ();
+                    }
+                    -- weight [e];
+                }
+            }
+            for (std::size_t r = 0; r < lp.size (); ++ r) {
+                const std::vector<std::size_t> &ei = elements [lp [r]];
+                for (std::size_t s = 0; s < ei.size (); ++ s)
+                    if (state [ei [s]] == detail::quotient_element && weight [ei [s]] == 0) {
+                        state [ei [s]] = detail::quotient_absorbed;
+                        std::vector<std::size_t> ().swap (members [ei [s]]);
+                    }
+            }
+
+            // Approximate degrees of the variables of the new element
+            const std::size_t remaining = n - k - 1;
+            for (std::size_t r = 0; r < lp.size (); ++ r) {
+                const std::size_t i = lp [r];
+                if (previous [i] != none)
+                    next [previous [i]] = next [i];
+                else
+                    head [degree [i]] = next [i];
+                if (next [i] != none)
+                    previous [next [i]] = previous [i];
+
+                std::vector<std::size_t> &vi = variables [i];
+                vi.erase (std::remove_if (vi.begin (), vi.end (), detail::ordering_outside (state, mark, stamp)), vi.end ());
+                std::vector<std::size_t> &ei = elements [i];
+                std::size_t d = vi.size () + lp.size () - 1;
+                std::size_t filled = 0;
+                for (std::size_t s = 0; s < ei.size (); ++ s)
+                    if (state [ei [s]] == detail::quotient_element) {
+                        d += weight [ei [s]];
+                        ei [filled ++] = ei [s];
+                    }
+                ei.resize (filled);
+                ei.push_back (v);
+                d = (std::min) (d, degree [i] + lp.size () - 1);
+                d = (std::min) (d, remaining - 1);
+                degree [i] = d;
+
+                previous [i] = none;
+                next [i] = head [d];
+                if (head [d] != none)
+                    previous [head [d]] = i;
+                head [d] = i;
+                least = (std::min) (least, d);
+            }
+        }
+    }
+
+    // P A P^T in O(nnz) by two transpositions with renumbered indices: the first one sorts the
+    // elements of the new lines of the other orientation, the second one those of the new lines.
+    // Explicitly stored zeros are dropped.
+    template<class T, class L, std::size_t IB, class IA, class TA, class PV>
+    void symmetric_permute (const compressed_matrix<T, L, IB, IA, TA> &a, const PV &p, compressed_matrix<T, L, IB, IA, TA> &b) {
+        typedef compressed_matrix<T, L, IB, IA, TA> matrix_type;
+        BOOST_UBLAS_CHECK (a.size1 () == a.size2 (), bad_size ());
+        const std::size_t n = a.size1 ();
+        BOOST_UBLAS_CHECK (p.size () == n, bad_size ());
+        if (&a == &b) {
+            const matrix_type t (a);
+            symmetric_permute (t, p, b);
+            return;
+        }
+        std::vector<std::size_t> q (n, n);
+        for (std::size_t k = 0; k < n; ++ k) {
+            BOOST_UBLAS_CHECK (std::size_t (p [k]) < n && q [p [k]] == n, bad_argument ());
+            q [p [k]] = k;
+        }
+        const detail::compressed_lines<matrix_type> lines (a);
+        detail::sparse_lines_buffer<T> transposed;
+        transposed.prepare (! lines.row_major (), n, n, lines.nnz ());
+        detail::sparse_lines_transpose (detail::renumbered_lines<detail::compressed_lines<matrix_type> > (lines, q), transposed);
+        b.resize (n, n, false);
+        sparse_lines_assign (detail::renumbered_lines<detail::sparse_lines_buffer<T> > (transposed, q), b);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,599 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_RFP_
+#define _BOOST_UBLAS_RFP_
+
+#include <algorithm>
+
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/detail/temporary.hpp>
+
+// Cholesky factorization of symmetric and hermitian matrices in rectangular full packed storage
+// in the spirit of LAPACK pftrf and pftrs. The triangle is processed as two triangles and a
+// rectangle, the bulk of the work being done by the blocked inplace_solve of the rectangle and
+// the rank k update of the second triangle, on matrix ranges sharing the packed storage.
+//
+// Triangular solves in the spirit of pftrs's building block tfsm and rank k updates in the
+// spirit of sfrk and hfrk work on the same three blocks.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // A dense block of the rectangle with element (i, j) at data [i * stride1 + j * stride2]
+    template<class T>
+    struct rfp_block {
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        BOOST_UBLAS_INLINE
+        rfp_block ():
+            data_ (0), stride1_ (0), stride2_ (0) {}
+        BOOST_UBLAS_INLINE
+        rfp_block (T *data, size_type stride1, size_type stride2):
+            data_ (data), stride1_ (stride1), stride2_ (stride2) {}
+
+        BOOST_UBLAS_INLINE
+        T &operator () (size_type i, size_type j) const {
+            return data_ [difference_type (i) * stride1_ + difference_type (j) * stride2_];
+        }
+
+    private:
+        T *data_;
+        difference_type stride1_;
+        difference_type stride2_;
+    };
+
+    // The blocks of the lower triangle of A, or of A^T for upper storage, in the rectangle:
+    // a11 of size s, a21 of size (n - s) x s and a22 of size n - s. Returns s.
+    template<class T, class O>
+    std::size_t rfp_blocks (lower_tag, O, T *data, std::size_t n,
+                            rfp_block<T> &a11, rfp_block<T> &a21, rfp_block<T> &a22) {
+        typedef rfp_rectangle<std::size_t> rectangle;
+        const std::size_t sr = rectangle::element (O (), 1, 0, n);
+        const std::size_t sc = rectangle::element (O (), 0, 1, n);
+        const std::size_t s = rectangle::size2 (n);
+        const std::size_t e = n % 2 ? 0 : 1;
+        a11 = rfp_block<T> (data + e * sr, sr, sc);
+        a21 = rfp_block<T> (data + (s + e) * sr, sr, sc);
+        a22 = rfp_block<T> (data + (1 - e) * sc, sc, sr);
+        return s;
+    }
+    template<class T, class O>
+    std::size_t rfp_blocks (upper_tag, O, T *data, std::size_t n,
+                            rfp_block<T> &a11, rfp_block<T> &a21, rfp_block<T> &a22) {
+        typedef rfp_rectangle<std::size_t> rectangle;
+        const std::size_t sr = rectangle::element (O (), 1, 0, n);
+        const std::size_t sc = rectangle::element (O (), 0, 1, n);
+        const std::size_t s = n / 2;
+        const std::size_t e = n % 2 ? 0 : 1;
+        a11 = rfp_block<T> (data + (n - s + e) * sr, sr, sc);
+        a21 = rfp_block<T> (data, sc, sr);
+        a22 = rfp_block<T> (data + s * sr, sc, sr);
+        return s;
+    }
+
+    // The rectangle of size1 x size2 elements at data as a dense matrix sharing the storage. In
+    // the layout of the packed matrix and in the transposed one, each block of rfp_blocks and its
+    // transpose are ranges of one of the two.
+    template<class T, class L>
+    void rfp_rectangle_matrix (matrix<T, L, array_adaptor<T> > &r, T *data, std::size_t size1, std::size_t size2) {
+        r.resize (size1, size2, false);
+        r.data ().resize (size1 * size2, data);
+    }
+
+    // a := F (a) on the block a, which turns the transpose of a21 into F (a21)^T
+    template<class T, class M>
+    void rfp_apply (scalar_identity<T>, M &) {}
+    template<class T, class M>
+    void rfp_apply (scalar_conj<T>, M &a) {
+        a.assign (conj (a));
+    }
+
+    // a22 := a22 - F (y)^T * y on the lower triangle of a22, with y = F (a21)^T
+    template<class T, class M22, class M21>
+    void rfp_downdate (scalar_identity<T>, M22 &a22, const M21 &y) {
+        symmetric_adaptor<M22, lower> s (a22);
+        symmetric_prod_update (s, trans (y), y, T (-1), T (1));
+    }
+    template<class T, class M22, class M21>
+    void rfp_downdate (scalar_conj<T>, M22 &a22, const M21 &y) {
+        hermitian_adaptor<M22, lower> h (a22);
+        symmetric_prod_update (h, herm (y), y, T (-1), T (1));
+    }
+
+    template<class F, class M, class MT>
+    std::size_t rfp_potrf (M &m, MT &mt, std::size_t i0, std::size_t j0, std::size_t n, bool definite);
+
+    // One step of a blocked Cholesky factorization: the diagonal block of size s at (i1, j1) of
+    // m1 is factorized, a21 := a21 * F (L11)^-T by a triangular solve on its transpose a21t, the
+    // lower triangle of the diagonal block of size n2 at (i2, j2) of m2 is downdated by a rank
+    // s update and factorized. m1t and m2t are the transposes of m1 and m2.
+    template<class F, class M1, class M1T, class M21, class M2, class M2T>
+    std::size_t rfp_potrf_split (M1 &m1, M1T &m1t, std::size_t i1, std::size_t j1, std::size_t s, M21 a21t,
+                                 M2 &m2, M2T &m2t, std::size_t i2, std::size_t j2, std::size_t n2, bool definite) {
+        std::size_t singular = rfp_potrf<F> (m1, m1t, i1, j1, s, definite);
+        if (singular != 0)
+            return singular;
+        // F (a21)^T := L11^-1 * F (a21)^T
+        const matrix_range<M1> a11 (m1, range (i1, i1 + s), range (j1, j1 + s));
+        rfp_apply (F (), a21t);
+        inplace_solve (triangular_adaptor<const matrix_range<M1>, lower> (a11), a21t, lower_tag ());
+        matrix_range<M2> a22 (m2, range (i2, i2 + n2), range (j2, j2 + n2));
+        rfp_downdate (F (), a22, a21t);
+        rfp_apply (F (), a21t);
+        singular = rfp_potrf<F> (m2, m2t, i2, j2, n2, definite);
+        return singular != 0 ? singular + s : 0;
+    }
+
+    // Factorizes the lower triangle of the diagonal block of size n at (i0, j0) of m as
+    // L * F (L)^T, mt being the transpose of m. Blocks larger than the solve block size are
+    // split in two. Returns 0, or i + 1 for the first pivot i which is zero or, for definite
+    // matrices, not positive.
+    template<class F, class M, class MT>
+    std::size_t rfp_potrf (M &m, MT &mt, std::size_t i0, std::size_t j0, std::size_t n, bool definite) {
+        typedef std::size_t size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+        if (n > BOOST_UBLAS_SOLVE_BLOCK_SIZE) {
+            const size_type s = n / 2;
+            return rfp_potrf_split<F> (m, mt, i0, j0, s, project (mt, range (j0, j0 + s), range (i0 + s, i0 + n)),
+                                       m, mt, i0 + s, j0 + s, n - s, definite);
+        }
+        for (size_type j = 0; j < n; ++ j) {
+            value_type d (m (i0 + j, j0 + j));
+            for (size_type p = 0; p < j; ++ p)
+                d -= m (i0 + j, j0 + p) * F::apply (m (i0 + j, j0 + p));
+            if (d == value_type/*zero*/() || (definite && type_traits<value_type>::real (d) <= real_type/*zero*/()))
+                return j + 1;
+            d = definite ? value_type (type_traits<real_type>::type_sqrt (type_traits<value_type>::real (d))) : type_traits<value_type>::type_sqrt (d);
+            m (i0 + j, j0 + j) = d;
+            for (size_type i = j + 1; i < n; ++ i) {
+                value_type t (m (i0 + i, j0 + j));
+                for (size_type p = 0; p < j; ++ p)
+                    t -= m (i0 + i, j0 + p) * F::apply (m (i0 + j, j0 + p));
+                m (i0 + i, j0 + j) = t / d;
+            }
+        }
+        return 0;
+    }
+
+    // The three blocks of rfp_blocks as ranges of the rectangle r and of its transpose t
+    template<class F, class R, class RT>
+    std::size_t rfp_potrf (lower_tag, R &r, RT &t, std::size_t n, bool definite) {
+        const std::size_t s = rfp_rectangle<std::size_t>::size2 (n);
+        const std::size_t e = n % 2 ? 0 : 1;
+        return rfp_potrf_split<F> (r, t, e, 0, s, project (t, range (0, s), range (s + e, n + e)),
+                                   t, r, 1 - e, 0, n - s, definite);
+    }
+    template<class F, class R, class RT>
+    std::size_t rfp_potrf (upper_tag, R &r, RT &t, std::size_t n, bool definite) {
+        const std::size_t s = n / 2;
+        const std::size_t e = n % 2 ? 0 : 1;
+        return rfp_potrf_split<F> (r, t, n - s + e, 0, s, project (r, range (0, s), range (0, n - s)),
+                                   t, r, 0, s, n - s, definite);
+    }
+
+    // Conjugates the rectangle, which turns hermitian upper storage into the lower triangle
+    // of A^T = conj (A)
+    template<class T>
+    void rfp_conj (T *data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++ i)
+            data [i] = type_traits<T>::conj (data [i]);
+    }
+
+    template<class F, class M, class TRI>
+    typename M::size_type rfp_cholesky_factorize (M &m, TRI, bool definite, bool conjugate) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::orientation_category orientation_category;
+        typedef typename boost::mpl::if_<boost::is_same<orientation_category, row_major_tag>,
+                                         row_major, column_major>::type layout_type;
+
+        const size_type n = m.size1 ();
+        if (n == 0)
+            return 0;
+        value_type *data = &m.data () [0];
+        const size_type size = n * (n + 1) / 2;
+        if (conjugate)
+            rfp_conj (data, size);
+        matrix<value_type, layout_type, array_adaptor<value_type> > r;
+        matrix<value_type, typename layout_type::transposed_layout, array_adaptor<value_type> > t;
+        rfp_rectangle_matrix (r, data, rfp_rectangle<size_type>::size1 (n), rfp_rectangle<size_type>::size2 (n));
+        rfp_rectangle_matrix (t, data, rfp_rectangle<size_type>::size2 (n), rfp_rectangle<size_type>::size1 (n));
+        const size_type singular = rfp_potrf<F> (TRI (), r, t, n, definite);
+        if (conjugate)
+            rfp_conj (data, size);
+        return singular;
+    }
+
+    // The vector, or the columns of the matrix, on the right hand side of a solve, so that
+    // the columns of a matrix are updated together row by row
+    template<class MV, class C = typename MV::type_category>
+    class rfp_rhs;
+    template<class V>
+    class rfp_rhs<V, vector_tag> {
+    public:
+        typedef std::size_t size_type;
+        typedef typename V::reference reference;
+
+        BOOST_UBLAS_INLINE
+        rfp_rhs (V &v):
+            v_ (v) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return v_.size ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return 1;
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type i, size_type) const {
+            return v_ (i);
+        }
+
+    private:
+        V &v_;
+    };
+    template<class M>
+    class rfp_rhs<M, matrix_tag> {
+    public:
+        typedef std::size_t size_type;
+        typedef typename M::reference reference;
+
+        BOOST_UBLAS_INLINE
+        rfp_rhs (M &m):
+            m_ (m) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return m_.size1 ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return m_.size2 ();
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type i, size_type j) const {
+            return m_ (i, j);
+        }
+
+    private:
+        M &m_;
+    };
+
+    // x [o, o + n) := R (L)^-1 x [o, o + n), with a unit diagonal if unit
+    template<class R, class T, class X>
+    void rfp_lower_solve (const rfp_block<T> &l, std::size_t n, const X &x, std::size_t o, bool unit) {
+        typedef std::size_t size_type;
+        const size_type k = x.size2 ();
+        for (size_type i = 0; i < n; ++ i) {
+            for (size_type p = 0; p < i; ++ p) {
+                const T t (R::apply (l (i, p)));
+                if (t != T/*zero*/())
+                    for (size_type c = 0; c < k; ++ c)
+                        x (o + i, c) -= t * x (o + p, c);
+            }
+            if (unit)
+                continue;
+            const T d (R::apply (l (i, i)));
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+            BOOST_UBLAS_CHECK (d != T/*zero*/(), singular ());
+#else
+            if (d == T/*zero*/())
+                singular ().raise ();
+#endif
+            for (size_type c = 0; c < k; ++ c)
+                x (o + i, c) /= d;
+        }
+    }
+    // x [o, o + n) := B (L)^-T x [o, o + n), with a unit diagonal if unit
+    template<class B, class T, class X>
+    void rfp_lower_back_solve (const rfp_block<T> &l, std::size_t n, const X &x, std::size_t o, bool unit) {
+        typedef std::size_t size_type;
+        const size_type k = x.size2 ();
+        for (size_type j = n; j-- > 0;) {
+            for (size_type i = j + 1; i < n; ++ i) {
+                const T t (B::apply (l (i, j)));
+                if (t != T/*zero*/())
+                    for (size_type c = 0; c < k; ++ c)
+                        x (o + j, c) -= t * x (o + i, c);
+            }
+            if (unit)
+                continue;
+            const T d (B::apply (l (j, j)));
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+            BOOST_UBLAS_CHECK (d != T/*zero*/(), singular ());
+#else
+            if (d == T/*zero*/())
+                singular ().raise ();
+#endif
+            for (size_type c = 0; c < k; ++ c)
+                x (o + j, c) /= d;
+        }
+    }
+
+    // x := R (L)^-1 x with L the lower triangle read from the rectangle through R
+    template<class R, class M, class TRI, class X>
+    void rfp_forward_substitute (const M &m, TRI, const X &x, bool unit) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::orientation_category orientation_category;
+
+        const size_type n = BOOST_UBLAS_SAME (m.size1 (), x.size1 ());
+        if (n == 0)
+            return;
+        const size_type k = x.size2 ();
+        rfp_block<value_type> a11, a21, a22;
+        const size_type s = rfp_blocks (TRI (), orientation_category (), const_cast<value_type *> (&m.data () [0]), n, a11, a21, a22);
+        rfp_lower_solve<R> (a11, s, x, 0, unit);
+        for (size_type r = 0; r < n - s; ++ r)
+            for (size_type p = 0; p < s; ++ p) {
+                const value_type t (R::apply (a21 (r, p)));
+                if (t != value_type/*zero*/())
+                    for (size_type c = 0; c < k; ++ c)
+                        x (s + r, c) -= t * x (p, c);
+            }
+        rfp_lower_solve<R> (a22, n - s, x, s, unit);
+    }
+    // x := B (L)^-T x
+    template<class B, class M, class TRI, class X>
+    void rfp_back_substitute (const M &m, TRI, const X &x, bool unit) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::orientation_category orientation_category;
+
+        const size_type n = BOOST_UBLAS_SAME (m.size1 (), x.size1 ());
+        if (n == 0)
+            return;
+        const size_type k = x.size2 ();
+        rfp_block<value_type> a11, a21, a22;
+        const size_type s = rfp_blocks (TRI (), orientation_category (), const_cast<value_type *> (&m.data () [0]), n, a11, a21, a22);
+        rfp_lower_back_solve<B> (a22, n - s, x, s, unit);
+        for (size_type p = 0; p < s; ++ p)
+            for (size_type r = 0; r < n - s; ++ r) {
+                const value_type t (B::apply (a21 (r, p)));
+                if (t != value_type/*zero*/())
+                    for (size_type c = 0; c < k; ++ c)
+                        x (p, c) -= t * x (s + r, c);
+            }
+        rfp_lower_back_solve<B> (a11, s, x, 0, unit);
+    }
+
+    // Solves L * F (L)^T x = b with the factor of rfp_cholesky_factorize. R reads the lower
+    // triangle of L from the rectangle and B is F applied after R.
+    template<class R, class B, class M, class TRI, class MV>
+    void rfp_cholesky_substitute (const M &m, TRI, MV &mv) {
+        const rfp_rhs<MV> x (mv);
+        rfp_forward_substitute<R> (m, TRI (), x, false);
+        rfp_back_substitute<B> (m, TRI (), x, false);
+    }
+
+    // Solves T x = b for a triangular matrix, the lower triangle L or the upper triangle L^T
+    template<class M, class MV>
+    void rfp_triangular_solve (const M &m, lower_tag, MV &mv, bool unit) {
+        typedef scalar_identity<typename M::value_type> identity;
+        rfp_forward_substitute<identity> (m, lower_tag (), rfp_rhs<MV> (mv), unit);
+    }
+    template<class M, class MV>
+    void rfp_triangular_solve (const M &m, upper_tag, MV &mv, bool unit) {
+        typedef scalar_identity<typename M::value_type> identity;
+        rfp_back_substitute<identity> (m, upper_tag (), rfp_rhs<MV> (mv), unit);
+    }
+
+    // c := beta * c + t1 + t2 over the block of c holding the rows [i0, i1) and the columns
+    // [j0, j1) of the lower triangle, by tiles of packed operands as in rank_update_rows.
+    // TRI selects the elements of the block which belong to the triangle.
+    template<class TRI, class T, class T1, class T2>
+    void rfp_prod_update_block (const rfp_block<T> &c, std::size_t i0, std::size_t i1, std::size_t j0, std::size_t j1,
+                                const T1 &t1, const T2 &t2, const T &beta, bool hermitian) {
+        typedef std::size_t size_type;
+        typedef typename vector_scratch_traits<T>::type scratch_type;
+
+        const size_type depth = t1.size ();
+        const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        const size_type panel = 4 * block;
+        scratch_type acc (block * block);
+        scratch_type xp (block * (std::min) (panel, depth + 1));
+        scratch_type yp (block * (std::min) (panel, depth + 1));
+        for (size_type ib = i0; ib < i1; ib += block) {
+            const size_type ie = (std::min) (ib + block, i1);
+            for (size_type jb = j0; jb < j1 && TRI::other (ie - 1, jb); jb += block) {
+                const size_type je = (std::min) (jb + block, j1);
+                std::fill (acc.begin (), acc.end (), T/*zero*/());
+                for (size_type k0 = 0; k0 < depth; k0 += panel) {
+                    const size_type k1 = (std::min) (k0 + panel, depth);
+                    t1.template apply<TRI> (&acc [0], &xp [0], &yp [0], ib, ie, jb, je, k0, k1);
+                    t2.template apply<TRI> (&acc [0], &xp [0], &yp [0], ib, ie, jb, je, k0, k1);
+                }
+                for (size_type i = ib; i < ie; ++ i)
+                    for (size_type j = jb; j < je; ++ j) {
+                        if (! TRI::other (i, j))
+                            continue;
+                        T t (acc [(i - ib) * (je - jb) + j - jb]);
+                        if (beta != T/*zero*/())
+                            t += beta * c (i - i0, j - j0);
+                        if (hermitian && i == j)
+                            t = type_traits<T>::real (t);
+                        c (i - i0, j - j0) = t;
+                    }
+            }
+        }
+    }
+
+    // m := beta * m + alpha * x * y on the three blocks of the rectangle, the product being
+    // symmetric (hermitian) so that the lower triangle also gives the upper storage. Hermitian
+    // upper storage is conjugated around the update, which conjugates alpha and beta as well.
+    template<class M, class TRI, class E1, class E2>
+    void rfp_prod_update (M &m, TRI, const E1 &x, const E2 &y, typename M::value_type alpha, typename M::value_type beta,
+                          bool hermitian, bool conjugate) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::orientation_category orientation_category;
+        typedef rank_update_term<E1, E2, value_type> term_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == x.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == y.size2 (), bad_size ());
+        const size_type n = m.size1 ();
+        if (n == 0)
+            return;
+        value_type *data = &m.data () [0];
+        const size_type size = n * (n + 1) / 2;
+        if (conjugate) {
+            rfp_conj (data, size);
+            alpha = type_traits<value_type>::conj (alpha);
+            beta = type_traits<value_type>::conj (beta);
+        }
+        const term_type t1 (x, y, alpha);
+        const rank_update_none<value_type> t2;
+        rfp_block<value_type> a11, a21, a22;
+        const size_type s = rfp_blocks (TRI (), orientation_category (), data, n, a11, a21, a22);
+        rfp_prod_update_block<basic_lower<size_type> > (a11, 0, s, 0, s, t1, t2, beta, hermitian);
+        rfp_prod_update_block<basic_full<size_type> > (a21, s, n, 0, s, t1, t2, beta, hermitian);
+        rfp_prod_update_block<basic_lower<size_type> > (a22, s, n, s, n, t1, t2, beta, hermitian);
+        if (conjugate)
+            rfp_conj (data, size);
+    }
+
+}
+
+    /** \brief Cholesky factorization of a symmetric matrix in rectangular full packed storage
+     *
+     * Overwrites the stored triangle with \f$L\f$ of \f$A=LL^T\f$ (rfp_lower) or with
+     * \f$U\f$ of \f$A=U^TU\f$ (rfp_upper). Returns 0, or \f$i+1\f$ for the first pivot
+     * \f$i\f$ which is zero or, for real matrices, not positive.
+     */
+    template<class T, class Z, class L, class A>
+    typename symmetric_matrix<T, basic_rfp_lower<Z>, L, A>::size_type
+    cholesky_factorize (symmetric_matrix<T, basic_rfp_lower<Z>, L, A> &m) {
+        return detail::rfp_cholesky_factorize<scalar_identity<T> > (m, lower_tag (), boost::is_same<T, typename type_traits<T>::real_type>::value, false);
+    }
+    template<class T, class Z, class L, class A>
+    typename symmetric_matrix<T, basic_rfp_upper<Z>, L, A>::size_type
+    cholesky_factorize (symmetric_matrix<T, basic_rfp_upper<Z>, L, A> &m) {
+        return detail::rfp_cholesky_factorize<scalar_identity<T> > (m, upper_tag (), boost::is_same<T, typename type_traits<T>::real_type>::value, false);
+    }
+
+    /** \brief Cholesky factorization of a hermitian matrix in rectangular full packed storage
+     *
+     * Overwrites the stored triangle with \f$L\f$ of \f$A=LL^H\f$ (rfp_lower) or with
+     * \f$U\f$ of \f$A=U^HU\f$ (rfp_upper). Returns 0, or \f$i+1\f$ for the first pivot
+     * \f$i\f$ which is not positive.
+     */
+    template<class T, class Z, class L, class A>
+    typename hermitian_matrix<T, basic_rfp_lower<Z>, L, A>::size_type
+    cholesky_factorize (hermitian_matrix<T, basic_rfp_lower<Z>, L, A> &m) {
+        return detail::rfp_cholesky_factorize<scalar_conj<T> > (m, lower_tag (), true, false);
+    }
+    template<class T, class Z, class L, class A>
+    typename hermitian_matrix<T, basic_rfp_upper<Z>, L, A>::size_type
+    cholesky_factorize (hermitian_matrix<T, basic_rfp_upper<Z>, L, A> &m) {
+        return detail::rfp_cholesky_factorize<scalar_conj<T> > (m, upper_tag (), true, true);
+    }
+
+    /** \brief Solves \f$Ax=b\f$ with the factor of cholesky_factorize, overwriting the vector
+     * or the columns of the matrix \f$b\f$ with \f$x\f$
+     */
+    template<class T, class Z, class L, class A, class MV>
+    void cholesky_substitute (const symmetric_matrix<T, basic_rfp_lower<Z>, L, A> &m, MV &mv) {
+        detail::rfp_cholesky_substitute<scalar_identity<T>, scalar_identity<T> > (m, lower_tag (), mv);
+    }
+    template<class T, class Z, class L, class A, class MV>
+    void cholesky_substitute (const symmetric_matrix<T, basic_rfp_upper<Z>, L, A> &m, MV &mv) {
+        detail::rfp_cholesky_substitute<scalar_identity<T>, scalar_identity<T> > (m, upper_tag (), mv);
+    }
+    template<class T, class Z, class L, class A, class MV>
+    void cholesky_substitute (const hermitian_matrix<T, basic_rfp_lower<Z>, L, A> &m, MV &mv) {
+        detail::rfp_cholesky_substitute<scalar_identity<T>, scalar_conj<T> > (m, lower_tag (), mv);
+    }
+    template<class T, class Z, class L, class A, class MV>
+    void cholesky_substitute (const hermitian_matrix<T, basic_rfp_upper<Z>, L, A> &m, MV &mv) {
+        detail::rfp_cholesky_substitute<scalar_conj<T>, scalar_identity<T> > (m, upper_tag (), mv);
+    }
+
+
+    /** \brief Solves \f$Lx=b\f$ or \f$Ux=b\f$ for a triangular matrix in rectangular full
+     * packed storage, overwriting the vector or the columns of the matrix \f$b\f$ with \f$x\f$
+     *
+     * The columns of a matrix \f$b\f$ are solved together, row by row. Other triangles than the
+     * stored one go through the generic inplace_solve.
+     */
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_lower<Z>, L, A> &m, vector_expression<E> &e, lower_tag) {
+        detail::rfp_triangular_solve (m, lower_tag (), e (), false);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_lower<Z>, L, A> &m, vector_expression<E> &e, unit_lower_tag) {
+        detail::rfp_triangular_solve (m, lower_tag (), e (), true);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_upper<Z>, L, A> &m, vector_expression<E> &e, upper_tag) {
+        detail::rfp_triangular_solve (m, upper_tag (), e (), false);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_upper<Z>, L, A> &m, vector_expression<E> &e, unit_upper_tag) {
+        detail::rfp_triangular_solve (m, upper_tag (), e (), true);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_lower<Z>, L, A> &m, matrix_expression<E> &e, lower_tag) {
+        detail::rfp_triangular_solve (m, lower_tag (), e (), false);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_lower<Z>, L, A> &m, matrix_expression<E> &e, unit_lower_tag) {
+        detail::rfp_triangular_solve (m, lower_tag (), e (), true);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_upper<Z>, L, A> &m, matrix_expression<E> &e, upper_tag) {
+        detail::rfp_triangular_solve (m, upper_tag (), e (), false);
+    }
+    template<class T, class Z, class L, class A, class E>
+    void inplace_solve (const triangular_matrix<T, basic_rfp_upper<Z>, L, A> &m, matrix_expression<E> &e, unit_upper_tag) {
+        detail::rfp_triangular_solve (m, upper_tag (), e (), true);
+    }
+
+    /** \brief Rank \a k update of a symmetric or hermitian matrix in rectangular full packed
+     * storage, \f$M := \beta M + \alpha XY\f$ as in LAPACK sfrk and hfrk
+     *
+     * Overloads symmetric_prod_update, hence also serves srk, hrk and products assigned to
+     * such matrices. Rank \a 2k updates go through the generic kernel.
+     */
+    template<class T, class Z, class L, class A, class E1, class E2>
+    void symmetric_prod_update (symmetric_matrix<T, basic_rfp_lower<Z>, L, A> &m, const E1 &x, const E2 &y,
+                                const typename symmetric_matrix<T, basic_rfp_lower<Z>, L, A>::value_type &alpha,
+                                const typename symmetric_matrix<T, basic_rfp_lower<Z>, L, A>::value_type &beta) {
+        detail::rfp_prod_update (m, lower_tag (), x, y, alpha, beta, false, false);
+    }
+    template<class T, class Z, class L, class A, class E1, class E2>
+    void symmetric_prod_update (symmetric_matrix<T, basic_rfp_upper<Z>, L, A> &m, const E1 &x, const E2 &y,
+                                const typename symmetric_matrix<T, basic_rfp_upper<Z>, L, A>::value_type &alpha,
+                                const typename symmetric_matrix<T, basic_rfp_upper<Z>, L, A>::value_type &beta) {
+        detail::rfp_prod_update (m, upper_tag (), x, y, alpha, beta, false, false);
+    }
+    template<class T, class Z, class L, class A, class E1, class E2>
+    void symmetric_prod_update (hermitian_matrix<T, basic_rfp_lower<Z>, L, A> &m, const E1 &x, const E2 &y,
+                                const typename hermitian_matrix<T, basic_rfp_lower<Z>, L, A>::value_type &alpha,
+                                const typename hermitian_matrix<T, basic_rfp_lower<Z>, L, A>::value_type &beta) {
+        detail::rfp_prod_update (m, lower_tag (), x, y, alpha, beta, true, false);
+    }
+    template<class T, class Z, class L, class A, class E1, class E2>
+    void symmetric_prod_update (hermitian_matrix<T, basic_rfp_upper<Z>, L, A> &m, const E1 &x, const E2 &y,
+                                const typename hermitian_matrix<T, basic_rfp_upper<Z>, L, A>::value_type &alpha,
+                                const typename hermitian_matrix<T, basic_rfp_upper<Z>, L, A>::value_type &beta) {
+        detail::rfp_prod_update (m, upper_tag (), x, y, alpha, beta, true, true);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,725 @@
+//
+//  Copyright (c) 2026
+//  The uBLAS contributors
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SPARSE_CHOLESKY_
+#define _BOOST_UBLAS_SPARSE_CHOLESKY_
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/numeric/ublas/ordering.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+// Supernodal Cholesky factorization of sparse symmetric or hermitian positive definite matrices
+// stored in compressed matrices. The symbolic factorization orders the matrix, computes the
+// elimination tree, postordered, and the counts of the columns of the factor, groups columns of
+// the same structure into supernodes and lays out their storage, dense blocks of columns. It
+// depends on the pattern only, so that it serves any number of numeric factorizations. Each
+// supernode gathers the updates of the supernodes below it which reach its columns, then
+// factorizes its block, both by dense blocked kernels. Supernodes at the same height in the
+// supernodal tree depend on none of each other and are shared between OpenMP threads.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // The elimination tree of P (A + A^T) P^T, from the adjacency of A + A^T, the permutation
+    // and its inverse, the roots having n for their parent, by Liu's algorithm with path
+    // compression
+    BOOST_UBLAS_INLINE
+    void elimination_tree (const std::vector<std::size_t> &starts, const std::vector<std::size_t> &adjacency,
+                           const std::vector<std::size_t> &permutation, const std::vector<std::size_t> &inverse,
+                           std::vector<std::size_t> &parent) {
+        const std::size_t n = permutation.size ();
+        parent.assign (n, n);
+        std::vector<std::size_t> ancestor (n, n);
+        for (std::size_t k = 0; k < n; ++ k)
+            for (std::size_t a = starts [permutation [k]]; a < starts [permutation [k] + 1]; ++ a) {
+                std::size_t r = inverse [adjacency [a]];
+                if (r >= k)
+                    continue;
+                while (ancestor [r] != n && ancestor [r] != k) {
+                    const std::size_t next = ancestor [r];
+                    ancestor [r] = k;
+                    r = next;
+                }
+                if (ancestor [r] == n) {
+                    ancestor [r] = k;
+                    parent [r] = k;
+                }
+            }
+    }
+
+    // The vertices of a forest in postorder, children by increasing index
+    BOOST_UBLAS_INLINE
+    void tree_postorder (const std::vector<std::size_t> &parent, std::vector<std::size_t> &post) {
+        const std::size_t n = parent.size ();
+        std::vector<std::size_t> head (n, n), next (n, n), stack;
+        for (std::size_t j = n; j-- > 0;)
+            if (parent [j] != n) {
+                next [j] = head [parent [j]];
+                head [parent [j]] = j;
+            }
+        post.clear ();
+        post.reserve (n);
+        for (std::size_t j = 0; j < n; ++ j) {
+            if (parent [j] != n)
+                continue;
+            stack.push_back (j);
+            while (! stack.empty ()) {
+                const std::size_t v = stack.back ();
+                if (head [v] != n) {
+                    const std::size_t c = head [v];
+                    head [v] = next [c];
+                    stack.push_back (c);
+                } else {
+                    stack.pop_back ();
+                    post.push_back (v);
+                }
+            }
+        }
+    }
+
+}
+
+    /** \brief Symbolic supernodal Cholesky factorization of the pattern of a compressed matrix
+     *
+     * Holds the ordering, the elimination tree, the supernodes with their rows and the layout of
+     * the factor, and the addresses in the factor of the elements of A. Any matrix of the same
+     * type with the same stored elements in the same order is factorized with it.
+     */
+    class sparse_cholesky_symbolic {
+    public:
+        typedef std::size_t size_type;
+        typedef std::vector<size_type> index_array_type;
+
+        // Construction
+        BOOST_UBLAS_INLINE
+        sparse_cholesky_symbolic ():
+            size_ (0), nnz_ (0), pattern_row_major_ (true) {}
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        explicit sparse_cholesky_symbolic (const compressed_matrix<T, L, IB, IA, TA> &a):
+            size_ (0), nnz_ (0), pattern_row_major_ (true) {
+            analyze (a);
+        }
+        template<class T, class L, std::size_t IB, class IA, class TA, class PV>
+        sparse_cholesky_symbolic (const compressed_matrix<T, L, IB, IA, TA> &a, const PV &p):
+            size_ (0), nnz_ (0), pattern_row_major_ (true) {
+            analyze (a, p);
+        }
+
+        // Analysis in the approximate minimum degree ordering of a
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        void analyze (const compressed_matrix<T, L, IB, IA, TA> &a) {
+            vector<size_type> p (a.size1 ());
+            approximate_minimum_degree_ordering (a, p);
+            analyze (a, p);
+        }
+        // Analysis in the ordering p, postordered
+        template<class T, class L, std::size_t IB, class IA, class TA, class PV>
+        void analyze (const compressed_matrix<T, L, IB, IA, TA> &a, const PV &p);
+
+        // Whether a stores the same elements in the same order as the matrix analyzed
+        template<class T, class L, std::size_t IB, class IA, class TA>
+        bool same_pattern (const compressed_matrix<T, L, IB, IA, TA> &a) const;
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            return size_;
+        }
+        // The number of elements of the dense blocks of the supernodes
+        BOOST_UBLAS_INLINE
+        size_type nnz () const {
+            return nnz_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type supernodes () const {
+            return supernode_starts_.size () - 1;
+        }
+        // Column k of the factor is row and column permutation () [k] of A
+        BOOST_UBLAS_INLINE
+        const index_array_type &permutation () const {
+            return permutation_;
+        }
+        // The parents of the columns in the elimination tree, size () for roots
+        BOOST_UBLAS_INLINE
+        const index_array_type &parent () const {
+            return parent_;
+        }
+        // Supernode s holds the columns [supernode_starts () [s], supernode_starts () [s + 1])
+        BOOST_UBLAS_INLINE
+        const index_array_type &supernode_starts () const {
+            return supernode_starts_;
+        }
+        // The rows of supernode s, its columns first, are rows () [row_starts () [s], row_starts () [s + 1])
+        BOOST_UBLAS_INLINE
+        const index_array_type &row_starts () const {
+            return row_starts_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &rows () const {
+            return rows_;
+        }
+        // The block of supernode s, column major, begins at value_starts () [s]
+        BOOST_UBLAS_INLINE
+        const index_array_type &value_starts () const {
+            return value_starts_;
+        }
+        // The supernodes updating supernode s are updates () [update_starts () [s], update_starts () [s + 1]),
+        // their first rows in s at the positions update_offsets () in their own rows
+        BOOST_UBLAS_INLINE
+        const index_array_type &update_starts () const {
+            return update_starts_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &updates () const {
+            return updates_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &update_offsets () const {
+            return update_offsets_;
+        }
+        // The supernodes of height h in the supernodal tree are level_supernodes () [level_starts () [h], level_starts () [h + 1])
+        BOOST_UBLAS_INLINE
+        const index_array_type &level_starts () const {
+            return level_starts_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &level_supernodes () const {
+            return level_supernodes_;
+        }
+        // The addresses in the factor of the stored elements of A, nnz () for those above the
+        // diagonal, and whether they are transposed in the factor
+        BOOST_UBLAS_INLINE
+        const index_array_type &element_map () const {
+            return element_map_;
+        }
+        BOOST_UBLAS_INLINE
+        const std::vector<bool> &element_transposed () const {
+            return element_transposed_;
+        }
+
+    private:
+        size_type size_;
+        size_type nnz_;
+        index_array_type permutation_;
+        index_array_type parent_;
+        index_array_type supernode_starts_;
+        index_array_type row_starts_;
+        index_array_type rows_;
+        index_array_type value_starts_;
+        index_array_type update_starts_;
+        index_array_type updates_;
+        index_array_type update_offsets_;
+        index_array_type level_starts_;
+        index_array_type level_supernodes_;
+        index_array_type element_map_;
+        std::vector<bool> element_transposed_;
+        bool pattern_row_major_;
+        index_array_type pattern_starts_;
+        index_array_type pattern_indices_;
+    };
+
+    template<class T, class L, std::size_t IB, class IA, class TA, class PV>
+    void sparse_cholesky_symbolic::analyze (const compressed_matrix<T, L, IB, IA, TA> &a, const PV &p) {
+        typedef compressed_matrix<T, L, IB, IA, TA> matrix_type;
+        BOOST_UBLAS_CHECK (a.size1 () == a.size2 (), bad_size ());
+        const size_type n = a.size1 ();
+        BOOST_UBLAS_CHECK (p.size () == n, bad_size ());
+        const detail::compressed_lines<matrix_type> lines (a);
+        index_array_type starts, adjacency;
+        detail::symmetric_adjacency (lines, starts, adjacency);
+        size_ = n;
+
+        // Elimination tree in the ordering p, then in its postorder
+        index_array_type permutation (n), inverse (n), parent, post;
+        for (size_type k = 0; k < n; ++ k) {
+            permutation [k] = p [k];
+            inverse [p [k]] = k;
+        }
+        detail::elimination_tree (starts, adjacency, permutation, inverse, parent);
+        detail::tree_postorder (parent, post);
+        index_array_type post_inverse (n);
+        for (size_type k = 0; k < n; ++ k)
+            post_inverse [post [k]] = k;
+        permutation_.resize (n);
+        parent_.resize (n);
+        for (size_type k = 0; k < n; ++ k) {
+            permutation_ [k] = permutation [post [k]];
+            parent_ [k] = parent [post [k]] == n ? n : post_inverse [parent [post [k]]];
+        }
+        for (size_type k = 0; k < n; ++ k)
+            inverse [permutation_ [k]] = k;
+
+        // Counts of the columns below the diagonal, row k of the factor being the subtree of
+        // the elimination tree spanned from the elements of row k of the lower triangle
+        index_array_type counts (n, 0), mark (n, n), children (n, 0);
+        for (size_type k = 0; k < n; ++ k) {
+            mark [k] = k;
+            for (size_type e = starts [permutation_ [k]]; e < starts [permutation_ [k] + 1]; ++ e)
+                for (size_type r = inverse [adjacency [e]]; r < k && mark [r] != k; r = parent_ [r]) {
+                    ++ counts [r];
+                    mark [r] = k;
+                }
+            if (parent_ [k] != n)
+                ++ children [parent_ [k]];
+        }
+
+        // Fundamental supernodes: a chain of columns of the tree with nested structures
+        index_array_type supernode (n);
+        supernode_starts_.assign (1, 0);
+        for (size_type j = 0; j < n; ++ j) {
+            if (j > 0 && ! (parent_ [j - 1] == j && counts [j - 1] == counts [j] + 1 && children [j] == 1))
+                supernode_starts_.push_back (j);
+            supernode [j] = supernode_starts_.size () - 1;
+        }
+        if (n > 0)
+            supernode_starts_.push_back (n);
+        const size_type supernodes = supernode_starts_.size () - 1;
+        index_array_type supernode_parent (supernodes, supernodes);
+        index_array_type child_starts (supernodes + 1, 0);
+        for (size_type s = 0; s < supernodes; ++ s) {
+            const size_type last = supernode_starts_ [s + 1] - 1;
+            if (parent_ [last] != n) {
+                supernode_parent [s] = supernode [parent_ [last]];
+                ++ child_starts [supernode_parent [s] + 1];
+            }
+        }
+        for (size_type s = 0; s < supernodes; ++ s)
+            child_starts [s + 1] += child_starts [s];
+        index_array_type child_list (child_starts [supernodes]);
+        {
+            index_array_type next (child_starts.begin (), child_starts.end () - 1);
+            for (size_type s = 0; s < supernodes; ++ s)
+                if (supernode_parent [s] != supernodes)
+                    child_list [next [supernode_parent [s]] ++] = s;
+        }
+
+        // Rows of the supernodes: their columns, the rows of the lower triangle in their
+        // columns and the rows of their children below them, children coming first
+        row_starts_.assign (1, 0);
+        rows_.clear ();
+        value_starts_.assign (1, 0);
+        std::fill (mark.begin (), mark.end (), n);
+        for (size_type s = 0; s < supernodes; ++ s) {
+            const size_type first = supernode_starts_ [s], last = supernode_starts_ [s + 1];
+            for (size_type j = first; j < last; ++ j) {
+                rows_.push_back (j);
+                mark [j] = s;
+            }
+            const size_type below = rows_.size ();
+            for (size_type j = first; j < last; ++ j)
+                for (size_type e = starts [permutation_ [j]]; e < starts [permutation_ [j] + 1]; ++ e) {
+                    const size_type i = inverse [adjacency [e]];
+                    if (i >= last && mark [i] != s) {
+                        mark [i] = s;
+                        rows_.push_back (i);
+                    }
+                }
+            for (size_type c = child_starts [s]; c < child_starts [s + 1]; ++ c)
+                for (size_type r = row_starts_ [child_list [c]]; r < row_starts_ [child_list [c] + 1]; ++ r) {
+                    const size_type i = rows_ [r];
+                    if (i >= last && mark [i] != s) {
+                        mark [i] = s;
+                        rows_.push_back (i);
+                    }
+                }
+            std::sort (rows_.begin () + below, rows_.end ());
+            row_starts_.push_back (rows_.size ());
+            value_starts_.push_back (value_starts_.back () + (rows_.size () - row_starts_ [s]) * (last - first));
+        }
+        nnz_ = value_starts_.back ();
+
+        // Updates: the rows of each supernode below its columns, grouped by supernode
+        update_starts_.assign (supernodes + 1, 0);
+        for (size_type d = 0; d < supernodes; ++ d)
+            for (size_type r = row_starts_ [d] + supernode_starts_ [d + 1] - supernode_starts_ [d]; r < row_starts_ [d + 1]; ++ r)
+                if (r == row_starts_ [d] + supernode_starts_ [d + 1] - supernode_starts_ [d] ||
+                    supernode [rows_ [r]] != supernode [rows_ [r - 1]])
+                    ++ update_starts_ [supernode [rows_ [r]] + 1];
+        for (size_type s = 0; s < supernodes; ++ s)
+            update_starts_ [s + 1] += update_starts_ [s];
+        updates_.resize (update_starts_ [supernodes]);
+        update_offsets_.resize (update_starts_ [supernodes]);
+        {
+            index_array_type next (update_starts_.begin (), update_starts_.end () - 1);
+            for (size_type d = 0; d < supernodes; ++ d)
+                for (size_type r = row_starts_ [d] + supernode_starts_ [d + 1] - supernode_starts_ [d]; r < row_starts_ [d + 1]; ++ r)
+                    if (r == row_starts_ [d] + supernode_starts_ [d + 1] - supernode_starts_ [d] ||
+                        supernode [rows_ [r]] != supernode [rows_ [r - 1]]) {
+                        const size_type s = supernode [rows_ [r]];
+                        updates_ [next [s]] = d;
+                        update_offsets_ [next [s] ++] = r - row_starts_ [d];
+                    }
+        }
+
+        // Heights in the supernodal tree, children coming first
+        index_array_type height (supernodes, 0);
+        size_type heights = supernodes > 0 ? 1 : 0;
+        for (size_type s = 0; s < supernodes; ++ s)
+            if (supernode_parent [s] != supernodes) {
+                height [supernode_parent [s]] = (std::max) (height [supernode_parent [s]], height [s] + 1);
+                heights = (std::max) (heights, height [s] + 2);
+            }
+        level_starts_.assign (heights + 1, 0);
+        for (size_type s = 0; s < supernodes; ++ s)
+            ++ level_starts_ [height [s] + 1];
+        for (size_type h = 0; h < heights; ++ h)
+            level_starts_ [h + 1] += level_starts_ [h];
+        level_supernodes_.resize (supernodes);
+        {
+            index_array_type next (level_starts_.begin (), level_starts_.end () - 1);
+            for (size_type s = 0; s < supernodes; ++ s)
+                level_supernodes_ [next [height [s]] ++] = s;
+        }
+
+        // Addresses of the elements of the lower triangle of A in the factor
+        element_map_.assign (lines.nnz (), nnz_);
+        element_transposed_.assign (lines.nnz (), false);
+        for (size_type l = 0; l < lines.lines (); ++ l)
+            for (size_type k = lines.begin (l); k < lines.end (l); ++ k) {
+                const size_type i = lines.row_major () ? l : lines.index (k);
+                const size_type j = lines.row_major () ? lines.index (k) : l;
+                if (i < j)
+                    continue;
+                const size_type r = (std::max) (inverse [i], inverse [j]), c = (std::min) (inverse [i], inverse [j]);
+                const size_type s = supernode [c];
+                const size_type *first = &rows_ [0] + row_starts_ [s], *last = &rows_ [0] + row_starts_ [s + 1];
+                const size_type height = last - first;
+                element_map_ [k] = value_starts_ [s] + (c - supernode_starts_ [s]) * height + (std::lower_bound (first, last, r) - first);
+                element_transposed_ [k] = inverse [i] < inverse [j];
+            }
+
+        // The pattern of A, against which later matrices are checked
+        pattern_row_major_ = lines.row_major ();
+        pattern_starts_.resize (lines.lines () + 1);
+        pattern_indices_.resize (lines.nnz ());
+        for (size_type l = 0; l < lines.lines (); ++ l)
+            pattern_starts_ [l] = lines.begin (l);
+        pattern_starts_ [lines.lines ()] = lines.nnz ();
+        for (size_type k = 0; k < lines.nnz (); ++ k)
+            pattern_indices_ [k] = lines.index (k);
+    }
+
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    bool sparse_cholesky_symbolic::same_pattern (const compressed_matrix<T, L, IB, IA, TA> &a) const {
+        const detail::compressed_lines<compressed_matrix<T, L, IB, IA, TA> > lines (a);
+        if (a.size1 () != size_ || a.size2 () != size_ || lines.row_major () != pattern_row_major_ ||
+            lines.nnz () != pattern_indices_.size ())
+            return false;
+        for (size_type l = 0; l < lines.lines (); ++ l)
+            if (lines.begin (l) != pattern_starts_ [l])
+                return false;
+        for (size_type k = 0; k < lines.nnz (); ++ k)
+            if (lines.index (k) != pattern_indices_ [k])
+                return false;
+        return true;
+    }
+
+    /** \brief Numeric supernodal Cholesky factor \f$L\f$ of \f$P A P^T = L L^H\f$
+     *
+     * Holds its symbolic factorization and the dense blocks of its supernodes.
+     */
+    template<class T>
+    class sparse_cholesky_factor {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef std::vector<value_type> value_array_type;
+
+        // Construction
+        BOOST_UBLAS_INLINE
+        sparse_cholesky_factor ():
+            symbolic_ (), value_data_ () {}
+        BOOST_UBLAS_INLINE
+        explicit sparse_cholesky_factor (const sparse_cholesky_symbolic &symbolic):
+            symbolic_ (symbolic), value_data_ () {}
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            return symbolic_.size ();
+        }
+        BOOST_UBLAS_INLINE
+        const sparse_cholesky_symbolic &symbolic () const {
+            return symbolic_;
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &value_data () const {
+            return value_data_;
+        }
+        BOOST_UBLAS_INLINE
+        value_array_type &value_data () {
+            return value_data_;
+        }
+
+    private:
+        sparse_cholesky_symbolic symbolic_;
+        value_array_type value_data_;
+    };
+
+namespace detail {
+
+    // c := a1 * herm (a2) on the lower trapezoid of c of size m x k, column major, a1 being m x w
+    // from a and a2 its first k rows, a of leading dimension ld. Blocks of columns of c are
+    // accumulated while the columns of a stream past them.
+    template<class T>
+    void supernode_update (std::size_t m, std::size_t k, std::size_t w, const T *a, std::size_t ld, T *c) {
+        const long block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        std::fill (c, c + m * k, T/*zero*/());
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        if (long (k) > block && m * k * w >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+            omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+#pragma omp parallel for schedule (dynamic, 1)
+            for (long jb = 0; jb < long (k); jb += block)
+                for (std::size_t p = 0; p < w; ++ p)
+                    for (std::size_t j = jb; j < (std::min) (k, std::size_t (jb + block)); ++ j) {
+                        const T t (type_traits<T>::conj (a [j + p * ld]));
+                        if (t != T/*zero*/())
+                            for (std::size_t i = j; i < m; ++ i)
+                                c [i + j * m] += a [i + p * ld] * t;
+                    }
+            return;
+        }
+#endif
+        for (std::size_t jb = 0; jb < k; jb += block)
+            for (std::size_t p = 0; p < w; ++ p)
+                for (std::size_t j = jb; j < (std::min) (k, jb + block); ++ j) {
+                    const T t (type_traits<T>::conj (a [j + p * ld]));
+                    if (t != T/*zero*/())
+                        for (std::size_t i = j; i < m; ++ i)
+                            c [i + j * m] += a [i + p * ld] * t;
+                }
+    }
+
+    // Columns [first, last) of a, of size m x n column major, updated by columns [kb, ke)
+    template<class T>
+    void supernode_trailing_update (std::size_t m, std::size_t first, std::size_t last, std::size_t kb, std::size_t ke, T *a) {
+        for (std::size_t j = first; j < last; ++ j)
+            for (std::size_t p = kb; p < ke; ++ p) {
+                const T t (type_traits<T>::conj (a [j + p * m]));
+                if (t != T/*zero*/())
+                    for (std::size_t i = j; i < m; ++ i)
+                        a [i + j * m] -= a [i + p * m] * t;
+            }
+    }
+
+    // Factorizes a supernode of m rows and n columns, column major, its first n rows being its
+    // diagonal block, by blocks of columns: each block is factorized left looking over its own
+    // columns and applied to the columns to its right. Returns 0, or j + 1 for the first pivot
+    // j which is not positive.
+    template<class T>
+    std::size_t supernode_potrf (std::size_t m, std::size_t n, T *a) {
+        typedef typename type_traits<T>::real_type real_type;
+        const std::size_t block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+        for (std::size_t kb = 0; kb < n; kb += block) {
+            const std::size_t ke = (std::min) (n, kb + block);
+            for (std::size_t j = kb; j < ke; ++ j) {
+                supernode_trailing_update (m, j, j + 1, kb, j, a);
+                const real_type d (type_traits<T>::real (a [j + j * m]));
+                if (! (d > real_type/*zero*/()))
+                    return j + 1;
+                const real_type r (type_traits<real_type>::type_sqrt (d));
+                a [j + j * m] = T (r);
+                for (std::size_t i = j + 1; i < m; ++ i)
+                    a [i + j * m] /= r;
+            }
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            if (long (n - ke) > long (block) && m * (n - ke) * (ke - kb) >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long jb = long (ke); jb < long (n); jb += long (block))
+                    supernode_trailing_update (m, jb, (std::min) (n, std::size_t (jb) + block), kb, ke, a);
+                continue;
+            }
+#endif
+            supernode_trailing_update (m, ke, n, kb, ke, a);
+        }
+        return 0;
+    }
+
+    // Factorizes supernode s once the supernodes below it are: the updates of those reaching
+    // its columns are computed into buffer and subtracted through the positions of its rows.
+    // Returns 0, or j + 1 for the first column j of the factor of which the pivot is not positive.
+    template<class T>
+    std::size_t sparse_cholesky_supernode (const sparse_cholesky_symbolic &symbolic, std::size_t s, T *values,
+                                           std::vector<std::size_t> &position, std::vector<T> &buffer) {
+        typedef std::size_t size_type;
+        const size_type *rows = &symbolic.rows () [0];
+        const size_type first = symbolic.supernode_starts () [s], columns = symbolic.supernode_starts () [s + 1] - first;
+        const size_type *srows = rows + symbolic.row_starts () [s];
+        const size_type height = symbolic.row_starts () [s + 1] - symbolic.row_starts () [s];
+        T *ls = values + symbolic.value_starts () [s];
+        for (size_type r = 0; r < height; ++ r)
+            position [srows [r]] = r;
+        for (size_type u = symbolic.update_starts () [s]; u < symbolic.update_starts () [s + 1]; ++ u) {
+            const size_type d = symbolic.updates () [u], o = symbolic.update_offsets () [u];
+            const size_type *drows = rows + symbolic.row_starts () [d];
+            const size_type dheight = symbolic.row_starts () [d + 1] - symbolic.row_starts () [d];
+            const size_type dcolumns = symbolic.supernode_starts () [d + 1] - symbolic.supernode_starts () [d];
+            size_type o2 = o;
+            while (o2 < dheight && drows [o2] < first + columns)
+                ++ o2;
+            const size_type m = dheight - o, k = o2 - o;
+            if (buffer.size () < m * k)
+                buffer.resize (m * k);
+            supernode_update (m, k, dcolumns, values + symbolic.value_starts () [d] + o, dheight, &buffer [0]);
+            for (size_type j = 0; j < k; ++ j) {
+                T *lc = ls + (drows [o + j] - first) * height;
+                for (size_type i = j; i < m; ++ i)
+                    lc [position [drows [o + i]]] -= buffer [i + j * m];
+            }
+        }
+        const size_type singular = supernode_potrf (height, columns, ls);
+        return singular == 0 ? 0 : first + singular;
+    }
+
+    template<class T, class V>
+    void sparse_cholesky_substitute (const sparse_cholesky_factor<T> &f, V &v, vector_tag) {
+        typedef std::size_t size_type;
+        const sparse_cholesky_symbolic &symbolic = f.symbolic ();
+        const size_type n = BOOST_UBLAS_SAME (f.size (), v.size ());
+        if (n == 0)
+            return;
+        BOOST_UBLAS_CHECK (f.value_data ().size () == symbolic.nnz (), external_logic ());
+        const size_type *rows = &symbolic.rows () [0];
+        const T *values = &f.value_data () [0];
+        std::vector<T> y (n);
+        for (size_type k = 0; k < n; ++ k)
+            y [k] = v (symbolic.permutation () [k]);
+        const size_type supernodes = symbolic.supernodes ();
+        // L y = P b
+        for (size_type s = 0; s < supernodes; ++ s) {
+            const size_type first = symbolic.supernode_starts () [s], columns = symbolic.supernode_starts () [s + 1] - first;
+            const size_type *srows = rows + symbolic.row_starts () [s];
+            const size_type height = symbolic.row_starts () [s + 1] - symbolic.row_starts () [s];
+            const T *ls = values + symbolic.value_starts () [s];
+            for (size_type j = 0; j < columns; ++ j) {
+                const T *lj = ls + j * height;
+                const T t (y [first + j] /= lj [j]);
+                if (t != T/*zero*/())
+                    for (size_type r = j + 1; r < height; ++ r)
+                        y [srows [r]] -= lj [r] * t;
+            }
+        }
+        // L^H x = y
+        for (size_type s = supernodes; s-- > 0;) {
+            const size_type first = symbolic.supernode_starts () [s], columns = symbolic.supernode_starts () [s + 1] - first;
+            const size_type *srows = rows + symbolic.row_starts () [s];
+            const size_type height = symbolic.row_starts () [s + 1] - symbolic.row_starts () [s];
+            const T *ls = values + symbolic.value_starts () [s];
+            for (size_type j = columns; j-- > 0;) {
+                const T *lj = ls + j * height;
+                T t (y [first + j]);
+                for (size_type r = j + 1; r < height; ++ r)
+                    t -= type_traits<T>::conj (lj [r]) * y [srows [r]];
+                y [first + j] = t / type_traits<T>::conj (lj [j]);
+            }
+        }
+        for (size_type k = 0; k < n; ++ k)
+            v (symbolic.permutation () [k]) = y [k];
+    }
+    template<class T, class M>
+    void sparse_cholesky_substitute (const sparse_cholesky_factor<T> &f, M &m, matrix_tag) {
+        typedef typename M::size_type size_type;
+        for (size_type k = 0; k < m.size2 (); ++ k) {
+            matrix_column<M> mck (column (m, k));
+            sparse_cholesky_substitute (f, mck, vector_tag ());
+        }
+    }
+
+}
+
+    /** \brief Supernodal Cholesky factorization \f$P A P^T = L L^H\f$ of a symmetric or
+     * hermitian positive definite compressed matrix
+     *
+     * Reads the elements of A on and below the diagonal, those above it being ignored, so that
+     * A is stored either whole or as its lower triangle, and overwrites the factor f, which
+     * holds the symbolic factorization of A. Supernodes at the same height in the supernodal tree
+     * are factorized in parallel with OpenMP. Returns 0, or \f$j+1\f$ for a column \f$j\f$ of
+     * the factor of which the pivot is not positive, the first one when computed serially.
+     */
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    typename sparse_cholesky_factor<T>::size_type
+    cholesky_factorize (const compressed_matrix<T, L, IB, IA, TA> &a, sparse_cholesky_factor<T> &f) {
+        typedef typename sparse_cholesky_factor<T>::size_type size_type;
+        const sparse_cholesky_symbolic &symbolic = f.symbolic ();
+        BOOST_UBLAS_CHECK (a.size1 () == symbolic.size () && a.size2 () == symbolic.size (), bad_size ());
+        BOOST_UBLAS_CHECK (symbolic.same_pattern (a), bad_argument ());
+        const size_type n = symbolic.size ();
+        std::vector<T> &values = f.value_data ();
+        values.assign (symbolic.nnz (), T/*zero*/());
+        const size_type nnz = symbolic.element_map ().size ();
+        for (size_type k = 0; k < nnz; ++ k)
+            if (symbolic.element_map () [k] != symbolic.nnz ())
+                values [symbolic.element_map () [k]] = symbolic.element_transposed () [k] ?
+                                                       type_traits<T>::conj (a.value_data () [k]) : a.value_data () [k];
+        if (n == 0)
+            return 0;
+
+        const size_type supernodes = symbolic.supernodes ();
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+        if (symbolic.nnz () >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) && omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+            const int threads = omp_get_max_threads ();
+            std::vector<std::vector<size_type> > positions (threads);
+            std::vector<std::vector<T> > buffers (threads);
+            std::vector<size_type> position (n);
+            std::vector<T> buffer;
+            size_type singular = 0;
+            for (size_type h = 0; h + 1 < symbolic.level_starts ().size () && singular == 0; ++ h) {
+                const size_type first = symbolic.level_starts () [h], last = symbolic.level_starts () [h + 1];
+                if (last - first == 1) {
+                    singular = detail::sparse_cholesky_supernode (symbolic, symbolic.level_supernodes () [first],
+                                                                  &values [0], position, buffer);
+                    continue;
+                }
+#pragma omp parallel for schedule (dynamic, 1) num_threads (threads)
+                for (long l = long (first); l < long (last); ++ l) {
+                    const int t = omp_get_thread_num ();
+                    if (positions [t].size () < n)
+                        positions [t].resize (n);
+                    const size_type r = detail::sparse_cholesky_supernode (symbolic, symbolic.level_supernodes () [l],
+                                                                           &values [0], positions [t], buffers [t]);
+                    if (r != 0) {
+#pragma omp critical
+                        if (singular == 0 || r < singular)
+                            singular = r;
+                    }
+                }
+            }
+            return singular;
+        }
+#endif
+        std::vector<size_type> position (n);
+        std::vector<T> buffer;
+        for (size_type s = 0; s < supernodes; ++ s) {
+            const size_type singular = detail::sparse_cholesky_supernode (symbolic, s, &values [0], position, buffer);
+            if (singular != 0)
+                return singular;
+        }
+        return 0;
+    }
+
+    /** \brief Solves \f$Ax=b\f$ with the factor of cholesky_factorize, overwriting the vector
+     * or the columns of the matrix \f$b\f$ with \f$x\f$
+     */
+    template<class T, class MV>
+    void cholesky_substitute (const sparse_cholesky_factor<T> &f, MV &mv) {
+        detail::sparse_cholesky_substitute (f, mv, typename MV::type_category ());
+    }
+
+}}}
+
+#endif
@@ -25,6 +25,8 @@
 #include <boost/numeric/ublas/exception.hpp>
 #include <boost/numeric/ublas/traits.hpp>
 #include <boost/numeric/ublas/detail/iterator.hpp>
+#include <boost/numeric/ublas/detail/streaming.hpp>
+#include <boost/numeric/ublas/arena.hpp>
 
 
 namespace boost { namespace numeric { namespace ublas {
@@ -80,7 +82,10 @@ namespace boost { namespace numeric { namespace ublas {
             alloc_ (a), size_ (size) {
             if (size_) {
                 data_ = alloc_.allocate (size_);
-                std::uninitialized_fill (begin(), end(), init);
+                if (detail::has_trivial_constructor<T>::value && detail::has_trivial_assign<T>::value)
+                    detail::fill_storage (data_, data_ + size_, init);
+                else
+                    std::uninitialized_fill (begin(), end(), init);
             }
             else
                 data_ = 0;
@@ -91,7 +96,10 @@ namespace boost { namespace numeric { namespace ublas {
             alloc_ (c.alloc_), size_ (c.size_) {
             if (size_) {
                 data_ = alloc_.allocate (size_);
-                std::uninitialized_copy (c.begin(), c.end(), begin());
+                if (detail::has_trivial_constructor<T>::value && detail::has_trivial_assign<T>::value)
+                    detail::copy_storage (c.data_, c.data_ + c.size_, data_);
+                else
+                    std::uninitialized_copy (c.begin(), c.end(), begin());
             }
             else
                 data_ = 0;
@@ -201,7 +209,7 @@ namespace boost { namespace numeric { namespace ublas {
         unbounded_array &operator = (const unbounded_array &a) {
             if (this != &a) {
                 resize (a.size_);
-                std::copy (a.data_, a.data_ + a.size_, data_);
+                detail::copy_storage (a.data_, a.data_ + a.size_, data_);
             }
             return *this;
         }
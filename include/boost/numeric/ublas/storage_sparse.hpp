@@ -534,6 +534,19 @@ namespace boost { namespace numeric { namespace ublas {
             m.reserve (capacity);
         }
 
+        // append helpers for map_array and generic maps, the key of p following all others
+
+        template<class M>
+        BOOST_UBLAS_INLINE
+        void map_append (M &m, const typename M::value_type &p) {
+            m.insert (m.end (), p);
+        }
+        template<class I, class T, class ALLOC>
+        BOOST_UBLAS_INLINE
+        void map_append (map_array<I, T, ALLOC> &m, const typename map_array<I, T, ALLOC>::value_type &p) {
+            m.push_back (m.end (), p);
+        }
+
         template<class M>
         struct map_capacity_traits {
             typedef typename M::size_type type ;
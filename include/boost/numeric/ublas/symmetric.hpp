@@ -16,6 +16,7 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/triangular.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
+#include <boost/numeric/ublas/detail/symmetric_kernel.hpp>
 
 // Iterators based on ideas of Jeremy Siek
 // Symmetric matrices are square. Thanks to Peter Schmitteckert for spotting this.
@@ -2129,6 +2130,55 @@ namespace boost { namespace numeric { namespace ublas {
     struct matrix_temporary_traits< const symmetric_adaptor<M, TRI> >
     : matrix_temporary_traits< M > {} ;
 
+
+    namespace detail {
+        template<class T, class TRI, class L, class A>
+        struct matrix_vector_kernel_traits<symmetric_matrix<T, TRI, L, A> > {
+            static const bool value = boost::is_pointer<typename A::iterator>::value &&
+                                      packed_lines_traits<TRI>::value;
+        };
+        template<class M, class TRI>
+        struct matrix_vector_kernel_traits<symmetric_adaptor<M, TRI> > {
+            static const bool value = dense_block_traits<typename boost::remove_const<M>::type>::value;
+        };
+
+        template<class T, class TRI, class L, class A>
+        struct symmetric_target_traits<symmetric_matrix<T, TRI, L, A> > {
+            static const bool value = true;
+            static const bool hermitian = false;
+            typedef TRI triangular_type;
+            typedef symmetric_matrix<T, TRI, L, A> temporary_type;
+        };
+        template<class M, class TRI>
+        struct symmetric_target_traits<symmetric_adaptor<M, TRI> > {
+            static const bool value = dense_block_traits<typename boost::remove_const<M>::type>::value;
+            static const bool hermitian = false;
+            typedef TRI triangular_type;
+            typedef symmetric_matrix<typename M::value_type, TRI> temporary_type;
+        };
+    }
+
+    // Matrix vector product kernels, reading the stored triangle along its lines of unit stride
+    template<class T, class TRI, class L, class A>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const symmetric_matrix<T, TRI, L, A> &m, const T *x, T *y, const T &alpha) {
+        typedef detail::packed_triangle_lines<T, TRI, L> lines_type;
+        const bool rows = boost::is_same<typename L::orientation_category, row_major_tag>::value;
+        const bool before = rows ? TRI::other (1, 0) : TRI::other (0, 1);
+        detail::symmetric_axpy<scalar_identity<T> > (lines_type (&m.data () [0], m.size1 ()), m.size1 (), rows, before, x, y, alpha);
+    }
+    template<class M, class TRI>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_axpy (const symmetric_adaptor<M, TRI> &m, const typename M::value_type *x, typename M::value_type *y,
+                             const typename M::value_type &alpha) {
+        typedef typename M::value_type value_type;
+        typedef detail::dense_triangle_lines<typename symmetric_adaptor<M, TRI>::matrix_closure_type> lines_type;
+        const bool rows = boost::is_same<typename detail::dense_block_traits<typename boost::remove_const<M>::type>::orientation_category,
+                                         row_major_tag>::value;
+        const bool before = rows ? TRI::other (1, 0) : TRI::other (0, 1);
+        detail::symmetric_axpy<scalar_identity<value_type> > (lines_type (m.data ()), m.size1 (), rows, before, x, y, alpha);
+    }
+
 }}}
 
 #endif
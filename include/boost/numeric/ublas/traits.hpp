@@ -607,6 +607,12 @@ namespace boost { namespace numeric { namespace ublas {
         template<typename FLT>
         struct has_trivial_destructor<std::complex<FLT> > : public has_trivial_destructor<FLT> {};
 
+        template<typename T>
+        struct has_trivial_assign : public boost::has_trivial_assign<T> {};
+
+        template<typename FLT>
+        struct has_trivial_assign<std::complex<FLT> > : public has_trivial_assign<FLT> {};
+
     }
 
 
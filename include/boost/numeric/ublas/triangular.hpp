@@ -14,9 +14,14 @@
 #define _BOOST_UBLAS_TRIANGULAR_
 
 #include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
 #include <boost/type_traits/remove_const.hpp>
 
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 // Iterators based on ideas of Jeremy Siek
 
 namespace boost { namespace numeric { namespace ublas {
@@ -2364,6 +2369,108 @@ namespace boost { namespace numeric { namespace ublas {
         typedef matrix<promote_type> result_type;
     };
 
+    namespace detail {
+        // Solves with many right hand sides are blocked (as in BLAS trsm) for dense right hand
+        // sides and dense triangles, triangular_matrix and triangular_adaptor of those
+        struct blocked_solve_tag {};
+
+        template<class E>
+        struct blocked_solve_operand {
+            static const bool value = boost::is_convertible<typename E::storage_category, dense_proxy_tag>::value;
+        };
+        template<class T, class TRI, class L, class A>
+        struct blocked_solve_operand<triangular_matrix<T, TRI, L, A> > {
+            static const bool value = true;
+        };
+        template<class M, class TRI>
+        struct blocked_solve_operand<triangular_adaptor<M, TRI> > {
+            static const bool value = blocked_solve_operand<typename boost::remove_const<M>::type>::value;
+        };
+
+        template<class E1, class E2>
+        struct matrix_solve_traits {
+            typedef typename boost::mpl::if_c<blocked_solve_operand<E1>::value &&
+                                              boost::is_convertible<typename E2::storage_category, dense_proxy_tag>::value,
+                                              blocked_solve_tag,
+                                              typename E1::storage_category>::type storage_category;
+        };
+
+        // Columns [first, last) of the right hand sides. Each diagonal block of the triangle is
+        // solved element by element, the rows below (above) it are updated by a matrix product.
+        template<class E1, class E2>
+        void blocked_solve_panel (const E1 &e1, E2 &e2, lower_tag,
+                                  typename E2::size_type first, typename E2::size_type last) {
+            typedef typename E2::size_type size_type;
+            typedef typename E2::value_type value_type;
+
+            const size_type size1 = e2.size1 ();
+            const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            for (size_type k0 = 0; k0 < size1; k0 += block) {
+                const size_type k1 = (std::min) (k0 + block, size1);
+                for (size_type n = k0; n < k1; ++ n) {
+                    for (size_type l = first; l < last; ++ l) {
+                        value_type t = e2 (n, l) /= e1 (n, n);
+                        if (t != value_type/*zero*/()) {
+                            for (size_type m = n + 1; m < k1; ++ m)
+                                e2 (m, l) -= e1 (m, n) * t;
+                        }
+                    }
+                }
+                if (k1 < size1)
+                    project (e2, range (k1, size1), range (first, last)).minus_assign (
+                        prod (project (e1, range (k1, size1), range (k0, k1)),
+                              project (e2, range (k0, k1), range (first, last))));
+            }
+        }
+        template<class E1, class E2>
+        void blocked_solve_panel (const E1 &e1, E2 &e2, upper_tag,
+                                  typename E2::size_type first, typename E2::size_type last) {
+            typedef typename E2::size_type size_type;
+            typedef typename E2::value_type value_type;
+
+            const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            for (size_type k1 = e2.size1 (); k1 > 0;) {
+                const size_type k0 = k1 > block ? k1 - block : 0;
+                for (size_type n = k1; n-- > k0;) {
+                    for (size_type l = first; l < last; ++ l) {
+                        value_type t = e2 (n, l) /= e1 (n, n);
+                        if (t != value_type/*zero*/()) {
+                            for (size_type m = k0; m < n; ++ m)
+                                e2 (m, l) -= e1 (m, n) * t;
+                        }
+                    }
+                }
+                if (k0 > 0)
+                    project (e2, range (0, k0), range (first, last)).minus_assign (
+                        prod (project (e1, range (0, k0), range (k0, k1)),
+                              project (e2, range (k0, k1), range (first, last))));
+                k1 = k0;
+            }
+        }
+
+        // The right hand sides are solved in panels of columns, shared between OpenMP threads
+        // for large systems
+        template<class E1, class E2, class C>
+        void blocked_solve (const E1 &e1, E2 &e2, C) {
+            typedef typename E2::size_type size_type;
+
+            const size_type size2 = e2.size2 ();
+            const size_type panel = 4 * BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            if (size2 > panel && e2.size1 () * size2 >= size_type (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+                const long panels = long ((size2 + panel - 1) / panel);
+#pragma omp parallel for schedule (dynamic, 1)
+                for (long p = 0; p < panels; ++ p)
+                    blocked_solve_panel (e1, e2, C (), size_type (p) * panel, (std::min) (size_type (p + 1) * panel, size2));
+                return;
+            }
+#endif
+            for (size_type l = 0; l < size2; l += panel)
+                blocked_solve_panel (e1, e2, C (), l, (std::min) (l + panel, size2));
+        }
+    }
+
     // Operations:
     //  k * n * (n - 1) / 2 + k * n = k * n * (n + 1) / 2 multiplications,
     //  k * n * (n - 1) / 2 additions
@@ -2460,12 +2567,32 @@ namespace boost { namespace numeric { namespace ublas {
             }
         }
     }
+    // Blocked case
+    template<class E1, class E2>
+    void inplace_solve (const matrix_expression<E1> &e1, matrix_expression<E2> &e2,
+                        lower_tag, detail::blocked_solve_tag) {
+        typedef typename E2::size_type size_type;
+        typedef typename E2::value_type value_type;
+
+        BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size1 (), bad_size ());
+        size_type size1 = e2 ().size1 ();
+        for (size_type n = 0; n < size1; ++ n) {
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+#else
+            if (e1 () (n, n) == value_type/*zero*/())
+                singular ().raise ();
+#endif
+        }
+        detail::blocked_solve (e1 (), e2 (), lower_tag ());
+    }
     // Dispatcher
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
     void inplace_solve (const matrix_expression<E1> &e1, matrix_expression<E2> &e2,
                         lower_tag) {
-        typedef typename E1::storage_category dispatch_category;
+        typedef typename detail::matrix_solve_traits<E1, E2>::storage_category dispatch_category;
         inplace_solve (e1, e2,
                        lower_tag (), dispatch_category ());
     }
@@ -2473,7 +2600,7 @@ namespace boost { namespace numeric { namespace ublas {
     BOOST_UBLAS_INLINE
     void inplace_solve (const matrix_expression<E1> &e1, matrix_expression<E2> &e2,
                         unit_lower_tag) {
-        typedef typename E1::storage_category dispatch_category;
+        typedef typename detail::matrix_solve_traits<E1, E2>::storage_category dispatch_category;
         inplace_solve (triangular_adaptor<const E1, unit_lower> (e1 ()), e2,
                        unit_lower_tag (), dispatch_category ());
     }
@@ -2570,12 +2697,32 @@ namespace boost { namespace numeric { namespace ublas {
             }
         }
     }
+    // Blocked case
+    template<class E1, class E2>
+    void inplace_solve (const matrix_expression<E1> &e1, matrix_expression<E2> &e2,
+                        upper_tag, detail::blocked_solve_tag) {
+        typedef typename E2::size_type size_type;
+        typedef typename E2::value_type value_type;
+
+        BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size1 (), bad_size ());
+        size_type size1 = e2 ().size1 ();
+        for (size_type n = 0; n < size1; ++ n) {
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+#else
+            if (e1 () (n, n) == value_type/*zero*/())
+                singular ().raise ();
+#endif
+        }
+        detail::blocked_solve (e1 (), e2 (), upper_tag ());
+    }
     // Dispatcher
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
     void inplace_solve (const matrix_expression<E1> &e1, matrix_expression<E2> &e2,
                         upper_tag) {
-        typedef typename E1::storage_category dispatch_category;
+        typedef typename detail::matrix_solve_traits<E1, E2>::storage_category dispatch_category;
         inplace_solve (e1, e2,
                        upper_tag (), dispatch_category ());
     }
@@ -2583,7 +2730,7 @@ namespace boost { namespace numeric { namespace ublas {
     BOOST_UBLAS_INLINE
     void inplace_solve (const matrix_expression<E1> &e1, matrix_expression<E2> &e2,
                         unit_upper_tag) {
-        typedef typename E1::storage_category dispatch_category;
+        typedef typename detail::matrix_solve_traits<E1, E2>::storage_category dispatch_category;
         inplace_solve (triangular_adaptor<const E1, unit_upper> (e1 ()), e2,
                        unit_upper_tag (), dispatch_category ());
     }
@@ -2599,6 +2746,185 @@ namespace boost { namespace numeric { namespace ublas {
         return r;
     }
 
+    namespace detail {
+        template<class T, class TRI, class L, class A>
+        struct triangular_operand_traits<triangular_matrix<T, TRI, L, A> > {
+            static const bool value = true;
+            typedef TRI triangular_type;
+        };
+        template<class M, class TRI>
+        struct triangular_operand_traits<triangular_adaptor<M, TRI> > {
+            static const bool value = dense_block_traits<typename boost::remove_const<M>::type>::value ||
+                                      triangular_operand_traits<typename boost::remove_const<M>::type>::value;
+            typedef TRI triangular_type;
+        };
+
+        template<class C>
+        struct triangular_tag_traits {};
+        template<>
+        struct triangular_tag_traits<lower_tag> {
+            typedef lower type;
+        };
+        template<>
+        struct triangular_tag_traits<upper_tag> {
+            typedef upper type;
+        };
+        template<>
+        struct triangular_tag_traits<unit_lower_tag> {
+            typedef unit_lower type;
+        };
+        template<>
+        struct triangular_tag_traits<unit_upper_tag> {
+            typedef unit_upper type;
+        };
+
+        // The off diagonal blocks lie in the stored triangle, where an adaptor and the adapted
+        // matrix agree: they are read from the adapted matrix
+        template<class M>
+        const M &triangular_data (const M &m) {
+            return m;
+        }
+        template<class M, class TRI>
+        const typename triangular_adaptor<M, TRI>::matrix_closure_type &triangular_data (const triangular_adaptor<M, TRI> &m) {
+            return m.data ();
+        }
+
+        // m += t * b (m -= t * b) as in BLAS trmm: the off diagonal blocks of the stored
+        // triangle are multiplied as dense blocks, the diagonal blocks element by element
+        // without the structural zeros
+        template<class TRI, class E1, class D, class E2, class M>
+        void triangular_left_prod (const E1 &t, const D &d, const E2 &b, M &m, bool minus) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            const bool lower = boost::is_convertible<typename TRI::triangular_type, lower_tag>::value;
+            const size_type size1 = t.size1 ();
+            const size_type size = BOOST_UBLAS_SAME (t.size2 (), b.size1 ());
+            const size_type size2 = b.size2 ();
+            const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            for (size_type i0 = 0; i0 < size1; i0 += block) {
+                const size_type i1 = (std::min) (i0 + block, size1);
+                const size_type d0 = (std::min) (i0, size);
+                const size_type d1 = (std::min) (i1, size);
+                const size_type p0 = lower ? 0 : d1;
+                const size_type p1 = lower ? d0 : size;
+                if (p0 < p1) {
+                    if (minus)
+                        project (m, range (i0, i1), range (0, size2)).minus_assign (
+                            prod (project (d, range (i0, i1), range (p0, p1)), project (b, range (p0, p1), range (0, size2))));
+                    else
+                        project (m, range (i0, i1), range (0, size2)).plus_assign (
+                            prod (project (d, range (i0, i1), range (p0, p1)), project (b, range (p0, p1), range (0, size2))));
+                }
+                for (size_type i = i0; i < i1; ++ i)
+                    for (size_type p = d0; p < d1; ++ p) {
+                        if (TRI::zero (i, p))
+                            continue;
+                        const value_type a (minus ? value_type (- t (i, p)) : value_type (t (i, p)));
+                        if (a != value_type/*zero*/())
+                            for (size_type l = 0; l < size2; ++ l)
+                                m (i, l) += a * b (p, l);
+                    }
+            }
+        }
+        // m += b * t (m -= b * t)
+        template<class TRI, class E1, class E2, class D, class M>
+        void triangular_right_prod (const E1 &b, const E2 &t, const D &d, M &m, bool minus) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            const bool lower = boost::is_convertible<typename TRI::triangular_type, lower_tag>::value;
+            const size_type size1 = b.size1 ();
+            const size_type size = BOOST_UBLAS_SAME (b.size2 (), t.size1 ());
+            const size_type size2 = t.size2 ();
+            const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            for (size_type j0 = 0; j0 < size2; j0 += block) {
+                const size_type j1 = (std::min) (j0 + block, size2);
+                const size_type d0 = (std::min) (j0, size);
+                const size_type d1 = (std::min) (j1, size);
+                const size_type p0 = lower ? d1 : 0;
+                const size_type p1 = lower ? size : d0;
+                if (p0 < p1) {
+                    if (minus)
+                        project (m, range (0, size1), range (j0, j1)).minus_assign (
+                            prod (project (b, range (0, size1), range (p0, p1)), project (d, range (p0, p1), range (j0, j1))));
+                    else
+                        project (m, range (0, size1), range (j0, j1)).plus_assign (
+                            prod (project (b, range (0, size1), range (p0, p1)), project (d, range (p0, p1), range (j0, j1))));
+                }
+                for (size_type p = d0; p < d1; ++ p)
+                    for (size_type j = j0; j < j1; ++ j) {
+                        if (TRI::zero (p, j))
+                            continue;
+                        const value_type a (minus ? value_type (- t (p, j)) : value_type (t (p, j)));
+                        if (a != value_type/*zero*/())
+                            for (size_type i = 0; i < size1; ++ i)
+                                m (i, j) += b (i, p) * a;
+                    }
+            }
+        }
+
+        // b := t * b, the rows of b being replaced in the order in which they are no more needed
+        template<class TRI, class E1, class D, class E2>
+        void inplace_triangular_prod (const E1 &t, const D &d, E2 &b) {
+            typedef typename E2::size_type size_type;
+            typedef typename E2::value_type value_type;
+
+            const bool lower = boost::is_convertible<typename TRI::triangular_type, lower_tag>::value;
+            BOOST_UBLAS_CHECK (t.size1 () == t.size2 (), bad_size ());
+            const size_type size = BOOST_UBLAS_SAME (t.size2 (), b.size1 ());
+            const size_type size2 = b.size2 ();
+            const size_type block = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            for (size_type k = 0; k < size; k += block) {
+                // Lower triangles from the last block up, upper ones from the first block down
+                const size_type i0 = lower ? (size - k > block ? size - k - block : 0) : k;
+                const size_type i1 = lower ? size - k : (std::min) (k + block, size);
+                for (size_type n = 0; n < i1 - i0; ++ n) {
+                    const size_type i = lower ? i1 - 1 - n : i0 + n;
+                    for (size_type l = 0; l < size2; ++ l) {
+                        value_type s = value_type/*zero*/();
+                        for (size_type p = lower ? i0 : i; p < (lower ? i + 1 : i1); ++ p)
+                            if (! TRI::zero (i, p))
+                                s += t (i, p) * b (p, l);
+                        b (i, l) = s;
+                    }
+                }
+                const size_type p0 = lower ? 0 : i1;
+                const size_type p1 = lower ? i0 : size;
+                if (p0 < p1)
+                    project (b, range (i0, i1), range (0, size2)).plus_assign (
+                        prod (project (d, range (i0, i1), range (p0, p1)), project (b, range (p0, p1), range (0, size2))));
+            }
+        }
+
+        template<class E1, class E2, class M>
+        void triangular_prod_axpy (const E1 &e1, const E2 &e2, M &m, bool minus, boost::mpl::true_) {
+            typedef typename triangular_operand_traits<E1>::triangular_type triangular_type;
+            triangular_left_prod<triangular_type> (e1, closure_matrix (triangular_data (e1)), e2, m, minus);
+        }
+        template<class E1, class E2, class M>
+        void triangular_prod_axpy (const E1 &e1, const E2 &e2, M &m, bool minus, boost::mpl::false_) {
+            typedef typename triangular_operand_traits<E2>::triangular_type triangular_type;
+            triangular_right_prod<triangular_type> (e1, e2, closure_matrix (triangular_data (e2)), m, minus);
+        }
+    }
+
+    // Products with a triangular_matrix or triangular_adaptor, see triangular_prod_tag
+    template<class E1, class E2, class M>
+    void triangular_prod_axpy (const E1 &e1, const E2 &e2, M &m, bool minus) {
+        detail::triangular_prod_axpy (e1, e2, m, minus, boost::mpl::bool_<detail::triangular_operand_traits<E1>::value> ());
+    }
+
+    /** \brief Multiplies in place by a triangular matrix, \f$B := TB\f$ as in BLAS trmm
+     *
+     * The triangle of \c e1 is selected by the tag, as for inplace_solve.
+     */
+    template<class E1, class E2, class C>
+    void inplace_prod (const matrix_expression<E1> &e1, matrix_expression<E2> &e2, C) {
+        typedef typename detail::triangular_tag_traits<C>::type triangular_type;
+        detail::inplace_triangular_prod<triangular_type> (triangular_adaptor<const E1, triangular_type> (e1 ()), e1 (), e2 ());
+    }
+
 }}}
 
 #endif
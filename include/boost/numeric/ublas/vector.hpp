@@ -263,7 +263,7 @@ namespace boost { namespace numeric { namespace ublas {
 	/// \brief Clear the vector, i.e. set all values to the \c zero value.
 	     BOOST_UBLAS_INLINE
 	     void clear () {
-	         std::fill (data ().begin (), data ().end (), value_type/*zero*/());
+	         detail::fill_storage (data ().begin (), data ().end (), value_type/*zero*/());
 	     }
 
 	     // Assignment
@@ -14,6 +14,7 @@
 #define _BOOST_UBLAS_VECTOR_EXPRESSION_
 
 #include <boost/numeric/ublas/expression_types.hpp>
+#include <boost/numeric/ublas/detail/contiguous.hpp>
 
 
 // Expression templates based on ideas of Todd Veldhuizen and Geoffrey Furnish
@@ -521,8 +522,10 @@ namespace boost { namespace numeric { namespace ublas {
         typedef E1 expression1_type;
         typedef E2 expression2_type;
         typedef F functor_type;
+    public:
         typedef typename E1::const_closure_type expression1_closure_type;
         typedef typename E2::const_closure_type expression2_closure_type;
+    private:
         typedef vector_binary<E1, E2, F> self_type;
     public:
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
@@ -548,8 +551,8 @@ namespace boost { namespace numeric { namespace ublas {
             return BOOST_UBLAS_SAME (e1_.size (), e2_.size ()); 
         }
 
-    private:
-        // Accessors
+    public:
+        // Expression accessors
         BOOST_UBLAS_INLINE
         const expression1_closure_type &expression1 () const {
             return e1_;
@@ -902,6 +905,40 @@ namespace boost { namespace numeric { namespace ublas {
 #endif
     };
 
+    namespace detail {
+        // The constant vectors and matrices, of which sums and products are folded when they
+        // are evaluated, see vector_fold_traits and matrix_fold_traits, and inner products when
+        // they are computed
+        template<class E>
+        struct constant_expression_traits {
+            static const bool zero = false;
+            static const bool identity = false;
+            static const bool scalar = false;
+            static const bool unit = false;
+        };
+        template<class T, class ALLOC>
+        struct constant_expression_traits<zero_vector<T, ALLOC> > {
+            static const bool zero = true;
+            static const bool identity = false;
+            static const bool scalar = false;
+            static const bool unit = false;
+        };
+        template<class T, class ALLOC>
+        struct constant_expression_traits<unit_vector<T, ALLOC> > {
+            static const bool zero = false;
+            static const bool identity = false;
+            static const bool scalar = false;
+            static const bool unit = true;
+        };
+        template<class T, class ALLOC>
+        struct constant_expression_traits<scalar_vector<T, ALLOC> > {
+            static const bool zero = false;
+            static const bool identity = false;
+            static const bool scalar = true;
+            static const bool unit = false;
+        };
+    }
+
     // (v1 + v2) [i] = v1 [i] + v2 [i]
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -1639,18 +1676,72 @@ namespace boost { namespace numeric { namespace ublas {
 #endif
     };
 
+    namespace detail {
+        // Inner products with a zero_vector or a unit_vector, which pick an element of the other
+        // operand, unless scalar expressions are used
+        template<class E1, class E2, class F>
+        struct inner_prod_fold_traits {
+            typedef typename F::result_type value_type;
+            typedef typename boost::mpl::if_c<! boost::is_same<typename vector_scalar_binary_traits<E1, E2, F>::result_type, value_type>::value,
+                                              expression_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::zero || constant_expression_traits<E2>::zero,
+                                          zero_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E1>::unit,
+                                          second_line_fold_tag,
+                typename boost::mpl::if_c<constant_expression_traits<E2>::unit,
+                                          first_line_fold_tag,
+                                          expression_fold_tag>::type>::type>::type>::type fold_category;
+        };
+
+        template<class E1, class E2, class F, class C = typename inner_prod_fold_traits<E1, E2, F>::fold_category>
+        struct inner_prod_fold {
+            typedef typename vector_scalar_binary_traits<E1, E2, F>::result_type result_type;
+            static BOOST_UBLAS_INLINE
+            result_type apply (const E1 &e1, const E2 &e2) {
+                typedef typename vector_scalar_binary_traits<E1, E2, F>::expression_type expression_type;
+                return expression_type (e1, e2);
+            }
+        };
+        template<class E1, class E2, class F>
+        struct inner_prod_fold<E1, E2, F, zero_fold_tag> {
+            typedef typename F::result_type result_type;
+            static BOOST_UBLAS_INLINE
+            result_type apply (const E1 &e1, const E2 &e2) {
+                BOOST_UBLAS_CHECK (e1.size () == e2.size (), bad_size ());
+                return result_type/*zero*/();
+            }
+        };
+        template<class E1, class E2, class F>
+        struct inner_prod_fold<E1, E2, F, first_line_fold_tag> {
+            typedef typename F::result_type result_type;
+            static BOOST_UBLAS_INLINE
+            result_type apply (const E1 &e1, const E2 &e2) {
+                BOOST_UBLAS_CHECK (e1.size () == e2.size (), bad_size ());
+                return result_type (e1 (e2.index ()));
+            }
+        };
+        template<class E1, class E2, class F>
+        struct inner_prod_fold<E1, E2, F, second_line_fold_tag> {
+            typedef typename F::result_type result_type;
+            static BOOST_UBLAS_INLINE
+            result_type apply (const E1 &e1, const E2 &e2) {
+                BOOST_UBLAS_CHECK (e1.size () == e2.size (), bad_size ());
+                return result_type (e2 (e1.index ()));
+            }
+        };
+    }
+
     // inner_prod (v1, v2) = sum (v1 [i] * v2 [i])
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
-    typename vector_scalar_binary_traits<E1, E2, vector_inner_prod<E1, E2,
-                                                                   typename promote_traits<typename E1::value_type,
-                                                                                           typename E2::value_type>::promote_type> >::result_type
+    typename detail::inner_prod_fold<E1, E2, vector_inner_prod<E1, E2,
+                                                               typename promote_traits<typename E1::value_type,
+                                                                                       typename E2::value_type>::promote_type> >::result_type
     inner_prod (const vector_expression<E1> &e1,
                 const vector_expression<E2> &e2) {
-        typedef typename vector_scalar_binary_traits<E1, E2, vector_inner_prod<E1, E2,
-                                                                   typename promote_traits<typename E1::value_type,
-                                                                                           typename E2::value_type>::promote_type> >::expression_type expression_type;
-        return expression_type (e1 (), e2 ());
+        return detail::inner_prod_fold<E1, E2, vector_inner_prod<E1, E2,
+                                                                 typename promote_traits<typename E1::value_type,
+                                                                                         typename E2::value_type>::promote_type> >::apply (e1 (), e2 ());
     }
 
     template<class E1, class E2>
@@ -1253,6 +1253,84 @@ namespace boost { namespace numeric { namespace ublas {
     template<class T, class L, class A>
     const typename generalized_vector_of_vector<T, L, A>::value_type generalized_vector_of_vector<T, L, A>::zero_ = value_type/*zero*/();
 
+    // Conversions with the other sparse matrix formats, see detail/sparse_conversion.hpp
+    namespace detail {
+        template<class T, class L, class A>
+        struct sparse_format_traits<generalized_vector_of_vector<T, L, A> > {
+            static const bool value = true;
+        };
+
+        // Appending to a sparse vector in the order of the indices
+        template<class V, class T>
+        BOOST_UBLAS_INLINE
+        void sparse_vector_append (V &v, std::size_t i, const T &t) {
+            v.push_back (i, t);
+        }
+        template<class T1, class A, class T>
+        BOOST_UBLAS_INLINE
+        void sparse_vector_append (mapped_vector<T1, A> &v, std::size_t i, const T &t) {
+            map_append (v.data (), typename A::value_type (i, t));
+        }
+
+        // Line l of v into the vector of line l
+        template<class V, class D>
+        void vector_of_vector_line_assign (const V &v, std::size_t l, D &d) {
+            typedef typename V::value_type value_type;
+            d.clear ();
+            d.reserve (sparse_line_count (v, l), false);
+            for (std::size_t k = v.begin (l); k < v.end (l); ++ k)
+                if (v.value (k) != value_type/*zero*/())
+                    sparse_vector_append (d, v.index (k), v.value (k));
+        }
+
+        // The lines of v into the vectors of m, both in the same orientation. The vectors are
+        // filled in parallel, each by a single OpenMP thread.
+        template<class V, class M>
+        void vector_of_vector_lines_assign (const V &v, M &m) {
+            typedef typename M::vector_data_value_type vector_data_value_type;
+            const std::size_t lines = v.lines ();
+            std::vector<vector_data_value_type *> vd (lines);
+            for (std::size_t l = 0; l < lines; ++ l)
+                vd [l] = &ref (m.data () [l]);
+#ifdef BOOST_UBLAS_HAVE_OPENMP
+            const long chunk = BOOST_UBLAS_SOLVE_BLOCK_SIZE;
+            if (long (lines) > chunk && v.nnz () >= std::size_t (BOOST_UBLAS_PARALLEL_THRESHOLD) &&
+                omp_get_max_threads () > 1 && ! omp_in_parallel ()) {
+#pragma omp parallel for schedule (dynamic, chunk)
+                for (long l = 0; l < long (lines); ++ l)
+                    vector_of_vector_line_assign (v, l, *vd [l]);
+                return;
+            }
+#endif
+            for (std::size_t l = 0; l < lines; ++ l)
+                vector_of_vector_line_assign (v, l, *vd [l]);
+        }
+
+        template<class V, class T, class L, class A>
+        void sparse_lines_assign (const V &v, generalized_vector_of_vector<T, L, A> &m) {
+            const bool row_major = boost::is_same<typename L::orientation_category, row_major_tag>::value;
+            if (v.row_major () == row_major) {
+                vector_of_vector_lines_assign (v, m);
+            } else {
+                sparse_lines_buffer<typename V::value_type> b;
+                b.prepare (row_major, v.line_size (), v.lines (), v.nnz ());
+                sparse_lines_transpose (v, b);
+                vector_of_vector_lines_assign (b, m);
+            }
+        }
+    }
+
+    // Conversion into any other sparse matrix format, in O(nnz), see sparse_conversion_traits.
+    // The elements are gathered line by line first.
+    template<class T2, class L2, class A2, class M>
+    void sparse_convert (const generalized_vector_of_vector<T2, L2, A2> &e, M &m) {
+        if (static_cast<const void *> (&e) != static_cast<const void *> (&m)) {
+            detail::sparse_lines_buffer<T2> b;
+            b.gather (e, typename L2::orientation_category ());
+            sparse_lines_assign (b, m);
+        }
+    }
+
 }}}
 
 #endif
@@ -16,6 +16,7 @@
 #include <boost/numeric/ublas/storage_sparse.hpp>
 #include <boost/numeric/ublas/vector_expression.hpp>
 #include <boost/numeric/ublas/detail/vector_assign.hpp>
+#include <boost/numeric/ublas/detail/sparse_conversion.hpp>
 #if BOOST_UBLAS_TYPE_CHECK
 #include <boost/numeric/ublas/vector.hpp>
 #endif
@@ -1410,6 +1411,114 @@ namespace boost { namespace numeric { namespace ublas {
     template<class T, std::size_t IB, class IA, class TA>
     const typename compressed_vector<T, IB, IA, TA>::value_type compressed_vector<T, IB, IA, TA>::zero_ = value_type/*zero*/();
 
+    namespace detail {
+        template<class T, std::size_t IB, class IA, class TA>
+        struct sparse_merge_traits<compressed_vector<T, IB, IA, TA> > {
+            static const bool value = true;
+        };
+
+        // View of a compressed vector as a single line, see detail/sparse_conversion.hpp
+        template<class V>
+        class compressed_vector_line {
+        public:
+            typedef typename V::value_type value_type;
+
+            BOOST_UBLAS_INLINE
+            explicit compressed_vector_line (const V &v):
+                v_ (v) {}
+
+            BOOST_UBLAS_INLINE
+            bool row_major () const {
+                return true;
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t lines () const {
+                return 1;
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t line_size () const {
+                return v_.size ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t nnz () const {
+                return v_.filled ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t begin (std::size_t /* l */) const {
+                return 0;
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t end (std::size_t /* l */) const {
+                return v_.filled ();
+            }
+            BOOST_UBLAS_INLINE
+            std::size_t index (std::size_t k) const {
+                return v_.index_data () [k] - V::index_base ();
+            }
+            BOOST_UBLAS_INLINE
+            const value_type &value (std::size_t k) const {
+                return v_.value_data () [k];
+            }
+
+        private:
+            const V &v_;
+        };
+
+        // Sink into a compressed vector, reserved for all elements once their number is known
+        template<class V>
+        class compressed_vector_sink {
+        public:
+            typedef typename V::size_type size_type;
+
+            BOOST_UBLAS_INLINE
+            explicit compressed_vector_sink (V &v):
+                v_ (v), filled_ (0) {}
+
+            BOOST_UBLAS_INLINE
+            std::size_t filled () const {
+                return filled_;
+            }
+
+            BOOST_UBLAS_INLINE
+            void start (std::size_t l, std::size_t p) {
+                if (l == 1) {
+                    v_.reserve (p, false);
+                    filled_ = p;
+                }
+            }
+            template<class T>
+            BOOST_UBLAS_INLINE
+            void operator () (std::size_t p, std::size_t /* l */, std::size_t i, const T &t) {
+                v_.index_data () [p] = size_type (i + V::index_base ());
+                v_.value_data () [p] = t;
+            }
+
+        private:
+            V &v_;
+            std::size_t filled_;
+        };
+    }
+
+    /** \brief Element wise sum, difference or product of two compressed vectors, merged into \c v
+     * in two passes, the first counting the elements of the result
+     *
+     * The operation is the functor \c F, scalar_plus, scalar_minus or scalar_multiplies. A
+     * product only visits the indices stored in both operands. Zero results are dropped. \c v
+     * may be either operand.
+     */
+    template<class F, class T, std::size_t IB, class IA, class TA>
+    void sparse_merge (const compressed_vector<T, IB, IA, TA> &e1, const compressed_vector<T, IB, IA, TA> &e2,
+                       compressed_vector<T, IB, IA, TA> &v, F) {
+        typedef compressed_vector<T, IB, IA, TA> vector_type;
+        BOOST_UBLAS_CHECK (e1.size () == e2.size () && v.size () == e1.size (), bad_size ());
+        vector_type t (e1.size (), 0);
+        detail::compressed_vector_sink<vector_type> s (t);
+        detail::sparse_lines_merge<F> (detail::compressed_vector_line<vector_type> (e1), detail::compressed_vector_line<vector_type> (e2),
+                                       detail::merge_functor_traits<F>::intersection, s);
+        t.set_filled (s.filled ());
+        v.assign_temporary (t);
+    }
+
     // Thanks to Kresimir Fresl for extending this to cover different index bases.
 
     /** \brief Coordimate array based sparse vector
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Filling and checking of sparse matrices for the tests of the sparse formats and kernels.
+// The test including this header defines element<T> (i, j) for real T, the pattern and the
+// values of its matrices. The complex elements follow the real ones.
+
+#ifndef BOOST_NUMERIC_UBLAS_TEST_SPARSE_UTILS_HPP
+#define BOOST_NUMERIC_UBLAS_TEST_SPARSE_UTILS_HPP
+
+#include <complex>
+#include <cstddef>
+
+typedef std::complex<double> complex_type;
+
+template<class T>
+T element (std::size_t i, std::size_t j);
+template<>
+inline complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return element<double> (i, j) * complex_type (1.0, (i + j) % 3 - 1.0);
+}
+
+template<class M>
+void fill_sparse (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            if (element<typename M::value_type> (i, j) != typename M::value_type/*zero*/())
+                m (i, j) = element<typename M::value_type> (i, j);
+}
+
+template<class M>
+void fill_dense (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (1.0 + (i + 2 * j) % 5) / typename M::value_type (4);
+}
+
+template<class D>
+std::size_t non_zeros (const D &d) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            if (d (i, j) != typename D::value_type/*zero*/())
+                ++ count;
+    return count;
+}
+
+// The elements met by the iterators of m in both orientations, forward and backward, each
+// pass meeting the given number of elements
+template<class M, class D>
+bool same_iterated (const M &m, const D &d, std::size_t elements) {
+    std::size_t count = 0;
+    for (typename M::const_iterator1 it1 = m.begin1 (); it1 != m.end1 (); ++ it1)
+        for (typename M::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2, ++ count)
+            if (*it2 != d (it2.index1 (), it2.index2 ()))
+                return false;
+    if (count != elements)
+        return false;
+    count = 0;
+    for (typename M::const_iterator2 it2 = m.begin2 (); it2 != m.end2 (); ++ it2)
+        for (typename M::const_iterator1 it1 = it2.begin (); it1 != it2.end (); ++ it1, ++ count)
+            if (*it1 != d (it1.index1 (), it1.index2 ()))
+                return false;
+    if (count != elements)
+        return false;
+    count = 0;
+    for (typename M::const_reverse_iterator1 it1 = m.rbegin1 (); it1 != m.rend1 (); ++ it1)
+        for (typename M::const_reverse_iterator2 it2 = it1.rbegin (); it2 != it1.rend (); ++ it2, ++ count)
+            if (*it2 != d (it2.index1 (), it2.index2 ()))
+                return false;
+    if (count != elements)
+        return false;
+    count = 0;
+    for (typename M::const_reverse_iterator2 it2 = m.rbegin2 (); it2 != m.rend2 (); ++ it2)
+        for (typename M::const_reverse_iterator1 it1 = it2.rbegin (); it1 != it2.rend (); ++ it1, ++ count)
+            if (*it1 != d (it1.index1 (), it1.index2 ()))
+                return false;
+    return count == elements;
+}
+// Each stored element once
+template<class M, class D>
+bool same_iterated (const M &m, const D &d) {
+    return same_iterated (m, d, m.nnz ());
+}
+
+#endif
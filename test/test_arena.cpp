@@ -0,0 +1,166 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/arena.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef unbounded_array<double, arena_allocator<double> > arena_array;
+
+BOOST_UBLAS_TEST_DEF( test_scope_rewind )
+{
+    arena a (4096);
+    BOOST_UBLAS_TEST_CHECK( arena::active () == 0 );
+    {
+        arena_scope scope (a);
+        BOOST_UBLAS_TEST_CHECK( arena::active () == &a );
+
+        vector<double, arena_array> v (100);
+        BOOST_UBLAS_TEST_CHECK( a.owns (&v (0)) );
+        BOOST_UBLAS_TEST_CHECK( reinterpret_cast<std::size_t> (&v (0)) % BOOST_UBLAS_ARENA_ALIGNMENT == 0 );
+        BOOST_UBLAS_TEST_CHECK( a.used () >= 100 * sizeof (double) );
+
+        std::size_t used = a.used ();
+        {
+            arena_scope nested;
+            BOOST_UBLAS_TEST_CHECK( arena::active () == &a );
+            // Larger than a block
+            vector<double, arena_array> w (1000, 1.0);
+            BOOST_UBLAS_TEST_CHECK( a.owns (&w (999)) );
+        }
+        BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), used );
+    }
+    BOOST_UBLAS_TEST_CHECK( arena::active () == 0 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), std::size_t (0) );
+
+    // Blocks are kept for reuse
+    std::size_t capacity = a.capacity ();
+    {
+        arena_scope scope (a);
+        vector<double, arena_array> v (1000);
+    }
+    BOOST_UBLAS_TEST_CHECK_EQUAL( a.capacity (), capacity );
+    a.release ();
+    BOOST_UBLAS_TEST_CHECK( a.capacity () <= capacity );
+}
+
+BOOST_UBLAS_TEST_DEF( test_heap_fallback )
+{
+    arena a;
+    // Allocated on the heap, released inside a scope
+    vector<double, arena_array> *v = new vector<double, arena_array> (10, 2.0);
+    BOOST_UBLAS_TEST_CHECK( ! a.owns (&(*v) (0)) );
+    {
+        arena_scope scope (a);
+        delete v;
+    }
+    BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), std::size_t (0) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_late_release )
+{
+    arena a;
+    vector<double, arena_array> *v;
+    {
+        arena_scope scope (a);
+        v = new vector<double, arena_array> (10, 2.0);
+        BOOST_UBLAS_TEST_CHECK( a.owns (&(*v) (0)) );
+    }
+    // Released after its scope, with no scope active, leaves the arena alone
+    delete v;
+    BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), std::size_t (0) );
+
+    // A stale release does not take back a newer allocation in the same place
+    {
+        arena_scope scope (a);
+        v = new vector<double, arena_array> (10, 2.0);
+    }
+    {
+        arena_scope scope (a);
+        vector<double, arena_array> w (10, 3.0);
+        const std::size_t used = a.used ();
+        delete v;
+        BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), used );
+        vector<double, arena_array> x (10, 4.0);
+        BOOST_UBLAS_TEST_CHECK( &x (0) != &w (0) );
+        BOOST_UBLAS_TEST_CHECK_EQUAL( w (9), 3.0 );
+    }
+
+    // Neither does a release where another arena is active, as on another thread
+    {
+        arena b;
+        arena_scope scope (a);
+        v = new vector<double, arena_array> (10, 2.0);
+        const std::size_t used = a.used ();
+        {
+            arena_scope other (b);
+            delete v;
+        }
+        BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), used );
+    }
+
+    // Library temporaries of default allocated containers stay on the heap
+    {
+        arena_scope scope (a);
+        matrix<double> m (4, 4, 1.0);
+        matrix<double> p (m + m);
+        BOOST_UBLAS_TEST_CHECK( ! a.owns (&p (0, 0)) );
+    }
+}
+
+BOOST_UBLAS_TEST_DEF( test_library_temporaries )
+{
+    const std::size_t n = 8;
+    matrix<double> m (n, n);
+    vector<double> x (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        x (i) = 1.0 + i;
+        for (std::size_t j = 0; j < n; ++ j)
+            m (i, j) = (i == j) ? 10.0 : 1.0 / (1.0 + i + j);
+    }
+    matrix<double> lu (m);
+    permutation_matrix<> pm (n);
+    vector<double> y (n);
+    matrix<double> p (n, n);
+
+    arena a;
+    {
+        arena_scope scope (a);
+        lu_factorize (lu, pm);
+        axpy_prod (m, x, y, true);
+        opb_prod (m, m, p, true);
+        row (p, 0) = row (m, 1) + row (m, 2);
+        project (p, range (1, 3), range (1, 3)) = project (m, range (0, 2), range (0, 2));
+        p = m + m;
+    }
+    BOOST_UBLAS_TEST_CHECK_EQUAL( a.used (), std::size_t (0) );
+    BOOST_UBLAS_TEST_CHECK( ! a.owns (&p (0, 0)) );
+
+    vector<double> r (prod (m, x));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( y, r, n, 1e-12 );
+    matrix<double> mm (m + m);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE( p, mm, n, n, 1e-12 );
+
+    lu_substitute (lu, pm, r);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( r, x, n, 1e-10 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_scope_rewind );
+    BOOST_UBLAS_TEST_DO( test_heap_fallback );
+    BOOST_UBLAS_TEST_DO( test_late_release );
+    BOOST_UBLAS_TEST_DO( test_library_temporaries );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,174 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <complex>
+
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// Deterministic band with small diagonal entries, so that pivoting is needed.
+// Triangular bands cannot be pivoted and get a dominant diagonal to stay well conditioned.
+template<class M>
+void fill_band (M &m, std::size_t lower, std::size_t upper) {
+    const double diagonal = (lower && upper) ? 0.01 : 10.0;
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            if (i <= j + lower && j <= i + upper)
+                m (i, j) = (i == j) ? diagonal * (1 + i % 3) : 1.0 + ((7 * i + 3 * j) % 11) / 5.0;
+}
+
+template<class L>
+void check_banded_lu (std::size_t size, std::size_t lower, std::size_t upper, std::size_t &test_fails__) {
+    banded_matrix<double, L> a (size, size, lower, upper);
+    a.clear ();
+    fill_band (a, lower, upper);
+    const matrix<double> dense (a);
+
+    vector<double> x (size);
+    for (std::size_t i = 0; i < size; ++ i)
+        x (i) = 1.0 + i % 5;
+    vector<double> b (prod (dense, x));
+
+    banded_matrix<double, L> lu (a);
+    permutation_matrix<> pm (size);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( banded_lu_factorize (lu, pm), std::size_t (0) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( lu.lower (), lower );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( lu.upper (), upper + lower );
+
+    vector<double> y (b);
+    banded_lu_substitute (lu, pm, y);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( y, x, size, 1e-8 );
+
+    // Several right hand sides
+    matrix<double> xs (size, 3), bs (size, 3);
+    for (std::size_t k = 0; k < 3; ++ k)
+        column (xs, k) = (k + 1.0) * x;
+    bs = prod (dense, xs);
+    banded_lu_substitute (lu, pm, bs);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE( bs, xs, size, 3, 1e-8 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_banded_lu )
+{
+    check_banded_lu<row_major> (40, 2, 1, test_fails__);
+    check_banded_lu<row_major> (60, 3, 4, test_fails__);
+    check_banded_lu<column_major> (35, 1, 2, test_fails__);
+    check_banded_lu<row_major> (20, 0, 3, test_fails__);
+    check_banded_lu<row_major> (20, 3, 0, test_fails__);
+    check_banded_lu<row_major> (1, 0, 0, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_banded_lu_singular )
+{
+    banded_matrix<double> a (5, 5, 1, 1);
+    a.clear ();
+    for (std::size_t i = 0; i < 5; ++ i)
+        a (i, i) = 1.0;
+    a (2, 2) = 0.0;
+    permutation_matrix<> pm (5);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( banded_lu_factorize (a, pm), std::size_t (3) );
+}
+
+template<class T>
+void tridiagonal (std::size_t size, std::size_t k, vector<T> &dl, vector<T> &d, vector<T> &du) {
+    dl.resize (size - 1);
+    d.resize (size);
+    du.resize (size - 1);
+    for (std::size_t i = 0; i < size; ++ i) {
+        // Zero diagonal entries force interchanges
+        d (i) = (i % 4 == 1) ? T (0) : T (0.5 + k + (i % 3));
+        if (i + 1 < size) {
+            dl (i) = T (1.0 + (i + k) % 5);
+            du (i) = T (-1.0 - (2 * i) % 3);
+        }
+    }
+}
+
+template<class T>
+vector<T> tridiagonal_prod (const vector<T> &dl, const vector<T> &d, const vector<T> &du, const vector<T> &x) {
+    std::size_t size = d.size ();
+    vector<T> b (size);
+    for (std::size_t i = 0; i < size; ++ i) {
+        b (i) = d (i) * x (i);
+        if (i > 0)
+            b (i) += dl (i - 1) * x (i - 1);
+        if (i + 1 < size)
+            b (i) += du (i) * x (i + 1);
+    }
+    return b;
+}
+
+BOOST_UBLAS_TEST_DEF( test_tridiagonal )
+{
+    const std::size_t sizes [] = { 1, 2, 3, 10, 101 };
+    for (std::size_t s = 0; s < 5; ++ s) {
+        std::size_t size = sizes [s];
+        vector<double> dl, d, du;
+        tridiagonal (size, 2, dl, d, du);
+        if (size == 1)
+            d (0) = 3.0;
+        vector<double> x (size);
+        for (std::size_t i = 0; i < size; ++ i)
+            x (i) = 1.0 + 0.25 * i;
+        vector<double> b (tridiagonal_prod (dl, d, du, x));
+        BOOST_UBLAS_TEST_CHECK_EQUAL( tridiagonal_solve (dl, d, du, b), std::size_t (0) );
+        BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( b, x, size, 1e-10 );
+    }
+
+    // Complex values
+    typedef std::complex<double> value_type;
+    vector<value_type> dl (9, value_type (1, 1)), d (10, value_type (0, 3)), du (9, value_type (-1, 0));
+    vector<value_type> x (10, value_type (2, -1));
+    vector<value_type> b (tridiagonal_prod (dl, d, du, x));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( tridiagonal_solve (dl, d, du, b), std::size_t (0) );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (b - x) < 1e-10 );
+
+    // Singular
+    vector<double> sl (2, 0.0), sd (3, 1.0), su (2, 0.0), sb (3, 1.0);
+    sd (1) = 0.0;
+    BOOST_UBLAS_TEST_CHECK_EQUAL( tridiagonal_solve (sl, sd, su, sb), std::size_t (2) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_tridiagonal_batched )
+{
+    const std::size_t size = 17, count = 5;
+    matrix<double> dl (size - 1, count), d (size, count), du (size - 1, count), b (size, count), x (size, count);
+    for (std::size_t k = 0; k < count; ++ k) {
+        vector<double> vl, vd, vu, vx (size);
+        tridiagonal (size, k, vl, vd, vu);
+        for (std::size_t i = 0; i < size; ++ i)
+            vx (i) = 0.5 * k + 1.0 + 0.1 * i;
+        column (dl, k) = vl;
+        column (d, k) = vd;
+        column (du, k) = vu;
+        column (x, k) = vx;
+        column (b, k) = tridiagonal_prod (vl, vd, vu, vx);
+    }
+    BOOST_UBLAS_TEST_CHECK_EQUAL( tridiagonal_solve_batched (dl, d, du, b), std::size_t (0) );
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE( b, x, size, count, 1e-10 );
+
+    // The singular system is reported, the others are still solved
+    matrix<double> sl (2, 3, 0.0), sd (3, 3, 1.0), su (2, 3, 0.0), sb (3, 3, 2.0);
+    sd (1, 2) = 0.0;
+    BOOST_UBLAS_TEST_CHECK_EQUAL( tridiagonal_solve_batched (sl, sd, su, sb), std::size_t (3) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( sb (2, 0), 2.0 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( sb (1, 1), 2.0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_banded_lu );
+    BOOST_UBLAS_TEST_DO( test_banded_lu_singular );
+    BOOST_UBLAS_TEST_DO( test_tridiagonal );
+    BOOST_UBLAS_TEST_DO( test_tridiagonal_batched );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <complex>
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+void fill_band (M &m, std::size_t lower, std::size_t upper) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            if (i <= j + lower && j <= i + upper)
+                m (i, j) = typename M::value_type (1.0 + (3 * i + 5 * j) % 7);
+}
+
+template<class V, class E>
+bool uses_kernel () {
+    typedef typename V::reference reference;
+    typedef typename E::value_type value_type;
+    return boost::is_same<typename detail::vector_prod_traits<V, E, scalar_assign<reference, value_type>, dense_tag>::storage_category,
+                          detail::matrix_vector_kernel_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef vector<double> dv;
+    typedef banded_matrix<double> rb;
+    typedef banded_matrix<double, column_major> cb;
+    typedef banded_adaptor<matrix<double> > ab;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dv, matrix_vector_binary1<rb, dv, matrix_vector_prod1<rb, dv, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dv, matrix_vector_binary1<cb, dv, matrix_vector_prod1<cb, dv, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dv, matrix_vector_binary1<ab, dv, matrix_vector_prod1<ab, dv, double> > > () ));
+    typedef vector_slice<dv> sv;
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dv, matrix_vector_binary1<rb, sv, matrix_vector_prod1<rb, sv, double> > > () ));
+    typedef banded_matrix<float> fb;
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dv, matrix_vector_binary1<fb, dv, matrix_vector_prod1<fb, dv, double> > > () ));
+    typedef matrix<double> dm;
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dv, matrix_vector_binary1<dm, dv, matrix_vector_prod1<dm, dv, double> > > () ));
+}
+
+template<class M>
+void check_prod_vector (const M &m, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    const matrix<value_type> dense (m);
+    vector<value_type> x (m.size2 ());
+    for (std::size_t j = 0; j < x.size (); ++ j)
+        x (j) = value_type (1.0 + j % 4);
+    const vector<value_type> expected (prod (dense, x));
+
+    vector<value_type> y (prod (m, x));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( y, expected, y.size () );
+
+    noalias (y) += prod (m, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * expected) == 0 );
+    noalias (y) -= prod (m, x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( y, expected, y.size () );
+
+    vector<value_type> z (m.size1 (), value_type (7));
+    axpy_prod (m, x, z, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected - scalar_vector<value_type> (z.size (), value_type (7))) == 0 );
+    axpy_prod (m, x, z);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( z, expected, z.size () );
+
+    // Ranges of a larger vector
+    vector<value_type> w (m.size1 () + 4, value_type (3));
+    noalias (project (w, range (2, m.size1 () + 2))) = prod (m, x);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (1), value_type (3) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (m.size1 () + 2), value_type (3) );
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        BOOST_UBLAS_TEST_CHECK_EQUAL( w (i + 2), expected (i) );
+}
+
+template<class L>
+void check_banded_vector (std::size_t size1, std::size_t size2, std::size_t lower, std::size_t upper, std::size_t &test_fails__) {
+    banded_matrix<double, L> b (size1, size2, lower, upper);
+    b.clear ();
+    fill_band (b, lower, upper);
+    check_prod_vector (b, test_fails__);
+
+    matrix<double, L> d (size1, size2, 0.0);
+    banded_adaptor<matrix<double, L> > a (d, lower, upper);
+    fill_band (a, lower, upper);
+    check_prod_vector (a, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod_vector )
+{
+    check_banded_vector<row_major> (30, 30, 2, 3, test_fails__);
+    check_banded_vector<column_major> (30, 30, 2, 3, test_fails__);
+    check_banded_vector<row_major> (17, 25, 4, 1, test_fails__);
+    check_banded_vector<column_major> (25, 17, 0, 5, test_fails__);
+    check_banded_vector<row_major> (5, 5, 7, 7, test_fails__);
+    check_banded_vector<column_major> (1, 1, 0, 0, test_fails__);
+
+    banded_matrix<std::complex<double>, column_major> c (12, 12, 1, 2);
+    c.clear ();
+    fill_band (c, 1, 2);
+    c (3, 4) = std::complex<double> (1, -2);
+    check_prod_vector (c, test_fails__);
+
+    // Precision products are not dispatched and keep their precision
+    banded_matrix<float> f (10, 10, 1, 1);
+    f.clear ();
+    fill_band (f, 1, 1);
+    vector<float> fx (10, 1.f);
+    vector<double> fy (prec_prod (f, fx));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( fy (0), double (f (0, 0) + f (0, 1)) );
+}
+
+template<class R, class M1, class M2>
+void check_banded_result (const R &r, const M1 &m1, const M2 &m2, std::size_t &test_fails__) {
+    const matrix<double> expected (prod (matrix<double> (m1), matrix<double> (m2)));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.size1 (), m1.size1 () );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.size2 (), m2.size2 () );
+    BOOST_UBLAS_TEST_CHECK( r.lower () <= m1.lower () + m2.lower () );
+    BOOST_UBLAS_TEST_CHECK( r.upper () <= m1.upper () + m2.upper () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (r) - expected) == 0 );
+}
+template<class M1, class M2>
+void check_prod_banded (const M1 &m1, const M2 &m2, std::size_t &test_fails__) {
+    check_banded_result (banded_prod (m1, m2), m1, m2, test_fails__);
+    // prod is still the lazy expression, restricted to the band of the target
+    banded_matrix<double> r (m1.size1 (), m2.size2 (), m1.lower () + m2.lower (), m1.upper () + m2.upper ());
+    noalias (r) = prod (m1, m2);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (r) - matrix<double> (banded_prod (m1, m2))) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod_banded )
+{
+    banded_matrix<double> b1 (20, 20, 2, 1);
+    banded_matrix<double, column_major> b2 (20, 20, 1, 3);
+    b1.clear ();
+    b2.clear ();
+    fill_band (b1, 2, 1);
+    fill_band (b2, 1, 3);
+    check_prod_banded (b1, b2, test_fails__);
+    check_prod_banded (b2, b1, test_fails__);
+
+    banded_matrix<double> r (banded_prod (b1, b2));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.lower (), std::size_t (3) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.upper (), std::size_t (4) );
+
+    matrix<double> d (20, 20, 0.0);
+    banded_adaptor<matrix<double> > a (d, 0, 2);
+    fill_band (a, 0, 2);
+    check_prod_banded (a, b1, test_fails__);
+    check_prod_banded (b2, a, test_fails__);
+    check_prod_banded (a, a, test_fails__);
+
+    // Rectangular, bandwidths are bounded by the size of the result
+    banded_matrix<double> b3 (6, 9, 4, 2), b4 (9, 4, 3, 5);
+    b3.clear ();
+    b4.clear ();
+    fill_band (b3, 4, 2);
+    fill_band (b4, 3, 5);
+    check_prod_banded (b3, b4, test_fails__);
+    banded_matrix<double> r34 (banded_prod (b3, b4));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r34.lower (), std::size_t (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r34.upper (), std::size_t (3) );
+
+    // Used as the operand of further products
+    vector<double> x (20, 1.0);
+    vector<double> y (prod (banded_prod (b1, b2), x));
+    vector<double> z (prod (matrix<double> (b1), vector<double> (prod (b2, x))));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( y, z, 20 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod_vector );
+    BOOST_UBLAS_TEST_DO( test_prod_banded );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,233 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Eight block rows to a chunk of the threaded products, which start at a hundred elements
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 8
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "utils.hpp"
+#include "sparse_utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// About a quarter of the blocks of 3 by 2 are non zero, some of them only partly
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    if ((i / 3 * 7 + j / 2 * 5) % 4 != 0 || (i + 2 * j) % 5 == 0)
+        return T/*zero*/();
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+
+template<class B, class T, class L>
+void check_storage (B &b, std::size_t &test_fails__) {
+    const std::size_t size1 = b.size1 (), size2 = b.size2 ();
+    matrix<T, L> d (size1, size2, T/*zero*/());
+    fill_sparse (d);
+    fill_sparse (b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (b - d) == 0 );
+    BOOST_UBLAS_TEST_CHECK( b.nnz () == b.nnz_blocks () * b.block1 () * b.block2 () );
+    BOOST_UBLAS_TEST_CHECK( same_iterated (b, d) );
+    const B &cb (b);
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j)
+            BOOST_UBLAS_TEST_CHECK( cb (i, j) == d (i, j) && (cb.find_element (i, j) != 0) ==
+                                    (cb.find_block (i / b.block1 (), j / b.block2 ()) != 0) );
+
+    // Elements of stored blocks are zeroed, others insert a block
+    std::size_t blocks = b.nnz_blocks ();
+    b.erase_element (0, 0);
+    BOOST_UBLAS_TEST_CHECK( b.nnz_blocks () == blocks && cb (0, 0) == T/*zero*/() );
+    b.insert_element (size1 - 1, size2 - 1, T (5));
+    BOOST_UBLAS_TEST_CHECK( cb (size1 - 1, size2 - 1) == T (5) );
+    T *block = b.insert_block (0, 0);
+    block [0] = T (7);
+    BOOST_UBLAS_TEST_CHECK( cb (0, 0) == T (7) && b.insert_block (0, 0) == block );
+    b *= T (2);
+    BOOST_UBLAS_TEST_CHECK( cb (0, 0) == T (14) );
+    b.clear ();
+    BOOST_UBLAS_TEST_CHECK( b.nnz_blocks () == 0 && norm_inf (b) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_storage )
+{
+    block_compressed_matrix<double, 3, 2> r (24, 16);
+    check_storage<block_compressed_matrix<double, 3, 2>, double, row_major> (r, test_fails__);
+    block_compressed_matrix<double, 3, 2, column_major> c (24, 16);
+    check_storage<block_compressed_matrix<double, 3, 2, column_major>, double, column_major> (c, test_fails__);
+    block_compressed_matrix<complex_type> rr (15, 20, 5, 4);
+    check_storage<block_compressed_matrix<complex_type>, complex_type, row_major> (rr, test_fails__);
+    block_compressed_matrix<double, 0, 0, column_major> rc (6, 6, 1, 1);
+    check_storage<block_compressed_matrix<double, 0, 0, column_major>, double, column_major> (rc, test_fails__);
+}
+
+template<class B, class S>
+void check_conversion (const S &s, std::size_t block1, std::size_t block2, std::size_t &test_fails__) {
+    typedef typename B::value_type value_type;
+    const matrix<value_type> d (s);
+    B b (s, block1, block2);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (b - d) == 0 );
+    BOOST_UBLAS_TEST_CHECK( same_iterated (b, d) );
+    compressed_matrix<value_type> r (b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - d) == 0 && r.nnz () <= b.nnz () );
+    compressed_matrix<value_type, column_major> c (b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - d) == 0 );
+
+    // Assignments keep the block size
+    B t (d.size1 (), d.size2 (), block1, block2);
+    t = s;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (t - d) == 0 && t.block1 () == block1 && t.block2 () == block2 );
+    t = trans (trans (d));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (t - d) == 0 && t.nnz_blocks () == b.nnz_blocks () );
+    t += s;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (t - value_type (2) * d) == 0 );
+    t.plus_assign (d);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (t - value_type (3) * d) == 0 );
+    t -= b;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (t - value_type (2) * d) == 0 );
+    t.assign (t + b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (t - value_type (3) * d) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_conversion )
+{
+    const std::size_t size1 = 24, size2 = 36;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    compressed_matrix<double, column_major, 1> cc (size1, size2);
+    fill_sparse (cc);
+    coordinate_matrix<double> co (size1, size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j)
+            if (element<double> (i, j) != 0) {
+                // Repeated elements are summed
+                co.append_element (i, j, 0.5 * element<double> (i, j));
+                co.append_element (i, j, 0.5 * element<double> (i, j));
+            }
+    matrix<double> d (size1, size2, 0.0);
+    fill_sparse (d);
+
+    check_conversion<block_compressed_matrix<double, 3, 2> > (cr, 3, 2, test_fails__);
+    check_conversion<block_compressed_matrix<double, 3, 2, column_major> > (cr, 3, 2, test_fails__);
+    check_conversion<block_compressed_matrix<double, 3, 2> > (cc, 3, 2, test_fails__);
+    check_conversion<block_compressed_matrix<double, 3, 2> > (co, 3, 2, test_fails__);
+    check_conversion<block_compressed_matrix<double, 4, 4, column_major> > (co, 4, 4, test_fails__);
+    check_conversion<block_compressed_matrix<double> > (d, 2, 6, test_fails__);
+    check_conversion<block_compressed_matrix<double> > (cr, 1, 1, test_fails__);
+    check_conversion<block_compressed_matrix<double, 0, 0, column_major> > (d, 8, 9, test_fails__);
+    check_conversion<block_compressed_matrix<double> > (zero_matrix<double> (size1, size2), 4, 3, test_fails__);
+
+    block_compressed_matrix<double, 2, 2> b (cr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (b - d) == 0 );
+    block_compressed_matrix<double, 2, 2> e;
+    BOOST_UBLAS_TEST_CHECK( e.size1 () == 0 && e.nnz_blocks () == 0 );
+    e = b;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (e - d) == 0 );
+}
+
+template<class M, class E1, class E2>
+bool uses_kernel () {
+    typedef typename M::reference reference;
+    typedef typename E1::value_type value_type;
+    typedef matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, value_type> > expression_type;
+    return boost::is_same<typename detail::matrix_prod_traits<M, expression_type, scalar_assign<reference, value_type>, dense_proxy_tag>::storage_category,
+                          detail::matrix_matrix_kernel_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef block_compressed_matrix<double, 2, 2> bm;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix<double>, bm, matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix<double, column_major>, bm, matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix_range<matrix<double> >, bm, matrix_range<matrix<double, column_major> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<double>, matrix<double>, bm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<double>, bm, compressed_matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<compressed_matrix<double>, bm, matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<complex_type>, bm, matrix<complex_type> > () ));
+}
+
+template<class B>
+void check_prod (const B &b, std::size_t &test_fails__) {
+    typedef typename B::value_type value_type;
+    const matrix<value_type> d (b);
+    const double tolerance = 1e-13 * (1 + norm_inf (d));
+
+    vector<value_type> x (b.size2 ()), y (b.size1 ()), e (b.size1 ());
+    for (std::size_t j = 0; j < x.size (); ++ j)
+        x (j) = value_type (1.0 + j % 4) / value_type (3);
+    e = prod (d, x);
+    y = prod (b, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    noalias (y) += prod (b, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+    noalias (y) -= prod (b, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= 2 * tolerance );
+    axpy_prod (b, x, y, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    axpy_prod (b, x, y, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+
+    matrix<value_type> xr (b.size2 (), 7), yr (b.size1 (), 7), er (b.size1 (), 7);
+    fill_dense (xr);
+    matrix<value_type, column_major> xc (xr), yc (b.size1 (), 7);
+    er = prod (d, xr);
+    yr = prod (b, xr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - er) <= tolerance );
+    noalias (yc) = prod (b, xc);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yc - er) <= tolerance );
+    noalias (yc) += prod (b, xr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yc - value_type (2) * er) <= 2 * tolerance );
+    noalias (yr) -= prod (b, xc);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr) <= 2 * tolerance );
+    axpy_prod (b, xr, yr, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - er) <= tolerance );
+    axpy_prod (b, xc, yr, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - value_type (2) * er) <= 2 * tolerance );
+
+    // Ranges of the dense operands, a single column
+    matrix<value_type> wide (b.size2 () + 2, 9), out (b.size1 () + 3, 5, value_type (-1));
+    fill_dense (wide);
+    matrix_range<matrix<value_type> > rin (wide, range (2, b.size2 () + 2), range (3, 4));
+    matrix_range<matrix<value_type> > rout (out, range (1, b.size1 () + 1), range (2, 3));
+    noalias (rout) = prod (b, rin);
+    matrix<value_type> ein (rin);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<value_type> (rout) - prod (d, ein)) <= tolerance );
+    BOOST_UBLAS_TEST_CHECK( out (0, 2) == value_type (-1) && out (1, 1) == value_type (-1) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    const std::size_t size1 = 60, size2 = 48;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    check_prod (block_compressed_matrix<double, 3, 2> (cr), test_fails__);
+    check_prod (block_compressed_matrix<double, 3, 2, column_major> (cr), test_fails__);
+    check_prod (block_compressed_matrix<double, 4, 4> (cr), test_fails__);
+    check_prod (block_compressed_matrix<double> (cr, 6, 1), test_fails__);
+    check_prod (block_compressed_matrix<double, 0, 0, column_major> (cr, 5, 8), test_fails__);
+    compressed_matrix<complex_type> cz (size1, size2);
+    fill_sparse (cz);
+    check_prod (block_compressed_matrix<complex_type, 3, 2> (cz), test_fails__);
+    check_prod (block_compressed_matrix<complex_type> (cz, 2, 3), test_fails__);
+    check_prod (block_compressed_matrix<double, 3, 2> (size1, size2), test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_storage );
+    BOOST_UBLAS_TEST_DO( test_conversion );
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small blocks and panels, and the threaded path when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 8
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+template<>
+std::complex<double> element<std::complex<double> > (std::size_t i, std::size_t j) {
+    return std::complex<double> (1.0 + (3 * i + 5 * j) % 7, 2.0 - (i + 2 * j) % 5) / 8.0;
+}
+
+// A well conditioned triangle with a dominant diagonal, the other triangle is filled too
+template<class M>
+void fill_matrix (M &m) {
+    typedef typename M::value_type value_type;
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = i == j ? value_type (2.0 + i % 3) : element<value_type> (i, j);
+}
+
+template<class M>
+void fill_rhs (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = element<typename M::value_type> (j, i + j);
+}
+
+template<class E1, class E2>
+bool blocked () {
+    return boost::is_same<typename detail::matrix_solve_traits<E1, E2>::storage_category,
+                          detail::blocked_solve_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef matrix<double> dm;
+    typedef matrix<double, column_major> cm;
+    BOOST_UBLAS_TEST_CHECK(( blocked<dm, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( blocked<cm, matrix_range<dm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( blocked<triangular_matrix<double, lower>, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( blocked<triangular_adaptor<const dm, upper>, cm> () ));
+    BOOST_UBLAS_TEST_CHECK(( blocked<triangular_adaptor<const triangular_matrix<double, unit_lower>, unit_lower>, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! blocked<banded_matrix<double>, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! blocked<compressed_matrix<double>, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! blocked<dm, compressed_matrix<double> > () ));
+}
+
+// Solves with t, which holds the triangle C of the dense d
+template<class C, class M, class D>
+void check_solve (const M &t, const D &d, std::size_t size2, std::size_t &test_fails__) {
+    typedef typename D::value_type value_type;
+    typedef typename D::orientation_category orientation_category;
+    typedef typename boost::mpl::if_<boost::is_same<orientation_category, row_major_tag>, row_major, column_major>::type layout_type;
+    typedef typename boost::mpl::if_<boost::is_same<C, lower_tag>, lower,
+            typename boost::mpl::if_<boost::is_same<C, upper_tag>, upper,
+            typename boost::mpl::if_<boost::is_same<C, unit_lower_tag>, unit_lower, unit_upper>::type>::type>::type triangle_type;
+
+    const std::size_t size = d.size1 ();
+    const triangular_adaptor<const D, triangle_type> triangle (d);
+    const matrix<value_type> a (triangle);
+    matrix<value_type, layout_type> b (size, size2);
+    fill_rhs (b);
+    const double tolerance = 1e-12 * (1 + norm_inf (b)) * size;
+
+    matrix<value_type, layout_type> x (b);
+    inplace_solve (t, x, C ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, x) - b) <= tolerance );
+
+    // Columns of a larger matrix, the others are not touched
+    matrix<value_type, layout_type> w (size + 2, size2 + 3, value_type (5));
+    project (w, range (1, size + 1), range (2, size2 + 2)) = b;
+    matrix_range<matrix<value_type, layout_type> > wr (w, range (1, size + 1), range (2, size2 + 2));
+    inplace_solve (t, wr, C ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, wr) - b) <= tolerance );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (0, 0), value_type (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (size + 1, size2 + 2), value_type (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (1, 1), value_type (5) );
+
+    BOOST_UBLAS_TEST_CHECK( norm_inf (solve (t, b, C ()) - x) <= tolerance );
+}
+
+template<class T, class L>
+void check_dense (std::size_t size, std::size_t size2, std::size_t &test_fails__) {
+    matrix<T, L> d (size, size);
+    fill_matrix (d);
+    check_solve<lower_tag> (d, d, size2, test_fails__);
+    check_solve<upper_tag> (d, d, size2, test_fails__);
+    check_solve<unit_lower_tag> (d, d, size2, test_fails__);
+    check_solve<unit_upper_tag> (d, d, size2, test_fails__);
+    check_solve<lower_tag> (triangular_adaptor<const matrix<T, L>, lower> (d), d, size2, test_fails__);
+    check_solve<unit_upper_tag> (triangular_adaptor<const matrix<T, L>, upper> (d), d, size2, test_fails__);
+}
+
+template<class T, class L>
+void check_packed (std::size_t size, std::size_t size2, std::size_t &test_fails__) {
+    matrix<T, L> d (size, size);
+    fill_matrix (d);
+    const triangular_matrix<T, lower, L> tl ((triangular_adaptor<const matrix<T, L>, lower> (d)));
+    const triangular_matrix<T, upper, L> tu ((triangular_adaptor<const matrix<T, L>, upper> (d)));
+    check_solve<lower_tag> (tl, d, size2, test_fails__);
+    check_solve<upper_tag> (tu, d, size2, test_fails__);
+    check_solve<unit_lower_tag> (tl, d, size2, test_fails__);
+    const triangular_matrix<T, rfp_upper, L> tr ((triangular_adaptor<const matrix<T, L>, upper> (d)));
+    check_solve<upper_tag> (tr, d, size2, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_solve )
+{
+    check_dense<double, row_major> (37, 70, test_fails__);
+    check_dense<double, column_major> (37, 70, test_fails__);
+    check_dense<double, row_major> (16, 3, test_fails__);
+    check_dense<double, column_major> (1, 1, test_fails__);
+    check_dense<std::complex<double>, column_major> (19, 40, test_fails__);
+    check_packed<double, row_major> (29, 45, test_fails__);
+    check_packed<double, column_major> (29, 45, test_fails__);
+    check_packed<double, row_major> (8, 1, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_lu_substitute )
+{
+    const std::size_t size = 33;
+    matrix<double> a (size, size);
+    fill_matrix (a);
+    for (std::size_t i = 0; i < size; ++ i)
+        a (size - 1 - i, i) += 3.0;
+    matrix<double> lu (a);
+    permutation_matrix<std::size_t> pm (size);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( lu_factorize (lu, pm), std::size_t (0) );
+
+    matrix<double> b (size, 50);
+    fill_rhs (b);
+    matrix<double> x (b);
+    lu_substitute (lu, pm, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, x) - b) <= 1e-10 );
+
+    // Banded triangles are not blocked
+    banded_matrix<double> band (size, size, 2, 0);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = i >= 2 ? i - 2 : 0; j <= i; ++ j)
+            band (i, j) = a (i, j);
+    x = b;
+    inplace_solve (band, x, lower_tag ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (band, x) - b) <= 1e-10 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_solve );
+    BOOST_UBLAS_TEST_DO( test_lu_substitute );
+
+    BOOST_UBLAS_TEST_END();
+}
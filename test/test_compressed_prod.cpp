@@ -0,0 +1,120 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Rows and columns of the kernel in chunks of four, threaded under OpenMP from a hundred elements
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "utils.hpp"
+#include "sparse_utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// Rows of irregular lengths, every seventh row empty and every eleventh row long
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    if (i % 7 == 3)
+        return T/*zero*/();
+    if (i % 11 != 5 && (3 * i + 5 * j) % (2 + i % 9) != 0)
+        return T/*zero*/();
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+
+template<class M, class E1, class E2>
+bool uses_kernel () {
+    typedef typename M::reference reference;
+    typedef typename E1::value_type value_type;
+    typedef matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, value_type> > expression_type;
+    return boost::is_same<typename detail::matrix_prod_traits<M, expression_type, scalar_assign<reference, value_type>, dense_proxy_tag>::storage_category,
+                          detail::matrix_matrix_kernel_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef compressed_matrix<double> cm;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix<double>, cm, matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix<double, column_major>, compressed_matrix<double, column_major, 1>, matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<double>, matrix<double>, cm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<double>, cm, cm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<complex_type>, cm, matrix<complex_type> > () ));
+}
+
+// Products with k right hand sides, row and column major
+template<class S>
+void check_prod (const S &s, std::size_t k, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (s);
+    const double tolerance = 1e-13 * (1 + norm_inf (d));
+
+    matrix<value_type> xr (s.size2 (), k), yr (s.size1 (), k), er (s.size1 (), k);
+    fill_dense (xr);
+    matrix<value_type, column_major> xc (xr), yc (s.size1 (), k);
+    er = prod (d, xr);
+    yr = prod (s, xr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - er) <= tolerance );
+    noalias (yc) = prod (s, xc);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yc - er) <= tolerance );
+    noalias (yc) += prod (s, xr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yc - value_type (2) * er) <= 2 * tolerance );
+    noalias (yr) -= prod (s, xc);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr) <= 2 * tolerance );
+    axpy_prod (s, xr, yr, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - er) <= tolerance );
+    axpy_prod (s, xc, yr, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - value_type (2) * er) <= 2 * tolerance );
+
+    // Ranges of the dense operands
+    matrix<value_type> wide (s.size2 () + 2, k + 4), out (s.size1 () + 3, k + 5, value_type (-1));
+    fill_dense (wide);
+    matrix_range<matrix<value_type> > rin (wide, range (2, s.size2 () + 2), range (3, k + 3));
+    matrix_range<matrix<value_type> > rout (out, range (1, s.size1 () + 1), range (2, k + 2));
+    noalias (rout) = prod (s, rin);
+    matrix<value_type> ein (rin);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<value_type> (rout) - prod (d, ein)) <= tolerance );
+    BOOST_UBLAS_TEST_CHECK( out (0, 2) == value_type (-1) && out (1, 1) == value_type (-1) && out (1, k + 2) == value_type (-1) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    const std::size_t size1 = 150, size2 = 53;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    check_prod (cr, 1, test_fails__);
+    check_prod (cr, 7, test_fails__);
+    check_prod (cr, 37, test_fails__);
+    check_prod (compressed_matrix<double, column_major> (cr), 7, test_fails__);
+    check_prod (compressed_matrix<double, column_major> (cr), 37, test_fails__);
+    check_prod (compressed_matrix<double, row_major, 1> (cr), 37, test_fails__);
+    check_prod (compressed_matrix<double, column_major, 1> (cr), 37, test_fails__);
+    compressed_matrix<complex_type> cz (size1, size2);
+    fill_sparse (cz);
+    check_prod (cz, 9, test_fails__);
+    check_prod (compressed_matrix<complex_type, column_major> (cz), 9, test_fails__);
+    check_prod (compressed_matrix<double> (size1, size2), 7, test_fails__);
+    check_prod (compressed_matrix<double> (3, size2), 7, test_fails__);
+
+    // Rows past the last filled one
+    compressed_matrix<double> partial (size1, size2);
+    partial (2, 5) = 1.5;
+    partial (9, 0) = -2.0;
+    check_prod (partial, 7, test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <complex>
+
+#include <limits>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+template<class M>
+void fill_matrix (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (1.0 + (3 * i + 5 * j) % 7) / typename M::value_type (8);
+}
+
+template<class V>
+void fill_vector (V &v) {
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        v (i) = typename V::value_type (1.0 + (2 * i) % 5) / typename V::value_type (4);
+}
+
+template<class R, class E>
+bool has_type (const E &) {
+    return boost::is_same<R, E>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_vector )
+{
+    vector<double> v (7);
+    fill_vector (v);
+    const zero_vector<double> z (7);
+    const unit_vector<double> u (7, 3);
+
+    // Sums keep their expression types and are folded when assigned
+    BOOST_UBLAS_TEST_CHECK( (has_type<vector_binary<vector<double>, zero_vector<double>, scalar_plus<double, double> > > (v + z)) );
+    vector<double> r (v + z);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - v) == 0 );
+    r = z + v;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - v) == 0 );
+    noalias (r) -= v - z;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r) == 0 );
+    r = z - v;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r + v) == 0 );
+    r = v;
+    r (1) = std::numeric_limits<double>::quiet_NaN ();
+    r = r + z;
+    BOOST_UBLAS_TEST_CHECK( r (1) != r (1) && r (2) == v (2) );
+    BOOST_UBLAS_TEST_CHECK( inner_prod (v, z) == 0 );
+    BOOST_UBLAS_TEST_CHECK( inner_prod (z, v) == 0 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( inner_prod (v, u), v (3) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( inner_prod (u, v), v (3) );
+    BOOST_UBLAS_TEST_CHECK( has_type<double> (inner_prod (u, v)) );
+
+    // The value type changes: not folded
+    vector<complex_type> c (7);
+    fill_vector (c);
+    vector<complex_type> rc (c + z);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - c) == 0 );
+    BOOST_UBLAS_TEST_CHECK( inner_prod (c, u) == c (3) );
+    BOOST_UBLAS_TEST_CHECK( (z + c) (2) == c (2) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrix_vector )
+{
+    matrix<double> m (5, 7);
+    fill_matrix (m);
+    vector<double> v (7), w (5);
+    fill_vector (v);
+    fill_vector (w);
+
+    BOOST_UBLAS_TEST_CHECK( (has_type<matrix_vector_binary1<matrix<double>, zero_vector<double>,
+                                                            matrix_vector_prod1<matrix<double>, zero_vector<double>, double> > >
+                                 (prod (m, zero_vector<double> (7)))) );
+    vector<double> r (w);
+    r = prod (m, zero_vector<double> (7));
+    BOOST_UBLAS_TEST_CHECK( r.size () == 5 && norm_inf (r) == 0 );
+    r = w;
+    noalias (r) += prod (zero_matrix<double> (5, 7), v);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - w) == 0 );
+    r = prod (identity_matrix<double> (7), v);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - v) == 0 );
+    r = prod (w, identity_matrix<double> (5));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - w) == 0 );
+    noalias (r) -= prod (identity_matrix<double> (5), w);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r) == 0 );
+
+    // Identity matrices which are not square
+    r = prod (identity_matrix<double> (5, 7), v);
+    BOOST_UBLAS_TEST_CHECK( r.size () == 5 && norm_inf (r - subrange (v, 0, 5)) == 0 );
+    r = prod (v, identity_matrix<double> (7, 3));
+    BOOST_UBLAS_TEST_CHECK( r.size () == 3 && norm_inf (r - subrange (v, 0, 3)) == 0 );
+
+    // Unit vectors pick a column or a row
+    r = prod (m, unit_vector<double> (7, 4));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - column (m, 4)) == 0 );
+    r = prod (unit_vector<double> (5, 2), m);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - row (m, 2)) == 0 );
+    r = prod (trans (m), unit_vector<double> (5, 1));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - row (m, 1)) == 0 );
+    r = w;
+    noalias (r) += prod (m, unit_vector<double> (7, 6));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - w - column (m, 6)) == 0 );
+    compressed_vector<double> s (5);
+    s = prod (m, unit_vector<double> (7, 4));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - column (m, 4)) == 0 );
+
+    // Scalar matrices sum the vector
+    r = prod (scalar_matrix<double> (5, 7, 2.0), v);
+    BOOST_UBLAS_TEST_CHECK( r.size () == 5 && std::abs (r (4) - 2.0 * sum (v)) <= 1e-14 );
+    r = prod (w, scalar_matrix<double> (5, 3, 0.5));
+    BOOST_UBLAS_TEST_CHECK( r.size () == 3 && std::abs (r (0) - 0.5 * sum (w)) <= 1e-14 );
+
+    // Mixed value types are not folded
+    vector<complex_type> c (7);
+    fill_vector (c);
+    vector<complex_type> rc (prod (identity_matrix<double> (7), c));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - c) == 0 );
+    rc = prod (m, unit_vector<complex_type> (7, 4));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - column (m, 4)) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrix )
+{
+    matrix<double> a (5, 7), b (7, 4);
+    fill_matrix (a);
+    fill_matrix (b);
+    const zero_matrix<double> z (5, 7);
+
+    BOOST_UBLAS_TEST_CHECK( (has_type<matrix_binary<matrix<double>, zero_matrix<double>, scalar_plus<double, double> > > (a + z)) );
+    matrix<double> r (a + z);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - a) == 0 );
+    r = z + a;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - a) == 0 );
+    r = z - a;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r + a) == 0 );
+
+    BOOST_UBLAS_TEST_CHECK( (has_type<matrix_matrix_binary<matrix<double>, zero_matrix<double>,
+                                                           matrix_matrix_prod<matrix<double>, zero_matrix<double>, double> > >
+                                 (prod (a, zero_matrix<double> (7, 4)))) );
+    r = prod (zero_matrix<double> (3, 5), a);
+    BOOST_UBLAS_TEST_CHECK( r.size1 () == 3 && r.size2 () == 7 && norm_inf (r) == 0 );
+    r = prod (identity_matrix<double> (5), a);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - a) == 0 );
+    r = prod (a, identity_matrix<double> (7));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - a) == 0 );
+    r = prod (identity_matrix<double> (5, 3), matrix<double> (subrange (a, 0, 3, 0, 7)));
+    BOOST_UBLAS_TEST_CHECK( r.size1 () == 5 && norm_inf (subrange (r, 0, 3, 0, 7) - subrange (a, 0, 3, 0, 7)) == 0 &&
+                            norm_inf (subrange (r, 3, 5, 0, 7)) == 0 );
+
+    // Scalar matrices: sums of the columns or of the rows of the other operand
+    r = prod (scalar_matrix<double> (3, 5, 2.0), scalar_matrix<double> (5, 2, 3.0));
+    BOOST_UBLAS_TEST_CHECK( r.size1 () == 3 && r.size2 () == 2 && r (2, 1) == 30.0 );
+    const scalar_matrix<double> s1 (3, 5, 2.0), s2 (7, 6, -0.5);
+    BOOST_UBLAS_TEST_CHECK( (has_type<matrix_matrix_binary<scalar_matrix<double>, matrix<double>,
+                                                           matrix_matrix_prod<scalar_matrix<double>, matrix<double>, double> > >
+                                 (prod (s1, a))) );
+    r = prod (s1, a);
+    matrix<double> expected (prod (matrix<double> (s1), a));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= 1e-14 );
+    r = prod (a, s2);
+    expected = prod (a, matrix<double> (s2));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= 1e-14 );
+    r = prod (scalar_matrix<double> (3, 0, 1.0), scalar_matrix<double> (0, 2, 1.0));
+    BOOST_UBLAS_TEST_CHECK( r.size1 () == 3 && r.size2 () == 2 && norm_inf (r) == 0 );
+    r = prod (scalar_matrix<double> (3, 0, 1.0), matrix<double> (0, 2));
+    BOOST_UBLAS_TEST_CHECK( r.size1 () == 3 && r.size2 () == 2 && norm_inf (r) == 0 );
+
+    // Folded results in larger expressions and assignments
+    r = a;
+    noalias (r) += prod (a, identity_matrix<double> (7));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - 2.0 * a) == 0 );
+    noalias (r) -= prod (zero_matrix<double> (5, 5), a);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - 2.0 * a) == 0 );
+    r = prod (matrix<double> (prod (identity_matrix<double> (5), a)), b);
+    expected = prod (a, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= 1e-14 );
+
+    // Mixed value types are not folded
+    matrix<complex_type> c (5, 7);
+    fill_matrix (c);
+    matrix<complex_type> rc (prod (identity_matrix<double> (5), c));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - c) == 0 );
+    rc = c + zero_matrix<double> (5, 7);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - c) == 0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_vector );
+    BOOST_UBLAS_TEST_DO( test_matrix_vector );
+    BOOST_UBLAS_TEST_DO( test_matrix );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+void fill (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = 1000.0 * i + j;
+}
+
+template<class V, class E>
+bool copies_vector () {
+    return boost::is_same<typename detail::vector_copy_traits<V, E, scalar_assign<typename V::reference, typename E::value_type>, dense_tag>::storage_category,
+                          detail::dense_copy_tag>::value;
+}
+template<class M, class E>
+bool copies_matrix () {
+    return boost::is_same<typename detail::matrix_copy_traits<M, E, scalar_assign<typename M::reference, typename E::value_type>, dense_tag>::storage_category,
+                          detail::dense_copy_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef matrix<double> rm;
+    typedef matrix<double, column_major> cm;
+    typedef vector<double> dv;
+    BOOST_UBLAS_TEST_CHECK(( copies_matrix<rm, rm> () ));
+    BOOST_UBLAS_TEST_CHECK(( copies_matrix<matrix_range<rm>, matrix_range<const rm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( copies_matrix<cm, matrix_range<cm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( copies_matrix<matrix<double, padded_row_major>, rm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! copies_matrix<rm, cm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! copies_matrix<matrix<float>, rm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! copies_matrix<rm, matrix_slice<rm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! copies_matrix<matrix<double, row_major, std::vector<double> >, rm> () ));
+
+    BOOST_UBLAS_TEST_CHECK(( copies_vector<dv, dv> () ));
+    BOOST_UBLAS_TEST_CHECK(( copies_vector<vector_range<dv>, vector_range<const dv> > () ));
+    BOOST_UBLAS_TEST_CHECK(( copies_vector<matrix_row<rm>, dv> () ));
+    BOOST_UBLAS_TEST_CHECK(( copies_vector<dv, matrix_column<const cm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! copies_vector<dv, matrix_column<rm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! copies_vector<dv, vector_slice<dv> > () ));
+}
+
+template<class L1, class L2>
+void check_matrix (std::size_t &test_fails__) {
+    matrix<double, L2> b (23, 37);
+    fill (b);
+
+    matrix<double, L1> a (23, 37);
+    noalias (a) = b;
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( a, b, 23, 37 );
+
+    matrix<double, L1> c (b);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( c, b, 23, 37 );
+
+    a.clear ();
+    noalias (project (a, range (2, 12), range (5, 20))) = project (b, range (10, 20), range (1, 16));
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t j = 0; j < a.size2 (); ++ j) {
+            double expected = (i >= 2 && i < 12 && j >= 5 && j < 20) ? b (i + 8, j - 4) : 0.0;
+            if (a (i, j) != expected)
+                ++ test_fails__;
+        }
+
+    matrix<double, L1> p (project (b, range (3, 9), range (0, 37)));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( p (5, 36), b (8, 36) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrix )
+{
+    check_matrix<row_major, row_major> (test_fails__);
+    check_matrix<column_major, column_major> (test_fails__);
+    check_matrix<padded_row_major, row_major> (test_fails__);
+    check_matrix<column_major, padded_column_major> (test_fails__);
+    // Not dispatched, still correct
+    check_matrix<row_major, column_major> (test_fails__);
+
+    matrix<std::complex<double> > z (3, 4, std::complex<double> (1, 2));
+    matrix<std::complex<double> > w (3, 4);
+    noalias (w) = z;
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( w, z, 3, 4 );
+
+    matrix<double> e1 (0, 5), e2 (0, 5);
+    noalias (e1) = e2;
+    BOOST_UBLAS_TEST_CHECK_EQUAL( e1.size1 (), std::size_t (0) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_vector )
+{
+    vector<double> v (50);
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        v (i) = 1.0 + i;
+
+    vector<double> w (v);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( w, v, 50 );
+
+    w.clear ();
+    noalias (project (w, range (10, 30))) = project (v, range (0, 20));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (9), 0.0 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (10), 1.0 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (29), 20.0 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (30), 0.0 );
+
+    matrix<double> m (4, 50);
+    row (m, 2) = v;
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m (2, 49), 50.0 );
+    vector<double> r (row (m, 2));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( r, v, 50 );
+
+    matrix<double, column_major> c (50, 3);
+    column (c, 1) = v;
+    noalias (column (c, 2)) = column (c, 1);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( c (17, 2), 18.0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_matrix );
+    BOOST_UBLAS_TEST_DO( test_vector );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,246 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small chunks of lines, and the threaded path when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 8
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+template<>
+complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return complex_type (1.0 + (3 * i + 5 * j) % 7, 2.0 - (i + 2 * j) % 5) / 8.0;
+}
+
+template<class M>
+void fill_matrix (M &m, std::size_t offset = 0) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = element<typename M::value_type> (i + offset, j);
+}
+
+template<class M, class E1, class E2>
+bool uses_kernel () {
+    typedef typename M::reference reference;
+    typedef typename E1::value_type value_type;
+    typedef matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, value_type> > expression_type;
+    return boost::is_same<typename detail::matrix_prod_traits<M, expression_type, scalar_assign<reference, value_type>, dense_tag>::storage_category,
+                          detail::diagonal_prod_tag>::value;
+}
+
+// Diagonal matrices take part in expressions as their banded bases
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef matrix<double> dm;
+    typedef matrix<double, column_major> cm;
+    typedef banded_matrix<double> bm;
+    typedef banded_adaptor<const cm> ba;
+    typedef compressed_matrix<double> sm;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dm, bm, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<cm, dm, bm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix_range<dm>, ba, matrix_range<cm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<sm, bm, sm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<sm, sm, ba> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, bm, bm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, bm, sm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<sm, bm, compressed_matrix<double, column_major> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, triangular_matrix<double>, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<complex_type>, bm, dm> () ));
+}
+
+// Products of the diagonal d, held as the dense a, with dense matrices from either side
+template<class T, class L, class D>
+void check_prod (const D &d, std::size_t size, std::size_t &test_fails__) {
+    typedef matrix<T, L> matrix_type;
+    const matrix<T> a (d);
+
+    // Left
+    matrix_type b (a.size2 (), size);
+    fill_matrix (b);
+    matrix_type expected (prod (a, b));
+    double tolerance = 1e-12 * (1 + norm_inf (expected));
+    matrix_type r (a.size1 (), size, T (3));
+    noalias (r) = prod (d, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= tolerance );
+    noalias (r) += prod (d, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - T (2) * expected) <= 2 * tolerance );
+    noalias (r) -= prod (d, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= 3 * tolerance );
+    matrix_type z (a.size1 (), size, T (7));
+    axpy_prod (d, b, z, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected - scalar_matrix<T> (a.size1 (), size, T (7))) <= tolerance );
+    axpy_prod (d, b, z);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected) <= tolerance );
+
+    // Right, into columns of a larger matrix, the others are not touched
+    matrix_type c (size, a.size1 ());
+    fill_matrix (c, 2);
+    expected = prod (c, a);
+    tolerance = 1e-12 * (1 + norm_inf (expected));
+    matrix_type w (size + 2, a.size2 () + 3, T (5));
+    noalias (project (w, range (1, size + 1), range (2, a.size2 () + 2))) = prod (c, d);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (project (w, range (1, size + 1), range (2, a.size2 () + 2)) - expected) <= tolerance );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (0, 0), T (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (size + 1, a.size2 () + 2), T (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (1, 1), T (5) );
+    r = prod (c, d);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= tolerance );
+}
+
+template<class T, class L>
+void check_diagonal (std::size_t size1, std::size_t size2, std::size_t size, std::size_t &test_fails__) {
+    diagonal_matrix<T> d (size1, size2);
+    for (std::size_t k = 0; k < (std::min) (size1, size2); ++ k)
+        d (k, k) = element<T> (k, 2 * k + 1);
+    check_prod<T, L> (d, size, test_fails__);
+
+    matrix<T, L> f (size1, size2);
+    fill_matrix (f);
+    const diagonal_adaptor<const matrix<T, L> > da (f);
+    check_prod<T, L> (da, size, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    check_diagonal<double, row_major> (37, 37, 20, test_fails__);
+    check_diagonal<double, column_major> (37, 37, 20, test_fails__);
+    check_diagonal<double, row_major> (29, 13, 9, test_fails__);
+    check_diagonal<double, column_major> (13, 29, 9, test_fails__);
+    check_diagonal<double, row_major> (1, 1, 1, test_fails__);
+    check_diagonal<complex_type, column_major> (19, 19, 11, test_fails__);
+}
+
+template<class L>
+void check_inplace (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    matrix<double, L> a (size1, size2);
+    fill_matrix (a);
+    diagonal_matrix<double> dl (size1), dr (size2);
+    for (std::size_t k = 0; k < size1; ++ k)
+        dl (k, k) = element<double> (k, 1);
+    for (std::size_t k = 0; k < size2; ++ k)
+        dr (k, k) = element<double> (3, k);
+    const matrix<double> expected (prod (matrix<double> (prod (dl, a)), dr));
+    noalias (a) = prod (dl, a);
+    noalias (a) = prod (a, dr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (a - expected) <= 1e-12 * (1 + norm_inf (expected)) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_inplace )
+{
+    check_inplace<row_major> (30, 17, test_fails__);
+    check_inplace<column_major> (30, 17, test_fails__);
+    check_inplace<row_major> (1, 9, test_fails__);
+}
+
+template<class L>
+void check_sparse (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    typedef compressed_matrix<double, L> sparse_type;
+    sparse_type s (size1, size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j)
+            if ((i + 2 * j) % 3 == 0)
+                s (i, j) = element<double> (i, j);
+    const matrix<double> a (s);
+    const std::size_t nnz = s.nnz ();
+
+    diagonal_matrix<double> dl (size1), dr (size2);
+    for (std::size_t k = 0; k < size1; ++ k)
+        dl (k, k) = element<double> (k, 1);
+    for (std::size_t k = 0; k < size2; ++ k)
+        dr (k, k) = element<double> (3, k);
+    const double tolerance = 1e-12;
+
+    sparse_type r (prod (dl, s));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.nnz (), nnz );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (r) - prod (dl, a)) <= tolerance );
+    r = prod (s, dr);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.nnz (), nnz );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (r) - prod (a, dr)) <= tolerance );
+
+    // In place, and with a non square diagonal dropping elements
+    noalias (s) = prod (dl, s);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( s.nnz (), nnz );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (s) - prod (dl, a)) <= tolerance );
+    diagonal_matrix<double> dn (size1 + 2, size1);
+    for (std::size_t k = 0; k < size1; ++ k)
+        dn (k, k) = 2.0;
+    diagonal_matrix<double> dt (size2, size2 - 3);
+    for (std::size_t k = 0; k < size2 - 3; ++ k)
+        dt (k, k) = 2.0;
+    r = prod (dn, s);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.size1 (), size1 + 2 );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (r) - prod (dn, matrix<double> (s))) <= tolerance );
+    r = prod (s, dt);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.size2 (), size2 - 3 );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (r) - prod (matrix<double> (s), dt)) <= tolerance );
+}
+
+BOOST_UBLAS_TEST_DEF( test_sparse )
+{
+    check_sparse<row_major> (23, 17, test_fails__);
+    check_sparse<column_major> (17, 23, test_fails__);
+}
+
+// Wider bands take the general path
+BOOST_UBLAS_TEST_DEF( test_banded )
+{
+    banded_matrix<double> b (12, 12, 1, 2);
+    for (std::size_t i = 0; i < 12; ++ i)
+        for (std::size_t j = i >= 1 ? i - 1 : 0; j < (std::min) (i + 3, std::size_t (12)); ++ j)
+            b (i, j) = element<double> (i, j);
+    const matrix<double> a (b);
+    matrix<double> x (12, 5);
+    fill_matrix (x);
+    matrix<double> r (12, 5);
+    noalias (r) = prod (b, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - prod (a, x)) <= 1e-12 );
+    axpy_prod (b, x, r);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - prod (a, x)) <= 1e-12 );
+    compressed_matrix<double> s (x);
+    compressed_matrix<double> t (prod (b, s));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (t) - prod (a, x)) <= 1e-12 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_vector )
+{
+    diagonal_matrix<double> d (9);
+    vector<double> x (9), y (9, 1.0);
+    for (std::size_t k = 0; k < 9; ++ k) {
+        d (k, k) = double (k + 1);
+        x (k) = 2.0;
+    }
+    noalias (y) += prod (d, x);
+    for (std::size_t k = 0; k < 9; ++ k)
+        BOOST_UBLAS_TEST_CHECK_EQUAL( y (k), 2.0 * (k + 1) + 1.0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_inplace );
+    BOOST_UBLAS_TEST_DO( test_sparse );
+    BOOST_UBLAS_TEST_DO( test_banded );
+    BOOST_UBLAS_TEST_DO( test_vector );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,214 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Threads take the rows of either index four at a time, from a hundred elements under OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "utils.hpp"
+#include "sparse_utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// Rows and columns of irregular lengths, some of them empty
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    if (i % 7 == 3 || j % 9 == 4)
+        return T/*zero*/();
+    if ((3 * i + 5 * j) % (2 + (i + j) % 7) != 0)
+        return T/*zero*/();
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+
+// The elements met along the rows and the columns through the proxies
+template<class M, class D>
+bool same_lines (const M &m, const D &d) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i) {
+        const matrix_row<const M> r (m, i);
+        std::size_t count = 0;
+        for (typename matrix_row<const M>::const_iterator it = r.begin (); it != r.end (); ++ it, ++ count)
+            if (*it != d (i, it.index ()))
+                return false;
+        std::size_t elements = 0;
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            if (d (i, j) != typename D::value_type/*zero*/())
+                ++ elements;
+        if (count != elements)
+            return false;
+    }
+    for (std::size_t j = 0; j < m.size2 (); ++ j) {
+        const matrix_column<const M> c (m, j);
+        std::size_t count = 0;
+        for (typename matrix_column<const M>::const_iterator it = c.begin (); it != c.end (); ++ it, ++ count)
+            if (*it != d (it.index (), j))
+                return false;
+        std::size_t elements = 0;
+        for (std::size_t i = 0; i < m.size1 (); ++ i)
+            if (d (i, j) != typename D::value_type/*zero*/())
+                ++ elements;
+        if (count != elements)
+            return false;
+    }
+    return true;
+}
+
+template<class S>
+void check_storage (const S &s, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (s.data ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - d) == 0 );
+    BOOST_UBLAS_TEST_CHECK( same_iterated (s, d) );
+    BOOST_UBLAS_TEST_CHECK( same_lines (s, d) );
+    BOOST_UBLAS_TEST_CHECK( s.transposed_valid () );
+    BOOST_UBLAS_TEST_CHECK( s.transposed_index2_data ().size () == s.nnz () && s.permutation_data ().size () == s.nnz () );
+
+    // Back to compressed matrices of either orientation
+    compressed_matrix<value_type, row_major, 1> r (s);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - d) == 0 && r.nnz () == s.nnz () );
+    compressed_matrix<value_type, column_major> c (s.size1 (), s.size2 ());
+    c = s;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - d) == 0 && c.nnz () == s.nnz () );
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            BOOST_UBLAS_TEST_CHECK( r (i, j) == d (i, j) && c (i, j) == d (i, j) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_storage )
+{
+    const std::size_t size1 = 61, size2 = 37;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    check_storage (dual_compressed_matrix<double> (cr), test_fails__);
+    check_storage (dual_compressed_matrix<double, column_major> (cr), test_fails__);
+    check_storage (dual_compressed_matrix<double, row_major, 1> (cr), test_fails__);
+    check_storage (dual_compressed_matrix<double, column_major, 1, std::vector<std::size_t>, std::vector<double> > (cr), test_fails__);
+    check_storage (dual_compressed_matrix<double> (size1, size2), test_fails__);
+    check_storage (dual_compressed_matrix<double> (0, size2), test_fails__);
+    compressed_matrix<complex_type> cz (size2, size1);
+    fill_sparse (cz);
+    check_storage (dual_compressed_matrix<complex_type> (cz), test_fails__);
+
+    // Rows left empty at the end of the storage
+    compressed_matrix<double> tail (size1, size2);
+    tail.push_back (2, 3, 1.0);
+    tail.push_back (5, 0, 2.0);
+    check_storage (dual_compressed_matrix<double> (tail), test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_invalidation )
+{
+    const std::size_t size1 = 23, size2 = 31;
+    matrix<double> d (size1, size2, 0.0);
+    fill_sparse (d);
+    dual_compressed_matrix<double> s (d);
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () );
+    BOOST_UBLAS_TEST_CHECK( same_lines (s, d) && s.transposed_valid () );
+
+    // Changes of the values keep the transposed index
+    s (2, 15) = d (2, 15) = 3.0;
+    BOOST_UBLAS_TEST_CHECK( s.find_element (2, 15) != 0 && ! s.transposed_valid () );
+    BOOST_UBLAS_TEST_CHECK( same_lines (s, d) && s.transposed_valid () );
+    s (2, 15) = d (2, 15) = 4.0;
+    s.value_data () [0] *= 2.0;
+    d = matrix<double> (s.data ());
+    s *= 2.0;
+    d *= 2.0;
+    BOOST_UBLAS_TEST_CHECK( s.transposed_valid () && same_lines (s, d) );
+
+    // Changes of the structure discard it
+    s.erase_element (2, 15);
+    d (2, 15) = 0.0;
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () && same_lines (s, d) );
+    s.insert_element (0, 30, 5.0);
+    d (0, 30) = 5.0;
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () && same_iterated (s, d) );
+    s = 2.0 * d;
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () && same_lines (s, 2.0 * d) );
+    s += d;
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () && same_lines (s, 3.0 * d) );
+    s.assign (d);
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () && same_lines (s, d) );
+    s.clear ();
+    BOOST_UBLAS_TEST_CHECK( ! s.transposed_valid () && same_lines (s, zero_matrix<double> (size1, size2)) );
+    s.resize (size2, size1, false);
+    s.push_back (3, 4, 1.0);
+    BOOST_UBLAS_TEST_CHECK( s.size1 () == size2 && s.nnz () == 1 && s.transposed_index1_data ().size () == size1 + 1 );
+}
+
+template<class E>
+bool uses_kernel () {
+    typedef typename E::value_type value_type;
+    typedef typename matrix_vector_binary1_traits<value_type, E, value_type, vector<value_type> >::expression_type expression_type;
+    return boost::is_same<typename detail::vector_prod_traits<vector<value_type>, expression_type,
+                                                              scalar_assign<value_type &, value_type>, dense_proxy_tag>::storage_category,
+                          detail::matrix_vector_kernel_tag>::value;
+}
+
+template<class S>
+void check_prod (const S &s, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (s.data ());
+    const double tolerance = 1e-13 * (1 + norm_inf (d) + norm_1 (d));
+
+    vector<value_type> x (s.size2 ()), y (s.size1 ()), e (s.size1 ());
+    for (std::size_t j = 0; j < x.size (); ++ j)
+        x (j) = value_type (1.0 + j % 4) / value_type (3);
+    e = prod (d, x);
+    y = prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    noalias (y) += prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+    axpy_prod (s, x, y, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+
+    vector<value_type> xt (s.size1 ()), yt (s.size2 ()), et (s.size2 ());
+    for (std::size_t i = 0; i < xt.size (); ++ i)
+        xt (i) = value_type (1.0 + i % 5) / value_type (4);
+    et = prod (trans (d), xt);
+    yt = prod (trans (s), xt);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yt - et) <= tolerance );
+    noalias (yt) -= prod (trans (s), xt);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yt) <= 2 * tolerance );
+    axpy_prod (trans (s), xt, yt, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yt - et) <= 2 * tolerance );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    typedef dual_compressed_matrix<double> dm;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix_unary2<const dm, scalar_identity<double> > > () ));
+
+    const std::size_t size1 = 150, size2 = 53;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    check_prod (dual_compressed_matrix<double> (cr), test_fails__);
+    check_prod (dual_compressed_matrix<double, column_major> (cr), test_fails__);
+    check_prod (dual_compressed_matrix<double, row_major, 1> (cr), test_fails__);
+    compressed_matrix<complex_type> cz (size2, size1);
+    fill_sparse (cz);
+    check_prod (dual_compressed_matrix<complex_type> (cz), test_fails__);
+    check_prod (dual_compressed_matrix<complex_type, column_major> (cz), test_fails__);
+    check_prod (dual_compressed_matrix<double> (size1, size2), test_fails__);
+    check_prod (dual_compressed_matrix<double> (0, size2), test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_storage );
+    BOOST_UBLAS_TEST_DO( test_invalidation );
+    BOOST_UBLAS_TEST_DO( test_prod );
+
+    BOOST_UBLAS_TEST_END();
+}
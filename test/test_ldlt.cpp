@@ -0,0 +1,167 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small panels, and the threaded trailing update when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 8
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+// Indefinite, with small or zero diagonal elements so that 2 by 2 pivots are taken
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    if (i == j)
+        return T (i % 3 == 1 ? 0.0 : (i % 3 == 2 ? 0.01 : -2.5));
+    return T ((1.0 + (3 * (i + j) + i * j) % 7) / 8.0 * ((i + j) % 2 ? 1.0 : -1.0));
+}
+template<>
+complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return element<double> (i, j) * complex_type (1.0, (i + j) % 3 - 1.0);
+}
+
+template<class M>
+void fill_symmetric (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            m (i, j) = element<typename M::value_type> (i, j);
+}
+
+template<class M>
+void fill_rhs (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (1.0 + (i + 2 * j) % 5);
+}
+
+template<class PM>
+std::size_t blocks (const PM &pm) {
+    std::size_t n = 0;
+    for (std::size_t k = 1; k < pm.size (); ++ k)
+        if (pm (k) == k - 1)
+            ++ n;
+    return n;
+}
+
+// Factors m in place and solves against the dense copy of it
+template<class M>
+void check_factorize (M &m, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    const std::size_t size = m.size1 ();
+    const matrix<value_type> a (m);
+    permutation_matrix<std::size_t> pm (size);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( ldlt_factorize (m, pm), std::size_t (0) );
+    if (size >= 7)
+        BOOST_UBLAS_TEST_CHECK( blocks (pm) > 0 );
+
+    const double tolerance = 1e-10 * (1 + norm_inf (a));
+    vector<value_type> b (size);
+    for (std::size_t i = 0; i < size; ++ i)
+        b (i) = value_type (1.0 + i % 4);
+    vector<value_type> x (b);
+    ldlt_substitute (m, pm, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, x) - b) <= tolerance * (1 + norm_inf (x)) );
+
+    matrix<value_type, column_major> bm (size, 5);
+    fill_rhs (bm);
+    matrix<value_type, column_major> xm (bm);
+    ldlt_substitute (m, pm, xm);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, xm) - bm) <= tolerance * (1 + norm_inf (xm)) );
+}
+
+template<class T, class TRI, class L>
+void check_packed (std::size_t size, std::size_t &test_fails__) {
+    symmetric_matrix<T, TRI, L> m (size);
+    fill_symmetric (m);
+    check_factorize (m, test_fails__);
+}
+
+template<class T, class TRI, class L>
+void check_adaptor (std::size_t size, std::size_t &test_fails__) {
+    matrix<T, L> d (size, size, T (-100));
+    symmetric_adaptor<matrix<T, L>, TRI> m (d);
+    fill_symmetric (m);
+    check_factorize (m, test_fails__);
+    // The other triangle is not touched
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j < size; ++ j)
+            if (! TRI::other (i, j))
+                BOOST_UBLAS_TEST_CHECK( d (i, j) == T (-100) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_factorize )
+{
+    const std::size_t sizes [] = { 1, 2, 3, 7, 8, 9, 17, 40 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        check_packed<double, lower, row_major> (sizes [k], test_fails__);
+        check_packed<double, upper, column_major> (sizes [k], test_fails__);
+        check_adaptor<double, lower, column_major> (sizes [k], test_fails__);
+        check_adaptor<double, upper, row_major> (sizes [k], test_fails__);
+    }
+    check_packed<double, rfp_lower, row_major> (23, test_fails__);
+    check_packed<complex_type, lower, column_major> (29, test_fails__);
+    check_adaptor<complex_type, upper, row_major> (18, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_definite )
+{
+    // A positive definite matrix needs no interchanges and no 2 by 2 pivots
+    const std::size_t size = 21;
+    symmetric_matrix<double> m (size);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            m (i, j) = i == j ? 10.0 : 1.0 / (1.0 + i + j);
+    const matrix<double> a (m);
+    permutation_matrix<std::size_t> pm (size);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( ldlt_factorize (m, pm), std::size_t (0) );
+    for (std::size_t k = 0; k < size; ++ k)
+        BOOST_UBLAS_TEST_CHECK_EQUAL( pm (k), k );
+    // L D L^T
+    matrix<double> l (size, size), d (size, size);
+    l = identity_matrix<double> (size);
+    d.clear ();
+    for (std::size_t i = 0; i < size; ++ i) {
+        d (i, i) = m (i, i);
+        for (std::size_t j = 0; j < i; ++ j)
+            l (i, j) = m (i, j);
+    }
+    matrix<double> ld (prod (l, d));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (ld, trans (l)) - a) <= 1e-12 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_singular )
+{
+    symmetric_matrix<double> z (5);
+    z.clear ();
+    permutation_matrix<std::size_t> pm (5);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( ldlt_factorize (z, pm), std::size_t (1) );
+
+    // A zero row and column in the middle
+    symmetric_matrix<double> m (6);
+    for (std::size_t i = 0; i < 6; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            m (i, j) = i == 3 || j == 3 ? 0.0 : (i == j ? 4.0 : 1.0);
+    permutation_matrix<std::size_t> pm6 (6);
+    BOOST_UBLAS_TEST_CHECK( ldlt_factorize (m, pm6) != 0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_factorize );
+    BOOST_UBLAS_TEST_DO( test_definite );
+    BOOST_UBLAS_TEST_DO( test_singular );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,200 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small chunks of lines, and the threaded transpositions when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <set>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/ordering.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef vector<std::size_t> permutation_type;
+
+// The five point Laplacian of a k by k grid, with vertex v numbered (v * step) % (k * k)
+template<class M>
+M grid (std::size_t k, std::size_t step) {
+    const std::size_t n = k * k;
+    M m (n, n);
+    for (std::size_t x = 0; x < k; ++ x)
+        for (std::size_t y = 0; y < k; ++ y) {
+            const std::size_t v = (x * k + y) * step % n;
+            m (v, v) = 4.0;
+            if (x > 0)
+                m (v, ((x - 1) * k + y) * step % n) = -1.0;
+            if (x + 1 < k)
+                m (v, ((x + 1) * k + y) * step % n) = -1.0;
+            if (y > 0)
+                m (v, (x * k + y - 1) * step % n) = -1.0;
+            if (y + 1 < k)
+                m (v, (x * k + y + 1) * step % n) = -1.0;
+        }
+    return m;
+}
+
+bool is_permutation (const permutation_type &p) {
+    std::vector<bool> met (p.size (), false);
+    for (std::size_t k = 0; k < p.size (); ++ k) {
+        if (p (k) >= p.size () || met [p (k)])
+            return false;
+        met [p (k)] = true;
+    }
+    return true;
+}
+
+template<class M>
+std::size_t bandwidth (const M &m) {
+    std::size_t b = 0;
+    for (typename M::const_iterator1 it1 = m.begin1 (); it1 != m.end1 (); ++ it1)
+        for (typename M::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2)
+            b = (std::max) (b, std::size_t (it2.index1 () > it2.index2 () ? it2.index1 () - it2.index2 () : it2.index2 () - it2.index1 ()));
+    return b;
+}
+
+// The number of elements of the Cholesky factor of the pattern of m + trans (m) below the
+// diagonal, the structure of each column being passed on to its parent in the elimination tree
+template<class M>
+std::size_t fill (const M &m) {
+    const std::size_t n = m.size1 ();
+    std::vector<std::set<std::size_t> > columns (n);
+    for (typename M::const_iterator1 it1 = m.begin1 (); it1 != m.end1 (); ++ it1)
+        for (typename M::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2)
+            if (it2.index1 () != it2.index2 ())
+                columns [(std::min) (it2.index1 (), it2.index2 ())].insert ((std::max) (it2.index1 (), it2.index2 ()));
+    std::size_t count = 0;
+    for (std::size_t j = 0; j < n; ++ j) {
+        count += columns [j].size ();
+        if (columns [j].empty ())
+            continue;
+        const std::size_t parent = *columns [j].begin ();
+        columns [parent].insert (++ columns [j].begin (), columns [j].end ());
+    }
+    return count;
+}
+
+template<class M>
+void check_permute (const M &a, const permutation_type &p, std::size_t &test_fails__) {
+    M b;
+    symmetric_permute (a, p, b);
+    BOOST_UBLAS_TEST_CHECK( b.size1 () == a.size1 () && b.size2 () == a.size2 () && b.nnz () == a.nnz () );
+    const matrix<double> d (a);
+    std::size_t count = 0;
+    bool same = true;
+    for (typename M::const_iterator1 it1 = b.begin1 (); it1 != b.end1 (); ++ it1)
+        for (typename M::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2, ++ count)
+            same = same && *it2 == d (p (it2.index1 ()), p (it2.index2 ()));
+    BOOST_UBLAS_TEST_CHECK( same && count == a.nnz () );
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            same = same && b (i, j) == d (p (i), p (j));
+    BOOST_UBLAS_TEST_CHECK( same );
+
+    // In place
+    M c (a);
+    symmetric_permute (c, p, c);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - b) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_permute )
+{
+    const std::size_t n = 57;
+    compressed_matrix<double> a (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            if ((i * 3 + j * 5) % 11 == 0 || i == j)
+                a (i, j) = 1.0 + i + j * 0.5;
+    permutation_type p (n);
+    for (std::size_t k = 0; k < n; ++ k)
+        p (k) = k * 7 % n;
+    check_permute (a, p, test_fails__);
+    check_permute (compressed_matrix<double, column_major> (a), p, test_fails__);
+    check_permute (compressed_matrix<double, row_major, 1> (a), p, test_fails__);
+
+    permutation_type e (0);
+    check_permute (compressed_matrix<double> (0, 0), e, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_reverse_cuthill_mckee )
+{
+    const std::size_t k = 12;
+    const compressed_matrix<double> a (grid<compressed_matrix<double> > (k, 37));
+    BOOST_UBLAS_TEST_CHECK( bandwidth (a) > 4 * k );
+    permutation_type p (a.size1 ());
+    reverse_cuthill_mckee_ordering (a, p);
+    BOOST_UBLAS_TEST_CHECK( is_permutation (p) );
+    compressed_matrix<double> b;
+    symmetric_permute (a, p, b);
+    BOOST_UBLAS_TEST_CHECK( bandwidth (b) <= k + 1 );
+
+    // Several components, isolated vertices included, in either orientation
+    compressed_matrix<double, column_major, 1> c (2 * k * k + 5, 2 * k * k + 5);
+    for (std::size_t i = 0; i < k * k; ++ i)
+        for (std::size_t j = 0; j < k * k; ++ j)
+            if (a (i, j) != 0) {
+                c (2 * i, 2 * j) = a (i, j);
+                c (2 * i + 1, 2 * j + 1) = a (i, j);
+            }
+    permutation_type q (c.size1 ());
+    reverse_cuthill_mckee_ordering (c, q);
+    BOOST_UBLAS_TEST_CHECK( is_permutation (q) );
+    compressed_matrix<double, column_major, 1> d;
+    symmetric_permute (c, q, d);
+    BOOST_UBLAS_TEST_CHECK( bandwidth (d) <= k + 1 );
+
+    permutation_type e (0);
+    reverse_cuthill_mckee_ordering (compressed_matrix<double> (0, 0), e);
+}
+
+BOOST_UBLAS_TEST_DEF( test_minimum_degree )
+{
+    const std::size_t k = 15;
+    const compressed_matrix<double> a (grid<compressed_matrix<double> > (k, 1));
+    permutation_type p (a.size1 ());
+    approximate_minimum_degree_ordering (a, p);
+    BOOST_UBLAS_TEST_CHECK( is_permutation (p) );
+    compressed_matrix<double> b;
+    symmetric_permute (a, p, b);
+    BOOST_UBLAS_TEST_CHECK( fill (b) < fill (a) * 3 / 4 );
+
+    // The dense row and column of an arrow matrix come last, but for a tie, without any fill
+    const std::size_t n = 40;
+    compressed_matrix<double, column_major> c (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        c (i, i) = c (0, i) = c (i, 0) = 1.0;
+    BOOST_UBLAS_TEST_CHECK( fill (c) == n * (n - 1) / 2 );
+    permutation_type q (n);
+    approximate_minimum_degree_ordering (c, q);
+    BOOST_UBLAS_TEST_CHECK( is_permutation (q) && (q (n - 1) == 0 || q (n - 2) == 0) );
+    compressed_matrix<double, column_major> d;
+    symmetric_permute (c, q, d);
+    BOOST_UBLAS_TEST_CHECK( fill (d) == n - 1 );
+
+    // An unsymmetric pattern is ordered as that of a + trans (a)
+    compressed_matrix<double, row_major, 1> u (n, n);
+    for (std::size_t i = 1; i < n; ++ i)
+        u (i, i - 1) = u (i, (i * 13) % n) = 1.0;
+    permutation_type r (n);
+    approximate_minimum_degree_ordering (u, r);
+    BOOST_UBLAS_TEST_CHECK( is_permutation (r) );
+
+    permutation_type e (0);
+    approximate_minimum_degree_ordering (compressed_matrix<double> (0, 0), e);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_permute );
+    BOOST_UBLAS_TEST_DO( test_reverse_cuthill_mckee );
+    BOOST_UBLAS_TEST_DO( test_minimum_degree );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+void fill (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = 1000.0 * i + j;
+}
+
+BOOST_UBLAS_TEST_DEF( test_leading_dimension )
+{
+    BOOST_UBLAS_TEST_CHECK_EQUAL( detail::padded_leading_dimension<8> (std::size_t (3)), std::size_t (8) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( detail::padded_leading_dimension<8> (std::size_t (70)), std::size_t (72) );
+    // Powers of two get an extra cache line
+    BOOST_UBLAS_TEST_CHECK_EQUAL( detail::padded_leading_dimension<8> (std::size_t (512)), std::size_t (520) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( detail::padded_leading_dimension<8> (std::size_t (1024)), std::size_t (1032) );
+
+    matrix<double, padded_row_major> r (5, 512);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( raw::leading_dimension (r), 520 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( r.data ().size (), std::size_t (5 * 520) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( &r (1, 0) - &r (0, 0), 520 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( raw::stride1 (r), 520 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( raw::stride2 (r), 1 );
+
+    matrix<double, padded_column_major> c (512, 5);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( raw::leading_dimension (c), 520 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( &c (0, 1) - &c (0, 0), 520 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( raw::stride1 (c), 1 );
+
+    matrix<double> d (5, 512);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( raw::leading_dimension (d), 512 );
+}
+
+template<class L>
+void check_padded (std::size_t &test_fails__) {
+    matrix<double> ref (7, 13);
+    fill (ref);
+
+    matrix<double, L> m (ref);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( m, ref, 7, 13 );
+
+    // Iterators skip the padding
+    double sum = 0;
+    std::size_t count = 0;
+    for (typename matrix<double, L>::const_iterator1 it1 = m.begin1 (); it1 != m.end1 (); ++ it1)
+        for (typename matrix<double, L>::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2) {
+            BOOST_UBLAS_TEST_CHECK_EQUAL( *it2, ref (it2.index1 (), it2.index2 ()) );
+            sum += *it2;
+            ++ count;
+        }
+    BOOST_UBLAS_TEST_CHECK_EQUAL( count, std::size_t (7 * 13) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m.end1 () - m.begin1 (), 7 );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m.end2 () - m.begin2 (), 13 );
+
+    // Proxies
+    project (m, range (1, 3), range (2, 5)) = project (ref, range (4, 6), range (6, 9));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m (2, 4), ref (5, 8) );
+    row (m, 6) = row (ref, 0);
+    column (m, 12) = column (ref, 0);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m (6, 5), ref (0, 5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m (3, 12), ref (3, 0) );
+
+    // Expressions and resizing
+    matrix<double, L> t (trans (ref));
+    matrix<double> tt (trans (t));
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( tt, ref, 7, 13 );
+    m = ref;
+    m.resize (9, 70, true);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m (6, 12), ref (6, 12) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( m.data ().size (), L::storage_size (9, 70) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_padded_row_major )
+{
+    check_padded<padded_row_major> (test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_padded_column_major )
+{
+    check_padded<padded_column_major> (test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_leading_dimension );
+    BOOST_UBLAS_TEST_DO( test_padded_row_major );
+    BOOST_UBLAS_TEST_DO( test_padded_column_major );
+
+    BOOST_UBLAS_TEST_END();
+}
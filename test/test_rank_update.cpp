@@ -0,0 +1,238 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small blocks and panels, and the threaded path when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 8
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/blas.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+template<>
+complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return complex_type (1.0 + (3 * i + 5 * j) % 7, 2.0 - (i + 2 * j) % 5) / 8.0;
+}
+
+template<class T>
+T imaginary () {
+    return T/*zero*/();
+}
+template<>
+complex_type imaginary<complex_type> () {
+    return complex_type (0, 1);
+}
+
+template<class M>
+void fill_matrix (M &m, std::size_t offset = 0) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = element<typename M::value_type> (i + offset, j);
+}
+
+template<class M, class E1, class E2>
+bool uses_kernel () {
+    typedef typename M::reference reference;
+    typedef typename E1::value_type value_type;
+    typedef matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, value_type> > expression_type;
+    return boost::is_same<typename detail::matrix_prod_traits<M, expression_type, scalar_assign<reference, value_type>, packed_tag>::storage_category,
+                          detail::symmetric_prod_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef matrix<double> dm;
+    typedef matrix<complex_type, column_major> cm;
+    typedef matrix_unary2<dm, scalar_identity<double> > dt;
+    typedef matrix_unary2<cm, scalar_conj<complex_type> > ch;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<symmetric_matrix<double>, dt, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<symmetric_matrix<double, upper, column_major>, dm, dt> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<symmetric_matrix<double, rfp_lower>, dt, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<symmetric_adaptor<dm, lower>, dt, matrix_range<dm> > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<hermitian_matrix<complex_type>, ch, cm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<hermitian_adaptor<cm, upper>, cm, ch> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, dt, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<symmetric_matrix<double>, compressed_matrix<double>, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<symmetric_adaptor<compressed_matrix<double> >, dt, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<symmetric_matrix<complex_type>, dt, dm> () ));
+}
+
+// The stored triangle of m against the dense a
+template<class TRI, class M, class D>
+bool same_triangle (const M &m, const D &a, double tolerance) {
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t j = 0; j < a.size2 (); ++ j)
+            if (TRI::other (i, j) && std::abs (m (i, j) - a (i, j)) > tolerance)
+                return false;
+    return true;
+}
+
+// Gram matrices x^T x (x^H x) into m
+template<class TRI, class M, class X, class A>
+void check_gram (M &m, const X &x, const A &a, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    const double tolerance = 1e-12 * (1 + norm_inf (a));
+
+    noalias (m) = prod (a, x);
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, prod (a, x), tolerance) );
+    noalias (m) += prod (a, x);
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, value_type (2) * prod (a, x), 2 * tolerance) );
+    noalias (m) -= prod (a, x);
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, prod (a, x), 3 * tolerance) );
+    m = prod (a, x);
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, prod (a, x), tolerance) );
+}
+
+template<class TRI, class L>
+void check_symmetric (std::size_t size, std::size_t depth, std::size_t &test_fails__) {
+    matrix<double, L> x (depth, size);
+    fill_matrix (x);
+    symmetric_matrix<double, TRI, L> s (size);
+    check_gram<TRI> (s, x, trans (x), test_fails__);
+    matrix<double, L> d (size, size, -100.0);
+    symmetric_adaptor<matrix<double, L>, TRI> a (d);
+    check_gram<TRI> (a, x, trans (x), test_fails__);
+}
+
+template<class TRI, class L>
+void check_hermitian (std::size_t size, std::size_t depth, std::size_t &test_fails__) {
+    matrix<complex_type, L> x (depth, size);
+    fill_matrix (x);
+    hermitian_matrix<complex_type, TRI, L> h (size);
+    check_gram<TRI> (h, x, herm (x), test_fails__);
+    const hermitian_matrix<complex_type, TRI, L> &ch (h);
+    for (std::size_t i = 0; i < size; ++ i)
+        BOOST_UBLAS_TEST_CHECK_EQUAL( ch (i, i).imag (), 0.0 );
+    matrix<complex_type, L> d (size, size, complex_type (-100, 50));
+    hermitian_adaptor<matrix<complex_type, L>, TRI> a (d);
+    check_gram<TRI> (a, x, herm (x), test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    check_symmetric<lower, row_major> (37, 45, test_fails__);
+    check_symmetric<upper, row_major> (37, 45, test_fails__);
+    check_symmetric<lower, column_major> (16, 3, test_fails__);
+    check_symmetric<upper, column_major> (1, 40, test_fails__);
+    check_symmetric<rfp_lower, row_major> (21, 9, test_fails__);
+    check_symmetric<rfp_upper, column_major> (20, 9, test_fails__);
+    check_hermitian<lower, row_major> (19, 23, test_fails__);
+    check_hermitian<upper, column_major> (19, 23, test_fails__);
+    check_hermitian<rfp_upper, row_major> (9, 4, test_fails__);
+}
+
+template<class TRI, class M>
+void check_blas (M &m, std::size_t depth, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    typedef matrix<value_type> dense_type;
+    const std::size_t size = m.size1 ();
+    const bool hermitian = boost::is_same<value_type, complex_type>::value;
+    dense_type c (size, size);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j) {
+            c (i, j) = element<value_type> (i, j);
+            c (j, i) = hermitian ? type_traits<value_type>::conj (c (i, j)) : c (i, j);
+        }
+    for (std::size_t i = 0; i < size; ++ i)
+        c (i, i) = type_traits<value_type>::real (c (i, i));
+    dense_type a (size, depth), b (size, depth);
+    fill_matrix (a);
+    fill_matrix (b, 3);
+    const value_type t1 (0.5), t2 (hermitian ? value_type (-1.5) : value_type (1.5));
+    const value_type t3 (hermitian ? value_type (2) + imaginary<value_type> () : value_type (-2));
+    const double tolerance = 1e-12 * depth * (1 + norm_inf (c));
+
+    m = c;
+    if (hermitian)
+        blas_3::hrk (m, t1, t2, a);
+    else
+        blas_3::srk (m, t1, t2, a);
+    dense_type e (t1 * c + t2 * prod (a, hermitian ? dense_type (herm (a)) : dense_type (trans (a))));
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, e, tolerance) );
+
+    m = c;
+    if (hermitian) {
+        blas_3::hr2k (m, t1, t3, a, b);
+        e = t1 * c + t3 * prod (a, herm (b)) + type_traits<value_type>::conj (t3) * prod (b, herm (a));
+    } else {
+        blas_3::sr2k (m, t1, t3, a, b);
+        e = t1 * c + t3 * (prod (a, trans (b)) + prod (b, trans (a)));
+    }
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, e, tolerance) );
+
+    // The target as an operand, read before it is updated
+    const double aliased_tolerance = 1e-12 * size * (1 + norm_inf (c)) * (1 + norm_inf (c));
+    m = c;
+    if (hermitian)
+        blas_3::hrk (m, t1, t2, m);
+    else
+        blas_3::srk (m, t1, t2, m);
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, dense_type (t1 * c + t2 * prod (c, c)), aliased_tolerance) );
+
+    m = c;
+    if (hermitian) {
+        blas_3::hr2k (m, t1, t3, m, c);
+        e = t1 * c + t3 * prod (c, c) + type_traits<value_type>::conj (t3) * prod (c, c);
+    } else {
+        blas_3::sr2k (m, t1, t3, m, c);
+        e = t1 * c + t3 * (prod (c, c) + prod (c, c));
+    }
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, e, aliased_tolerance) );
+
+    // No depth: only the scaling is left
+    dense_type z (size, 0);
+    m = c;
+    if (hermitian)
+        blas_3::hrk (m, t1, t2, z);
+    else
+        blas_3::srk (m, t1, t2, z);
+    BOOST_UBLAS_TEST_CHECK( same_triangle<TRI> (m, t1 * c, tolerance) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_blas )
+{
+    symmetric_matrix<double, lower> sl (27);
+    check_blas<lower> (sl, 30, test_fails__);
+    symmetric_matrix<double, upper, column_major> su (17);
+    check_blas<upper> (su, 5, test_fails__);
+    matrix<double> d (20, 20);
+    symmetric_adaptor<matrix<double>, upper> sa (d);
+    check_blas<upper> (sa, 11, test_fails__);
+    hermitian_matrix<complex_type, lower> hl (23);
+    check_blas<lower> (hl, 12, test_fails__);
+    hermitian_matrix<complex_type, rfp_upper, column_major> hu (10);
+    check_blas<rfp_upper> (hu, 9, test_fails__);
+    symmetric_matrix<double, lower> sb (100);
+    check_blas<lower> (sb, 4, test_fails__);
+
+    // Plain matrices are updated as a whole
+    matrix<double> m (5, 5, 1.0), a (5, 3, 1.0);
+    blas_3::srk (m, 2.0, 1.0, a);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (m - scalar_matrix<double> (5, 5, 5.0)) == 0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_blas );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,297 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small blocks, so that the factorizations are split
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+
+#include <complex>
+
+#include <boost/numeric/ublas/rfp.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/blas.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    return T (1.0 + (3 * i + 5 * j) % 7);
+}
+template<>
+complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return complex_type (1.0 + (3 * i + 5 * j) % 7, i == j ? 0.0 : 2.0 - (i + 2 * j) % 5);
+}
+
+// Diagonally dominant with a positive diagonal, hermitian or complex symmetric
+template<class T>
+matrix<T> definite_matrix (std::size_t size, bool hermitian = true) {
+    matrix<T> a (size, size);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j) {
+            a (i, j) = element<T> (i, j);
+            a (j, i) = hermitian ? type_traits<T>::conj (a (i, j)) : a (i, j);
+        }
+    for (std::size_t i = 0; i < size; ++ i)
+        a (i, i) = T (10.0 * size);
+    return a;
+}
+
+template<class TRI, class L>
+void check_layout (std::size_t size, std::size_t &test_fails__) {
+    symmetric_matrix<double, TRI, L> s (size);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( s.data ().size (), size * (size + 1) / 2 );
+    std::fill (s.data ().begin (), s.data ().end (), -1.0);
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            s (i, j) = double (k ++);
+    // Every element of the rectangle holds exactly one element of the triangle
+    std::vector<double> stored (s.data ().begin (), s.data ().end ());
+    std::sort (stored.begin (), stored.end ());
+    for (std::size_t e = 0; e < stored.size (); ++ e)
+        BOOST_UBLAS_TEST_CHECK_EQUAL( stored [e], double (e) );
+
+    k = 0;
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j) {
+            BOOST_UBLAS_TEST_CHECK_EQUAL( s (i, j), double (k) );
+            BOOST_UBLAS_TEST_CHECK_EQUAL( s (j, i), double (k) );
+            ++ k;
+        }
+
+    const matrix<double> dense (definite_matrix<double> (size));
+    s = dense;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (s) - dense) == 0 );
+    vector<double> x (size);
+    for (std::size_t i = 0; i < size; ++ i)
+        x (i) = 1.0 + i % 3;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (vector<double> (prod (s, x)) - prod (dense, x)) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_layout )
+{
+    for (std::size_t size = 0; size < 10; ++ size) {
+        check_layout<rfp_lower, row_major> (size, test_fails__);
+        check_layout<rfp_upper, row_major> (size, test_fails__);
+        check_layout<rfp_lower, column_major> (size, test_fails__);
+        check_layout<rfp_upper, column_major> (size, test_fails__);
+    }
+
+    hermitian_matrix<complex_type, rfp_upper, column_major> h (7);
+    const matrix<complex_type> dense (definite_matrix<complex_type> (7));
+    h = dense;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<complex_type> (h) - dense) == 0 );
+
+    triangular_matrix<double, rfp_lower> t (8, 8);
+    matrix<double> lower_dense (8, 8, 0.0);
+    for (std::size_t i = 0; i < 8; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            lower_dense (i, j) = t (i, j) = element<double> (i, j);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (t) - lower_dense) == 0 );
+    vector<double> b (8, 1.0);
+    vector<double> x (solve (t, b, lower_tag ()));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (lower_dense, x) - b) <= 1e-12 );
+
+    triangular_matrix<double, rfp_upper, column_major> u (trans (lower_dense));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<double> (u) - trans (lower_dense)) == 0 );
+}
+
+// The stored triangle of the factor as a dense matrix
+template<class TRI, class M>
+matrix<typename M::value_type> factor (const M &m) {
+    typedef typename M::value_type value_type;
+    matrix<value_type> f (m.size1 (), m.size2 (), value_type (0));
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            if (TRI::other (i, j))
+                f (i, j) = m (i, j);
+    return f;
+}
+
+template<class TRI, class L, class M>
+void check_cholesky (M &m, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    const std::size_t size = m.size1 ();
+    const bool hermitian = ! boost::is_same<M, symmetric_matrix<value_type, TRI, L> >::value;
+    const matrix<value_type> a (definite_matrix<value_type> (size, hermitian));
+    m = a;
+    BOOST_UBLAS_TEST_CHECK_EQUAL( cholesky_factorize (m), std::size_t (0) );
+
+    const double tolerance = 1e-12 * size * norm_inf (a);
+    const matrix<value_type> f (factor<TRI> (m));
+    // Lower: A = L L^T (L^H), upper: A = U^T U (U^H U)
+    const matrix<value_type> ft (hermitian ? matrix<value_type> (herm (f)) : matrix<value_type> (trans (f)));
+    const matrix<value_type> r (boost::is_same<typename TRI::triangular_type, lower_tag>::value ? prod (f, ft) : prod (ft, f));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - a) <= tolerance );
+
+    vector<value_type> b (size);
+    for (std::size_t i = 0; i < size; ++ i)
+        b (i) = element<value_type> (i, 2 * i + 1);
+    vector<value_type> x (b);
+    cholesky_substitute (m, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, x) - b) <= tolerance );
+
+    matrix<value_type> bm (size, 3), xm;
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j < 3; ++ j)
+            bm (i, j) = element<value_type> (i + j, i);
+    xm = bm;
+    cholesky_substitute (m, xm);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (a, xm) - bm) <= tolerance );
+}
+
+template<class T, class TRI, class L>
+void check_symmetric (std::size_t size, std::size_t &test_fails__) {
+    symmetric_matrix<T, TRI, L> m (size);
+    check_cholesky<TRI, L> (m, test_fails__);
+}
+template<class TRI, class L>
+void check_hermitian (std::size_t size, std::size_t &test_fails__) {
+    hermitian_matrix<complex_type, TRI, L> m (size);
+    check_cholesky<TRI, L> (m, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_cholesky )
+{
+    const std::size_t sizes [] = { 1, 2, 3, 8, 17, 32 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        check_symmetric<double, rfp_lower, row_major> (sizes [k], test_fails__);
+        check_symmetric<double, rfp_upper, row_major> (sizes [k], test_fails__);
+        check_symmetric<double, rfp_lower, column_major> (sizes [k], test_fails__);
+        check_symmetric<double, rfp_upper, column_major> (sizes [k], test_fails__);
+        check_hermitian<rfp_lower, row_major> (sizes [k], test_fails__);
+        check_hermitian<rfp_upper, row_major> (sizes [k], test_fails__);
+        check_hermitian<rfp_lower, column_major> (sizes [k], test_fails__);
+        check_hermitian<rfp_upper, column_major> (sizes [k], test_fails__);
+    }
+    check_symmetric<complex_type, rfp_lower, row_major> (9, test_fails__);
+    check_symmetric<complex_type, rfp_upper, column_major> (10, test_fails__);
+}
+
+template<class TRI, class L>
+void check_triangular_solve (std::size_t size, std::size_t &test_fails__) {
+    const bool lower = boost::is_same<typename TRI::triangular_type, lower_tag>::value;
+    matrix<double> dense (size, size, 0.0), unit (size, size, 0.0);
+    triangular_matrix<double, TRI, L> t (size, size);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j < size; ++ j)
+            if (TRI::other (i, j)) {
+                dense (i, j) = t (i, j) = i == j ? 2.0 + i % 3 : element<double> (i, j) / size;
+                unit (i, j) = i == j ? 1.0 : dense (i, j);
+            }
+    const double tolerance = 1e-12 * (size + 1) * (size + 1);
+
+    vector<double> b (size);
+    for (std::size_t i = 0; i < size; ++ i)
+        b (i) = element<double> (i, 2 * i + 1);
+    vector<double> x (b), xu (b);
+    if (lower) {
+        inplace_solve (t, x, lower_tag ());
+        inplace_solve (t, xu, unit_lower_tag ());
+    } else {
+        inplace_solve (t, x, upper_tag ());
+        inplace_solve (t, xu, unit_upper_tag ());
+    }
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (dense, x) - b) <= tolerance * norm_inf (x) );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (unit, xu) - b) <= tolerance * norm_inf (xu) );
+
+    matrix<double> bm (size, 3);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t j = 0; j < 3; ++ j)
+            bm (i, j) = element<double> (i + j, i);
+    matrix<double> xm (bm);
+    if (lower)
+        inplace_solve (t, xm, lower_tag ());
+    else
+        inplace_solve (t, xm, upper_tag ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (dense, xm) - bm) <= tolerance * norm_inf (xm) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_triangular_solve )
+{
+    const std::size_t sizes [] = { 1, 2, 3, 8, 17 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        check_triangular_solve<rfp_lower, row_major> (sizes [k], test_fails__);
+        check_triangular_solve<rfp_upper, row_major> (sizes [k], test_fails__);
+        check_triangular_solve<rfp_lower, column_major> (sizes [k], test_fails__);
+        check_triangular_solve<rfp_upper, column_major> (sizes [k], test_fails__);
+    }
+}
+
+template<class M>
+void check_rank_update (M &m, std::size_t depth, bool hermitian, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    const std::size_t size = m.size1 ();
+    const matrix<value_type> a (definite_matrix<value_type> (size, hermitian));
+    matrix<value_type> x (size, depth);
+    for (std::size_t i = 0; i < size; ++ i)
+        for (std::size_t k = 0; k < depth; ++ k)
+            x (i, k) = element<value_type> (i + k, k);
+    const matrix<value_type> xt (hermitian ? matrix<value_type> (herm (x)) : matrix<value_type> (trans (x)));
+    const matrix<value_type> r (value_type (0.5) * a + value_type (2.0) * prod (x, xt));
+    const double tolerance = 1e-12 * norm_inf (r);
+
+    m = a;
+    symmetric_prod_update (m, x, xt, value_type (2.0), value_type (0.5));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<value_type> (m) - r) <= tolerance );
+
+    m = a;
+    if (hermitian)
+        blas_3::hrk (m, value_type (0.5), value_type (2.0), x);
+    else
+        blas_3::srk (m, value_type (0.5), value_type (2.0), x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<value_type> (m) - r) <= tolerance );
+}
+
+BOOST_UBLAS_TEST_DEF( test_rank_update )
+{
+    const std::size_t sizes [] = { 0, 1, 2, 7, 8, 33 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        const std::size_t size = sizes [k];
+        symmetric_matrix<double, rfp_lower, row_major> sl (size);
+        check_rank_update (sl, 5, false, test_fails__);
+        symmetric_matrix<double, rfp_upper, column_major> su (size);
+        check_rank_update (su, 3, false, test_fails__);
+        hermitian_matrix<complex_type, rfp_lower, column_major> hl (size);
+        check_rank_update (hl, 4, true, test_fails__);
+        hermitian_matrix<complex_type, rfp_upper, row_major> hu (size);
+        check_rank_update (hu, 70, true, test_fails__);
+    }
+}
+
+BOOST_UBLAS_TEST_DEF( test_singular )
+{
+    // Not positive definite: the pivot of the second triangle fails
+    matrix<double> a (definite_matrix<double> (6));
+    a (4, 4) = -1.0;
+    symmetric_matrix<double, rfp_lower> l (a);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( cholesky_factorize (l), std::size_t (5) );
+    symmetric_matrix<double, rfp_upper, column_major> u (a);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( cholesky_factorize (u), std::size_t (5) );
+
+    a (1, 1) = 0.0;
+    hermitian_matrix<complex_type, rfp_upper> h (6);
+    h = matrix<complex_type> (a);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( cholesky_factorize (h), std::size_t (2) );
+    // The storage is left valid
+    BOOST_UBLAS_TEST_CHECK_EQUAL( h (5, 4), complex_type (a (5, 4)) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_layout );
+    BOOST_UBLAS_TEST_DO( test_cholesky );
+    BOOST_UBLAS_TEST_DO( test_triangular_solve );
+    BOOST_UBLAS_TEST_DO( test_rank_update );
+    BOOST_UBLAS_TEST_DO( test_singular );
+
+    BOOST_UBLAS_TEST_END();
+}
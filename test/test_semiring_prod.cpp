@@ -0,0 +1,201 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// The plus_times semiring, counting its products
+struct counting_semiring:
+    public plus_times_semiring<double> {
+    static std::size_t products;
+
+    static double times (double t1, double t2) {
+        ++ products;
+        return t1 * t2;
+    }
+};
+std::size_t counting_semiring::products = 0;
+
+template<class M>
+M pattern (std::size_t size1, std::size_t size2, std::size_t seed) {
+    M m (size1, size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j)
+            if ((i * 7 + j * 3 + seed) % 5 == 0 || (i + j * seed) % 11 == 0)
+                m (i, j) = double (1 + (i + 2 * j + seed) % 4);
+    return m;
+}
+
+template<class E>
+bool is_stored (const E &e, std::size_t i, std::size_t j) {
+    return e.find1 (1, i, j) != e.find1 (1, i + 1, j) && e.find1 (1, i, j).index1 () == i;
+}
+
+// The product of the stored elements, where selected by the mask
+template<class S, class R, class E1, class E2, class K>
+bool check (const R &r, const E1 &a, const E2 &b, const K &k, bool masked, bool complemented) {
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t j = 0; j < b.size2 (); ++ j) {
+            double t (S::zero ());
+            if (! masked || is_stored (k, i, j) != complemented)
+                for (std::size_t l = 0; l < a.size2 (); ++ l)
+                    if (is_stored (a, i, l) && is_stored (b, l, j))
+                        t = S::plus (t, S::times (a (i, l), b (l, j)));
+            if (t != S::zero ()) {
+                if (! is_stored (r, i, j) || r (i, j) != t)
+                    return false;
+            } else if (is_stored (r, i, j))
+                return false;
+        }
+    return true;
+}
+
+template<class S, class M>
+void check_semiring (std::size_t &test_fails__) {
+    const M a (pattern<M> (13, 17, 1)), b (pattern<M> (17, 11, 2)), k (pattern<M> (13, 11, 3));
+    M r (13, 11);
+    sparse_prod (a, b, r, S (), no_mask ());
+    BOOST_UBLAS_TEST_CHECK( (check<S> (r, a, b, k, false, false)) );
+    sparse_prod (a, b, r, S (), mask (k));
+    BOOST_UBLAS_TEST_CHECK( (check<S> (r, a, b, k, true, false)) );
+    sparse_prod (a, b, r, S (), complement_mask (k));
+    BOOST_UBLAS_TEST_CHECK( (check<S> (r, a, b, k, true, true)) );
+    const M q (sparse_prod<M> (a, b, S (), mask (k)));
+    BOOST_UBLAS_TEST_CHECK( (check<S> (q, a, b, k, true, false)) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrix_prod )
+{
+    check_semiring<plus_times_semiring<double>, compressed_matrix<double> > (test_fails__);
+    check_semiring<min_plus_semiring<double>, compressed_matrix<double> > (test_fails__);
+    check_semiring<max_times_semiring<double>, compressed_matrix<double, column_major> > (test_fails__);
+    check_semiring<or_and_semiring<double>, compressed_matrix<double, column_major> > (test_fails__);
+    check_semiring<min_plus_semiring<double>, mapped_matrix<double> > (test_fails__);
+
+    // The arithmetic products are unchanged
+    const compressed_matrix<double> a (pattern<compressed_matrix<double> > (13, 17, 1));
+    const compressed_matrix<double> b (pattern<compressed_matrix<double> > (17, 11, 2));
+    compressed_matrix<double> r (13, 11);
+    sparse_prod (a, b, r);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - prod (a, b)) == 0 );
+    compressed_matrix<double, column_major> c (13, 11);
+    sparse_prod (a, b, c);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - prod (a, b)) == 0 );
+    r.clear ();
+    sparse_prod (a, b, r, full (), row_major_tag ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - prod (a, b)) == 0 );
+    c.clear ();
+    sparse_prod (a, b, c, full (), column_major_tag ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - prod (a, b)) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_mask_pruning )
+{
+    // Triangles of the graph of a, counted by a product masked by a
+    const std::size_t n = 30;
+    compressed_matrix<double> a (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            if (i != j && ((i + j) % 3 == 0 || (i * j) % 7 == 1))
+                a (i, j) = 1.0;
+    std::size_t triangles = 0;
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            for (std::size_t l = 0; l < n; ++ l)
+                if (a (i, j) != 0 && a (j, l) != 0 && a (l, i) != 0)
+                    ++ triangles;
+    compressed_matrix<double> c (n, n);
+    counting_semiring::products = 0;
+    sparse_prod (a, a, c, counting_semiring (), mask (a));
+    const std::size_t masked = counting_semiring::products;
+    BOOST_UBLAS_TEST_CHECK( std::size_t (sum (prod (c, scalar_vector<double> (n)))) == triangles );
+
+    counting_semiring::products = 0;
+    sparse_prod (a, a, c, counting_semiring (), no_mask ());
+    BOOST_UBLAS_TEST_CHECK( masked < counting_semiring::products );
+
+    // Rows without any selected element are skipped
+    compressed_matrix<double> k (n, n);
+    k (3, 4) = 1.0;
+    counting_semiring::products = 0;
+    sparse_prod (a, a, c, counting_semiring (), mask (k));
+    BOOST_UBLAS_TEST_CHECK( counting_semiring::products <= a.nnz () && c.nnz () <= 1 );
+}
+
+// Breadth first search, the level of every vertex reached from the frontier of the previous
+// level and not yet visited
+template<class M>
+void check_breadth_first (const M &a, std::size_t &test_fails__) {
+    const std::size_t n = a.size1 ();
+    compressed_vector<double> visited (n), frontier (n);
+    visited (0) = frontier (0) = 1.0;
+    vector<std::size_t> level (n, n);
+    level (0) = 0;
+    for (std::size_t d = 1; frontier.nnz () > 0; ++ d) {
+        compressed_vector<double> next (n);
+        sparse_prod (a, frontier, next, or_and_semiring<double> (), complement_mask (visited));
+        for (compressed_vector<double>::const_iterator it = next.begin (); it != next.end (); ++ it) {
+            level (it.index ()) = d;
+            visited (it.index ()) = 1.0;
+        }
+        frontier = next;
+    }
+    bool same = true;
+    for (std::size_t v = 0; v < n; ++ v)
+        same = same && level (v) == (v == 0 ? 0 : (v - 1) % 5 + 1);
+    BOOST_UBLAS_TEST_CHECK( same );
+}
+
+BOOST_UBLAS_TEST_DEF( test_vector_prod )
+{
+    // A star of paths of length 5 from vertex 0, the vertex 5 p + l at level l
+    const std::size_t n = 1 + 5 * 6;
+    compressed_matrix<double> a (n, n);
+    for (std::size_t p = 0; p < 6; ++ p)
+        for (std::size_t l = 1; l <= 5; ++ l) {
+            const std::size_t v = 5 * p + l, u = l == 1 ? 0 : v - 1;
+            a (u, v) = a (v, u) = 1.0;
+        }
+    check_breadth_first (a, test_fails__);
+    check_breadth_first (compressed_matrix<double, column_major> (a), test_fails__);
+
+    // Single source shortest paths by relaxations, in both orientations
+    const compressed_matrix<double> w (pattern<compressed_matrix<double> > (20, 20, 4));
+    vector<double> distance (20, min_plus_semiring<double>::zero ());
+    distance (0) = 0.0;
+    for (std::size_t r = 0; r < 20; ++ r) {
+        vector<double> relaxed (20, min_plus_semiring<double>::zero ());
+        sparse_prod (compressed_matrix<double, column_major> (trans (w)), distance, relaxed, min_plus_semiring<double> (), no_mask (), false);
+        vector<double> pulled (relaxed);
+        sparse_prod (trans (w), distance, pulled, min_plus_semiring<double> (), no_mask (), false);
+        BOOST_UBLAS_TEST_CHECK( norm_inf (pulled - relaxed) == 0 );
+        for (std::size_t v = 0; v < 20; ++ v)
+            distance (v) = (std::min) (distance (v), relaxed (v));
+    }
+    bool shortest = true;
+    for (std::size_t i = 0; i < 20; ++ i)
+        for (std::size_t j = 0; j < 20; ++ j)
+            if (is_stored (w, i, j))
+                shortest = shortest && distance (j) <= distance (i) + w (i, j);
+    BOOST_UBLAS_TEST_CHECK( shortest && distance (0) == 0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_matrix_prod );
+    BOOST_UBLAS_TEST_DO( test_mask_pruning );
+    BOOST_UBLAS_TEST_DO( test_vector_prod );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,215 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Slices of four rows per chunk, and products of a hundred elements or more threaded under OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "utils.hpp"
+#include "sparse_utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// Rows of irregular lengths, every seventh row empty and every eleventh row long
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    if (i % 7 == 3)
+        return T/*zero*/();
+    if (i % 11 != 5 && (3 * i + 5 * j) % (2 + i % 9) != 0)
+        return T/*zero*/();
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+
+template<class S, class E>
+void check_storage (const E &e, std::size_t sigma, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (e);
+    const compressed_matrix<value_type> c (e);
+    const S s (e, sigma);
+    BOOST_UBLAS_TEST_CHECK( s.size1 () == d.size1 () && s.size2 () == d.size2 () && s.sigma () == sigma );
+    BOOST_UBLAS_TEST_CHECK( s.nnz () == c.nnz () );
+    BOOST_UBLAS_TEST_CHECK( s.nnz_capacity () == s.nnz () + s.padding () );
+    BOOST_UBLAS_TEST_CHECK( s.nnz_capacity () % S::chunk_size () == 0 );
+    BOOST_UBLAS_TEST_CHECK( s.slices () * S::chunk_size () >= s.size1 () && s.slices () * S::chunk_size () < s.size1 () + S::chunk_size () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - d) == 0 );
+    BOOST_UBLAS_TEST_CHECK( same_iterated (s, d) );
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            BOOST_UBLAS_TEST_CHECK( s (i, j) == d (i, j) && (s.find_element (i, j) != 0) == (c.find_element (i, j) != 0) );
+
+    // Back to compressed matrices
+    compressed_matrix<value_type> r (s);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - d) == 0 && r.nnz () == s.nnz () );
+    compressed_matrix<value_type, column_major> rc (s);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - d) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_storage )
+{
+    const std::size_t size1 = 61, size2 = 37;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    check_storage<sliced_ellpack_matrix<double> > (cr, 1, test_fails__);
+    check_storage<sliced_ellpack_matrix<double, 4> > (cr, 1, test_fails__);
+    check_storage<sliced_ellpack_matrix<double, 4> > (cr, 16, test_fails__);
+    check_storage<sliced_ellpack_matrix<double, 4> > (cr, 7, test_fails__);
+    check_storage<sliced_ellpack_matrix<double, 1> > (cr, 1, test_fails__);
+    check_storage<sliced_ellpack_matrix<double, 8> > (cr, 1000, test_fails__);
+
+    // From other expressions, through a compressed matrix
+    compressed_matrix<double, column_major, 1> cc (size1, size2);
+    fill_sparse (cc);
+    check_storage<sliced_ellpack_matrix<double, 4> > (cc, 8, test_fails__);
+    matrix<double> d (size1, size2, 0.0);
+    fill_sparse (d);
+    check_storage<sliced_ellpack_matrix<double, 4> > (d, 8, test_fails__);
+    check_storage<sliced_ellpack_matrix<double> > (zero_matrix<double> (size1, size2), 1, test_fails__);
+    check_storage<sliced_ellpack_matrix<double> > (zero_matrix<double> (0, size2), 1, test_fails__);
+    compressed_matrix<complex_type> cz (size1, size2);
+    fill_sparse (cz);
+    check_storage<sliced_ellpack_matrix<complex_type, 2> > (cz, 4, test_fails__);
+
+    // Explicit zeros are kept as elements
+    compressed_matrix<double> z (5, 6);
+    z.push_back (1, 2, 0.0);
+    z.push_back (3, 4, 1.0);
+    sliced_ellpack_matrix<double, 4> sz (z);
+    BOOST_UBLAS_TEST_CHECK( sz.nnz () == 2 && sz.find_element (1, 2) != 0 && sz.find_element (1, 3) == 0 );
+
+    // Assignments keep the window
+    sliced_ellpack_matrix<double, 4> e;
+    BOOST_UBLAS_TEST_CHECK( e.size1 () == 0 && e.nnz () == 0 && e.padding () == 0 );
+    e = sliced_ellpack_matrix<double, 4> (cr, 16);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (e - d) == 0 && e.sigma () == 16 );
+    e = 2.0 * d;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (e - 2.0 * d) == 0 && e.sigma () == 16 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_padding )
+{
+    // One long row among short ones pads its whole slice only
+    compressed_matrix<double> c (16, 20);
+    for (std::size_t i = 0; i < 16; ++ i)
+        c (i, i) = 1.0;
+    for (std::size_t j = 0; j < 20; ++ j)
+        c (9, j) = 2.0;
+    sliced_ellpack_matrix<double, 4> s (c);
+    BOOST_UBLAS_TEST_CHECK( s.nnz () == 35 );
+    BOOST_UBLAS_TEST_CHECK( s.nnz_capacity () == 3 * 4 + 20 * 4 );
+    BOOST_UBLAS_TEST_CHECK( s.padding () == 3 * 4 + 20 * 4 - 35 );
+
+    // Sorting over the whole matrix does not pad more than slicing in order
+    const std::size_t size1 = 97, size2 = 41;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    sliced_ellpack_matrix<double, 8> in_order (cr, 1), sorted (cr, size1);
+    BOOST_UBLAS_TEST_CHECK( sorted.padding () <= in_order.padding () );
+    BOOST_UBLAS_TEST_CHECK( sorted.padding () < in_order.padding () );
+    sliced_ellpack_matrix<double, 1> csr (cr);
+    BOOST_UBLAS_TEST_CHECK( csr.padding () == 0 );
+}
+
+template<class M, class E1, class E2>
+bool uses_kernel () {
+    typedef typename M::reference reference;
+    typedef typename E1::value_type value_type;
+    typedef matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, value_type> > expression_type;
+    return boost::is_same<typename detail::matrix_prod_traits<M, expression_type, scalar_assign<reference, value_type>, dense_proxy_tag>::storage_category,
+                          detail::matrix_matrix_kernel_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef sliced_ellpack_matrix<double> sm;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix<double>, sm, matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix<double, column_major>, sm, matrix<double, column_major> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<double>, matrix<double>, sm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<double>, sm, compressed_matrix<double> > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<complex_type>, sm, matrix<complex_type> > () ));
+}
+
+template<class S>
+void check_prod (const S &s, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (s);
+    const double tolerance = 1e-13 * (1 + norm_inf (d));
+
+    vector<value_type> x (s.size2 ()), y (s.size1 ()), e (s.size1 ());
+    for (std::size_t j = 0; j < x.size (); ++ j)
+        x (j) = value_type (1.0 + j % 4) / value_type (3);
+    e = prod (d, x);
+    y = prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    noalias (y) += prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+    noalias (y) -= prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= 2 * tolerance );
+    axpy_prod (s, x, y, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    axpy_prod (s, x, y, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+
+    matrix<value_type> xr (s.size2 (), 7), yr (s.size1 (), 7), er (s.size1 (), 7);
+    fill_dense (xr);
+    matrix<value_type, column_major> xc (xr), yc (s.size1 (), 7);
+    er = prod (d, xr);
+    yr = prod (s, xr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - er) <= tolerance );
+    noalias (yc) = prod (s, xc);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yc - er) <= tolerance );
+    noalias (yc) += prod (s, xr);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yc - value_type (2) * er) <= 2 * tolerance );
+    noalias (yr) -= prod (s, xc);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr) <= 2 * tolerance );
+    axpy_prod (s, xr, yr, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - er) <= tolerance );
+    axpy_prod (s, xc, yr, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (yr - value_type (2) * er) <= 2 * tolerance );
+
+    // Ranges of the dense operands, a single column
+    matrix<value_type> wide (s.size2 () + 2, 9), out (s.size1 () + 3, 5, value_type (-1));
+    fill_dense (wide);
+    matrix_range<matrix<value_type> > rin (wide, range (2, s.size2 () + 2), range (3, 4));
+    matrix_range<matrix<value_type> > rout (out, range (1, s.size1 () + 1), range (2, 3));
+    noalias (rout) = prod (s, rin);
+    matrix<value_type> ein (rin);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (matrix<value_type> (rout) - prod (d, ein)) <= tolerance );
+    BOOST_UBLAS_TEST_CHECK( out (0, 2) == value_type (-1) && out (1, 1) == value_type (-1) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    const std::size_t size1 = 150, size2 = 53;
+    compressed_matrix<double> cr (size1, size2);
+    fill_sparse (cr);
+    check_prod (sliced_ellpack_matrix<double> (cr), test_fails__);
+    check_prod (sliced_ellpack_matrix<double> (cr, 32), test_fails__);
+    check_prod (sliced_ellpack_matrix<double, 4> (cr, 5), test_fails__);
+    check_prod (sliced_ellpack_matrix<double, 1> (cr), test_fails__);
+    compressed_matrix<complex_type> cz (size1, size2);
+    fill_sparse (cz);
+    check_prod (sliced_ellpack_matrix<complex_type, 4> (cz, 16), test_fails__);
+    check_prod (sliced_ellpack_matrix<double> (compressed_matrix<double> (size1, size2)), test_fails__);
+    check_prod (sliced_ellpack_matrix<double> (compressed_matrix<double> (3, size2)), test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_storage );
+    BOOST_UBLAS_TEST_DO( test_padding );
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small blocks of columns, and the factorization by levels when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/sparse_cholesky.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// The five point Laplacian of a k by k grid, shifted by s, with vertex v numbered (v * step) % (k * k)
+template<class M>
+M grid (std::size_t k, std::size_t step, double s) {
+    const std::size_t n = k * k;
+    M m (n, n);
+    for (std::size_t x = 0; x < k; ++ x)
+        for (std::size_t y = 0; y < k; ++ y) {
+            const std::size_t v = (x * k + y) * step % n;
+            m (v, v) = 4.0 + s;
+            if (x > 0)
+                m (v, ((x - 1) * k + y) * step % n) = -1.0;
+            if (x + 1 < k)
+                m (v, ((x + 1) * k + y) * step % n) = -1.0;
+            if (y > 0)
+                m (v, (x * k + y - 1) * step % n) = -1.0;
+            if (y + 1 < k)
+                m (v, (x * k + y + 1) * step % n) = -1.0;
+        }
+    return m;
+}
+
+// The residual of a x = b relative to b
+template<class M, class V>
+double residual (const M &a, const V &x, const V &b) {
+    return norm_2 (prod (a, x) - b) / norm_2 (b);
+}
+
+void check_structure (const sparse_cholesky_symbolic &s, std::size_t &test_fails__) {
+    const std::size_t n = s.size ();
+    bool valid = s.supernode_starts ().front () == 0 && s.supernode_starts ().back () == n;
+    for (std::size_t k = 0; k < n; ++ k)
+        valid = valid && (s.parent () [k] == n || s.parent () [k] > k);
+    for (std::size_t j = 0; j < s.supernodes (); ++ j) {
+        const std::size_t first = s.supernode_starts () [j], columns = s.supernode_starts () [j + 1] - first;
+        valid = valid && columns > 0 && s.row_starts () [j + 1] - s.row_starts () [j] >= columns;
+        for (std::size_t r = s.row_starts () [j]; r + 1 < s.row_starts () [j + 1]; ++ r)
+            valid = valid && s.rows () [r] < s.rows () [r + 1];
+        valid = valid && s.rows () [s.row_starts () [j]] == first;
+    }
+    BOOST_UBLAS_TEST_CHECK( valid );
+    BOOST_UBLAS_TEST_CHECK( s.level_supernodes ().size () == s.supernodes () );
+}
+
+BOOST_UBLAS_TEST_DEF( test_grid )
+{
+    const std::size_t k = 15;
+    const compressed_matrix<double> a (grid<compressed_matrix<double> > (k, 37, 0.0));
+    const std::size_t n = a.size1 ();
+    sparse_cholesky_symbolic s (a);
+    BOOST_UBLAS_TEST_CHECK( s.size () == n && s.supernodes () < n );
+    check_structure (s, test_fails__);
+
+    sparse_cholesky_factor<double> f (s);
+    BOOST_UBLAS_TEST_CHECK( cholesky_factorize (a, f) == 0 );
+    vector<double> b (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        b (i) = 1.0 + (i * 7 % 13);
+    vector<double> x (b);
+    cholesky_substitute (f, x);
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1.0e-12 );
+
+    // Several right hand sides
+    matrix<double> bm (n, 3), xm;
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < 3; ++ j)
+            bm (i, j) = double (i * (j + 1) % 17) - 8.0;
+    xm = bm;
+    cholesky_substitute (f, xm);
+    BOOST_UBLAS_TEST_CHECK( norm_frobenius (prod (a, xm) - bm) / norm_frobenius (bm) < 1.0e-12 );
+
+    // The lower triangle only, column major and one based, in the natural ordering
+    compressed_matrix<double, column_major, 1> l (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            if (a (i, j) != 0)
+                l (i, j) = a (i, j);
+    vector<std::size_t> p (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        p (i) = i;
+    sparse_cholesky_factor<double> g ((sparse_cholesky_symbolic (l, p)));
+    BOOST_UBLAS_TEST_CHECK( cholesky_factorize (l, g) == 0 );
+    x = b;
+    cholesky_substitute (g, x);
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1.0e-12 );
+    BOOST_UBLAS_TEST_CHECK( s.nnz () < g.symbolic ().nnz () );
+}
+
+BOOST_UBLAS_TEST_DEF( test_refactorize )
+{
+    const std::size_t k = 12;
+    compressed_matrix<double, column_major> a (grid<compressed_matrix<double, column_major> > (k, 5, 0.0));
+    const std::size_t n = a.size1 ();
+    sparse_cholesky_factor<double> f ((sparse_cholesky_symbolic (a)));
+    vector<double> b (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        b (i) = double (i % 5) - 2.0;
+    for (int shift = 0; shift < 3; ++ shift) {
+        // The same pattern with new values
+        const compressed_matrix<double, column_major> c (grid<compressed_matrix<double, column_major> > (k, 5, shift * 0.5));
+        BOOST_UBLAS_TEST_CHECK( f.symbolic ().same_pattern (c) );
+        BOOST_UBLAS_TEST_CHECK( cholesky_factorize (c, f) == 0 );
+        vector<double> x (b);
+        cholesky_substitute (f, x);
+        BOOST_UBLAS_TEST_CHECK( residual (c, x, b) < 1.0e-12 );
+    }
+
+    // Not positive definite
+    const compressed_matrix<double, column_major> d (grid<compressed_matrix<double, column_major> > (k, 5, -6.0));
+    BOOST_UBLAS_TEST_CHECK( cholesky_factorize (d, f) != 0 );
+    compressed_matrix<double> e (3, 3);
+    e (0, 0) = 1.0; e (1, 1) = -1.0; e (2, 2) = 1.0;
+    vector<std::size_t> p (3);
+    p (0) = 0; p (1) = 1; p (2) = 2;
+    sparse_cholesky_factor<double> g ((sparse_cholesky_symbolic (e, p)));
+    BOOST_UBLAS_TEST_CHECK( cholesky_factorize (e, g) == 2 );
+
+    // As many elements in another pattern or another orientation
+    compressed_matrix<double> o (3, 3);
+    o (0, 0) = 1.0; o (1, 1) = 1.0; o (2, 1) = 1.0;
+    BOOST_UBLAS_TEST_CHECK( ! g.symbolic ().same_pattern (o) );
+    BOOST_UBLAS_TEST_CHECK( ! g.symbolic ().same_pattern (compressed_matrix<double, column_major> (e)) );
+    BOOST_UBLAS_TEST_CHECK( ! f.symbolic ().same_pattern (e) );
+
+    sparse_cholesky_factor<double> z ((sparse_cholesky_symbolic (compressed_matrix<double> (0, 0))));
+    BOOST_UBLAS_TEST_CHECK( cholesky_factorize (compressed_matrix<double> (0, 0), z) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_hermitian )
+{
+    typedef std::complex<double> value_type;
+    const std::size_t n = 60;
+    compressed_matrix<value_type> a (n, n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        a (i, i) = value_type (10.0, 0.0);
+        for (std::size_t j = 0; j < i; ++ j)
+            if ((i * 3 + j * 7) % 13 == 0 || i == j + 1) {
+                const value_type t (0.5, 0.25 * (1.0 + j % 3));
+                a (i, j) = t;
+                a (j, i) = std::conj (t);
+            }
+    }
+    sparse_cholesky_symbolic s (a);
+    check_structure (s, test_fails__);
+    sparse_cholesky_factor<value_type> f (s);
+    BOOST_UBLAS_TEST_CHECK( cholesky_factorize (a, f) == 0 );
+    vector<value_type> b (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        b (i) = value_type (1.0 + i % 3, double (i % 4));
+    vector<value_type> x (b);
+    cholesky_substitute (f, x);
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1.0e-12 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_grid );
+    BOOST_UBLAS_TEST_DO( test_refactorize );
+    BOOST_UBLAS_TEST_DO( test_hermitian );
+
+    BOOST_UBLAS_TEST_END();
+}
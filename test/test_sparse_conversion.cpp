@@ -0,0 +1,190 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Lines converted four at a time per thread, from a hundred elements under OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector_of_vector.hpp>
+
+#include "utils.hpp"
+#include "sparse_utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// Rows and columns of irregular lengths, some of them empty
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    if (i % 7 == 3 || j % 9 == 4)
+        return T/*zero*/();
+    if ((3 * i + 5 * j) % (2 + (i + j) % 7) != 0)
+        return T/*zero*/();
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+
+// Unsorted, with pairs of duplicates summing up to the elements
+template<class T, class L, std::size_t IB>
+void fill_sparse (coordinate_matrix<T, L, IB> &m) {
+    for (std::size_t i = m.size1 (); i-- > 0;)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            if (element<T> (i, j) != T/*zero*/()) {
+                m.append_element (i, j, element<T> (i, j) / T (4));
+                m.append_element (i, j, element<T> (i, j) * T (3) / T (4));
+            }
+}
+
+// The elements met by the iterators of m along its orientation, and their number. Only this
+// direction is checked, as a coordinate_matrix cannot be iterated across its orientation.
+template<class M, class D>
+bool same_major_iterated (const M &m, const D &d, row_major_tag) {
+    std::size_t count = 0;
+    for (typename M::const_iterator1 it1 = m.begin1 (); it1 != m.end1 (); ++ it1)
+        for (typename M::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2, ++ count)
+            if (*it2 != d (it2.index1 (), it2.index2 ()))
+                return false;
+    return count == non_zeros (d);
+}
+template<class M, class D>
+bool same_major_iterated (const M &m, const D &d, column_major_tag) {
+    std::size_t count = 0;
+    for (typename M::const_iterator2 it2 = m.begin2 (); it2 != m.end2 (); ++ it2)
+        for (typename M::const_iterator1 it1 = it2.begin (); it1 != it2.end (); ++ it1, ++ count)
+            if (*it1 != d (it1.index1 (), it1.index2 ()))
+                return false;
+    return count == non_zeros (d);
+}
+template<class M, class D>
+bool same_major_iterated (const M &m, const D &d) {
+    return same_major_iterated (m, d, typename M::orientation_category ());
+}
+
+template<class M, class E>
+bool uses_conversion () {
+    typedef scalar_assign<typename M::reference, typename E::value_type> functor_type;
+    return boost::is_same<typename detail::matrix_conversion_traits<M, E, functor_type, dense_proxy_tag>::storage_category,
+                          detail::sparse_conversion_tag>::value;
+}
+
+// Conversion of s into R, empty or with previous contents. Plain assignment copies a matrix
+// of the same type, explicit zeros included, assign () converts it.
+template<class R, class S, class D>
+void check_target (const S &s, const D &d, std::size_t &test_fails__) {
+    BOOST_UBLAS_TEST_CHECK(( uses_conversion<R, S> () ));
+    R r (d.size1 (), d.size2 ());
+    r.assign (s);
+    BOOST_UBLAS_TEST_CHECK( same_major_iterated (r, d) );
+    R a (d.size1 (), d.size2 ());
+    a (0, 0) = a (d.size1 () - 1, d.size2 () - 1) = typename D::value_type (5);
+    a.assign (s);
+    BOOST_UBLAS_TEST_CHECK( same_major_iterated (a, d) );
+    const R c (s);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - d) == 0 );
+}
+
+template<class S, class D>
+void check_targets (const S &s, const D &d, std::size_t &test_fails__) {
+    typedef typename D::value_type value_type;
+    check_target<compressed_matrix<value_type> > (s, d, test_fails__);
+    check_target<compressed_matrix<value_type, column_major> > (s, d, test_fails__);
+    check_target<compressed_matrix<value_type, row_major, 1> > (s, d, test_fails__);
+    check_target<compressed_matrix<value_type, column_major, 1> > (s, d, test_fails__);
+    check_target<coordinate_matrix<value_type> > (s, d, test_fails__);
+    check_target<coordinate_matrix<value_type, column_major, 1> > (s, d, test_fails__);
+    check_target<mapped_matrix<value_type> > (s, d, test_fails__);
+    check_target<mapped_matrix<value_type, column_major> > (s, d, test_fails__);
+    check_target<mapped_matrix<value_type, row_major, std::map<std::size_t, value_type> > > (s, d, test_fails__);
+    check_target<generalized_vector_of_vector<value_type, row_major> > (s, d, test_fails__);
+    check_target<generalized_vector_of_vector<value_type, column_major> > (s, d, test_fails__);
+    check_target<generalized_vector_of_vector<value_type, row_major, vector<mapped_vector<value_type> > > > (s, d, test_fails__);
+    check_target<generalized_vector_of_vector<value_type, column_major, vector<coordinate_vector<value_type> > > > (s, d, test_fails__);
+}
+
+template<class S>
+void check_source (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    S s (size1, size2);
+    fill_sparse (s);
+    matrix<value_type> d (size1, size2, value_type/*zero*/());
+    fill_sparse (d);
+    check_targets (s, d, test_fails__);
+}
+
+template<class T>
+void check_sources (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    check_source<compressed_matrix<T> > (size1, size2, test_fails__);
+    check_source<compressed_matrix<T, column_major, 1> > (size1, size2, test_fails__);
+    check_source<coordinate_matrix<T> > (size1, size2, test_fails__);
+    check_source<coordinate_matrix<T, column_major, 1> > (size1, size2, test_fails__);
+    check_source<mapped_matrix<T> > (size1, size2, test_fails__);
+    check_source<mapped_matrix<T, column_major> > (size1, size2, test_fails__);
+    check_source<generalized_vector_of_vector<T, row_major> > (size1, size2, test_fails__);
+    check_source<generalized_vector_of_vector<T, column_major> > (size1, size2, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_formats )
+{
+    check_sources<double> (11, 17, test_fails__);
+    check_sources<double> (150, 53, test_fails__);
+    check_sources<complex_type> (53, 150, test_fails__);
+    check_sources<double> (1, 1, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_zeros )
+{
+    // Explicitly stored zeros are dropped, as by plain assignment
+    matrix<double> d (40, 30, 0.0);
+    fill_sparse (d);
+    compressed_matrix<double> c (d);
+    c.insert_element (3, 3, 0.0);
+    c (0, 1) = d (0, 1) = 0.0;
+    BOOST_UBLAS_TEST_CHECK( c.nnz () == non_zeros (d) + 2 );
+    check_targets (c, d, test_fails__);
+    coordinate_matrix<double, column_major> co (d.size1 (), d.size2 ());
+    fill_sparse (co);
+    co.append_element (5, 7, 2.0);
+    co.append_element (5, 7, -2.0);
+    check_targets (co, d, test_fails__);
+
+    // Matrices without elements
+    const compressed_matrix<double> z (d.size1 (), d.size2 ());
+    check_targets (z, matrix<double> (d.size1 (), d.size2 (), 0.0), test_fails__);
+    mapped_matrix<double> e (0, 5);
+    compressed_matrix<double, column_major> ec (e);
+    BOOST_UBLAS_TEST_CHECK( ec.size1 () == 0 && ec.size2 () == 5 && ec.nnz () == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_sorted )
+{
+    // The lines of a converted coordinate matrix are sorted already, so that elements can be
+    // appended at once
+    coordinate_matrix<double> s (60, 40);
+    fill_sparse (s);
+    coordinate_matrix<double, column_major> c (s);
+    c.push_back (58, 39, 7.0);
+    matrix<double> d (60, 40, 0.0);
+    fill_sparse (d);
+    d (58, 39) = 7.0;
+    BOOST_UBLAS_TEST_CHECK( same_major_iterated (c, d) );
+
+    // Assignment to itself leaves the matrix as it is
+    compressed_matrix<double> r (d);
+    r.assign (r);
+    BOOST_UBLAS_TEST_CHECK( same_major_iterated (r, d) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_formats );
+    BOOST_UBLAS_TEST_DO( test_zeros );
+    BOOST_UBLAS_TEST_DO( test_sorted );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small chunks of lines, and the threaded merges when compiled with OpenMP
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 4
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+// Two overlapping patterns, of which some common elements cancel in the difference
+template<class M>
+void fill (M &a, M &b) {
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t j = 0; j < a.size2 (); ++ j) {
+            if ((i * 3 + j * 5) % 7 == 0)
+                a (i, j) = typename M::value_type (1.0 + (i + j) % 4);
+            if ((i * 5 + j * 2) % 6 == 0 && i % 9 != 4)
+                b (i, j) = typename M::value_type (1.0 + (i * j) % 3);
+        }
+}
+
+template<class M>
+std::size_t count_nonzero (const matrix<typename M::value_type> &d) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            if (d (i, j) != typename M::value_type ())
+                ++ n;
+    return n;
+}
+
+template<class M, class E>
+bool uses_merge () {
+    typedef typename M::reference reference;
+    typedef typename E::value_type value_type;
+    return boost::is_same<typename detail::matrix_merge_traits<M, E, scalar_assign<reference, value_type>, sparse_tag>::storage_category,
+                          detail::sparse_merge_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef compressed_matrix<double> cm;
+    typedef compressed_vector<double> cv;
+    BOOST_UBLAS_TEST_CHECK(( uses_merge<cm, matrix_binary<cm, cm, scalar_plus<double, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_merge<cm, matrix_binary<cm, cm, scalar_minus<double, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_merge<cm, matrix_binary<cm, cm, scalar_multiplies<double, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_merge<cm, matrix_binary<cm, cm, scalar_divides<double, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_merge<cm, matrix_binary<cm, compressed_matrix<double, column_major>, scalar_plus<double, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_merge<mapped_matrix<double>, matrix_binary<mapped_matrix<double>, mapped_matrix<double>, scalar_plus<double, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( boost::is_same<detail::vector_merge_traits<cv, vector_binary<cv, cv, scalar_plus<double, double> >,
+                                                                        scalar_assign<cv::reference, double>, sparse_tag>::storage_category,
+                                            detail::sparse_merge_tag>::value ));
+}
+
+template<class M>
+void check_merge (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    M a (size1, size2), b (size1, size2);
+    fill (a, b);
+    const matrix<value_type> da (a), db (b);
+    const matrix<value_type> sum (da + db), difference (da - db), product (element_prod (da, db));
+
+    M c (a + b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - sum) == 0 && c.nnz () == count_nonzero<M> (sum) );
+    c = a - b;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - difference) == 0 && c.nnz () == count_nonzero<M> (difference) );
+    noalias (c) = element_prod (a, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (c - product) == 0 && c.nnz () == count_nonzero<M> (product) );
+
+    // Zero results are dropped
+    c = a - a;
+    BOOST_UBLAS_TEST_CHECK( c.nnz () == 0 && norm_inf (c) == 0 );
+
+    // Into an operand
+    noalias (a) = a + b;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (a - sum) == 0 && a.nnz () == count_nonzero<M> (sum) );
+    noalias (b) = a - b;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (b - da) == 0 && b.nnz () == count_nonzero<M> (da) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrix )
+{
+    check_merge<compressed_matrix<double> > (43, 29, test_fails__);
+    check_merge<compressed_matrix<double, column_major> > (43, 29, test_fails__);
+    check_merge<compressed_matrix<double, row_major, 1> > (17, 61, test_fails__);
+    check_merge<compressed_matrix<complex_type, column_major, 1> > (30, 30, test_fails__);
+    check_merge<compressed_matrix<double> > (0, 0, test_fails__);
+    check_merge<compressed_matrix<double> > (5, 0, test_fails__);
+
+    // Operands filled up to different lines
+    compressed_matrix<double> a (20, 20), b (20, 20);
+    a (2, 3) = 1.0;
+    b (15, 4) = 2.0;
+    b (2, 3) = -1.0;
+    const compressed_matrix<double> c (a + b);
+    BOOST_UBLAS_TEST_CHECK( c.nnz () == 1 && c (15, 4) == 2.0 && c.filled1 () == 21 );
+    const compressed_matrix<double> d (element_prod (a, b));
+    BOOST_UBLAS_TEST_CHECK( d.nnz () == 1 && d (2, 3) == -1.0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_vector )
+{
+    const std::size_t size = 57;
+    compressed_vector<double> u (size), v (size);
+    vector<double> du (size, 0.0), dv (size, 0.0);
+    for (std::size_t i = 0; i < size; ++ i) {
+        if (i % 3 == 0)
+            du (i) = u (i) = 1.0 + i % 5;
+        if (i % 4 == 0)
+            dv (i) = v (i) = 1.0 + i % 5;
+    }
+    // The multiples of 12 are common to both, and cancel in the difference
+    compressed_vector<double> w (u + v);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (w - (du + dv)) == 0 && w.nnz () == 19 + 15 - 5 );
+    w = u - v;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (w - (du - dv)) == 0 && w.nnz () == 19 + 15 - 2 * 5 );
+    noalias (w) = element_prod (u, v);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (w - element_prod (du, dv)) == 0 && w.nnz () == 5 );
+    noalias (u) = element_prod (u, v);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (u - w) == 0 && u.nnz () == w.nnz () );
+
+    compressed_vector<complex_type, 1> x (size), y (size);
+    x (3) = complex_type (1.0, 2.0);
+    y (3) = complex_type (1.0, 2.0);
+    y (40) = complex_type (0.0, 1.0);
+    compressed_vector<complex_type, 1> z (x - y);
+    BOOST_UBLAS_TEST_CHECK( z.nnz () == 1 && z (40) == complex_type (0.0, -1.0) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_matrix );
+    BOOST_UBLAS_TEST_DO( test_vector );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Exercise the non temporal paths on small containers
+#define BOOST_UBLAS_STREAMING_THRESHOLD 64
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class T>
+bool all_equal (const T *p, std::size_t size, const T &t) {
+    for (std::size_t i = 0; i < size; ++ i)
+        if (p [i] != t)
+            return false;
+    return true;
+}
+
+template<class T>
+void check_ranges (const T &t, std::size_t &test_fails__) {
+    const std::size_t size = 100;
+    T buffer [size + 2];
+    T copy [size + 2];
+    // Every alignment of the start and of the end
+    for (std::size_t first = 0; first < 2; ++ first)
+        for (std::size_t n = 0; n <= size; n += 7) {
+            std::fill (buffer, buffer + size + 2, T (1));
+            detail::fill_storage (buffer + first, buffer + first + n, t);
+            BOOST_UBLAS_TEST_CHECK( all_equal (buffer + first, n, t) );
+            BOOST_UBLAS_TEST_CHECK( buffer [first + n] == T (1) );
+            if (first)
+                BOOST_UBLAS_TEST_CHECK( buffer [0] == T (1) );
+
+            for (std::size_t i = 0; i < size + 2; ++ i)
+                buffer [i] = T (i);
+            std::fill (copy, copy + size + 2, T (0));
+            detail::copy_storage (buffer + 1, buffer + 1 + n, copy + first);
+            for (std::size_t i = 0; i < n; ++ i)
+                if (copy [first + i] != T (i + 1))
+                    ++ test_fails__;
+            BOOST_UBLAS_TEST_CHECK( copy [first + n] == T (0) );
+        }
+}
+
+BOOST_UBLAS_TEST_DEF( test_ranges )
+{
+    check_ranges<double> (2.5, test_fails__);
+    check_ranges<float> (-3.f, test_fails__);
+    check_ranges<char> ('x', test_fails__);
+    check_ranges<std::complex<double> > (std::complex<double> (1, 2), test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_containers )
+{
+    vector<double> v (1000, 3.0);
+    BOOST_UBLAS_TEST_CHECK( all_equal (&v (0), v.size (), 3.0) );
+    v.clear ();
+    BOOST_UBLAS_TEST_CHECK( all_equal (&v (0), v.size (), 0.0) );
+    vector_assign_scalar<scalar_assign> (v, 7);
+    BOOST_UBLAS_TEST_CHECK( all_equal (&v (0), v.size (), 7.0) );
+
+    vector<double> w (v);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( w, v, v.size () );
+    w.resize (10);
+    w = v;
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ( w, v, v.size () );
+
+    matrix<float> m (37, 41, 1.f);
+    m.clear ();
+    BOOST_UBLAS_TEST_CHECK( all_equal (&m (0, 0), m.data ().size (), 0.f) );
+    matrix_assign_scalar<scalar_assign> (m, 2);
+    BOOST_UBLAS_TEST_CHECK( all_equal (&m (0, 0), m.data ().size (), 2.f) );
+    m (3, 4) = 5.f;
+    matrix<float> c (m);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( c, m, 37, 41 );
+
+    // Computed assignments still go through the element wise loop
+    matrix_assign_scalar<scalar_multiplies_assign> (c, 2);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( c (3, 4), 10.f );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( c (0, 0), 4.f );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_ranges );
+    BOOST_UBLAS_TEST_DO( test_containers );
+
+    BOOST_UBLAS_TEST_END();
+}
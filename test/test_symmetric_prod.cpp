@@ -0,0 +1,153 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Exercise the threaded path on small matrices when compiled with OpenMP
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    return T (1.0 + (3 * i + 5 * j) % 7);
+}
+template<>
+complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return complex_type (1.0 + (3 * i + 5 * j) % 7, i == j ? 0.0 : 2.0 - (i + 2 * j) % 5);
+}
+
+// Fill the stored triangle, the other one follows
+template<class TRI, class M>
+void fill_triangle (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j <= i; ++ j) {
+            typename M::value_type t (element<typename M::value_type> (i, j));
+            if (TRI::other (i, j))
+                m (i, j) = t;
+            else
+                m (j, i) = type_traits<typename M::value_type>::conj (t);
+        }
+}
+
+template<class V, class E>
+bool uses_kernel () {
+    typedef typename V::reference reference;
+    typedef typename E::value_type value_type;
+    return boost::is_same<typename detail::vector_prod_traits<V, E, scalar_assign<reference, value_type>, dense_tag>::storage_category,
+                          detail::matrix_vector_kernel_tag>::value;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef vector<double> dv;
+    typedef symmetric_matrix<double> sm;
+    typedef hermitian_matrix<complex_type, upper, column_major> hm;
+    typedef vector<complex_type> cv;
+    typedef symmetric_adaptor<matrix<double> > sa;
+    typedef hermitian_adaptor<const matrix<complex_type, column_major>, upper> ha;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dv, matrix_vector_binary1<sm, dv, matrix_vector_prod1<sm, dv, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<cv, matrix_vector_binary1<hm, cv, matrix_vector_prod1<hm, cv, complex_type> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dv, matrix_vector_binary1<sa, dv, matrix_vector_prod1<sa, dv, double> > > () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<cv, matrix_vector_binary1<ha, cv, matrix_vector_prod1<ha, cv, complex_type> > > () ));
+    typedef symmetric_matrix<double, lower, row_major, std::vector<double> > vm;
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dv, matrix_vector_binary1<vm, dv, matrix_vector_prod1<vm, dv, double> > > () ));
+    typedef symmetric_adaptor<matrix_slice<matrix<double> > > ss;
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dv, matrix_vector_binary1<ss, dv, matrix_vector_prod1<ss, dv, double> > > () ));
+}
+
+template<class M>
+void check_prod_vector (const M &m, std::size_t &test_fails__) {
+    typedef typename M::value_type value_type;
+    const matrix<value_type> dense (m);
+    vector<value_type> x (m.size2 ());
+    for (std::size_t j = 0; j < x.size (); ++ j)
+        x (j) = element<value_type> (j, 2 * j + 1);
+    const vector<value_type> expected (prod (dense, x));
+    const double tolerance = 1e-12 * (1 + norm_inf (expected));
+
+    vector<value_type> y (prod (m, x));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - expected) <= tolerance );
+
+    noalias (y) += prod (m, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * expected) <= 2 * tolerance );
+    noalias (y) -= prod (m, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - expected) <= 3 * tolerance );
+
+    vector<value_type> z (m.size1 (), value_type (7));
+    axpy_prod (m, x, z, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected - scalar_vector<value_type> (z.size (), value_type (7))) <= tolerance );
+    axpy_prod (m, x, z);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected) <= tolerance );
+
+    vector<value_type> w (m.size1 () + 2, value_type (3));
+    noalias (project (w, range (1, m.size1 () + 1))) = prod (m, x);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (0), value_type (3) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (m.size1 () + 1), value_type (3) );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (project (w, range (1, m.size1 () + 1)) - expected) <= tolerance );
+}
+
+template<class T, class TRI, class L>
+void check_packed (std::size_t size, std::size_t &test_fails__) {
+    symmetric_matrix<T, TRI, L> s (size);
+    fill_triangle<TRI> (s);
+    check_prod_vector (s, test_fails__);
+
+    matrix<T, L> d (size, size, T (-100));
+    symmetric_adaptor<matrix<T, L>, TRI> a (d);
+    fill_triangle<TRI> (a);
+    check_prod_vector (a, test_fails__);
+}
+
+template<class TRI, class L>
+void check_hermitian (std::size_t size, std::size_t &test_fails__) {
+    hermitian_matrix<complex_type, TRI, L> h (size);
+    fill_triangle<TRI> (h);
+    check_prod_vector (h, test_fails__);
+
+    matrix<complex_type, L> d (size, size, complex_type (-100, 50));
+    hermitian_adaptor<matrix<complex_type, L>, TRI> a (d);
+    fill_triangle<TRI> (a);
+    check_prod_vector (a, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_symmetric )
+{
+    check_packed<double, lower, row_major> (23, test_fails__);
+    check_packed<double, upper, row_major> (23, test_fails__);
+    check_packed<double, lower, column_major> (23, test_fails__);
+    check_packed<double, upper, column_major> (23, test_fails__);
+    check_packed<double, lower, row_major> (1, test_fails__);
+    check_packed<complex_type, upper, row_major> (9, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_hermitian )
+{
+    check_hermitian<lower, row_major> (19, test_fails__);
+    check_hermitian<upper, row_major> (19, test_fails__);
+    check_hermitian<lower, column_major> (19, test_fails__);
+    check_hermitian<upper, column_major> (19, test_fails__);
+    check_hermitian<upper, row_major> (2, test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_symmetric );
+    BOOST_UBLAS_TEST_DO( test_hermitian );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,201 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Products with one stored triangle go threaded from a hundred elements under OpenMP
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 100
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "utils.hpp"
+#include "sparse_utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// A symmetric pattern of irregular rows, with some zero diagonal elements
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    const std::size_t r = (std::max) (i, j), c = (std::min) (i, j);
+    if (r == c)
+        return r % 5 == 2 ? T/*zero*/() : T (2.0 + r % 3);
+    if (r % 7 == 3 || (3 * r + 5 * c) % (2 + r % 6) != 0)
+        return T/*zero*/();
+    return T (1.0 + (3 * r + 5 * c) % 7) / T (8);
+}
+
+template<class M, class E>
+bool uses_conversion () {
+    typedef scalar_assign<typename M::reference, typename E::value_type> functor_type;
+    return boost::is_same<typename detail::matrix_conversion_traits<M, E, functor_type, dense_proxy_tag>::storage_category,
+                          detail::sparse_conversion_tag>::value;
+}
+
+template<class S, class E>
+void check_storage (const E &e, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (e);
+    const S s (e);
+    std::size_t strict = 0;
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < i; ++ j)
+            if (d (i, j) != value_type/*zero*/())
+                ++ strict;
+    BOOST_UBLAS_TEST_CHECK( s.size1 () == d.size1 () && s.size2 () == d.size2 () );
+    BOOST_UBLAS_TEST_CHECK( s.filled () == strict && s.nnz () == strict + d.size1 () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - d) == 0 );
+    BOOST_UBLAS_TEST_CHECK( same_iterated (s, d, non_zeros (d)) );
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            BOOST_UBLAS_TEST_CHECK( s (i, j) == d (i, j) && (s.find_element (i, j) != 0) == (i == j || d (i, j) != value_type/*zero*/()) );
+
+    // Back to compressed matrices, each element of the stored triangle twice
+    BOOST_UBLAS_TEST_CHECK(( uses_conversion<compressed_matrix<value_type>, S> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_conversion<compressed_matrix<value_type, column_major, 1>, S> () ));
+    compressed_matrix<value_type> r (s);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - d) == 0 && r.nnz () == non_zeros (d) );
+    compressed_matrix<value_type, column_major, 1> rc (d.size1 (), d.size2 ());
+    rc = s;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (rc - d) == 0 && rc.nnz () == non_zeros (d) );
+    for (std::size_t i = 0; i < d.size1 (); ++ i)
+        for (std::size_t j = 0; j < d.size2 (); ++ j)
+            BOOST_UBLAS_TEST_CHECK( r (i, j) == d (i, j) && rc (i, j) == d (i, j) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_storage )
+{
+    const std::size_t size = 61;
+    compressed_matrix<double> cr (size, size);
+    fill_sparse (cr);
+    check_storage<symmetric_compressed_matrix<double> > (cr, test_fails__);
+    check_storage<symmetric_compressed_matrix<double, upper> > (cr, test_fails__);
+
+    // From other expressions
+    compressed_matrix<double, column_major, 1> cc (size, size);
+    fill_sparse (cc);
+    check_storage<symmetric_compressed_matrix<double> > (cc, test_fails__);
+    check_storage<symmetric_compressed_matrix<double, upper> > (cc, test_fails__);
+    matrix<double> d (size, size, 0.0);
+    fill_sparse (d);
+    check_storage<symmetric_compressed_matrix<double, upper> > (d, test_fails__);
+    check_storage<symmetric_compressed_matrix<double> > (symmetric_compressed_matrix<double, upper> (cr), test_fails__);
+    check_storage<symmetric_compressed_matrix<double> > (zero_matrix<double> (size, size), test_fails__);
+    check_storage<symmetric_compressed_matrix<double> > (zero_matrix<double> (0, 0), test_fails__);
+    check_storage<symmetric_compressed_matrix<double, lower, std::vector<std::size_t>, std::vector<double> > > (cr, test_fails__);
+    compressed_matrix<complex_type> cz (size, size);
+    fill_sparse (cz);
+    check_storage<symmetric_compressed_matrix<complex_type, upper> > (cz, test_fails__);
+
+    // Only the stored triangle is read
+    compressed_matrix<double> skew (cr);
+    skew (2, 40) = 7.0;
+    skew (0, 1) = -1.0;
+    symmetric_compressed_matrix<double> sl (skew);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (sl - d) == 0 );
+    symmetric_compressed_matrix<double, upper> su (trans (skew));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (su - d) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_elements )
+{
+    const std::size_t size = 23;
+    matrix<double> d (size, size, 0.0);
+    fill_sparse (d);
+    symmetric_compressed_matrix<double> s (d);
+    symmetric_compressed_matrix<double, upper> u (d);
+
+    // Both elements of a pair are set at once
+    d (2, 15) = d (15, 2) = 3.0;
+    s (2, 15) = 3.0;
+    u.insert_element (15, 2, 3.0);
+    d (4, 4) = 0.0;
+    s.erase_element (4, 4);
+    u.erase_element (4, 4);
+    d (14, 0) = d (0, 14) = 0.0;
+    s.erase_element (0, 14);
+    u.erase_element (14, 0);
+    d (1, 0) = d (0, 1) = 5.0;
+    s.insert_element (1, 0, 5.0);
+    u (1, 0) = 5.0;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - d) == 0 && same_iterated (s, d, non_zeros (d)) );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (u - d) == 0 && same_iterated (u, d, non_zeros (d)) );
+    BOOST_UBLAS_TEST_CHECK( s.filled () == u.filled () && s.find_element (14, 0) == 0 );
+
+    // Repeated elements are summed
+    compressed_matrix<double> cr (d);
+    symmetric_compressed_matrix<double> sum (d);
+    sum.assign (cr + symmetric_compressed_matrix<double, upper> (cr));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (sum - 2.0 * d) == 0 );
+
+    // Assignments
+    s *= 2.0;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - 2.0 * d) == 0 );
+    s /= 4.0;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - 0.5 * d) == 0 );
+    s += d;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - 1.5 * d) == 0 );
+    s -= u;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - 0.5 * d) == 0 );
+    s = u;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - d) == 0 );
+    s = 3.0 * d;
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - 3.0 * d) == 0 );
+    s.assign (s);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (s - 3.0 * d) == 0 );
+    s.clear ();
+    BOOST_UBLAS_TEST_CHECK( s.filled () == 0 && norm_inf (s) == 0 && s.begin1 ().begin () == s.begin1 ().end () );
+    s.resize (5, 5, false);
+    BOOST_UBLAS_TEST_CHECK( s.size1 () == 5 && s.nnz () == 5 );
+}
+
+template<class S>
+void check_prod (const S &s, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    const matrix<value_type> d (s);
+    const double tolerance = 1e-13 * (1 + norm_inf (d));
+
+    vector<value_type> x (s.size2 ()), y (s.size1 ()), e (s.size1 ());
+    for (std::size_t j = 0; j < x.size (); ++ j)
+        x (j) = value_type (1.0 + j % 4) / value_type (3);
+    e = prod (d, x);
+    y = prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    noalias (y) += prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+    noalias (y) -= prod (s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= 2 * tolerance );
+    axpy_prod (s, x, y, true);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - e) <= tolerance );
+    axpy_prod (s, x, y, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y - value_type (2) * e) <= 2 * tolerance );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    const std::size_t size = 300;
+    compressed_matrix<double> cr (size, size);
+    fill_sparse (cr);
+    check_prod (symmetric_compressed_matrix<double> (cr), test_fails__);
+    check_prod (symmetric_compressed_matrix<double, upper> (cr), test_fails__);
+    compressed_matrix<complex_type> cz (size, size);
+    fill_sparse (cz);
+    check_prod (symmetric_compressed_matrix<complex_type> (cz), test_fails__);
+    check_prod (symmetric_compressed_matrix<complex_type, upper> (cz), test_fails__);
+    check_prod (symmetric_compressed_matrix<double> (size), test_fails__);
+    check_prod (symmetric_compressed_matrix<double> (0), test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_storage );
+    BOOST_UBLAS_TEST_DO( test_elements );
+    BOOST_UBLAS_TEST_DO( test_prod );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <complex>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+void fill (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = 1000.0 * i + j;
+}
+
+template<class M1, class M2>
+bool is_transposed (const M1 &t, const M2 &m) {
+    if (t.size1 () != m.size2 () || t.size2 () != m.size1 ())
+        return false;
+    for (std::size_t i = 0; i < t.size1 (); ++ i)
+        for (std::size_t j = 0; j < t.size2 (); ++ j)
+            if (t (i, j) != m (j, i))
+                return false;
+    return true;
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef matrix<double> rm;
+    typedef matrix<double, column_major> cm;
+    BOOST_UBLAS_TEST_CHECK(( boost::is_same<detail::matrix_transpose_traits<rm, matrix_unary2<const rm, scalar_identity<double> >, dense_tag>::storage_category,
+                                            detail::dense_transpose_tag>::value ));
+    BOOST_UBLAS_TEST_CHECK(( boost::is_same<detail::matrix_transpose_traits<cm, matrix_unary2<const cm, scalar_identity<double> >, dense_tag>::storage_category,
+                                            detail::dense_transpose_tag>::value ));
+    // Already contiguous on both sides, the element wise loop is kept
+    BOOST_UBLAS_TEST_CHECK(( boost::is_same<detail::matrix_transpose_traits<rm, matrix_unary2<const cm, scalar_identity<double> >, dense_tag>::storage_category,
+                                            dense_tag>::value ));
+}
+
+template<class L1, class L2>
+void check_assign (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    matrix<double, L2> a (size1, size2);
+    fill (a);
+
+    matrix<double, L1> b (size2, size1);
+    noalias (b) = trans (a);
+    BOOST_UBLAS_TEST_CHECK( is_transposed (b, a) );
+
+    matrix<double, L1> c (trans (a));
+    BOOST_UBLAS_TEST_CHECK( is_transposed (c, a) );
+
+    noalias (c) += trans (a);
+    for (std::size_t i = 0; i < c.size1 (); ++ i)
+        for (std::size_t j = 0; j < c.size2 (); ++ j)
+            if (c (i, j) != 2 * a (j, i))
+                ++ test_fails__;
+}
+
+BOOST_UBLAS_TEST_DEF( test_out_of_place )
+{
+    check_assign<row_major, row_major> (3, 5, test_fails__);
+    check_assign<row_major, row_major> (70, 45, test_fails__);
+    check_assign<row_major, row_major> (257, 130, test_fails__);
+    check_assign<column_major, column_major> (130, 257, test_fails__);
+    check_assign<row_major, column_major> (70, 45, test_fails__);
+    check_assign<padded_row_major, padded_row_major> (65, 100, test_fails__);
+    check_assign<padded_column_major, column_major> (100, 65, test_fails__);
+    check_assign<row_major, row_major> (0, 5, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_herm )
+{
+    typedef std::complex<double> value_type;
+    matrix<value_type> a (40, 75);
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t j = 0; j < a.size2 (); ++ j)
+            a (i, j) = value_type (i, j);
+    matrix<value_type> h (herm (a));
+    BOOST_UBLAS_TEST_CHECK_EQUAL( h.size1 (), std::size_t (75) );
+    for (std::size_t i = 0; i < h.size1 (); ++ i)
+        for (std::size_t j = 0; j < h.size2 (); ++ j)
+            if (h (i, j) != std::conj (a (j, i)))
+                ++ test_fails__;
+
+    // In place on the same square matrix
+    matrix<value_type> s (project (a, range (0, 40), range (0, 40)));
+    matrix<value_type> r (herm (s));
+    noalias (s) = herm (s);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( s, r, 40, 40 );
+}
+
+template<class L>
+void check_inplace (std::size_t size1, std::size_t size2, std::size_t &test_fails__) {
+    matrix<double, L> a (size1, size2);
+    fill (a);
+    matrix<double, L> m (a);
+    inplace_transpose (m);
+    BOOST_UBLAS_TEST_CHECK( is_transposed (m, a) );
+    inplace_transpose (m);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ( m, a, size1, size2 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_inplace )
+{
+    check_inplace<row_major> (1, 1, test_fails__);
+    check_inplace<row_major> (100, 100, test_fails__);
+    check_inplace<column_major> (67, 67, test_fails__);
+    check_inplace<row_major> (3, 7, test_fails__);
+    check_inplace<row_major> (1, 9, test_fails__);
+    check_inplace<row_major> (120, 45, test_fails__);
+    check_inplace<column_major> (45, 120, test_fails__);
+    check_inplace<padded_row_major> (70, 70, test_fails__);
+    check_inplace<padded_column_major> (30, 70, test_fails__);
+
+    matrix<double> e (0, 4);
+    inplace_transpose (e);
+    BOOST_UBLAS_TEST_CHECK_EQUAL( e.size1 (), std::size_t (4) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( e.size2 (), std::size_t (0) );
+
+    // The rectangular case keeps the storage
+    matrix<double> r (20, 30);
+    fill (r);
+    const double *data = &r (0, 0);
+    inplace_transpose (r);
+    BOOST_UBLAS_TEST_CHECK( data == &r (0, 0) );
+
+    // Through the assignment
+    matrix<double> a (90, 90);
+    fill (a);
+    matrix<double> s (a);
+    noalias (s) = trans (s);
+    BOOST_UBLAS_TEST_CHECK( is_transposed (s, a) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_out_of_place );
+    BOOST_UBLAS_TEST_DO( test_herm );
+    BOOST_UBLAS_TEST_DO( test_inplace );
+
+    BOOST_UBLAS_TEST_END();
+}
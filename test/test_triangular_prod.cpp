@@ -0,0 +1,214 @@
+// Copyright (c) 2026 The uBLAS contributors
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Small blocks, so that the off diagonal blocks are used
+#define BOOST_UBLAS_SOLVE_BLOCK_SIZE 8
+
+#include <complex>
+
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/blas.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef std::complex<double> complex_type;
+
+template<class T>
+T element (std::size_t i, std::size_t j) {
+    return T (1.0 + (3 * i + 5 * j) % 7) / T (8);
+}
+template<>
+complex_type element<complex_type> (std::size_t i, std::size_t j) {
+    return complex_type (1.0 + (3 * i + 5 * j) % 7, 2.0 - (i + 2 * j) % 5) / 8.0;
+}
+
+template<class M>
+void fill_matrix (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = element<typename M::value_type> (i, j + 1);
+}
+
+template<class M, class E>
+bool uses_kernel () {
+    typedef typename M::reference reference;
+    typedef typename E::value_type value_type;
+    return boost::is_same<typename detail::matrix_prod_traits<M, E, scalar_assign<reference, value_type>, dense_tag>::storage_category,
+                          detail::triangular_prod_tag>::value;
+}
+template<class M, class E1, class E2>
+bool uses_kernel () {
+    typedef typename E1::value_type value_type;
+    return uses_kernel<M, matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, value_type> > > ();
+}
+
+BOOST_UBLAS_TEST_DEF( test_dispatch )
+{
+    typedef matrix<double> dm;
+    typedef matrix<double, column_major> cm;
+    typedef triangular_matrix<double, lower> tl;
+    typedef triangular_adaptor<const cm, unit_upper> ta;
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dm, tl, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<cm, dm, tl> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<dm, ta, cm> () ));
+    BOOST_UBLAS_TEST_CHECK(( uses_kernel<matrix_range<dm>, matrix_range<dm>, ta> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, dm, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, tl, tl> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, banded_matrix<double>, dm> () ));
+    typedef triangular_adaptor<const banded_matrix<double>, lower> ba;
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<dm, ba, dm> () ));
+    BOOST_UBLAS_TEST_CHECK(( ! uses_kernel<matrix<complex_type>, tl, dm> () ));
+}
+
+// Products of the triangle t, held as the dense a, with the dense b from either side
+template<class M, class D>
+void check_prod (const M &t, const D &a, std::size_t size, std::size_t &test_fails__) {
+    typedef typename D::value_type value_type;
+    typedef typename D::orientation_category orientation_category;
+    typedef typename boost::mpl::if_<boost::is_same<orientation_category, row_major_tag>, column_major, row_major>::type layout_type;
+    typedef matrix<value_type, layout_type> matrix_type;
+
+    // Left
+    matrix_type b (a.size2 (), size);
+    fill_matrix (b);
+    matrix_type expected (prod (a, b));
+    double tolerance = 1e-12 * (1 + norm_inf (expected));
+    matrix_type r (prod (t, b));
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= tolerance );
+    noalias (r) += prod (t, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - value_type (2) * expected) <= 2 * tolerance );
+    noalias (r) -= prod (t, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= 3 * tolerance );
+    matrix_type z (a.size1 (), size, value_type (7));
+    axpy_prod (t, b, z, false);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected - scalar_matrix<value_type> (a.size1 (), size, value_type (7))) <= tolerance );
+    axpy_prod (t, b, z);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - expected) <= tolerance );
+    blas_3::tmm (z, value_type (2), t, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z - value_type (2) * expected) <= 2 * tolerance );
+
+    // Into rows and columns of a larger matrix, the others are not touched
+    matrix<value_type> w (a.size1 () + 2, size + 3, value_type (5));
+    noalias (project (w, range (1, a.size1 () + 1), range (2, size + 2))) = prod (t, b);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (project (w, range (1, a.size1 () + 1), range (2, size + 2)) - expected) <= tolerance );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (0, 0), value_type (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (a.size1 () + 1, size + 2), value_type (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (1, 1), value_type (5) );
+
+    // Right
+    matrix_type c (size, a.size1 ());
+    fill_matrix (c);
+    expected = prod (c, a);
+    tolerance = 1e-12 * (1 + norm_inf (expected));
+    r = prod (c, t);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= tolerance );
+    noalias (r) -= prod (c, t);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r) <= 2 * tolerance );
+    axpy_prod (c, t, r);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (r - expected) <= tolerance );
+}
+
+// The triangle as a dense matrix, read element by element
+template<class M>
+matrix<typename M::value_type> dense (const M &t) {
+    matrix<typename M::value_type> a (t.size1 (), t.size2 ());
+    for (std::size_t i = 0; i < t.size1 (); ++ i)
+        for (std::size_t j = 0; j < t.size2 (); ++ j)
+            a (i, j) = t (i, j);
+    return a;
+}
+
+template<class TRI, class T, class L>
+void check_adaptor (const matrix<T, L> &d, std::size_t size, std::size_t &test_fails__) {
+    const triangular_adaptor<const matrix<T, L>, TRI> t (d);
+    check_prod (t, dense (t), size, test_fails__);
+}
+
+template<class T, class L>
+void check_triangles (std::size_t size1, std::size_t size2, std::size_t size, std::size_t &test_fails__) {
+    matrix<T, L> d (size1, size2);
+    fill_matrix (d);
+    check_adaptor<lower> (d, size, test_fails__);
+    check_adaptor<upper> (d, size, test_fails__);
+    check_adaptor<unit_lower> (d, size, test_fails__);
+    check_adaptor<unit_upper> (d, size, test_fails__);
+    if (size1 != size2)
+        return;
+
+    // Packed storage of square triangles
+    triangular_matrix<T, lower, L> tl (size1, size2);
+    triangular_matrix<T, unit_upper, L> tu (size1, size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j) {
+            if (lower::other (i, j))
+                tl (i, j) = d (i, j);
+            if (unit_upper::other (i, j))
+                tu (i, j) = d (i, j);
+        }
+    check_prod (tl, dense (static_cast<const triangular_matrix<T, lower, L> &> (tl)), size, test_fails__);
+    check_prod (tu, dense (static_cast<const triangular_matrix<T, unit_upper, L> &> (tu)), size, test_fails__);
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    check_triangles<double, row_major> (37, 37, 20, test_fails__);
+    check_triangles<double, column_major> (37, 37, 20, test_fails__);
+    check_triangles<double, row_major> (29, 13, 9, test_fails__);
+    check_triangles<double, column_major> (13, 29, 9, test_fails__);
+    check_triangles<double, row_major> (1, 1, 1, test_fails__);
+    check_triangles<complex_type, column_major> (19, 19, 11, test_fails__);
+}
+
+template<class TRI, class C, class T, class L>
+void check_inplace (std::size_t size, std::size_t size2, std::size_t &test_fails__) {
+    matrix<T, L> d (size, size);
+    fill_matrix (d);
+    const matrix<T> a ((triangular_adaptor<const matrix<T, L>, TRI> (d)));
+    matrix<T, L> b (size, size2);
+    fill_matrix (b);
+    const matrix<T> expected (prod (a, b));
+    inplace_prod (d, b, C ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (b - expected) <= 1e-12 * (1 + norm_inf (expected)) );
+
+    // Columns of a larger matrix, the others are not touched
+    matrix<T, L> w (size + 2, size2 + 3, T (5));
+    fill_matrix (b);
+    project (w, range (1, size + 1), range (2, size2 + 2)) = b;
+    matrix_range<matrix<T, L> > wr (w, range (1, size + 1), range (2, size2 + 2));
+    const triangular_matrix<T, TRI, L> t (a);
+    inplace_prod (t, wr, C ());
+    BOOST_UBLAS_TEST_CHECK( norm_inf (wr - expected) <= 1e-12 * (1 + norm_inf (expected)) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (0, 0), T (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (size + 1, size2 + 2), T (5) );
+    BOOST_UBLAS_TEST_CHECK_EQUAL( w (1, 1), T (5) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_inplace )
+{
+    const std::size_t sizes [] = { 1, 7, 8, 9, 30 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        check_inplace<lower, lower_tag, double, row_major> (sizes [k], 11, test_fails__);
+        check_inplace<upper, upper_tag, double, row_major> (sizes [k], 11, test_fails__);
+        check_inplace<unit_lower, unit_lower_tag, double, column_major> (sizes [k], 5, test_fails__);
+        check_inplace<unit_upper, unit_upper_tag, double, column_major> (sizes [k], 5, test_fails__);
+    }
+    check_inplace<lower, lower_tag, complex_type, column_major> (21, 4, test_fails__);
+    check_inplace<upper, upper_tag, complex_type, row_major> (21, 4, test_fails__);
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_dispatch );
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_inplace );
+
+    BOOST_UBLAS_TEST_END();
+}